@@ -0,0 +1,242 @@
+/*
+	Runs benchmark scenarios and reports step time percentiles, time per subsystem from the StepProfilers, and peak resident memory.
+	Usage: bench [scenario ...] [--steps count] [--seed seed] [--json path] [--list]
+	With no scenario names every scenario is run. Must be run from the repository root so data can be loaded.
+	Peak memory is reset before each scenario on Linux, so scenarios run in one process do not inherit each other's peaks.
+*/
+#include "scenarios.h"
+#include "../engine/area/area.h"
+#include "../engine/config/config.h"
+#include "../engine/definitions/definitions.h"
+#include "../engine/json.h"
+#include "../engine/objective.h"
+#include "../engine/simulation/simulation.h"
+#include "../engine/stepProfiler.h"
+#include "../engine/threads.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <string>
+
+namespace
+{
+	struct DurationStats
+	{
+		double mean = 0;
+		double p50 = 0;
+		double p90 = 0;
+		double p99 = 0;
+		double max = 0;
+		int count = 0;
+		// Takes durations in milliseconds, sorts them.
+		static DurationStats create(std::vector<double>& durations)
+		{
+			DurationStats output;
+			if(durations.empty())
+				return output;
+			std::ranges::sort(durations);
+			const auto percentile = [&](const double fraction) { return durations[std::min<int>(durations.size() - 1, fraction * durations.size())]; };
+			output.mean = std::accumulate(durations.begin(), durations.end(), 0.0) / durations.size();
+			output.p50 = percentile(0.5);
+			output.p90 = percentile(0.9);
+			output.p99 = percentile(0.99);
+			output.max = durations.back();
+			output.count = durations.size();
+			return output;
+		}
+		[[nodiscard]] Json toJson() const { return {{"mean", mean}, {"p50", p50}, {"p90", p90}, {"p99", p99}, {"max", max}, {"count", count}}; }
+	};
+	struct ScenarioResult
+	{
+		std::string name;
+		DurationStats step;
+		// Only phases which were recorded at least once, in StepPhase order.
+		std::vector<std::pair<StepPhase, DurationStats>> phases;
+		double setupMilliseconds = 0;
+		int64_t peakResidentKiB = -1;
+		uint32_t seed = 0;
+		int stepCount = 0;
+		[[nodiscard]] Json toJson() const
+		{
+			Json output{
+				{"name", name},
+				{"seed", seed},
+				{"steps", stepCount},
+				{"setupMs", setupMilliseconds},
+				{"peakRssKiB", peakResidentKiB},
+				{"step", step.toJson()},
+			};
+			output["phases"] = Json::object();
+			for(const auto& [phase, stats] : phases)
+				output["phases"][std::string(StepProfiler::getPhaseName(phase))] = stats.toJson();
+			return output;
+		}
+	};
+	// Writing 5 to clear_refs resets the peak resident set size of the process, Linux only. Does nothing elsewhere.
+	void resetPeakResident()
+	{
+		std::ofstream clearRefs("/proc/self/clear_refs");
+		if(clearRefs)
+			clearRefs << "5";
+	}
+	// VmHWM from /proc/self/status, -1 if unavailable.
+	int64_t getPeakResidentKiB()
+	{
+		std::ifstream status("/proc/self/status");
+		std::string line;
+		while(std::getline(status, line))
+			if(line.starts_with("VmHWM:"))
+				return std::stoll(line.substr(6));
+		return -1;
+	}
+	[[nodiscard]] double toMilliseconds(const std::chrono::microseconds duration) { return duration.count() / 1000.0; }
+	// Each phase is collected from whichever profiler records it, Area phases from the Area and Simulation phases from the Simulation.
+	void collectPhases(const StepProfiler& profiler, std::vector<std::vector<double>>& durationsByPhase)
+	{
+		for(int stepsAgo = profiler.size() - 1; stepsAgo >= 0; --stepsAgo)
+		{
+			const StepProfile& profile = profiler.get(stepsAgo);
+			for(int phase = 0; phase != (int)StepPhase::Null; ++phase)
+				if(profile.phases[phase].recorded)
+					durationsByPhase[phase].push_back(toMilliseconds(profile.phases[phase].duration));
+		}
+	}
+	ScenarioResult run(BenchScenario& scenario, const uint32_t seed, const int stepCount)
+	{
+		ScenarioResult output;
+		output.name = scenario.name();
+		output.seed = seed;
+		output.stepCount = stepCount;
+		resetPeakResident();
+		const auto setupBegin = std::chrono::steady_clock::now();
+		scenario.setup(seed);
+		output.setupMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - setupBegin).count();
+		Simulation* simulation = scenario.getSimulation();
+		Area* area = scenario.getArea();
+		for(StepProfiler* profiler : {simulation == nullptr ? nullptr : &simulation->m_stepProfiler, area == nullptr ? nullptr : &area->m_stepProfiler})
+			if(profiler != nullptr)
+			{
+				profiler->setCapacity(stepCount);
+				profiler->setEnabled(true);
+			}
+		std::vector<double> stepDurations;
+		stepDurations.reserve(stepCount);
+		for(int i = 0; i != stepCount; ++i)
+		{
+			const auto begin = std::chrono::steady_clock::now();
+			scenario.step(i);
+			stepDurations.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count());
+		}
+		output.peakResidentKiB = getPeakResidentKiB();
+		output.step = DurationStats::create(stepDurations);
+		std::vector<std::vector<double>> durationsByPhase((int)StepPhase::Null);
+		if(simulation != nullptr)
+			collectPhases(simulation->m_stepProfiler, durationsByPhase);
+		if(area != nullptr)
+			collectPhases(area->m_stepProfiler, durationsByPhase);
+		for(int phase = 0; phase != (int)StepPhase::Null; ++phase)
+			if(!durationsByPhase[phase].empty())
+				output.phases.emplace_back((StepPhase)phase, DurationStats::create(durationsByPhase[phase]));
+		return output;
+	}
+	void print(const BenchScenario& scenario, const ScenarioResult& result)
+	{
+		std::printf("%s: %s\n", result.name.c_str(), std::string(scenario.description()).c_str());
+		std::printf("  seed %u, %d steps, setup %.1f ms", result.seed, result.stepCount, result.setupMilliseconds);
+		if(result.peakResidentKiB != -1)
+			std::printf(", peak RSS %.1f MiB", result.peakResidentKiB / 1024.0);
+		std::printf("\n  %-24s %10s %10s %10s %10s %10s (ms)\n", "", "mean", "p50", "p90", "p99", "max");
+		const auto printRow = [](const std::string_view name, const DurationStats& stats)
+		{
+			std::printf("  %-24s %10.3f %10.3f %10.3f %10.3f %10.3f\n", std::string(name).c_str(), stats.mean, stats.p50, stats.p90, stats.p99, stats.max);
+		};
+		printRow("step", result.step);
+		for(const auto& [phase, stats] : result.phases)
+			printRow(StepProfiler::getPhaseName(phase), stats);
+		std::printf("\n");
+	}
+	void printUsage()
+	{
+		std::printf("Usage: bench [scenario ...] [--steps count] [--seed seed] [--json path] [--list]\n");
+	}
+	[[nodiscard]] bool parseInt(const std::string_view text, auto& output)
+	{
+		const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), output);
+		return error == std::errc() && end == text.data() + text.size();
+	}
+}
+int main(int argc, char** argv)
+{
+	std::vector<std::string_view> names;
+	int stepCount = 0;
+	uint32_t seed = 0;
+	std::string jsonPath;
+	for(int i = 1; i < argc; ++i)
+	{
+		const std::string_view argument = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if(argument == "--list")
+		{
+			for(const std::string_view name : getBenchScenarioNames())
+				std::printf("%s: %s\n", std::string(name).c_str(), std::string(createBenchScenario(name)->description()).c_str());
+			return 0;
+		}
+		else if(argument == "--steps" && hasValue)
+		{
+			if(!parseInt(argv[++i], stepCount) || stepCount <= 0)
+			{
+				printUsage();
+				return 1;
+			}
+		}
+		else if(argument == "--seed" && hasValue)
+		{
+			if(!parseInt(argv[++i], seed))
+			{
+				printUsage();
+				return 1;
+			}
+		}
+		else if(argument == "--json" && hasValue)
+			jsonPath = argv[++i];
+		else if(argument.starts_with("--"))
+		{
+			printUsage();
+			return 1;
+		}
+		else
+			names.push_back(argument);
+	}
+	if(names.empty())
+		names = getBenchScenarioNames();
+	for(const std::string_view name : names)
+		if(createBenchScenario(name) == nullptr)
+		{
+			std::fprintf(stderr, "Unknown scenario %s, see --list.\n", std::string(name).c_str());
+			return 1;
+		}
+	// Config must be loaded before definitions.
+	Config::load();
+	definitions::load();
+	ObjectiveType::load();
+	threads::init();
+	Json output;
+	output["scenarios"] = Json::array();
+	for(const std::string_view name : names)
+	{
+		// Destroyed before the next scenario so its memory is not counted in the next peak.
+		std::unique_ptr<BenchScenario> scenario = createBenchScenario(name);
+		const ScenarioResult result = run(*scenario, seed, stepCount == 0 ? scenario->defaultStepCount() : stepCount);
+		print(*scenario, result);
+		output["scenarios"].push_back(result.toJson());
+	}
+	if(!jsonPath.empty())
+	{
+		std::ofstream file(jsonPath);
+		file << output.dump(1, '\t');
+	}
+	return 0;
+}
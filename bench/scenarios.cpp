@@ -0,0 +1,431 @@
+#include "scenarios.h"
+#include "../engine/actors/actors.h"
+#include "../engine/area/area.h"
+#include "../engine/area/stockpile.h"
+#include "../engine/areaBuilderUtil.h"
+#include "../engine/dataStructures/rtreeBoolean.h"
+#include "../engine/definitions/animalSpecies.h"
+#include "../engine/definitions/itemType.h"
+#include "../engine/definitions/materialType.h"
+#include "../engine/definitions/plantSpecies.h"
+#include "../engine/fluidType.h"
+#include "../engine/geometry/paramaterizedLine.h"
+#include "../engine/geometry/sphere.h"
+#include "../engine/items/items.h"
+#include "../engine/objectives/dig.h"
+#include "../engine/objectives/exterminate.h"
+#include "../engine/objectives/stockpile.h"
+#include "../engine/plants.h"
+#include "../engine/simulation/hasAreas.h"
+#include "../engine/simulation/simulation.h"
+#include "../engine/space/space.h"
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+	class SimulationScenario : public BenchScenario
+	{
+	protected:
+		std::unique_ptr<Simulation> m_simulation;
+		Area* m_area = nullptr;
+		uint32_t m_seed = 0;
+		[[nodiscard]] virtual std::unique_ptr<Simulation> createSimulation() { return std::make_unique<Simulation>(); }
+		// Builds the world in m_simulation, must call createArea.
+		virtual void build() = 0;
+		// Scripted changes made before a measured step, such as opening a dam.
+		virtual void beforeStep([[maybe_unused]] const int stepIndex) { }
+		Area& createArea(const int x, const int y, const int z)
+		{
+			m_area = &m_simulation->m_hasAreas->createArea(x, y, z);
+			m_area->m_random.seed(m_seed);
+			return *m_area;
+		}
+	public:
+		void setup(const uint32_t seed) override
+		{
+			m_seed = seed;
+			m_simulation = createSimulation();
+			m_simulation->m_random.seed(seed);
+			build();
+			assert(m_area != nullptr);
+		}
+		void step(const int stepIndex) override
+		{
+			beforeStep(stepIndex);
+			m_simulation->doStep();
+		}
+		[[nodiscard]] Simulation* getSimulation() override { return m_simulation.get(); }
+		[[nodiscard]] Area* getArea() override { return m_area; }
+	};
+	// 200x200x50 with a stone floor at z 10, interior walls with gaps and 500 dwarves hauling chunks to one stockpile.
+	class FortressScenario final : public SimulationScenario
+	{
+		void build() override
+		{
+			static const MaterialTypeId marble = MaterialType::byName("marble");
+			static const ItemTypeId chunk = ItemType::byName("chunk");
+			static const AnimalSpeciesId dwarf = AnimalSpecies::byName("dwarf");
+			Area& area = createArea(200, 200, 50);
+			area.m_hasRain.disable();
+			areaBuilderUtil::setSolidLayers(area, 0, 9, marble);
+			areaBuilderUtil::setSolidWalls(area, 14, marble);
+			// Interior walls dividing the floor into a 4x4 grid of halls, with a doorway in each wall segment.
+			for(int i = 40; i < 200; i += 40)
+				for(int segment = 0; segment < 200; segment += 40)
+				{
+					areaBuilderUtil::setSolidWall(area, Point3D::create(i, segment + 1, 10), Point3D::create(i, segment + 17, 12), marble);
+					areaBuilderUtil::setSolidWall(area, Point3D::create(i, segment + 21, 10), Point3D::create(i, segment + 38, 12), marble);
+					areaBuilderUtil::setSolidWall(area, Point3D::create(segment + 1, i, 10), Point3D::create(segment + 17, i, 12), marble);
+					areaBuilderUtil::setSolidWall(area, Point3D::create(segment + 21, i, 10), Point3D::create(segment + 38, i, 12), marble);
+				}
+			const FactionId faction = m_simulation->createFaction("Tower of Power");
+			area.m_hasStockPiles.registerFaction(faction);
+			area.m_hasStocks.addFaction(faction);
+			area.m_spaceDesignations.registerFaction(faction);
+			AreaHasStockPilesForFaction& stockPiles = area.m_hasStockPiles.getForFaction(faction);
+			std::vector<ItemQuery> queries;
+			queries.emplace_back(ItemQuery::create(chunk));
+			StockPile& stockPile = stockPiles.addStockPile(queries);
+			const Cuboid stockPileCuboid = {Point3D::create(30, 30, 10), Point3D::create(1, 1, 10)};
+			for(const Point3D point : stockPileCuboid)
+				stockPile.addPoint(point);
+			Items& items = area.getItems();
+			// Chunks on a regular grid outside of the stockpile, odd coordinates never fall on a wall.
+			for(int x = 3; x < 199; x += 4)
+				for(int y = 3; y < 199; y += 4)
+				{
+					const Point3D location = Point3D::create(x, y, 10);
+					if(stockPileCuboid.contains(location))
+						continue;
+					const ItemIndex item = items.create({.itemType=chunk, .materialType=marble, .location=location, .quantity=Quantity::create(1u)});
+					stockPiles.addItem(item);
+				}
+			Actors& actors = area.getActors();
+			const StockPileObjectiveType& objectiveType = static_cast<const StockPileObjectiveType&>(ObjectiveType::getByName("stockpile"));
+			int created = 0;
+			for(int x = 42; x < 198 && created != 500; x += 6)
+				for(int y = 42; y < 198 && created != 500; y += 6)
+				{
+					if(x % 40 == 0 || y % 40 == 0)
+						continue;
+					const ActorIndex actor = actors.create({
+						.species=dwarf,
+						.location=Point3D::create(x, y, 10),
+						.faction=faction,
+						.hasCloths=false,
+						.hasSidearm=false,
+					});
+					actors.objective_setPriority(actor, objectiveType.getId(), Priority::create(100));
+					++created;
+				}
+		}
+	public:
+		[[nodiscard]] std::string_view name() const override { return "fortress"; }
+		[[nodiscard]] std::string_view description() const override { return "200x200x50 fortress with 500 dwarves hauling to a stockpile"; }
+		[[nodiscard]] int defaultStepCount() const override { return 500; }
+	};
+	// A walled reservoir of water which is released into a 100x100 basin on the first measured step.
+	class FloodScenario final : public SimulationScenario
+	{
+		Cuboid m_dam;
+		void build() override
+		{
+			static const MaterialTypeId marble = MaterialType::byName("marble");
+			static const FluidTypeId water = FluidType::byName("water");
+			Area& area = createArea(100, 100, 30);
+			area.m_hasRain.disable();
+			areaBuilderUtil::setSolidLayers(area, 0, 4, marble);
+			areaBuilderUtil::setSolidWalls(area, 25, marble);
+			// Reservoir in one corner, closed by the dam on it's east and north sides.
+			areaBuilderUtil::setSolidWall(area, Point3D::create(31, 1, 5), Point3D::create(31, 31, 25), marble);
+			areaBuilderUtil::setSolidWall(area, Point3D::create(1, 31, 5), Point3D::create(30, 31, 25), marble);
+			areaBuilderUtil::setFullFluidCuboid(area, Point3D::create(1, 1, 5), Point3D::create(30, 30, 20), water);
+			m_dam = {Point3D::create(31, 20, 25), Point3D::create(31, 10, 5)};
+		}
+		void beforeStep(const int stepIndex) override
+		{
+			if(stepIndex == 0)
+				m_area->getSpace().solid_setNotCuboid(m_dam);
+		}
+	public:
+		[[nodiscard]] std::string_view name() const override { return "flood"; }
+		[[nodiscard]] std::string_view description() const override { return "30x30x16 reservoir of water released into a 100x100 basin"; }
+		[[nodiscard]] int defaultStepCount() const override { return 500; }
+	};
+	// Two factions of 500 armed dwarves each, sent to exterminate each other from opposite sides of a 150x150 field.
+	class BattleScenario final : public SimulationScenario
+	{
+		void build() override
+		{
+			static const MaterialTypeId marble = MaterialType::byName("marble");
+			static const AnimalSpeciesId dwarf = AnimalSpecies::byName("dwarf");
+			Area& area = createArea(150, 150, 5);
+			area.m_hasRain.disable();
+			areaBuilderUtil::setSolidLayer(area, 0, marble);
+			const FactionId red = m_simulation->createFaction("Red");
+			const FactionId blue = m_simulation->createFaction("Blue");
+			m_simulation->m_hasFactions.getById(red).enemies.insert(blue);
+			m_simulation->m_hasFactions.getById(blue).enemies.insert(red);
+			Actors& actors = area.getActors();
+			// 10 ranks of 50, two points apart.
+			const auto createSide = [&](const FactionId faction, const int xBegin, const Point3D destination)
+			{
+				for(int x = xBegin; x != xBegin + 20; x += 2)
+					for(int y = 25; y != 125; y += 2)
+					{
+						const ActorIndex actor = actors.create({
+							.species=dwarf,
+							.location=Point3D::create(x, y, 1),
+							.faction=faction,
+							.hasCloths=true,
+							.hasSidearm=true,
+						});
+						actors.objective_addTaskToStart(actor, std::make_unique<ExterminateObjective>(area, destination));
+					}
+			};
+			createSide(red, 5, Point3D::create(135, 75, 1));
+			createSide(blue, 125, Point3D::create(15, 75, 1));
+		}
+	public:
+		[[nodiscard]] std::string_view name() const override { return "battle"; }
+		[[nodiscard]] std::string_view description() const override { return "1000 armed dwarves in two factions charging each other"; }
+		[[nodiscard]] int defaultStepCount() const override { return 500; }
+	};
+	// 50 miners digging shafts into a 100x100 block while a free standing slab loses its pillars one at a time and caves in.
+	class CaveInScenario final : public SimulationScenario
+	{
+		std::vector<Cuboid> m_pillars;
+		void build() override
+		{
+			static const MaterialTypeId marble = MaterialType::byName("marble");
+			static const MaterialTypeId bronze = MaterialType::byName("bronze");
+			static const AnimalSpeciesId dwarf = AnimalSpecies::byName("dwarf");
+			static const ItemTypeId pick = ItemType::byName("pick");
+			Area& area = createArea(100, 100, 40);
+			area.m_hasRain.disable();
+			areaBuilderUtil::setSolidLayers(area, 0, 19, marble);
+			Space& space = area.getSpace();
+			// A 30x30 slab at z 25 on a 4x4 grid of pillars, touching nothing else.
+			for(int x = 62; x <= 92; x += 10)
+				for(int y = 62; y <= 92; y += 10)
+					m_pillars.push_back({Point3D::create(x, y, 24), Point3D::create(x, y, 20)});
+			for(const Cuboid pillar : m_pillars)
+				space.solid_setCuboid(pillar, marble, false);
+			space.solid_setCuboid({Point3D::create(92, 92, 25), Point3D::create(62, 62, 25)}, marble, false);
+			space.solid_prepare();
+			const FactionId faction = m_simulation->createFaction("Tower of Power");
+			area.m_spaceDesignations.registerFaction(faction);
+			area.m_hasDigDesignations.addFaction(faction);
+			// Shafts on a grid in the west half of the block, away from the slab.
+			for(int x = 5; x < 50; x += 6)
+				for(int y = 5; y < 95; y += 6)
+					for(int z = 19; z != 14; --z)
+						area.m_hasDigDesignations.designate(faction, Point3D::create(x, y, z), PointFeatureTypeId::Null);
+			Actors& actors = area.getActors();
+			Items& items = area.getItems();
+			const DigObjectiveType& digObjectiveType = static_cast<const DigObjectiveType&>(ObjectiveType::getByName("dig"));
+			for(int i = 0; i != 50; ++i)
+			{
+				// Along the south edge, clear of the shafts and the slab.
+				const Point3D location = Point3D::create(3 + (i % 10) * 5, 95 + i / 10, 20);
+				const ActorIndex actor = actors.create({
+					.species=dwarf,
+					.location=location,
+					.faction=faction,
+				});
+				items.create({.itemType=pick, .materialType=bronze, .location=location.east(), .quality=Quality::create(50u), .percentWear=Percent::create(0)});
+				actors.objective_setPriority(actor, digObjectiveType.getId(), Priority::create(100));
+			}
+		}
+		void beforeStep(const int stepIndex) override
+		{
+			// Remove a pillar every 20 steps, the slab falls when the last one goes.
+			if(stepIndex % 20 != 0)
+				return;
+			const int index = stepIndex / 20;
+			if(index < (int)m_pillars.size())
+				m_area->getSpace().solid_setNotCuboid(m_pillars[index]);
+		}
+	public:
+		[[nodiscard]] std::string_view name() const override { return "caveIn"; }
+		[[nodiscard]] std::string_view description() const override { return "50 miners digging while a slab loses its pillars and caves in"; }
+		[[nodiscard]] int defaultStepCount() const override { return 500; }
+	};
+	// 100000 wheat grass plants on a 320x320 field of dirt during the growing season, with rain.
+	class ForestScenario final : public SimulationScenario
+	{
+		[[nodiscard]] std::unique_ptr<Simulation> createSimulation() override { return std::make_unique<Simulation>("forest", DateTime::toSteps(12, 100, 1200)); }
+		void build() override
+		{
+			static const MaterialTypeId marble = MaterialType::byName("marble");
+			static const MaterialTypeId dirt = MaterialType::byName("dirt");
+			static const PlantSpeciesId wheatGrass = PlantSpecies::byName("wheat grass");
+			static const PlantSpeciesId sageBrush = PlantSpecies::byName("sage brush");
+			Area& area = createArea(320, 320, 8);
+			areaBuilderUtil::setSolidLayer(area, 0, marble);
+			areaBuilderUtil::setSolidLayer(area, 1, dirt);
+			Space& space = area.getSpace();
+			int created = 0;
+			for(int x = 0; x != 320 && created != 100'000; ++x)
+				for(int y = 0; y != 320 && created != 100'000; ++y)
+				{
+					const PlantSpeciesId species = area.m_random.chance(0.1) ? sageBrush : wheatGrass;
+					space.plant_create(Point3D::create(x, y, 2), species, Percent::create(area.m_random.getInRange(10, 90)));
+					++created;
+				}
+		}
+	public:
+		[[nodiscard]] std::string_view name() const override { return "forest"; }
+		[[nodiscard]] std::string_view description() const override { return "100000 plants growing on a 320x320 field"; }
+		[[nodiscard]] int defaultStepCount() const override { return 1000; }
+	};
+	// Random small cuboids in a 256x256x64 R-tree.
+	class RTreeScenario : public BenchScenario
+	{
+	protected:
+		RTreeBoolean m_tree;
+		Random m_random;
+		// Written so the queries are not optimized away.
+		int m_hits = 0;
+		[[nodiscard]] static Cuboid getBoundry() { return {Point3D::create(255, 255, 63), Point3D::create(0, 0, 0)}; }
+		// A point up to maxOffset past low on each axis, within the boundry.
+		[[nodiscard]] Point3D getNear(const Point3D low, const int maxOffset)
+		{
+			return Point3D::create(
+				std::min(255, (int)low.x().get() + m_random.getInRange(0, maxOffset)),
+				std::min(255, (int)low.y().get() + m_random.getInRange(0, maxOffset)),
+				std::min(63, (int)low.z().get() + m_random.getInRange(0, maxOffset))
+			);
+		}
+		void buildTree(const uint32_t seed)
+		{
+			m_random.seed(seed);
+			for(int i = 0; i != 4096; ++i)
+			{
+				const Point3D low = m_random.getInCuboid(getBoundry());
+				m_tree.maybeInsert(Cuboid{getNear(low, 3), low});
+			}
+			m_tree.prepare();
+		}
+	public:
+		[[nodiscard]] int defaultStepCount() const override { return 1000; }
+	};
+	// Queried with 1024 random points per step.
+	class RTreeQueryScenario final : public RTreeScenario
+	{
+		SmallSet<Point3D> m_queries;
+		bool m_batch;
+	public:
+		RTreeQueryScenario(const bool batch) : m_batch(batch) { }
+		void setup(const uint32_t seed) override
+		{
+			buildTree(seed);
+			for(int i = 0; i != 1024; ++i)
+				m_queries.maybeInsert(m_random.getInCuboid(getBoundry()));
+		}
+		void step([[maybe_unused]] const int stepIndex) override
+		{
+			if(m_batch)
+			{
+				for(const bool hit : m_tree.batchQuery(m_queries))
+					m_hits += hit;
+			}
+			else
+				for(const Point3D point : m_queries)
+					m_hits += m_tree.query(point);
+		}
+		[[nodiscard]] std::string_view name() const override { return m_batch ? "rtreeBatchQuery" : "rtreeQuery"; }
+		[[nodiscard]] std::string_view description() const override { return m_batch ? "1024 point queries per step in one R-tree walk" : "1024 point queries per step one at a time"; }
+	};
+	// Queried with 1024 random shapes per step in one R-tree walk. Cuboids are tested by CuboidArray::intersectionBits with AVX-512 or AVX2 when built with them, spheres and lines by the Eigen indicesOfIntersectingCuboids.
+	template<typename ShapeT>
+	class RTreeBatchShapeQueryScenario final : public RTreeScenario
+	{
+		std::vector<ShapeT> m_queries;
+		[[nodiscard]] ShapeT makeShape()
+		{
+			const Point3D point = m_random.getInCuboid(getBoundry());
+			if constexpr(std::is_same_v<ShapeT, Cuboid>)
+				return {getNear(point, 7), point};
+			else if constexpr(std::is_same_v<ShapeT, Sphere>)
+				return {point, DistanceFractional::create(m_random.getInRange(1.f, 4.f))};
+			else
+			{
+				static_assert(std::is_same_v<ShapeT, ParamaterizedLine>);
+				Point3D end = getNear(point, 15);
+				// A line needs a direction.
+				if(end == point)
+					end = point == getBoundry().m_high ? Point3D::create(0, 0, 0) : getBoundry().m_high;
+				return {point, end};
+			}
+		}
+	public:
+		void setup(const uint32_t seed) override
+		{
+			buildTree(seed);
+			m_queries.reserve(1024);
+			for(int i = 0; i != 1024; ++i)
+				m_queries.push_back(makeShape());
+		}
+		void step([[maybe_unused]] const int stepIndex) override
+		{
+			for(const bool hit : m_tree.batchQuery(m_queries))
+				m_hits += hit;
+		}
+		[[nodiscard]] std::string_view name() const override
+		{
+			if constexpr(std::is_same_v<ShapeT, Cuboid>)
+				return "rtreeBatchCuboidQuery";
+			else if constexpr(std::is_same_v<ShapeT, Sphere>)
+				return "rtreeBatchSphereQuery";
+			else
+				return "rtreeBatchLineQuery";
+		}
+		[[nodiscard]] std::string_view description() const override
+		{
+			if constexpr(std::is_same_v<ShapeT, Cuboid>)
+				return "1024 cuboid queries per step in one R-tree walk";
+			else if constexpr(std::is_same_v<ShapeT, Sphere>)
+				return "1024 sphere queries per step in one R-tree walk";
+			else
+				return "1024 line queries per step in one R-tree walk";
+		}
+	};
+	struct ScenarioFactory
+	{
+		std::string_view name;
+		std::function<std::unique_ptr<BenchScenario>()> create;
+	};
+	const std::vector<ScenarioFactory>& getFactories()
+	{
+		static const std::vector<ScenarioFactory> output = {
+			{"fortress", []{ return std::make_unique<FortressScenario>(); }},
+			{"flood", []{ return std::make_unique<FloodScenario>(); }},
+			{"battle", []{ return std::make_unique<BattleScenario>(); }},
+			{"caveIn", []{ return std::make_unique<CaveInScenario>(); }},
+			{"forest", []{ return std::make_unique<ForestScenario>(); }},
+			{"rtreeQuery", []{ return std::make_unique<RTreeQueryScenario>(false); }},
+			{"rtreeBatchQuery", []{ return std::make_unique<RTreeQueryScenario>(true); }},
+			{"rtreeBatchCuboidQuery", []{ return std::make_unique<RTreeBatchShapeQueryScenario<Cuboid>>(); }},
+			{"rtreeBatchSphereQuery", []{ return std::make_unique<RTreeBatchShapeQueryScenario<Sphere>>(); }},
+			{"rtreeBatchLineQuery", []{ return std::make_unique<RTreeBatchShapeQueryScenario<ParamaterizedLine>>(); }},
+		};
+		return output;
+	}
+}
+std::vector<std::string_view> getBenchScenarioNames()
+{
+	std::vector<std::string_view> output;
+	for(const ScenarioFactory& factory : getFactories())
+		output.push_back(factory.name);
+	return output;
+}
+std::unique_ptr<BenchScenario> createBenchScenario(const std::string_view name)
+{
+	for(const ScenarioFactory& factory : getFactories())
+		if(factory.name == name)
+			return factory.create();
+	return nullptr;
+}
@@ -0,0 +1,34 @@
+/*
+	Scenarios for the bench executable.
+	Each scenario builds the same world every time for a given seed, so step times can be compared between builds.
+	Simulation scenarios step a Simulation with one Area and report the Area and Simulation StepProfilers.
+	Micro scenarios repeat one operation per step and have no profilers.
+*/
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+class Area;
+class Simulation;
+
+class BenchScenario
+{
+public:
+	virtual ~BenchScenario() = default;
+	// Called once before any step, not timed as part of a step.
+	virtual void setup(const uint32_t seed) = 0;
+	// stepIndex counts from 0 for the first measured step.
+	virtual void step(const int stepIndex) = 0;
+	[[nodiscard]] virtual std::string_view name() const = 0;
+	[[nodiscard]] virtual std::string_view description() const = 0;
+	[[nodiscard]] virtual int defaultStepCount() const = 0;
+	// Null for micro scenarios.
+	[[nodiscard]] virtual Simulation* getSimulation() { return nullptr; }
+	[[nodiscard]] virtual Area* getArea() { return nullptr; }
+};
+// Scenarios are created on demand so only the requested ones allocate their worlds.
+[[nodiscard]] std::vector<std::string_view> getBenchScenarioNames();
+// Returns nullptr if there is no scenario with name.
+[[nodiscard]] std::unique_ptr<BenchScenario> createBenchScenario(const std::string_view name);
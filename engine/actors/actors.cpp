@@ -13,8 +13,10 @@
 #include "../items/items.h"
 #include "../numericTypes/types.h"
 #include "../objectives/wait.h"
+#include "../threads.h"
 #include "../portables.h"
 #include "../simulation/hasActors.h"
+#include "../simulation/hasAreas.h"
 #include "../simulation/simulation.h"
 #include "../sleep.h"
 #include "../util.h"
@@ -29,76 +31,76 @@
 #include <algorithm>
 #include <cstddef>
 #include <iostream>
-Percent ActorParamaters::getPercentGrown(Simulation& simulation)
+Percent ActorParamaters::getPercentGrown(Area& area)
 {
 	if(percentGrown.empty())
 	{
-		Percent percentLifeTime = Percent::create(simulation.m_random.getInRange(0, 100));
+		Percent percentLifeTime = Percent::create(area.m_random.getInRange(0, 100));
 		// Don't generate actors in the last 15% of their possible life span, they don't get out much.
 		Step adjustedMax = Step::create(util::scaleByPercent(AnimalSpecies::getDeathAgeSteps(species)[0].get(), Percent::create(85)));
 		// Using util::scaleByPercent and util::fractionToPercent give the wrong result here for some reason.
 		Step ageSteps = Step::create(util::scaleByPercent(adjustedMax.get(), percentLifeTime));
 		//Step ageSteps = Step::create(((float)adjustedMax.get() / (float)percentLifeTime.get()) * 100.f);
 		percentGrown = Percent::create(std::min(100, (int)(((float)ageSteps.get() / (float)AnimalSpecies::getStepsTillFullyGrown(species).get()) * 100.f)));
-		birthStep = simulation.m_step - ageSteps;
+		birthStep = area.m_simulation.m_step - ageSteps;
 	}
 	return percentGrown;
 }
-std::string ActorParamaters::getName(Simulation& simulation)
+std::string ActorParamaters::getName(Area& area)
 {
 	if(name.empty())
-		name = AnimalSpecies::getName(species) + std::to_string(getId(simulation).get());
+		name = AnimalSpecies::getName(species) + std::to_string(getId(area).get());
 	return name;
 }
-Step ActorParamaters::getBirthStep(Simulation& simulation)
+Step ActorParamaters::getBirthStep(Area& area)
 {
 	if(birthStep.empty())
 	{
 		if(percentGrown.empty())
-			getPercentGrown(simulation);
+			getPercentGrown(area);
 		else
 		{
 			// Pick an age for the given percent grown.
 			Step grown = AnimalSpecies::getStepsTillFullyGrown(species);
 			Step age = Step::create(percentGrown < 95 ?
 				util::scaleByPercent(grown.get(), percentGrown) :
-				simulation.m_random.getInRange(grown.get(), AnimalSpecies::getDeathAgeSteps(species)[1].get())
+				area.m_random.getInRange(grown.get(), AnimalSpecies::getDeathAgeSteps(species)[1].get())
 			);
-			birthStep = simulation.m_step - age;
+			birthStep = area.m_simulation.m_step - age;
 		}
 	}
 	return birthStep;
 }
-ActorId ActorParamaters::getId(Simulation& simulation)
+ActorId ActorParamaters::getId(Area& area)
 {
 	if(id.empty())
-		id = simulation.m_actors.getNextId();
+		id = area.m_simulation.m_actors.getNextId(area.m_actorIds);
 	return id;
 }
-Percent ActorParamaters::getPercentThirst(Simulation& simulation)
+Percent ActorParamaters::getPercentThirst(Area& area)
 {
 	if(percentThirst.empty())
 	{
-		percentThirst = Percent::create(simulation.m_random.getInRange(0, 100));
-		needsDrink = simulation.m_random.percentChance(Percent::create(10));
+		percentThirst = Percent::create(area.m_random.getInRange(0, 100));
+		needsDrink = area.m_random.percentChance(Percent::create(10));
 	}
 	return percentThirst;
 }
-Percent ActorParamaters::getPercentHunger(Simulation& simulation)
+Percent ActorParamaters::getPercentHunger(Area& area)
 {
 	if(percentHunger.empty())
 	{
-		percentHunger = Percent::create(simulation.m_random.getInRange(0, 100));
-		needsEat = simulation.m_random.percentChance(Percent::create(10));
+		percentHunger = Percent::create(area.m_random.getInRange(0, 100));
+		needsEat = area.m_random.percentChance(Percent::create(10));
 	}
 	return percentHunger;
 }
-Percent ActorParamaters::getPercentTired(Simulation& simulation)
+Percent ActorParamaters::getPercentTired(Area& area)
 {
 	if(percentTired.empty())
 	{
-		percentTired = Percent::create(simulation.m_random.getInRange(0, 100));
-		needsSleep = simulation.m_random.percentChance(Percent::create(10));
+		percentTired = Percent::create(area.m_random.getInRange(0, 100));
+		needsSleep = area.m_random.percentChance(Percent::create(10));
 	}
 	return percentTired;
 }
@@ -112,7 +114,7 @@ void ActorParamaters::generateEquipment(Area& area, const ActorIndex actor)
 	Actors& actors = area.getActors();
 	if(!actors.isSentient(actor))
 		return;
-	auto& random = area.m_simulation.m_random;
+	auto& random = area.m_random;
 	auto generate = [&](ItemTypeId itemType, const MaterialTypeId materialType){
 		Quality quality = Quality::create(random.getInRange(10, 50));
 		Percent wear = Percent::create(random.getInRange(10, 60));
@@ -254,8 +256,7 @@ template<class T>
 void to_json(const Json& data, std::unique_ptr<T>& t) { data = *t; }
 Actors::Actors(Area& area) :
 	Portables<Actors, ActorIndex, ActorReferenceIndex, true>(area),
-	m_coolDownEvent(area.m_eventSchedule),
-	m_moveEvent(area.m_eventSchedule)
+	m_coolDownEvent(area.m_eventSchedule)
 { }
 void Actors::load(const Json& data)
 {
@@ -296,7 +297,10 @@ void Actors::load(const Json& data)
 	data["coolDownDurationModifier"].get_to(m_coolDownDurationModifier);
 	data["combatScore"].get_to(m_combatScore);
 	data["soldier"].get_to(m_soldier);
-	m_moveEvent.load(m_area.m_simulation, data["moveEvent"], size);
+	data["moveStep"].get_to(m_moveStep);
+	for(const Step& step : m_moveStep)
+		if(step.exists() && (m_nextMoveStep.empty() || step < m_nextMoveStep))
+			m_nextMoveStep = step;
 	data["path"].get_to(m_path);
 	data["destination"].get_to(m_destination);
 	data["speedIndividual"].get_to(m_speedIndividual);
@@ -312,7 +316,7 @@ void Actors::load(const Json& data)
 	i = ActorIndex::create(0);
 	for(const Json& bodyData : data["body"]["data"])
 	{
-		m_body[i] = std::make_unique<Body>(bodyData, deserializationMemo, i);
+		m_body[i] = std::make_unique<Body>(bodyData, deserializationMemo, m_area, i);
 		++i;
 	}
 	m_mustSleep.resize(size);
@@ -391,7 +395,7 @@ void Actors::load(const Json& data)
 	for(ActorIndex index{0}; index != size; ++index)
 	{
 		const Json& psycologyData = data["psycology"][index.get()];
-		m_psycology[index] = Psycology::load(psycologyData, m_area.m_simulation);
+		m_psycology[index] = Psycology::load(psycologyData, m_area);
 	}
 	for(ActorIndex index : getAll())
 	{
@@ -504,7 +508,7 @@ Json Actors::toJson() const
 		{"coolDownDurationModifier", m_coolDownDurationModifier},
 		{"combatScore", m_combatScore},
 		{"soldier", m_soldier},
-		{"moveEvent", m_moveEvent},
+		{"moveStep", m_moveStep},
 		{"pathRequest", Json::object()},
 		{"path", m_path},
 		{"destination", m_destination},
@@ -536,9 +540,6 @@ void Actors::moveIndex(const ActorIndex oldIndex, const ActorIndex newIndex)
 {
 	forEachData([&](auto& data){ data.moveIndex(oldIndex, newIndex); });
 	updateStoredIndicesPortables(oldIndex, newIndex);
-	// Move event contains a ActorIndex which must be updated if MoveEvent exists.
-	if(m_moveEvent.contains(newIndex))
-		m_moveEvent[newIndex].updateIndex(oldIndex, newIndex);
 	// If carrying anything update the carried thing's carrierIndex.
 	if(m_carrying[newIndex].exists())
 	{
@@ -569,6 +570,7 @@ void Actors::moveIndex(const ActorIndex oldIndex, const ActorIndex newIndex)
 void Actors::destroy(const ActorIndex index)
 {
 	// No need to explicitly unschedule events here, destorying the event holder will do it.
+	m_area.m_hasJobs.maybeRemove(getReference(index));
 	if(hasLocation(index))
 	{
 		vision_clearRequestIfExists(index);
@@ -600,20 +602,32 @@ void Actors::onChangeAmbiantSurfaceTemperature(Temperature newAmbiant, const Cub
 			m_needsSafeTemperature[index]->setTemperature(m_area, newAmbiant);
 	});
 }
+void CreateActorInputAction::execute(Simulation& simulation)
+{
+	SimulationHasAreas& hasAreas = simulation.getAreas();
+	if(!hasAreas.contains(m_area))
+		return;
+	Area& area = hasAreas.getById(m_area);
+	const Space& space = area.getSpace();
+	if(!space.shape_anythingCanEnterEver(m_params.location) || !space.shape_anythingCanEnterCurrently(m_params.location))
+		return;
+	area.getActors().create(m_params);
+}
 ActorIndex Actors::create(ActorParamaters params)
 {
+	threads::assertNotInReadPhase();
 	ActorIndex index = ActorIndex::create(m_id.size());
 	resize(index + 1);
 	bool isStatic = false;
 	MoveTypeId moveType = AnimalSpecies::getMoveType(params.species);
-	ShapeId shape = AnimalSpecies::shapeForPercentGrown(params.species, params.getPercentGrown(m_area.m_simulation));
+	ShapeId shape = AnimalSpecies::shapeForPercentGrown(params.species, params.getPercentGrown(m_area));
 	Portables<Actors, ActorIndex, ActorReferenceIndex, true>::create(index, moveType, shape, params.faction, isStatic, Quantity::create(1));
 	Simulation& simulation = m_area.m_simulation;
-	m_id[index] = params.getId(simulation);
-	m_name[index] = params.getName(simulation);
+	m_id[index] = params.getId(m_area);
+	m_name[index] = params.getName(m_area);
 	m_species[index] = params.species;
 	m_project[index] = nullptr;
-	m_birthStep[index] = params.getBirthStep(simulation);
+	m_birthStep[index] = params.getBirthStep(m_area);
 	m_causeOfDeath[index] = CauseOfDeath::none;
 	m_strengthBonusOrPenalty[index] = AttributeLevelBonusOrPenalty::create(0);
 	m_strengthModifier[index] = 0.f;
@@ -624,7 +638,7 @@ ActorIndex Actors::create(ActorParamaters params)
 	//TODO: Only allocate equipment set for actors which have equipment.
 	m_equipmentSet[index] = std::make_unique<EquipmentSet>();
 	const auto& heightData = AnimalSpecies::getHeight(params.species);
-	m_adultHeight[index] = m_area.m_simulation.m_random.getInRange(heightData[0], heightData[1]);
+	m_adultHeight[index] = m_area.m_random.getInRange(heightData[0], heightData[1]);
 	m_massBonusOrPenalty[index] = 0;
 	m_massModifier[index] = 0.f;
 	m_unencomberedCarryMass[index] = Mass::null();
@@ -635,7 +649,7 @@ ActorIndex Actors::create(ActorParamaters params)
 	m_mustDrink[index] = std::make_unique<MustDrink>(m_area, index);
 	m_mustEat[index] = std::make_unique<MustEat>(m_area, index);
 	m_needsSafeTemperature[index] = std::make_unique<ActorNeedsSafeTemperature>(m_area, index);
-	m_canGrow[index] = std::make_unique<CanGrow>(m_area, index, params.getPercentGrown(simulation));
+	m_canGrow[index] = std::make_unique<CanGrow>(m_area, index, params.getPercentGrown(m_area));
 	assert(m_skillSet[index].empty());
 	// TODO: can reserve is not needed for non sentients or actors without factions.
 	m_canReserve[index] = std::make_unique<CanReserve>(params.faction);
@@ -663,7 +677,7 @@ ActorIndex Actors::create(ActorParamaters params)
 	m_combatScore[index] = CombatScore::null();
 	m_soldier[index] = SoldierData::create();
 	// Move.
-	assert(!m_moveEvent.exists(index));
+	assert(m_moveStep[index].empty());
 	assert(m_pathRequest[index] == nullptr);
 	assert(m_path[index].empty());
 	m_destination[index].clear();
@@ -891,9 +905,9 @@ void Actors::takeFallDamage(const ActorIndex index, const Distance distance, con
 	for(int i = 0; i < Config::hitsToDivideActorFallDamageInto; ++i)
 	{
 		auto& body = *m_body[index];
-		BodyPart& hitPart = body.pickABodyPartByVolume(m_area.m_simulation);
+		BodyPart& hitPart = body.pickABodyPartByVolume(m_area);
 		int area = Config::convertBodyPartVolumeToArea(BodyPartType::getVolume(hitPart.bodyPartType));
-		area = m_area.m_simulation.m_random.getInRange(int(area * 0.25), area);
+		area = m_area.m_random.getInRange(int(area * 0.25), area);
 		Hit hit(area, force, materialType, WoundType::Bludgeon);
 		takeHit(index, hit, hitPart);
 	}
@@ -4,6 +4,7 @@
 #include "../body.h"
 #include "../safeTemperature.h"
 #include "../dataStructures/strongVector.h"
+#include "../dataStructures/adaptiveSet.h"
 #include "../datetime.h"
 #include "../definitions/attackType.h"
 #include "../equipment.h"
@@ -66,15 +67,29 @@ struct ActorParamaters
 	bool hasHeavyArmor = false;
 	bool piloting = false;
 
-	Percent getPercentGrown(Simulation& simulation);
-	std::string getName(Simulation& simulation);
-	Step getBirthStep(Simulation& simulation);
-	ActorId getId(Simulation& simulation);
-	Percent getPercentThirst(Simulation& simulation);
-	Percent getPercentHunger(Simulation& simulation);
-	Percent getPercentTired(Simulation& simulation);
+	Percent getPercentGrown(Area& area);
+	std::string getName(Area& area);
+	Step getBirthStep(Area& area);
+	ActorId getId(Area& area);
+	Percent getPercentThirst(Area& area);
+	Percent getPercentHunger(Area& area);
+	Percent getPercentTired(Area& area);
 	void generateEquipment(Area& area, const ActorIndex actor);
 };
+// Spawns an actor at params.location, skipped if the point cannot be entered when the action executes. Mounting and piloting are not supported because they name other actors or items by index.
+class CreateActorInputAction final : public InputAction
+{
+	ActorParamaters m_params;
+	AreaId m_area;
+public:
+	CreateActorInputAction(const AreaId area, const ActorParamaters& params) : m_params(params), m_area(area)
+	{
+		assert(m_params.mountedOn.empty());
+		assert(!m_params.piloting);
+		assert(m_params.location.exists());
+	}
+	void execute(Simulation& simulation);
+};
 class Actors final : public Portables<Actors, ActorIndex, ActorReferenceIndex, true>
 {
 	StrongVector<ActorId, ActorIndex> m_id;
@@ -116,7 +131,7 @@ class Actors final : public Portables<Actors, ActorIndex, ActorReferenceIndex, t
 	// Stamina.
 	StrongVector<Stamina, ActorIndex> m_stamina;
 	// Vision.
-	StrongVector<SmallSet<ActorReference>, ActorIndex> m_canSee;
+	StrongVector<AdaptiveSet<ActorReference, ActorReference::Hash>, ActorIndex> m_canSee;
 	StrongVector<SmallSet<ActorReference>, ActorIndex> m_canBeSeenBy;
 	StrongVector<Distance, ActorIndex> m_visionRange;
 	StrongVector<HasOnSight, ActorIndex> m_onSight;
@@ -135,7 +150,8 @@ class Actors final : public Portables<Actors, ActorIndex, ActorReferenceIndex, t
 	StrongVector<CombatScore, ActorIndex> m_combatScoreNonLethal;
 	StrongVector<SoldierData, ActorIndex> m_soldier;
 	// Move.
-	HasScheduledEvents<MoveEvent, ActorIndex> m_moveEvent;
+	// Step of the next move along m_path, null when not moving. Moves are not scheduled events, every actor due on a step is moved together by move_doStep.
+	StrongVector<Step, ActorIndex> m_moveStep;
 	StrongVector<PathRequest*, ActorIndex> m_pathRequest;
 	// Path is stored backwards, with the first point being the destination and the last being the next step.
 	StrongVector<SmallSet<Point3D>, ActorIndex> m_path;
@@ -147,6 +163,8 @@ class Actors final : public Portables<Actors, ActorIndex, ActorReferenceIndex, t
 	StrongVector<std::pair<std::string, Step>, ActorIndex> m_dialog;
 	// Is piloting current m_isOnDeckOf
 	StrongBitSet<ActorIndex> m_isPilot;
+	// May be earlier then any m_moveStep if the actor which set it has since stopped, this only costs an empty pass.
+	Step m_nextMoveStep;
 	void moveIndex(const ActorIndex oldIndex, const ActorIndex newIndex);
 public:
 	Actors(Area& area);
@@ -210,7 +228,7 @@ public:
 		action(m_combatScore);
 		action(m_combatScoreNonLethal);
 		action(m_soldier);
-		action(m_moveEvent);
+		action(m_moveStep);
 		action(m_pathRequest);
 		action(m_path);
 		action(m_destination);
@@ -238,6 +256,11 @@ public:
 	SetLocationAndFacingResult location_tryToSet(const ActorIndex index, const Point3D point, const Facing4 facing);
 	SetLocationAndFacingResult location_tryToSetStatic(const ActorIndex index, const Point3D point, const Facing4 facing);
 	SetLocationAndFacingResult location_tryToSetDynamic(const ActorIndex index, const Point3D point, const Facing4 facing);
+	// Only checks if the delta can fit currently, the caller has already checked location_deltaIsBlockedEver.
+	SetLocationAndFacingResult location_tryToSetDynamicWithDelta(const ActorIndex index, const Point3D point, const Facing4 facing, const MapWithCuboidKeys<CollisionVolume>& cuboidsAndVolumesDelta);
+	// Cuboids and volumes which would be newly occupied by moving to point with facing. Read only, safe to call from the read step of move_doStep.
+	[[nodiscard]] MapWithCuboidKeys<CollisionVolume> location_getDynamicDelta(const ActorIndex index, const Point3D point, const Facing4 facing) const;
+	[[nodiscard]] bool location_deltaIsBlockedEver(const MapWithCuboidKeys<CollisionVolume>& cuboidsAndVolumesDelta) const;
 	void location_clear(const ActorIndex index);
 	void location_clearStatic(const ActorIndex index);
 	void location_clearDynamic(const ActorIndex index);
@@ -305,7 +328,7 @@ public:
 	void vision_maybeUpdateRange(const ActorIndex index, const Distance range);
 	void vision_maybeUpdateLocation(const ActorIndex index, const Point3D location);
 	void vision_removeOpaqueFromCuboidSet(const CuboidSet& cuboidSet) const;
-	[[nodiscard]] SmallSet<ActorReference>& vision_getCanSee(const ActorIndex index) { return m_canSee[index]; }
+	[[nodiscard]] const AdaptiveSet<ActorReference, ActorReference::Hash>& vision_getCanSee(const ActorIndex index) const { return m_canSee[index]; }
 	[[nodiscard]] SmallSet<ActorReference>& vision_getCanBeSeenBy(const ActorIndex index) { return m_canBeSeenBy[index]; }
 	[[nodiscard]] Distance vision_getRange(const ActorIndex index) const { return m_visionRange[index]; }
 	[[nodiscard]] DistanceSquared vision_getRangeSquared(const ActorIndex index) const { return m_visionRange[index].squared(); }
@@ -388,7 +411,12 @@ public:
 	void move_setType(const ActorIndex index, const MoveTypeId moveType);
 	void move_setMoveSpeedActual(const ActorIndex index, Speed speed);
 	void move_clearPath(const ActorIndex index);
+	// Moves every actor due this step. Checks are run in parallel, then moves are applied one at a time in reverse index order.
+	void move_doStep();
+	// Takes the next step on the path. Used by move_doStep for leaders, pilots and actors whose state changed after the parallel checks.
 	void move_callback(const ActorIndex index);
+	// Responds to trying to take the next step. nextCanEnterEver is whether the step after newLocation can ever be entered from it, only read when the step succeeded and newLocation is not the destination.
+	void move_onStepResult(const ActorIndex index, const SetLocationAndFacingResult result, const Point3D newLocation, const bool nextCanEnterEver);
 	void move_schedule(const ActorIndex index, const Point3D moveFrom);
 	void move_setDestination(const ActorIndex index, const Point3D destination, bool detour = false, bool adjacent = false, bool unreserved = false, bool reserve = false);
 	void move_setDestinationAdjacentToLocation(const ActorIndex index, const Point3D destination, bool detour = false, bool unreserved = false, bool reserve = false);
@@ -423,10 +451,13 @@ public:
 	[[nodiscard]] PathRequest& move_getPathRequest(const ActorIndex index) { return *m_pathRequest[index]; }
 	[[nodiscard]] auto& move_getPath(const ActorIndex index) { return m_path[index]; }
 	[[nodiscard]] Point3D move_getDestination(const ActorIndex index) { return m_destination[index]; }
-	[[nodiscard]] bool move_hasEvent(const ActorIndex index) const { return m_moveEvent.exists(index); }
+	[[nodiscard]] bool move_hasEvent(const ActorIndex index) const { return m_moveStep[index].exists(); }
 	[[nodiscard]] bool move_hasPathRequest(const ActorIndex index) const { return m_pathRequest[index] != nullptr; }
 	[[nodiscard]] bool move_hasPath(const ActorIndex index) const { return !m_path[index].empty(); }
 	[[nodiscard]] Step move_stepsTillNextMoveEvent(const ActorIndex index) const;
+	// Null when no actor is moving.
+	[[nodiscard]] Step move_getNextMoveStep() const { return m_nextMoveStep; }
+	[[nodiscard]] bool move_nextStepCanEnterEver(const ActorIndex index, const Point3D from) const;
 	[[nodiscard]] int move_getRetries(const ActorIndex index) const { return m_moveRetries[index]; }
 	[[nodiscard]] bool move_canPathTo(const ActorIndex index, const Point3D destination);
 	[[nodiscard]] bool move_canPathFromTo(const ActorIndex index, const Point3D start, const Facing4 startFacing, const Point3D destination);
@@ -497,6 +528,7 @@ public:
 	[[nodiscard]] bool objective_hasNeed(const ActorIndex index, NeedType needType) const;
 	[[nodiscard]] bool objective_hasSupressedNeed(const ActorIndex index, NeedType needType) const;
 	[[nodiscard]] Priority objective_getPriorityFor(const ActorIndex index, const ObjectiveTypeId objectiveType) const;
+	[[nodiscard]] const ObjectiveTypePrioritySet& objective_getPrioritySet(const ActorIndex index) const;
 	[[nodiscard]] std::string objective_getCurrentName(const ActorIndex index) const;
 	[[nodiscard]] ObjectiveTypeId objective_getCurrentTypeId(const ActorIndex index) const;
 	template<typename T>
@@ -709,7 +741,6 @@ public:
 	// For debugging.
 	void log(const ActorIndex index) const;
 	void satisfyNeeds(const ActorIndex index);
-	friend class MoveEvent;
 	friend class AttackCoolDownEvent;
 	friend class SupressedNeed;
 	friend class ThirstEvent;
@@ -723,22 +754,6 @@ public:
 	Actors(Actors&) = delete;
 	Actors(Actors&&) = delete;
 };
-class MoveEvent final : public ScheduledEvent
-{
-	ActorIndex m_actor;
-public:
-	MoveEvent(const Step delay, Area& area, const ActorIndex actor, const Step start = Step::null());
-	MoveEvent(Simulation& simulation, const Json& data);
-	void execute(Simulation& simulation, Area* area);
-	void clearReferences(Simulation& simulation, Area* area);
-	void onMoveIndex([[maybe_unused]] const HasShapeIndex oldIndex, const HasShapeIndex newIndex) { assert(m_actor == oldIndex.toActor()); m_actor = ActorIndex::create(newIndex.get()); }
-	void updateIndex([[maybe_unused]] const ActorIndex oldIndex, const ActorIndex newIndex)
-	{
-		assert(oldIndex == m_actor);
-		m_actor = newIndex;
-	}
-	[[nodiscard]] Json toJson() const;
-};
 class AttackCoolDownEvent final : public ScheduledEvent
 {
 	ActorIndex m_actor;
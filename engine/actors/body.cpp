@@ -11,7 +11,7 @@ bool Actors::body_isSeriouslyInjured(const ActorIndex index) const
 }
 BodyPart& Actors::body_pickABodyPartByVolume(const ActorIndex index) const
 {
-	return m_body[index]->pickABodyPartByVolume(m_area.m_simulation);
+	return m_body[index]->pickABodyPartByVolume(m_area);
 }
 BodyPart& Actors::body_pickABodyPartByType(const ActorIndex index, const BodyPartTypeId bodyPartType) const
 {
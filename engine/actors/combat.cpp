@@ -34,7 +34,7 @@ void Actors::combat_attackMeleeRange(const ActorIndex index, const ActorIndex ta
 		const Attack& attack = combat_getAttackForCombatScoreDifference(index, attackerCombatScore - targetCombatScore);
 		Force attackForce = Force::create(AttackType::getBaseForce(attack.attackType).get() + (m_strength[index].get() * Config::unitsOfAttackForcePerUnitOfStrength));
 		// TODO: Higher skill selects more important body parts to hit.
-		BodyPart& bodyPart = m_body[target]->pickABodyPartByVolume(m_area.m_simulation);
+		BodyPart& bodyPart = m_body[target]->pickABodyPartByVolume(m_area);
 		Hit hit(AttackType::getArea(attack.attackType), attackForce, attack.materialType, AttackType::getWoundType(attack.attackType));
 		takeHit(target, hit, bodyPart);
 		// If there is a weapon being used take the cool down from it, otherwise use onMiss cool down.
@@ -61,7 +61,7 @@ Step Actors::combat_attackMeleeRangeNonLethal(const ActorIndex index, const Acto
 		const Attack& attack = combat_getNonLethalAttackForCombatScoreDifference(index, attackerCombatScore - targetCombatScore);
 		Force attackForce = Force::create(AttackType::getBaseForce(attack.attackType).get() + (m_strength[index].get() * Config::unitsOfAttackForcePerUnitOfStrength));
 		// TODO: Higher skill selects more important body parts to hit.
-		BodyPart& bodyPart = m_body[target]->pickABodyPartByVolume(m_area.m_simulation);
+		BodyPart& bodyPart = m_body[target]->pickABodyPartByVolume(m_area);
 		Hit hit(AttackType::getArea(attack.attackType), attackForce, attack.materialType, AttackType::getWoundType(attack.attackType));
 		takeHit(target, hit, bodyPart);
 		// If there is a weapon being used take the cool down from it, otherwise use onMiss cool down.
@@ -89,7 +89,7 @@ void Actors::combat_attackLongRange(const ActorIndex index, const ActorIndex tar
 	{
 		// Attack hits.
 		// TODO: Higher skill selects more important body parts to hit.
-		BodyPart& bodyPart = m_body[target]->pickABodyPartByVolume(m_area.m_simulation);
+		BodyPart& bodyPart = m_body[target]->pickABodyPartByVolume(m_area);
 		Hit hit(AttackType::getArea(attackType), AttackType::getBaseForce(attackType), attack.materialType, AttackType::getWoundType(attack.attackType));
 		takeHit(target, hit, bodyPart);
 	}
@@ -340,7 +340,7 @@ Percent Actors::combat_projectileHitPercent(const ActorIndex index, const Attack
 bool Actors::combat_doesProjectileHit(const ActorIndex index, Attack& attack, const ActorIndex target) const
 {
 	Percent chance = combat_projectileHitPercent(index, attack, target);
-	return m_area.m_simulation.m_random.percentChance(chance);
+	return m_area.m_random.percentChance(chance);
 }
 float Actors::combat_getQualityModifier(const ActorIndex, const Quality quality) const
 {
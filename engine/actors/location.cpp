@@ -2,9 +2,11 @@
 #include "../area/area.h"
 #include "../space/space.h"
 #include "../portables.h"
+#include "../threads.h"
 
 void Actors::location_set(const ActorIndex index, const Point3D location, const Facing4 facing)
 {
+	threads::assertNotInReadPhase();
 	if(isStatic(index))
 		location_setStatic(index, location, facing);
 	else
@@ -119,9 +121,25 @@ SetLocationAndFacingResult Actors::location_tryToSetStatic(const ActorIndex inde
 	return SetLocationAndFacingResult::Success;
 }
 SetLocationAndFacingResult Actors::location_tryToSetDynamic(const ActorIndex index, const Point3D location, const Facing4 facing)
+{
+	const MapWithCuboidKeys<CollisionVolume> cuboidsAndVolumesDelta = location_getDynamicDelta(index, location, facing);
+	if(location_deltaIsBlockedEver(cuboidsAndVolumesDelta))
+		return SetLocationAndFacingResult::PermanantlyBlocked;
+	return location_tryToSetDynamicWithDelta(index, location, facing, cuboidsAndVolumesDelta);
+}
+SetLocationAndFacingResult Actors::location_tryToSetDynamicWithDelta(const ActorIndex index, const Point3D location, const Facing4 facing, const MapWithCuboidKeys<CollisionVolume>& cuboidsAndVolumesDelta)
+{
+	assert(!isStatic(index));
+	const Space& space = m_area.getSpace();
+	for(const auto& [cuboid, volume] : cuboidsAndVolumesDelta)
+		if(space.shape_cuboidCanFitCurrentlyDynamic(cuboid, volume))
+			return SetLocationAndFacingResult::TemporarilyBlocked;
+	location_setDynamic(index, location, facing);
+	return SetLocationAndFacingResult::Success;
+}
+MapWithCuboidKeys<CollisionVolume> Actors::location_getDynamicDelta(const ActorIndex index, const Point3D location, const Facing4 facing) const
 {
 	assert(!isStatic(index));
-	Space& space = m_area.getSpace();
 	// Get offsets and volumes for facing. Use compound shape to include anything on deck.
 	const Point3D previousLocation = getCombinedLocation(index);
 	const Offset3D offset = previousLocation.offsetTo(location);
@@ -136,15 +154,16 @@ SetLocationAndFacingResult Actors::location_tryToSetDynamic(const ActorIndex ind
 		CuboidSet lineOccupied = lineLead_getOccupiedCuboids(index);
 		cuboidsAndVolumesDelta.maybeRemoveAll(lineOccupied);
 	}
+	return cuboidsAndVolumesDelta;
+}
+bool Actors::location_deltaIsBlockedEver(const MapWithCuboidKeys<CollisionVolume>& cuboidsAndVolumesDelta) const
+{
+	const Space& space = m_area.getSpace();
 	for(const auto& [cuboid, volume] : cuboidsAndVolumesDelta)
 		// Don't use shape_anythingCanEnterEverHere because it checks Space::m_dynamic.
 		if(space.solid_isAny(cuboid) || space.pointFeature_blocksEntrance(cuboid))
-			return SetLocationAndFacingResult::PermanantlyBlocked;
-	for(const auto& [cuboid, volume] : cuboidsAndVolumesDelta)
-		if(space.shape_cuboidCanFitCurrentlyDynamic(cuboid, volume))
-			return SetLocationAndFacingResult::TemporarilyBlocked;
-	location_setDynamic(index, location, facing);
-	return SetLocationAndFacingResult::Success;
+			return true;
+	return false;
 }
 void Actors::location_clear(const ActorIndex index)
 {
@@ -14,6 +14,7 @@
 #include "../eventSchedule.h"
 #include "../items/items.h"
 #include "../path/areaHasPaths.h"
+#include "../threads.h"
 #include <ranges>
 Speed Actors::move_getIndividualSpeedWithAddedMass(const ActorIndex index, const Mass mass) const
 {
@@ -69,6 +70,74 @@ void Actors::move_clearPath(const ActorIndex index)
 	m_path[index].clear();
 	move_clearAllEventsAndTasks(index);
 }
+void Actors::move_doStep()
+{
+	const Step now = m_area.m_simulation.m_step;
+	if(m_nextMoveStep.empty() || m_nextMoveStep > now)
+		return;
+	// Find the actors due to move and the earliest step of the rest in one pass over a single column.
+	std::vector<ActorIndex> due;
+	StepWidth next = Step::nullPrimitive();
+	const StepWidth nowWidth = now.get();
+	for(auto index = ActorIndex::create(0); index < size(); ++index)
+	{
+		const StepWidth step = m_moveStep[index].get();
+		if(step <= nowWidth)
+			due.push_back(index);
+		else
+			next = std::min(next, step);
+	}
+	m_nextMoveStep = Step::create(next);
+	// Read step: compute what each move would occupy and check it against terrain, which moving does not change.
+	// Leaders and pilots also move their followers or vehicle so they are left to move_callback.
+	struct MoveProposal
+	{
+		MapWithCuboidKeys<CollisionVolume> delta;
+		Point3D from;
+		Point3D to;
+		Facing4 facing = Facing4::Null;
+		bool blockedEver = false;
+		bool nextCanEnterEver = false;
+	};
+	const int dueCount = due.size();
+	std::vector<MoveProposal> proposals(dueCount);
+	#pragma omp parallel for schedule(dynamic)
+	for(int i = 0; i < dueCount; ++i)
+	{
+		threads::ReadPhaseGuard guard;
+		const ActorIndex index = due[i];
+		if(m_isPilot[index] || isLeading(index))
+			continue;
+		MoveProposal& proposal = proposals[i];
+		proposal.from = m_location[index];
+		proposal.to = m_path[index].back();
+		proposal.facing = proposal.from.getFacingTwords(proposal.to);
+		proposal.delta = location_getDynamicDelta(index, proposal.to, proposal.facing);
+		proposal.blockedEver = location_deltaIsBlockedEver(proposal.delta);
+		if(!proposal.blockedEver && proposal.to != m_destination[index])
+			proposal.nextCanEnterEver = move_nextStepCanEnterEver(index, proposal.to);
+	}
+	// Write step: check dynamic volume and apply each move in order, so actors competing for the same space always resolve the same way.
+	// Reverse order because an actor which is destroyed is replaced by the last actor, which has then already moved.
+	for(int i = dueCount - 1; i >= 0; --i)
+	{
+		const ActorIndex index = due[i];
+		// Cleared or rescheduled by an earlier move.
+		if(m_moveStep[index].empty() || m_moveStep[index] > now)
+			continue;
+		m_moveStep[index].clear();
+		const MoveProposal& proposal = proposals[i];
+		if(proposal.to.empty() || proposal.from != m_location[index] || proposal.to != m_path[index].back())
+		{
+			move_callback(index);
+			continue;
+		}
+		const SetLocationAndFacingResult result = proposal.blockedEver ?
+			SetLocationAndFacingResult::PermanantlyBlocked :
+			location_tryToSetDynamicWithDelta(index, proposal.to, proposal.facing, proposal.delta);
+		move_onStepResult(index, result, proposal.to, proposal.nextCanEnterEver);
+	}
+}
 void Actors::move_callback(const ActorIndex index)
 {
 	assert(!m_path[index].empty());
@@ -77,18 +146,13 @@ void Actors::move_callback(const ActorIndex index)
 	const Point3D newLocation = m_path[index].back();
 	const Point3D previousLocation = getCombinedLocation(index);
 	const Facing4 previousFacing = getFacing(index);
-	Items& items = getItems();
 	SetLocationAndFacingResult result;
-	const Point3D destination = move_getDestination(index);
-	const Space& space = m_area.getSpace();
-	const ShapeId shape = getCompoundShape(index);
-	const MoveTypeId moveType = getMoveType(index);
 	if(m_isPilot[index])
 	{
 		// If piloting then move the vehicle instead of the actor.
 		// When piloting a mounted actor the mount should recive the move_callback so we assume that we are piloting a vehicle.
 		const ItemIndex isPiloting = m_isOnDeckOf[index].getItem();
-		const auto itemAndResult = items.location_tryToMoveToDynamic(isPiloting, newLocation);
+		const auto itemAndResult = getItems().location_tryToMoveToDynamic(isPiloting, newLocation);
 		result = itemAndResult.second;
 	}
 	else
@@ -104,6 +168,15 @@ void Actors::move_callback(const ActorIndex index)
 		if(result != SetLocationAndFacingResult::Success)
 			location_set(index, previousLocation, previousFacing);
 	}
+	const bool nextCanEnterEver = result == SetLocationAndFacingResult::Success && newLocation != m_destination[index] && move_nextStepCanEnterEver(index, newLocation);
+	move_onStepResult(index, result, newLocation, nextCanEnterEver);
+}
+void Actors::move_onStepResult(const ActorIndex index, const SetLocationAndFacingResult result, const Point3D newLocation, const bool nextCanEnterEver)
+{
+	const Point3D destination = move_getDestination(index);
+	const Space& space = m_area.getSpace();
+	const ShapeId shape = getCompoundShape(index);
+	const MoveTypeId moveType = getMoveType(index);
 	if(result == SetLocationAndFacingResult::PermanantlyBlocked)
 	{
 		// Path has become permanantly blocked since being generated.
@@ -160,7 +233,7 @@ void Actors::move_callback(const ActorIndex index)
 				// If there is no rider piloting check if we are towing an item with a pilot.
 				const ActorOrItemIndex follower = getFollower(index);
 				if(follower.exists() && follower.isItem())
-					pilot = items.pilot_get(follower.getItem());
+					pilot = getItems().pilot_get(follower.getItem());
 			}
 			if(pilot.exists())
 				m_hasObjectives[pilot]->subobjectiveComplete(m_area);
@@ -171,11 +244,7 @@ void Actors::move_callback(const ActorIndex index)
 		{
 			assert(m_path[index].size() != 1);
 			m_path[index].popBack();
-			const Point3D nextLocation = m_path[index].back();
-			if(
-				space.shape_anythingCanEnterEver(nextLocation) &&
-				space.shape_shapeAndMoveTypeCanEnterEverFrom(nextLocation, shape, moveType, newLocation)
-			)
+			if(nextCanEnterEver)
 				// Can take next step.
 				move_schedule(index, newLocation);
 			else if(space.shape_shapeAndMoveTypeCanEnterEverWithAnyFacing(destination, shape, moveType))
@@ -187,12 +256,26 @@ void Actors::move_callback(const ActorIndex index)
 		}
 	}
 }
+bool Actors::move_nextStepCanEnterEver(const ActorIndex index, const Point3D from) const
+{
+	const SmallSet<Point3D>& path = m_path[index];
+	assert(path.size() > 1);
+	assert(path.back() == from);
+	// Path is stored backwards, the step after from is second to last.
+	const Point3D nextLocation = path[path.size() - 2];
+	const Space& space = m_area.getSpace();
+	return space.shape_anythingCanEnterEver(nextLocation) && space.shape_shapeAndMoveTypeCanEnterEverFrom(nextLocation, getCompoundShape(index), getMoveType(index), from);
+}
 void Actors::move_schedule(const ActorIndex index, const Point3D moveFrom)
 {
 	assert(!isFollowing(index));
 	assert(moveFrom != m_destination[index]);
+	assert(m_moveStep[index].empty());
 	const Point3D moveTo = m_path[index].back();
-	m_moveEvent.schedule(index, move_delayToMoveInto(index, moveFrom, moveTo), m_area, index);
+	const Step step = m_area.m_simulation.m_step + move_delayToMoveInto(index, moveFrom, moveTo);
+	m_moveStep[index] = step;
+	if(m_nextMoveStep.empty() || step < m_nextMoveStep)
+		m_nextMoveStep = step;
 }
 void Actors::move_setDestination(const ActorIndex index, const Point3D destination, bool detour, bool adjacent, bool unreserved, bool reserve)
 {
@@ -349,7 +432,7 @@ void Actors::move_setDestinationToEdge(const ActorIndex index, bool detour)
 }
 void Actors::move_clearAllEventsAndTasks(const ActorIndex index)
 {
-	m_moveEvent.maybeUnschedule(index);
+	m_moveStep[index].clear();
 	move_pathRequestMaybeCancel(index);
 }
 void Actors::move_onLeaveArea(const ActorIndex index) { move_clearAllEventsAndTasks(index); }
@@ -518,7 +601,7 @@ SmallSet<Point3D> Actors::move_makePathTo(const ActorIndex index, const Point3D
 Step Actors::move_stepsTillNextMoveEvent(const ActorIndex index) const
 {
 	// Add 1 because we increment step number at the end of the step.
-	return Step::create(1) + m_moveEvent.getStep(index) - m_area.m_simulation.m_step;
+	return Step::create(1) + m_moveStep[index] - m_area.m_simulation.m_step;
 }
 bool Actors::move_canPathTo(const ActorIndex index, const Point3D destination)
 {
@@ -540,19 +623,3 @@ bool Actors::move_canPathFromTo(const ActorIndex index, const Point3D start, con
 	});
 	return hasPaths.accessable(params);
 }
-// MoveEvent
-MoveEvent::MoveEvent(const Step delay, Area& area, const ActorIndex actor, const Step start) :
-	ScheduledEvent(area.m_simulation, delay, start), m_actor(actor) { }
-MoveEvent::MoveEvent(Simulation& simulation, const Json& data) :
-	ScheduledEvent(simulation, data["delay"].get<Step>(), data["start"].get<Step>())
-{
-	data["actor"].get_to(m_actor);
-}
-void MoveEvent::execute(Simulation&, Area* area) { area->getActors().move_callback(m_actor); }
-void MoveEvent::clearReferences(Simulation &, Area *area) { area->getActors().m_moveEvent.clearPointer(m_actor); }
-Json MoveEvent::toJson() const
-{
-	Json output = {{"delay", duration()}, {"start", m_startStep}};
-	output["actor"] = m_actor;
-	return output;
-}
@@ -87,6 +87,10 @@ Priority Actors::objective_getPriorityFor(const ActorIndex index, const Objectiv
 {
 	return m_hasObjectives[index]->m_prioritySet.getPriorityFor(objectiveType);
 }
+const ObjectiveTypePrioritySet& Actors::objective_getPrioritySet(const ActorIndex index) const
+{
+	return m_hasObjectives[index]->m_prioritySet;
+}
 // For testing.
 bool Actors::objective_queuesAreEmpty(const ActorIndex index) const
 {
@@ -48,7 +48,7 @@ void Actors::vision_setNoLongerCanBeSeenBy(const ActorIndex index, const ActorRe
 }
 void Actors::vision_setCanSee(const ActorIndex index, SmallSet<ActorReference>&& others)
 {
-	m_canSee[index] = std::move(others);
+	m_canSee[index].assign(std::move(others));
 }
 void Actors::vision_setCanBeSeenBy(const ActorIndex index, SmallSet<ActorReference>&& others)
 {
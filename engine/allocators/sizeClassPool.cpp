@@ -0,0 +1,50 @@
+#include "sizeClassPool.h"
+SizeClassPool::~SizeClassPool()
+{
+	// Owners destroy their objects before the pool, anything left would have it's destructor skipped.
+	assert(m_liveCount == 0);
+}
+void SizeClassPool::addChunk(const int sizeClass)
+{
+	const int size = (sizeClass + 1) * granularity;
+	const int count = Config::objectPoolChunkBytes / size;
+	assert(count != 0);
+	m_chunks.push_back(std::make_unique_for_overwrite<std::byte[]>(Config::objectPoolChunkBytes));
+	++m_heapAllocationCount;
+	std::byte* chunk = m_chunks.back().get();
+	// Link in reverse so allocations proceed forward through the chunk.
+	for(int i = count - 1; i >= 0; --i)
+	{
+		FreeNode* node = new (chunk + i * size) FreeNode{m_free[sizeClass]};
+		m_free[sizeClass] = node;
+	}
+}
+void* SizeClassPool::allocate(const std::size_t size)
+{
+	assert(size != 0);
+	++m_allocationCount;
+	++m_liveCount;
+	if(size > Config::objectPoolLargestSize)
+	{
+		++m_heapAllocationCount;
+		return ::operator new(size);
+	}
+	const int sizeClass = getSizeClass(size);
+	if(m_free[sizeClass] == nullptr)
+		addChunk(sizeClass);
+	FreeNode* output = m_free[sizeClass];
+	m_free[sizeClass] = output->next;
+	return output;
+}
+void SizeClassPool::deallocate(void* pointer, const std::size_t size)
+{
+	assert(m_liveCount != 0);
+	--m_liveCount;
+	if(size > Config::objectPoolLargestSize)
+	{
+		::operator delete(pointer);
+		return;
+	}
+	const int sizeClass = getSizeClass(size);
+	m_free[sizeClass] = new (pointer) FreeNode{m_free[sizeClass]};
+}
@@ -0,0 +1,82 @@
+/*
+	Free list allocator for small polymorphic objects which are created and destroyed at a high rate, such as ScheduledEvent and ThreadedTask.
+	Sizes are rounded up to a multiple of granularity, each size class takes memory from chunks of Config::objectPoolChunkBytes which are only returned when the pool is destroyed.
+	Objects larger then Config::objectPoolLargestSize fall back to the global allocator.
+	Not thread safe, each owner is expected to enforce the same threading rules it applies to inserting objects.
+	Objects are held by Pooled, a unique_ptr with PoolDeleter, which records the pool and size so the owner does not need to know the derived type. A default constructed PoolDeleter uses delete, so objects created with make_unique can be adopted.
+*/
+#pragma once
+#include "../config/config.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class SizeClassPool;
+struct PoolDeleter
+{
+	SizeClassPool* m_pool = nullptr;
+	uint32_t m_size = 0;
+	template<typename T>
+	void operator()(T* pointer) const;
+};
+template<typename T>
+using Pooled = std::unique_ptr<T, PoolDeleter>;
+class SizeClassPool
+{
+	static constexpr int granularity = alignof(std::max_align_t);
+	static constexpr int classCount = Config::objectPoolLargestSize / granularity;
+	struct FreeNode { FreeNode* next; };
+	std::array<FreeNode*, classCount> m_free = {};
+	std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+	uint64_t m_allocationCount = 0;
+	uint64_t m_heapAllocationCount = 0;
+	int m_liveCount = 0;
+	[[nodiscard]] static int getSizeClass(const std::size_t size) { return (size - 1) / granularity; }
+	void addChunk(const int sizeClass);
+public:
+	SizeClassPool() = default;
+	SizeClassPool(const SizeClassPool&) = delete;
+	SizeClassPool(SizeClassPool&&) = delete;
+	~SizeClassPool();
+	[[nodiscard]] void* allocate(const std::size_t size);
+	void deallocate(void* pointer, const std::size_t size);
+	template<typename T, typename ...Args>
+	[[nodiscard]] Pooled<T> create(Args&& ...args)
+	{
+		static_assert(alignof(T) <= granularity);
+		void* memory = allocate(sizeof(T));
+		T* output;
+		try { output = new (memory) T(std::forward<Args>(args)...); }
+		catch(...) { deallocate(memory, sizeof(T)); throw; }
+		return Pooled<T>(output, PoolDeleter{this, (uint32_t)sizeof(T)});
+	}
+	// Every allocation served, including those which fell back to the global allocator.
+	[[nodiscard]] uint64_t getAllocationCount() const { return m_allocationCount; }
+	// Chunks and oversized objects requested from the global allocator.
+	[[nodiscard]] uint64_t getHeapAllocationCount() const { return m_heapAllocationCount; }
+	[[nodiscard]] int getLiveCount() const { return m_liveCount; }
+	[[nodiscard]] std::size_t getReservedBytes() const { return m_chunks.size() * Config::objectPoolChunkBytes; }
+};
+template<typename T>
+void PoolDeleter::operator()(T* pointer) const
+{
+	if(m_pool == nullptr)
+	{
+		delete pointer;
+		return;
+	}
+	// Virtual destructors dispatch to the derived type, m_size was recorded from it at creation. The derived object may not start at the base address.
+	void* address;
+	if constexpr(std::is_polymorphic_v<T>)
+		address = dynamic_cast<void*>(pointer);
+	else
+		address = pointer;
+	pointer->~T();
+	m_pool->deallocate(address, m_size);
+}
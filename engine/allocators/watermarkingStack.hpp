@@ -1,6 +1,6 @@
 #pragma once
 #include "watermarkingStack.h"
-#include <omp.h>
+#include "../threads.h"
 template<typename T>
 void ThreadStripedWatermarkingStack<T>::init(int maxThreads)
 {
@@ -10,7 +10,7 @@ void ThreadStripedWatermarkingStack<T>::init(int maxThreads)
 template<typename T>
 std::vector<T>& ThreadStripedWatermarkingStack<T>::get()
 {
-	return s_buffer[(int)omp_get_thread_num()];
+	return s_buffer[threads::getIndex()];
 }
 template<typename T>
 ThreadStripedWatermarkingStack<T>::ThreadStripedWatermarkingStack() :
@@ -60,7 +60,7 @@ Area::Area(AreaId id, std::string n, Simulation& s, const Distance x, const Dist
 	m_hasRain.scheduleRestart();
 	m_hasEvaporation.schedule(*this);
 }
-Area::Area(const Json& data, DeserializationMemo& deserializationMemo, Simulation& simulation) :
+Area::Area(const Json& data, DeserializationMemo& deserializationMemo, Simulation& simulation, BinaryArchiveReader* rtrees, const std::vector<BinaryArchiveReader*>& rtreeDeltas) :
 	#ifndef NDEBUG
 		m_space(std::make_unique<Space>(*this, data["space"]["x"].get<Distance>(), data["space"]["y"].get<Distance>(), data["space"]["z"].get<Distance>())),
 		m_actors(std::make_unique<Actors>(*this)),
@@ -96,7 +96,7 @@ Area::Area(const Json& data, DeserializationMemo& deserializationMemo, Simulatio
 	// Record id now so json point references will function later in this method.
 	m_simulation.m_hasAreas->recordId(*this);
 	setup();
-	getSpace().load(data["space"], deserializationMemo);
+	getSpace().load(data["space"], deserializationMemo, rtrees, rtreeDeltas);
 	data["fluidGroups"].get_to(m_hasFluidGroups);
 	// Load plants.
 	getPlants().load(data["plants"]);
@@ -154,11 +154,11 @@ Area::~Area()
 		if(actors.objective_exists(actor))
 			actors.objective_getCurrent<Objective>(actor).onBeforeUnload(*this, actor);
 }
-Json Area::toJson() const
+Json Area::toJson(const bool includeSpaceRTrees) const
 {
 	Json data{
 		{"id", m_id}, {"name", m_name},
-		{"actors", getActors().toJson()}, {"items", getItems().toJson()}, {"space", getSpace().toJson()},
+		{"actors", getActors().toJson()}, {"items", getItems().toJson()}, {"space", getSpace().toJson(includeSpaceRTrees)},
 		{"plants", getPlants().toJson()}, {"fluidSources", m_fluidSources.toJson()}, {"fires", m_fires},
 		{"sleepingSpots", m_hasSleepingSpots.toJson()}, {"rain", m_hasRain.toJson()},
 		{"designations", m_spaceDesignations}, {"temperature", m_hasTemperature}, {"fluidGroups", m_hasFluidGroups}
@@ -175,24 +175,82 @@ Json Area::toJson() const
 }
 void Area::setup()
 {
+	// Distinct for each Area, and the same each time the simulation runs with the same seed. The multiplier spreads consecutive ids across the seed space.
+	m_random.seed(m_simulation.m_random.getSeed() + (uint32_t)m_id.get() * 0x9E3779B9u);
 	updateClimate();
 }
 void Area::doStep()
 {
+	m_stepProfiler.beginStep(m_simulation.m_step);
+	m_hasJobs.beginStep();
+	m_stepProfiler.beginPhase();
+	const int fluidGroupCount = m_hasFluidGroups.m_groups.size();
 	m_hasFluidGroups.doStep();
+	m_stepProfiler.endPhase(StepPhase::FluidGroups, fluidGroupCount);
 	Space& space = getSpace();
-	space.prepareRtrees();
+	m_stepProfiler.beginPhase();
+	space.prepareRtreesIncremental();
+	m_stepProfiler.endPhase(StepPhase::PrepareRtrees);
+	m_stepProfiler.beginPhase();
 	space.doSupportStep();
+	m_stepProfiler.endPhase(StepPhase::Support);
+	m_stepProfiler.beginPhase();
 	m_hasTemperature.doStep(*this);
+	m_stepProfiler.endPhase(StepPhase::Temperature);
 	if(m_hasRain.isRaining() && m_simulation.m_step.modulusIsZero(Config::rainWriteStepFreqency))
+	{
+		m_stepProfiler.beginPhase();
 		m_hasRain.doStep();
+		m_stepProfiler.endPhase(StepPhase::Rain);
+	}
+	m_stepProfiler.beginPhase();
 	m_fluidSources.doStep();
+	m_stepProfiler.endPhase(StepPhase::FluidSources);
+	m_stepProfiler.beginPhase();
+	const int visionRequestCount = m_visionRequests.size();
 	m_visionRequests.doStep();
+	m_stepProfiler.endPhase(StepPhase::Vision, visionRequestCount);
+	m_stepProfiler.beginPhase();
 	m_hasPaths.doStep(*this);
+	m_stepProfiler.endPhase(StepPhase::Paths, m_hasPaths.getLastStepStats().pathCount);
+	m_stepProfiler.beginPhase();
+	const int threadedTaskCount = m_threadedTaskEngine.count();
 	m_threadedTaskEngine.doStep(m_simulation, this);
+	m_stepProfiler.endPhase(StepPhase::AreaThreadedTasks, threadedTaskCount);
+	m_stepProfiler.beginPhase();
+	const int eventCount = m_eventSchedule.countForStep(m_simulation.m_step);
 	m_eventSchedule.doStep(m_simulation.m_step);
+	m_stepProfiler.endPhase(StepPhase::AreaEvents, eventCount);
+	m_stepProfiler.beginPhase();
+	getActors().move_doStep();
+	m_stepProfiler.endPhase(StepPhase::Movement);
+	m_stepProfiler.beginPhase();
+	getPlants().doStep();
+	m_stepProfiler.endPhase(StepPhase::Plants);
+	m_stepProfiler.beginPhase();
 	m_hasSoldiers.doStep(*this);
+	m_stepProfiler.endPhase(StepPhase::Soldiers);
+	m_stepProfiler.beginPhase();
 	m_fires.doStep(m_simulation.m_step, *this);
+	m_stepProfiler.endPhase(StepPhase::Fires);
+	m_stepProfiler.beginPhase();
+	const int idleActorCount = m_hasJobs.waitingCount();
+	m_hasJobs.doStep(*this);
+	m_stepProfiler.endPhase(StepPhase::Jobs, idleActorCount);
+	m_stepProfiler.endStep();
+}
+void Area::writeToSimulation(std::function<void()>&& action)
+{
+	if(m_simulation.m_hasAreas->isSteppingConcurrently())
+		m_deferredSimulationWrites.push_back(std::move(action));
+	else
+		action();
+}
+void Area::applyDeferredSimulationWrites()
+{
+	for(std::function<void()>& action : m_deferredSimulationWrites)
+		action();
+	m_deferredSimulationWrites.clear();
 }
 void Area::updateClimate()
 {
@@ -202,9 +260,7 @@ void Area::updateClimate()
 	if(m_simulation.m_step.modulusIsZero(Config::stepsPerDay))
 	{
 		int day = DateTime(m_simulation.m_step).day;
-		Plants& plants = getPlants();
-		for(auto plant : plants.getAll())
-			plants.setDayOfYear(plant, day);
+		getPlants().setDayOfYear(day);
 		m_hasFarmFields.setDayOfYear(day);
 	}
 }
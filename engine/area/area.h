@@ -34,10 +34,15 @@
 #include "hasConstructionDesignations.h"
 #include "hasSoldiers.h"
 #include "hasOnSightForFaction.h"
+#include "hasJobs.h"
 #include "../fluid/fluidGroup.h"
 #include "../fluid/areaHasFluidGroups.h"
+#include "../random.h"
+#include "../dataStructures/idRegistry.h"
+#include "../stepProfiler.h"
 //#include "medical.h"
 
+#include <functional>
 #include <vector>
 #include <tuple>
 #include <list>
@@ -73,6 +78,8 @@ class Area final
 		std::unique_ptr<Plants> m_plants;
 		std::unique_ptr<Items> m_items;
 	#endif
+	// Writes to Simulation made while stepping concurrently with other Areas, applied in Area order after all Areas have stepped.
+	std::vector<std::function<void()>> m_deferredSimulationWrites;
 public:
 	EventSchedule m_eventSchedule;
 	ThreadedTaskEngine m_threadedTaskEngine;
@@ -95,6 +102,8 @@ public:
 	AreaHasSleepingSpots m_hasSleepingSpots;
 	AreaHasWoodCuttingDesignations m_hasWoodCuttingDesignations;
 	AreaHasInstallItemDesignations m_hasInstallItemDesignations;
+	// Matches idle actors with objective types once per step.
+	AreaHasJobs m_hasJobs;
 	//AreaHasMedicalPatients m_hasMedicalPatients;
 	AreaHasFluidSources m_fluidSources;
 	AreaHasFluidGroups m_hasFluidGroups;
@@ -106,6 +115,13 @@ public:
 	VisionRequests m_visionRequests;
 	OpacityFacade m_opacityFacade;
 	AreaHasDecks m_decks;
+	// Each Area has it's own stream so results do not depend on the order in which Areas are stepped. Seeded from the Simulation's seed and m_id in setup.
+	Random m_random;
+	// Blocks of ids this Area allocates from, see IdRegistry.
+	IdBlock m_actorIds;
+	IdBlock m_itemIds;
+	// Disabled by default, see StepProfiler::setEnabled.
+	StepProfiler m_stepProfiler{{&m_eventSchedule.getPool(), &m_threadedTaskEngine.getPool()}};
 	std::string m_name;
 	Simulation& m_simulation;
 	AreaId m_id;
@@ -114,18 +130,23 @@ public:
 
 	// Create space and store adjacent
 	Area(AreaId id, std::string n, Simulation& s, const Distance x, const Distance y, const Distance z);
-	Area(const Json& data, DeserializationMemo& deserializationMemo, Simulation& s);
+	// When loading a binary save rtrees holds the Space R-trees, which are not in data, and rtreeDeltas holds changes to them which are applied in order.
+	Area(const Json& data, DeserializationMemo& deserializationMemo, Simulation& s, BinaryArchiveReader* rtrees = nullptr, const std::vector<BinaryArchiveReader*>& rtreeDeltas = {});
 	Area(const Area& area) = delete;
 	Area(const Area&& area) = delete;
 	~Area();
 	void setup();
 
 	void doStep();
+	// Runs action immediately unless Areas are being stepped concurrently, in which case it is queued untill applyDeferredSimulationWrites.
+	// For writes to state shared by all Areas, such as dialogue boxes.
+	void writeToSimulation(std::function<void()>&& action);
+	void applyDeferredSimulationWrites();
 
 	// To be called periodically by Simulation.
 	void updateClimate();
 
-	[[nodiscard]] Json toJson() const;
+	[[nodiscard]] Json toJson(const bool includeSpaceRTrees = true) const;
 	#ifdef NDEBUG
 		[[nodiscard]] Space& getSpace() { return m_space; }
 		[[nodiscard]] Plants& getPlants() { return m_plants; }
@@ -1,6 +1,8 @@
 #include "hasDigDesignations.h"
 #include "area.h"
 #include "../space/space.h"
+#include "../simulation/simulation.h"
+#include "../simulation/hasAreas.h"
 HasDigDesignationsForFaction::HasDigDesignationsForFaction(const Json& data, DeserializationMemo& deserializationMemo, const FactionId faction, Area& area) :
 	m_faction(faction)
 {
@@ -137,4 +139,18 @@ DigProject& AreaHasDigDesignations::getForFactionAndPoint(const FactionId factio
 	assert(m_data.contains(faction));
 	assert(m_data[faction].m_data.contains(point));
 	return m_data[faction].m_data[point];
-}
\ No newline at end of file
+}
+// Input.
+void DigDesignateInputAction::execute(Simulation& simulation)
+{
+	SimulationHasAreas& hasAreas = simulation.getAreas();
+	if(!hasAreas.contains(m_area))
+		return;
+	Area& area = hasAreas.getById(m_area);
+	Space& space = area.getSpace();
+	AreaHasDigDesignations& hasDigDesignations = area.m_hasDigDesignations;
+	// Designate adds the faction if needed.
+	for(const Point3D point : m_cuboid)
+		if(space.solid_isAny(point) && (!hasDigDesignations.hasFaction(m_faction) || !hasDigDesignations.contains(m_faction, point)))
+			hasDigDesignations.designate(m_faction, point, m_pointFeatureType);
+}
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "../geometry/cuboid.h"
-//#include "input.h"
+#include "../input.h"
 #include "../reservable.h"
 #include "../numericTypes/types.h"
 #include "../eventSchedule.hpp"
@@ -62,6 +62,19 @@ public:
 	[[nodiscard]] Json toJson() const;
 	[[nodiscard]] bool areThereAnyForFaction(const FactionId faction) const;
 	[[nodiscard]] bool contains(const FactionId faction, const Point3D point) const { return m_data[faction].m_data.contains(point); }
+	[[nodiscard]] bool hasFaction(const FactionId faction) const { return m_data.contains(faction); }
 	[[nodiscard]] DigProject& getForFactionAndPoint(const FactionId faction, const Point3D point);
 	[[nodiscard]] DigProject* getProjectWithCondition(const FactionId faction, const auto& shape, auto&& condition) { return m_data[faction].getProjectWithCondition(shape, condition); }
-};
\ No newline at end of file
+};
+// Designates every solid point in cuboid which is not already designated. Points which were dug out before the action executes are skipped.
+class DigDesignateInputAction final : public InputAction
+{
+	AreaId m_area;
+	FactionId m_faction;
+	Cuboid m_cuboid;
+	PointFeatureTypeId m_pointFeatureType;
+public:
+	DigDesignateInputAction(const AreaId area, const FactionId faction, const Cuboid cuboid, const PointFeatureTypeId pointFeatureType) :
+		m_area(area), m_faction(faction), m_cuboid(cuboid), m_pointFeatureType(pointFeatureType) { }
+	void execute(Simulation& simulation);
+};
@@ -0,0 +1,188 @@
+#include "hasJobs.h"
+#include "area.h"
+#include "../actors/actors.h"
+#include "../objective.h"
+#include "../objectives/rest.h"
+#include "../objectives/wander.h"
+#include "../simulation/simulation.h"
+#include <algorithm>
+namespace
+{
+	// Queries boxes of doubling size around location. Once a box of half width radius holds a site the nearest one is at most radius * sqrt(3) away, so the leaves within twice radius include it.
+	[[nodiscard]] Distance getDistanceToNearestSite(const RTreeBoolean& sites, const Point3D location, const Cuboid boundry)
+	{
+		int radius = 1;
+		while(true)
+		{
+			const Cuboid box = Cuboid::create(location).inflated(Distance::create(radius)).intersection(boundry);
+			if(sites.query(box))
+				break;
+			if(box == boundry)
+				return Distance::max();
+			radius *= 2;
+		}
+		Distance output = Distance::max();
+		for(const Cuboid cuboid : sites.queryGetLeaves(Cuboid::create(location).inflated(Distance::create(radius * 2)).intersection(boundry)))
+			output = std::min(output, cuboid.distanceTo(location));
+		return output;
+	}
+}
+void AreaHasJobs::beginStep()
+{
+	assert(m_idle.empty());
+	m_deferMatching = true;
+}
+void AreaHasJobs::doStep(Area& area)
+{
+	// Objectives assigned below may fail immediately and leave their actor idle again, that actor is matched on it's own rather than waiting for the next step.
+	m_deferMatching = false;
+	if(m_idle.empty())
+		return;
+	Actors& actors = area.getActors();
+	// Grouped by faction in the order they became idle.
+	std::vector<std::pair<FactionId, std::vector<ActorIndex>>> byFaction;
+	for(const ActorReference& actor : m_idle)
+	{
+		const ActorIndex index = actor.getIndex(actors.m_referenceData);
+		// May have been given a need or a task since becoming idle.
+		if(actors.objective_exists(index))
+			continue;
+		const FactionId faction = actors.getFaction(index);
+		auto found = std::ranges::find(byFaction, faction, &std::pair<FactionId, std::vector<ActorIndex>>::first);
+		if(found == byFaction.end())
+			byFaction.emplace_back(faction, std::vector<ActorIndex>{index});
+		else
+			found->second.push_back(index);
+	}
+	m_idle.clear();
+	for(const auto& [faction, forFaction] : byFaction)
+		match(area, faction, forFaction);
+}
+void AreaHasJobs::setObjectiveFor(Area& area, const ActorIndex actor)
+{
+	if(m_deferMatching)
+	{
+		const ActorReference ref = area.getActors().getReference(actor);
+		if(!isWaiting(ref))
+			m_idle.push_back(ref);
+	}
+	else
+		match(area, area.getActors().getFaction(actor), {actor});
+}
+void AreaHasJobs::maybeRemove(const ActorReference actor)
+{
+	std::erase(m_idle, actor);
+}
+bool AreaHasJobs::isWaiting(const ActorReference actor) const
+{
+	return std::ranges::find(m_idle, actor) != m_idle.end();
+}
+void AreaHasJobs::match(Area& area, const FactionId faction, const std::vector<ActorIndex>& actors)
+{
+	Actors& areaActors = area.getActors();
+	const Step& currentStep = area.m_simulation.m_step;
+	const Cuboid boundry = area.getSpace().boundry();
+	struct JobSites
+	{
+		// Null when the objective type is matched without job sites.
+		const RTreeBoolean* sites = nullptr;
+		// How many more actors may be matched with this objective type in this pass.
+		int64_t capacity = 0;
+		bool checked = false;
+	};
+	// Indexed by ObjectiveTypeId, each is read at most once per pass.
+	std::vector<JobSites> jobSitesByType(objectiveTypeData.size());
+	auto getJobSites = [&](const ObjectiveTypeId objectiveTypeId) -> JobSites&
+	{
+		JobSites& output = jobSitesByType[objectiveTypeId.get()];
+		if(output.checked)
+			return output;
+		output.checked = true;
+		// Actors without a faction have no designations to read, canBeAssigned decides for them.
+		if(!faction.exists())
+		{
+			output.capacity = INT64_MAX;
+			return output;
+		}
+		const ObjectiveType& objectiveType = ObjectiveType::getById(objectiveTypeId);
+		if(!objectiveType.hasWorkForFaction(area, faction))
+			return output;
+		const SpaceDesignation designation = objectiveType.getJobSiteDesignation();
+		if(designation == SpaceDesignation::Null)
+		{
+			output.capacity = INT64_MAX;
+			return output;
+		}
+		if(!area.m_spaceDesignations.contains(faction))
+			return output;
+		output.sites = &area.m_spaceDesignations.getForFaction(faction).getForDesignation(designation);
+		// Walks the tree's nodes rather then gathering the sites.
+		output.capacity = (int64_t)output.sites->totalLeafVolume() * objectiveType.getActorsPerJobSite();
+		return output;
+	};
+	struct Candidate
+	{
+		Priority priority;
+		Distance distance;
+		int actor;
+		ObjectiveTypeId objectiveType;
+	};
+	std::vector<Candidate> candidates;
+	for(int i = 0; i != (int)actors.size(); ++i)
+	{
+		const ActorIndex actor = actors[i];
+		const Point3D location = areaActors.getLocation(actor);
+		for(const ObjectivePriority& objectivePriority : areaActors.objective_getPrioritySet(actor).getAll())
+		{
+			if(currentStep <= objectivePriority.doNotAssignAgainUntil)
+				continue;
+			const JobSites& jobSites = getJobSites(objectivePriority.objectiveType);
+			if(jobSites.capacity == 0)
+				continue;
+			Distance distance = Distance::create(0);
+			if(jobSites.sites != nullptr && location.exists())
+				distance = getDistanceToNearestSite(*jobSites.sites, location, boundry);
+			candidates.emplace_back(objectivePriority.priority, distance, i, objectivePriority.objectiveType);
+		}
+	}
+	// Stable so that ties keep the order actors became idle in and the order each actor lists it's priorities in.
+	std::ranges::stable_sort(candidates, [](const Candidate& a, const Candidate& b)
+	{
+		if(a.priority != b.priority)
+			return a.priority > b.priority;
+		return a.distance < b.distance;
+	});
+	std::vector<bool> matched(actors.size(), false);
+	for(const Candidate& candidate : candidates)
+	{
+		if(matched[candidate.actor])
+			continue;
+		JobSites& jobSites = jobSitesByType[candidate.objectiveType.get()];
+		if(jobSites.capacity == 0)
+			continue;
+		const ActorIndex actor = actors[candidate.actor];
+		// An objective assigned earlier in this pass may have given this actor something to do.
+		if(areaActors.objective_exists(actor))
+		{
+			matched[candidate.actor] = true;
+			continue;
+		}
+		const ObjectiveType& objectiveType = ObjectiveType::getById(candidate.objectiveType);
+		if(!objectiveType.canBeAssigned(area, actor))
+			continue;
+		matched[candidate.actor] = true;
+		--jobSites.capacity;
+		areaActors.objective_addTaskToStart(actor, objectiveType.makeFor(area, actor));
+	}
+	for(int i = 0; i != (int)actors.size(); ++i)
+		if(!matched[i] && !areaActors.objective_exists(actors[i]))
+			assignIdleTask(area, actors[i]);
+}
+void AreaHasJobs::assignIdleTask(Area& area, const ActorIndex actor)
+{
+	Actors& actors = area.getActors();
+	if(!actors.stamina_isFull(actor))
+		actors.objective_addTaskToStart(actor, std::make_unique<RestObjective>(area));
+	else
+		actors.objective_addTaskToStart(actor, std::make_unique<WanderObjective>());
+}
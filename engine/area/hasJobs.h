@@ -0,0 +1,29 @@
+/*
+	Job board, matches idle actors with objective types.
+	Actors which become idle during Area::doStep wait here until the end of the step, then all of them are matched in one pass per faction, so assignment still completes within the step. Actors which become idle outside of a step, such as from player input, are matched immediately as a batch of one.
+	Job sites are read from the faction's space designations, which are already spatially indexed by an RTreeBoolean per designation. ObjectiveType::getJobSiteDesignation names the designation for an objective type, those without one such as craft and install item are matched on hasWorkForFaction alone. Each actor's distance to the nearest site is found with boxes of doubling size around it on that R-tree, so the cost grows with how far away the nearest site is rather then with how many sites there are.
+	Candidates are taken in order of the priority the actor gives the objective type, then by distance from the actor to the nearest job site. Each job site takes ObjectiveType::getActorsPerJobSite actors per pass, an actor who does not get one moves on to it's next objective type.
+	Skills and reachability are still confirmed for each match by canBeAssigned and by the path request the objective makes.
+*/
+#pragma once
+#include "../numericTypes/types.h"
+#include "../reference.h"
+#include <vector>
+class Area;
+class AreaHasJobs final
+{
+	std::vector<ActorReference> m_idle;
+	bool m_deferMatching = false;
+	void match(Area& area, const FactionId faction, const std::vector<ActorIndex>& actors);
+	void assignIdleTask(Area& area, const ActorIndex actor);
+public:
+	// Called at the start of Area::doStep, idle actors wait for doStep from here on.
+	void beginStep();
+	// Called at the end of Area::doStep.
+	void doStep(Area& area);
+	// Called by ObjectiveTypePrioritySet::setObjectiveFor.
+	void setObjectiveFor(Area& area, const ActorIndex actor);
+	void maybeRemove(const ActorReference actor);
+	[[nodiscard]] bool isWaiting(const ActorReference actor) const;
+	[[nodiscard]] int waitingCount() const { return m_idle.size(); }
+};
@@ -3,6 +3,8 @@
 #include "../actors/actors.h"
 #include "../config/psycology.h"
 #include "../dataStructures/rtreeData.hpp"
+#include "../random.h"
+#include "../threads.h"
 void AreaHasSoldiersForFaction::prefetchToL3() const
 {
 	util::prefetchL3ReadMode(soldiers);
@@ -137,7 +139,7 @@ void AreaHasSoldiers::updateSoldierCombatScore(Area& area, const ActorIndex acto
 	unsetLocation(area, actor, previous);
 	setLocation(area, actor);
 }
-void AreaHasSoldiers::doStepThread(Area& area, const AreaHasSoldiersCourageCheckThreadData& threadData)
+void AreaHasSoldiers::doStepThread(Area& area, AreaHasSoldiersCourageCheckThreadData& threadData)
 {
 	threadData.prefetchToL1(*this);
 	SmallMap<int, PsycologyWeight> actorsNeedingToTestCourage;
@@ -154,17 +156,15 @@ void AreaHasSoldiers::doStepThread(Area& area, const AreaHasSoldiersCourageCheck
 		if(maliceDelta + courage[adjustedIndex] < Config::Psycology::minimumMaliceDeltaPlusCourageToHoldFirmWithoutTest)
 			actorsNeedingToTestCourage.insert(adjustedIndex, maliceDelta);
 	});
-	Actors& actors = area.getActors();
+	const Actors& actors = area.getActors();
+	const Step step = area.m_simulation.m_step;
+	threadData.results.clear();
 	for(const auto& [index, maliceDelta] : actorsNeedingToTestCourage)
 	{
-		bool holdsFirm = area.m_simulation.m_random.applyRandomFuzzPlusOrMinusRatio(courage[index], Config::ratioOfMaximumVarianceForCourageTest) > maliceDelta;
-		if(holdsFirm)
-			// Test of courage passed, hold ground and gain permanant courage.
-			actors.psycology_event(soldiers[index], PsycologyEventType::StandGround, PsycologyAttribute::Courage, Config::Psycology::courageToGainOnStandGround, Step::null(), Config::Psycology::coolDownForStandGround);
-		else
-			// Test failed, flee.
-			actors.combat_flee(soldiers[index]);
-			// TODO: gain shame?
+		// Each soldier draws from its own stream so the result does not depend on which thread tests it.
+		RandomStream random = area.m_random.getStream(step, actors.getId(soldiers[index]).get(), RandomPurpose::CourageTest);
+		const bool holdsFirm = random.applyRandomFuzzPlusOrMinusRatio(courage[index], Config::ratioOfMaximumVarianceForCourageTest) > maliceDelta;
+		threadData.results.emplace_back(soldiers[index], holdsFirm);
 	}
 }
 void AreaHasSoldiers::doStep(Area& area)
@@ -184,10 +184,25 @@ void AreaHasSoldiers::doStep(Area& area)
 				soldiersAssignedToThread += Config::soldiersPerMoraleCheckThread;
 			}
 		}
-		// This is safe to parallelize without having read/write steps because the changes are only internal to the actors.
-		// If that stops being true, for example if combat_isFleeing changed combatScore, then this would be a race condition.
 		#pragma omp parallel for
-			for(const AreaHasSoldiersCourageCheckThreadData& threadData : threadDatas)
+			for(AreaHasSoldiersCourageCheckThreadData& threadData : threadDatas)
+			{
+				threads::ReadPhaseGuard guard;
 				doStepThread(area, threadData);
+			}
+		// Apply results in thread data order, which is independent of how thread datas were distributed between threads.
+		// Fleeing sets a destination, which records a path request, so it cannot be done in the read step.
+		Actors& actors = area.getActors();
+		for(const AreaHasSoldiersCourageCheckThreadData& threadData : threadDatas)
+			for(const auto& [actor, holdsFirm] : threadData.results)
+			{
+				if(holdsFirm)
+					// Test of courage passed, hold ground and gain permanant courage.
+					actors.psycology_event(actor, PsycologyEventType::StandGround, PsycologyAttribute::Courage, Config::Psycology::courageToGainOnStandGround, Step::null(), Config::Psycology::coolDownForStandGround);
+				else
+					// Test failed, flee.
+					actors.combat_flee(actor);
+					// TODO: gain shame?
+			}
 	}
-}
\ No newline at end of file
+}
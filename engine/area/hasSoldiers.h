@@ -15,6 +15,8 @@ struct AreaHasSoldiersCourageCheckThreadData
 {
 	const FactionId faction;
 	const int start;
+	// Soldiers which tested their courage and whether they held firm, written by doStepThread and applied by doStep.
+	std::vector<std::pair<ActorIndex, bool>> results;
 	void prefetchToL1(const AreaHasSoldiers& areaHasSoldiers) const;
 };
 struct AreaHasSoldiersForFaction
@@ -39,7 +41,8 @@ public:
 	void updateSoldierIndex(Area& area, const ActorIndex oldIndex, const ActorIndex newIndex);
 	void updateSoldierCourage(Area& area, const ActorIndex actor);
 	void updateSoldierCombatScore(Area& area, const ActorIndex actor, const CombatScore previous);
-	void doStepThread(Area& area, const AreaHasSoldiersCourageCheckThreadData& threadData);
+	// Read step, does not modify actors.
+	void doStepThread(Area& area, AreaHasSoldiersCourageCheckThreadData& threadData);
 	void doStep(Area& area);
 	[[nodiscard]] PsycologyWeight get(const Point3D point, const FactionId faction) const;
 	friend struct AreaHasSoldiersCourageCheckThreadData;
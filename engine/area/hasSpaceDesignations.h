@@ -17,6 +17,7 @@ public:
 	void maybeUnset(const auto& shape, const SpaceDesignation designation) { m_data[(int)designation].maybeRemove(shape); }
 	void maybeSet(const auto& shape, const SpaceDesignation designation) { m_data[(int)designation].maybeInsert(shape); }
 	void prepare() { for(auto& rtree : m_data) rtree.prepare(); }
+	void prepareIncremental() { for(auto& rtree : m_data) rtree.prepareIncremental(); }
 	void queryForEach(auto& shape, auto&& action) const
 	{
 		for(int designation = 0; designation != (int)SpaceDesignation::Null; ++designation)
@@ -53,6 +54,7 @@ public:
 	void maybeRegisterFaction(const FactionId faction) { if(!contains(faction)) m_data.emplace(faction); }
 	void unregisterFaction(const FactionId faction) { m_data.erase(faction); }
 	void prepare() { for(auto& pair : m_data) pair.second.prepare(); }
+	void prepareIncremental() { for(auto& pair : m_data) pair.second.prepareIncremental(); }
 	void queryForEachForFactionIfExists(const FactionId faction, const auto& shape, auto&& action)
 	{
 		auto found = m_data.find(faction);
@@ -83,7 +83,7 @@ void AreaHasRain::doStep()
 }
 void AreaHasRain::scheduleRestart()
 {
-	auto random = m_area.m_simulation.m_random;
+	auto random = m_area.m_random;
 	Percent humidity = humidityForSeason();
 	Step restartAt =
 		Step::create((100 - humidity.get()) *
@@ -108,7 +108,7 @@ void RainEvent::execute(Simulation&, Area* area)
 	}
 	else
 	{
-		auto random = area->m_hasRain.m_area.m_simulation.m_random;
+		auto random = area->m_random;
 		Percent humidity{area->m_hasRain.humidityForSeason()};
 		float modifier = random.getInRange(Config::minimumRainIntensityModifier, Config::maximumRainIntensityModifier);
 		assert(modifier != 0.0f);
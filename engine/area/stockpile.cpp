@@ -25,7 +25,7 @@ StockPile::StockPile(std::vector<ItemQuery>& q, Area& a, const FactionId f) :
 StockPile::StockPile(const Json& data, DeserializationMemo& deserializationMemo, Area& area) :
 	m_openPoints(data["openPoints"].get<Quantity>()),
 	m_area(area), m_faction(data["faction"].get<FactionId>()),
-	m_enabled(data["enabled"].get<bool>()), m_reenableScheduledEvent(m_area.m_simulation.m_eventSchedule),
+	m_enabled(data["enabled"].get<bool>()), m_reenableScheduledEvent(m_area.m_eventSchedule),
 	m_projectNeedingMoreWorkers(data.contains("projectNeedingMoreWorkers") ? &static_cast<StockPileProject&>(*deserializationMemo.m_projects.at(data["projectNeedingMoreWorkers"].get<uintptr_t>())) : nullptr)
 {
 	deserializationMemo.m_stockpiles[data["address"].get<uintptr_t>()] = this;
@@ -185,7 +185,7 @@ AreaHasStockPilesForFaction::AreaHasStockPilesForFaction(const Json& data, Deser
 			for(const Json& stockPileAddress : pair[1])
 			{
 				StockPile& stockPile = *deserializationMemo.m_stockpiles.at(stockPileAddress.get<uintptr_t>());
-				m_availableStockPilesByItemType.getOrCreate(itemType).insert(&stockPile);
+				m_availableStockPilesByItemType[itemType].insert(&stockPile);
 			}
 		}
 	if(data.contains("itemsWithoutDestinationsByItemType"))
@@ -211,7 +211,7 @@ AreaHasStockPilesForFaction::AreaHasStockPilesForFaction(const Json& data, Deser
 			for(const Json& item : pair[1])
 			{
 				ItemReference ref(item, items.m_referenceData);
-				m_itemsWithDestinationsByStockPile.getOrCreate(&stockPile).insert(ref);
+				recordDestination(stockPile, ref);
 			}
 		}
 	if(data.contains("projectsByItem"))
@@ -221,7 +221,7 @@ AreaHasStockPilesForFaction::AreaHasStockPilesForFaction(const Json& data, Deser
 			for(const Json& projectData : pair[1])
 			{
 				StockPileProject& project = m_projects.emplace_back(projectData, deserializationMemo, m_area);
-				m_projectsByItem.getOrCreate(ref).insert(&project);
+				m_projectsByItem[ref].insert(&project);
 			}
 		}
 }
@@ -313,9 +313,14 @@ void AreaHasStockPilesForFaction::destroyStockPile(StockPile& stockPile)
 	Items& items = m_area.getItems();
 	// Potentially transfer items from withDestination to withoutDestination, also cancel any associated projects and remove from items with destinations without projects.
 	// Sort items which no longer have a potential destination from ones which have a new one.
-	if(m_itemsWithDestinationsByStockPile.contains(&stockPile))
-		for(ItemReference item : m_itemsWithDestinationsByStockPile[&stockPile])
+	auto found = m_itemsWithDestinationsByStockPile.find(&stockPile);
+	if(found != m_itemsWithDestinationsByStockPile.end())
+	{
+		// Copy because erasing the last item erases the entry.
+		const ItemReferenceSet itemsForStockPile = found->second;
+		for(ItemReference item : itemsForStockPile)
 		{
+			maybeEraseDestination(item);
 			ItemIndex itemIndex = item.getIndex(items.m_referenceData);
 			StockPile* newStockPile = getStockPileFor(itemIndex);
 			assert(newStockPile != &stockPile);
@@ -323,19 +328,19 @@ void AreaHasStockPilesForFaction::destroyStockPile(StockPile& stockPile)
 			{
 				// Remove all those which no longer have a destination from m_itemsToBeStockPiled.
 				// Add them to items without destinaitons by item type.
-				auto found = m_itemsToBeStockPiled.find(item);
-				if(found != m_itemsToBeStockPiled.end())
+				auto foundToBeStockPiled = m_itemsToBeStockPiled.find(item);
+				if(foundToBeStockPiled != m_itemsToBeStockPiled.end())
 				{
-					m_itemsToBeStockPiled.erase(found);
+					m_itemsToBeStockPiled.erase(foundToBeStockPiled);
 					m_itemsWithoutDestinationsByItemType[items.getItemType(itemIndex)].insert(item);
 				}
 			}
 			else
 				// Record the new stockpile in items with destinations by stockpile.
-				m_itemsWithDestinationsByStockPile[newStockPile].insert(item);
+				recordDestination(*newStockPile, item);
 		}
-	// Remove the stockpile entry from items with destinations by stockpile.
-	m_itemsWithDestinationsByStockPile.maybeErase(&stockPile);
+	}
+	assert(!m_itemsWithDestinationsByStockPile.contains(&stockPile));
 	// Destruct.
 	m_stockPiles.remove(stockPile);
 }
@@ -356,10 +361,10 @@ void AreaHasStockPilesForFaction::addItem(const ItemIndex item)
 	StockPile* stockPile = getStockPileFor(item);
 	ItemReference ref = items.getReference(item);
 	if(stockPile == nullptr)
-		m_itemsWithoutDestinationsByItemType.getOrCreate(items.getItemType(item)).insert(ref);
+		m_itemsWithoutDestinationsByItemType[items.getItemType(item)].insert(ref);
 	else
 	{
-		m_itemsWithDestinationsByStockPile.getOrCreate(stockPile).insert(ref);
+		recordDestination(*stockPile, ref);
 		m_itemsToBeStockPiled.insert(ref);
 	}
 	AreaHasSpaceDesignationsForFaction& hasDesignations = m_area.m_spaceDesignations.getForFaction(m_faction);
@@ -386,15 +391,13 @@ void AreaHasStockPilesForFaction::removeItem(const ItemIndex item)
 	ItemTypeId itemType = m_area.getItems().getItemType(item);
 	items.stockpile_maybeUnset(item, m_faction);
 	ItemReference ref = items.getReference(item);
-	if(m_itemsWithoutDestinationsByItemType.contains(itemType) && m_itemsWithoutDestinationsByItemType[itemType].contains(ref))
-		m_itemsWithoutDestinationsByItemType[itemType].erase(ref);
+	auto foundWithoutDestination = m_itemsWithoutDestinationsByItemType.find(itemType);
+	if(foundWithoutDestination != m_itemsWithoutDestinationsByItemType.end() && foundWithoutDestination->second.contains(ref))
+		foundWithoutDestination->second.erase(ref);
 	else
 	{
-		m_itemsToBeStockPiled.maybeErase(ref);
-		m_itemsWithDestinationsByStockPile.eraseIf([&](auto& pair){
-			pair.second.maybeErase(ref);
-			return pair.second.empty();
-		});
+		m_itemsToBeStockPiled.erase(ref);
+		maybeEraseDestination(ref);
 	}
 	auto found = m_projectsByItem.find(ref);
 	if(found != m_projectsByItem.end())
@@ -416,23 +419,33 @@ void AreaHasStockPilesForFaction::removeItem(const ItemIndex item)
 }
 void AreaHasStockPilesForFaction::maybeRemoveFromItemsWithDestinationByStockPile(const StockPile& stockPile, const ItemIndex item)
 {
-	Items& items = m_area.getItems();
-	StockPile* nonConst = const_cast<StockPile*>(&stockPile);
-	auto found = m_itemsWithDestinationsByStockPile.find(nonConst);
-	if(found == m_itemsWithDestinationsByStockPile.end())
+	const ItemReference ref = m_area.getItems().getReference(item);
+	auto found = m_destinationByItem.find(ref);
+	if(found != m_destinationByItem.end() && found->second == &stockPile)
+		maybeEraseDestination(ref);
+}
+void AreaHasStockPilesForFaction::recordDestination(StockPile& stockPile, const ItemReference item)
+{
+	maybeEraseDestination(item);
+	m_itemsWithDestinationsByStockPile[&stockPile].insert(item);
+	m_destinationByItem[item] = &stockPile;
+}
+void AreaHasStockPilesForFaction::maybeEraseDestination(const ItemReference item)
+{
+	auto found = m_destinationByItem.find(item);
+	if(found == m_destinationByItem.end())
 		return;
-	if(found->second.size() == 1 && found->second.front().getIndex(items.m_referenceData) == item)
-		m_itemsWithDestinationsByStockPile.erase(found);
-	else
-	{
-		ItemReference ref = m_area.getItems().getReference(item);
-		found->second.maybeErase(ref);
-	}
+	auto foundStockPile = m_itemsWithDestinationsByStockPile.find(found->second);
+	assert(foundStockPile != m_itemsWithDestinationsByStockPile.end());
+	foundStockPile->second.erase(item);
+	if(foundStockPile->second.empty())
+		m_itemsWithDestinationsByStockPile.erase(foundStockPile);
+	m_destinationByItem.erase(found);
 }
 void AreaHasStockPilesForFaction::updateItemReferenceForProject(StockPileProject& project, const ItemReference ref)
 {
 	removeFromProjectsByItem(project);
-	m_projectsByItem.getOrCreate(ref).insert(&project);
+	m_projectsByItem[ref].insert(&project);
 }
 void AreaHasStockPilesForFaction::removePoint(const Point3D point)
 {
@@ -447,14 +460,14 @@ void AreaHasStockPilesForFaction::setAvailable(StockPile& stockPile)
 	for(ItemQuery& itemQuery : stockPile.m_queries)
 	{
 		assert(itemQuery.m_itemType.exists());
-		m_availableStockPilesByItemType.getOrCreate(itemQuery.m_itemType).maybeInsert(&stockPile);
+		m_availableStockPilesByItemType[itemQuery.m_itemType].maybeInsert(&stockPile);
 		auto found = m_itemsWithoutDestinationsByItemType.find(itemQuery.m_itemType);
 		bool inserted = false;
 		if(found != m_itemsWithoutDestinationsByItemType.end())
 			for(ItemReference item : found->second)
 				if(itemQuery.query(m_area, item.getIndex(items.m_referenceData)))
 				{
-					m_itemsWithDestinationsByStockPile.getOrCreate(&stockPile).insert(item);
+					recordDestination(stockPile, item);
 					m_itemsToBeStockPiled.insert(item);
 					inserted = true;
 				}
@@ -466,19 +479,22 @@ void AreaHasStockPilesForFaction::setUnavailable(StockPile& stockPile)
 {
 	for(ItemQuery& itemQuery : stockPile.m_queries)
 		m_availableStockPilesByItemType[itemQuery.m_itemType].erase(&stockPile);
-	if(m_itemsWithDestinationsByStockPile.contains(&stockPile))
+	auto found = m_itemsWithDestinationsByStockPile.find(&stockPile);
+	if(found != m_itemsWithDestinationsByStockPile.end())
 	{
 		Items& items = m_area.getItems();
-		for(ItemReference item : m_itemsWithDestinationsByStockPile[&stockPile])
+		// Copy because erasing the last item erases the entry.
+		const ItemReferenceSet itemsForStockPile = found->second;
+		for(ItemReference item : itemsForStockPile)
 		{
+			maybeEraseDestination(item);
 			ItemIndex itemIndex = item.getIndex(items.m_referenceData);
 			StockPile* newStockPile = getStockPileFor(itemIndex);
 			if(newStockPile == nullptr)
-				m_itemsWithoutDestinationsByItemType.getOrCreate(items.getItemType(itemIndex)).maybeInsert(item);
+				m_itemsWithoutDestinationsByItemType[items.getItemType(itemIndex)].insert(item);
 			else
-				m_itemsWithDestinationsByStockPile.getOrCreate(newStockPile).maybeInsert(item);
+				recordDestination(*newStockPile, item);
 		}
-		m_itemsWithDestinationsByStockPile.erase(&stockPile);
 	}
 }
 void AreaHasStockPilesForFaction::makeProject(const ItemIndex item, const Point3D destination, StockPileObjective& objective, const ActorIndex actor)
@@ -503,7 +519,7 @@ void AreaHasStockPilesForFaction::makeProject(const ItemIndex item, const Point3
 	}
 	ItemReference ref = m_area.getItems().getReference(item);
 	StockPileProject& project = m_projects.emplace_back(m_faction, m_area, destination, item, quantity, maxWorkers);
-	m_projectsByItem.getOrCreate(ref).insert(&project);
+	m_projectsByItem[ref].insert(&project);
 	std::unique_ptr<DishonorCallback> dishonorCallback = std::make_unique<StockPileHasShapeDishonorCallback>(project);
 	project.setLocationDishonorCallback(std::move(dishonorCallback));
 	project.addWorkerCandidate(actor, objective);
@@ -511,7 +527,7 @@ void AreaHasStockPilesForFaction::makeProject(const ItemIndex item, const Point3
 	if(items.reservable_getUnreservedCount(item, m_faction) == quantity)
 	{
 		items.stockpile_maybeUnset(item, m_faction);
-		m_itemsToBeStockPiled.maybeErase(ref);
+		m_itemsToBeStockPiled.erase(ref);
 	}
 }
 void AreaHasStockPilesForFaction::cancelProject(StockPileProject& project)
@@ -537,7 +553,7 @@ void AreaHasStockPilesForFaction::addQuery(StockPile& stockPile, const ItemQuery
 {
 	stockPile.addQuery(query);
 	assert(query.m_itemType.exists());
-	m_availableStockPilesByItemType.getOrCreate(query.m_itemType).insert(&stockPile);
+	m_availableStockPilesByItemType[query.m_itemType].insert(&stockPile);
 }
 void AreaHasStockPilesForFaction::removeQuery(StockPile& stockPile, const ItemQuery& query)
 {
@@ -552,7 +568,7 @@ void AreaHasStockPilesForFaction::removeQuery(StockPile& stockPile, const ItemQu
 bool AreaHasStockPilesForFaction::isAnyHaulingAvailableFor([[maybe_unused]] const ActorIndex actor) const
 {
 	assert(m_faction == m_area.getActors().getFaction(actor));
-	return !m_itemsToBeStockPiled.empty();
+	return isAnyHaulingAvailable();
 }
 ItemIndex AreaHasStockPilesForFaction::getHaulableItemForAt(const ActorIndex actor, const Point3D point)
 {
@@ -574,9 +590,10 @@ ItemIndex AreaHasStockPilesForFaction::getHaulableItemForAt(const ActorIndex act
 StockPile* AreaHasStockPilesForFaction::getStockPileFor(const ItemIndex item) const
 {
 	ItemTypeId itemType = m_area.getItems().getItemType(item);
-	if(!m_availableStockPilesByItemType.contains(itemType))
+	auto found = m_availableStockPilesByItemType.find(itemType);
+	if(found == m_availableStockPilesByItemType.end())
 		return nullptr;
-	for(StockPile* stockPile : m_availableStockPilesByItemType[itemType])
+	for(StockPile* stockPile : found->second)
 		if(stockPile->accepts(item))
 			return stockPile;
 	return nullptr;
@@ -16,6 +16,8 @@
 #include <utility>
 #include <tuple>
 #include <list>
+#include <unordered_map>
+#include <unordered_set>
 
 class StockPilePathRequest;
 class StockPileProject;
@@ -105,17 +107,20 @@ struct StockPileHasShapeDishonorCallback final : public DishonorCallback
 };
 class AreaHasStockPilesForFaction
 {
+	using ItemReferenceSet = std::unordered_set<ItemReference, ItemReference::Hash>;
+	// Item sets are hashed because they may hold thousands of loose items, for example after a battle or while mining.
 	// Stockpiles may accept multiple item types and thus may appear here more then once.
-	SmallMap<ItemTypeId, SmallSet<StockPile*>> m_availableStockPilesByItemType;
+	std::unordered_map<ItemTypeId, SmallSet<StockPile*>, ItemTypeId::Hash> m_availableStockPilesByItemType;
 	// These items are checked whenever a new stockpile is created to see if they should be move to items with destinations.
-	SmallMap<ItemTypeId, SmallSet<ItemReference>> m_itemsWithoutDestinationsByItemType;
+	std::unordered_map<ItemTypeId, ItemReferenceSet, ItemTypeId::Hash> m_itemsWithoutDestinationsByItemType;
 	// Only when an item is added here does it get designated for stockpiling.
-	SmallSet<ItemReference> m_itemsToBeStockPiled;
-	//TODO: Replace these SmallMaps with medium maps?
+	ItemReferenceSet m_itemsToBeStockPiled;
 	// The stockpile used as index here is not neccesarily where the item will go, it is used to prove that there is somewhere the item could go.
-	SmallMap<StockPile*, SmallSet<ItemReference>> m_itemsWithDestinationsByStockPile;
+	std::unordered_map<StockPile*, ItemReferenceSet> m_itemsWithDestinationsByStockPile;
+	// The inverse of m_itemsWithDestinationsByStockPile, so an item can be removed without searching every stockpile.
+	std::unordered_map<ItemReference, StockPile*, ItemReference::Hash> m_destinationByItem;
 	// Multiple projects per item due to generic item stacking.
-	SmallMap<ItemReference, SmallSet<StockPileProject*>> m_projectsByItem;
+	std::unordered_map<ItemReference, SmallSet<StockPileProject*>, ItemReference::Hash> m_projectsByItem;
 	std::list<StockPileProject> m_projects;
 	std::list<StockPile> m_stockPiles;
 	Area& m_area;
@@ -123,6 +128,9 @@ class AreaHasStockPilesForFaction
 	// To be called when the last point is removed from the stockpile.
 	// To remove all space call StockPile::destroy.
 	void destroyStockPile(StockPile& stockPile);
+	// Maintain m_itemsWithDestinationsByStockPile and m_destinationByItem together.
+	void recordDestination(StockPile& stockPile, const ItemReference item);
+	void maybeEraseDestination(const ItemReference item);
 public:
 	AreaHasStockPilesForFaction(Area& a, const FactionId f) : m_area(a), m_faction(f) { }
 	AreaHasStockPilesForFaction(const Json& data, DeserializationMemo& deserializationMemo, Area& a, const FactionId f);
@@ -146,6 +154,7 @@ public:
 	void updateItemReferenceForProject(StockPileProject& project, const ItemReference ref);
 	[[nodiscard]] bool isValidStockPileDestinationfor(const Point3D point, const ItemIndex item) const;
 	[[nodiscard]] bool isAnyHaulingAvailableFor(const ActorIndex actor) const;
+	[[nodiscard]] bool isAnyHaulingAvailable() const { return !m_itemsToBeStockPiled.empty(); }
 	[[nodiscard]] ItemIndex getHaulableItemForAt(const ActorIndex actor, const Point3D point);
 	[[nodiscard]] StockPile* getStockPileFor(const ItemIndex item) const;
 	friend class StockPilePathRequest;
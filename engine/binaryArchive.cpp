@@ -0,0 +1,132 @@
+#include "binaryArchive.h"
+#include "config/config.h"
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+BinaryArchiveWriter::BinaryArchiveWriter(const std::filesystem::path& path, const uint32_t magic) :
+	m_path(path),
+	m_stream(path, std::ios::binary | std::ios::trunc)
+{
+	if(!m_stream.is_open())
+		throw BinaryArchiveError(m_path, "cannot open for writing");
+	write(magic);
+	write(binaryArchive::version);
+	write<uint32_t>(Config::rtreeNodeSize);
+}
+void BinaryArchiveWriter::writeBytes(const void* data, const std::size_t size)
+{
+	m_stream.write(static_cast<const char*>(data), size);
+}
+void BinaryArchiveWriter::writeJson(const Json& data)
+{
+	const std::vector<uint8_t> bytes = Json::to_cbor(data);
+	writeBlock(bytes.data(), bytes.size());
+}
+std::size_t BinaryArchiveWriter::close()
+{
+	m_stream.flush();
+	if(!m_stream)
+		throw BinaryArchiveError(m_path, "write failed");
+	const std::size_t output = m_stream.tellp();
+	m_stream.close();
+	if(!m_stream)
+		throw BinaryArchiveError(m_path, "close failed");
+	return output;
+}
+BinaryArchiveReader::BinaryArchiveReader(const std::filesystem::path& path, const uint32_t magic) :
+	m_path(path)
+{
+	m_fileDescriptor = open(path.c_str(), O_RDONLY);
+	if(m_fileDescriptor == -1)
+		fail(std::string("cannot open: ") + std::strerror(errno));
+	struct stat status;
+	if(fstat(m_fileDescriptor, &status) != 0)
+	{
+		const int error = errno;
+		close(m_fileDescriptor);
+		fail(std::string("cannot stat: ") + std::strerror(error));
+	}
+	m_size = status.st_size;
+	// mmap rejects a zero length, an empty file fails the header check below instead.
+	if(m_size != 0)
+	{
+		void* mapped = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+		if(mapped == MAP_FAILED)
+		{
+			const int error = errno;
+			close(m_fileDescriptor);
+			fail(std::string("cannot map: ") + std::strerror(error));
+		}
+		m_data = static_cast<const std::byte*>(mapped);
+		// Most of the file is read once from front to back.
+		madvise(mapped, m_size, MADV_SEQUENTIAL);
+	}
+	// The destructor does not run if the constructor throws, so header failures release the mapping here.
+	const auto failHeader = [&](const std::string& message)
+	{
+		if(m_data != nullptr)
+			munmap(const_cast<std::byte*>(m_data), m_size);
+		close(m_fileDescriptor);
+		fail(message);
+	};
+	if(m_size < sizeof(uint32_t) * 3)
+		failHeader("truncated header");
+	const uint32_t fileMagic = read<uint32_t>();
+	if(fileMagic != magic)
+		failHeader("wrong magic number " + std::to_string(fileMagic) + ", expected " + std::to_string(magic));
+	const uint32_t fileVersion = read<uint32_t>();
+	if(fileVersion != binaryArchive::version)
+		failHeader("version " + std::to_string(fileVersion) + " is not supported, expected " + std::to_string(binaryArchive::version));
+	const uint32_t fileRTreeNodeSize = read<uint32_t>();
+	if(fileRTreeNodeSize != Config::rtreeNodeSize)
+		failHeader("written with rtreeNodeSize " + std::to_string(fileRTreeNodeSize) + ", this build uses " + std::to_string(Config::rtreeNodeSize));
+}
+BinaryArchiveReader::~BinaryArchiveReader()
+{
+	if(m_data != nullptr)
+		munmap(const_cast<std::byte*>(m_data), m_size);
+	close(m_fileDescriptor);
+}
+void BinaryArchiveReader::readBytes(void* destination, const std::size_t size)
+{
+	checkRemaining(size, 1);
+	std::memcpy(destination, m_data + m_position, size);
+	m_position += size;
+}
+std::size_t BinaryArchiveReader::readBlockCount() { return read<uint64_t>(); }
+void BinaryArchiveReader::skipBlock()
+{
+	const std::size_t count = readBlockCount();
+	const uint32_t elementSize = read<uint32_t>();
+	checkRemaining(count, elementSize);
+	m_position += count * elementSize;
+}
+Json BinaryArchiveReader::readJson()
+{
+	const std::size_t size = readBlockCount();
+	checkElementSize(read<uint32_t>(), 1);
+	checkRemaining(size, 1);
+	const uint8_t* begin = reinterpret_cast<const uint8_t*>(m_data + m_position);
+	m_position += size;
+	// Parsed directly from the mapping, without copying into a buffer first.
+	Json output = Json::from_cbor(begin, begin + size, true, false);
+	if(output.is_discarded())
+		fail("invalid CBOR");
+	return output;
+}
+void BinaryArchiveReader::checkElementSize(const uint32_t elementSize, const std::size_t expected) const
+{
+	if(elementSize != expected)
+		fail("block element size " + std::to_string(elementSize) + ", expected " + std::to_string(expected));
+}
+void BinaryArchiveReader::checkRemaining(const std::size_t count, const std::size_t elementSize) const
+{
+	const std::size_t remaining = m_size - m_position;
+	if(elementSize != 0 && count > remaining / elementSize)
+		fail("truncated at byte " + std::to_string(m_position));
+}
+void BinaryArchiveReader::fail(const std::string& message) const { throw BinaryArchiveError(m_path, message); }
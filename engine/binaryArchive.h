@@ -0,0 +1,117 @@
+/*
+	Versioned binary save files.
+	A file starts with a header holding a magic number identifying what it contains and binaryArchive::version, readers check that both match.
+	Files come from disk and may be truncated or from another build, so unlike most of the engine failures are checked at runtime and reported by throwing BinaryArchiveError rather then asserted.
+	Plain data such as R-tree node arrays is written as raw blocks and copied straight out of the mapped file when loading. Everything else is written as length prefixed CBOR, which is much smaller and faster to parse then text JSON.
+	Blocks are only valid on the architecture and build configuration which wrote them, the header records Config::rtreeNodeSize which is also checked.
+*/
+#pragma once
+#include "json.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace binaryArchive
+{
+	constexpr uint32_t version = 2;
+	constexpr uint32_t areaMagic = 0x41524541; // AREA
+	constexpr uint32_t areaDeltaMagic = 0x41444C54; // ADLT
+}
+class BinaryArchiveError final : public std::runtime_error
+{
+public:
+	BinaryArchiveError(const std::filesystem::path& path, const std::string& message) : std::runtime_error(path.string() + ": " + message) { }
+};
+class BinaryArchiveWriter
+{
+	std::filesystem::path m_path;
+	std::ofstream m_stream;
+public:
+	// Throws BinaryArchiveError if the file cannot be created.
+	BinaryArchiveWriter(const std::filesystem::path& path, const uint32_t magic);
+	void writeBytes(const void* data, const std::size_t size);
+	template<typename T>
+	void write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		writeBytes(&value, sizeof(T));
+	}
+	// Contained must be safe to copy bytewise. The element size is recorded and checked on read.
+	template<typename Contained>
+	void writeBlock(const Contained* data, const std::size_t count)
+	{
+		static_assert(std::is_trivially_copyable_v<Contained>);
+		write<uint64_t>(count);
+		write<uint32_t>(sizeof(Contained));
+		writeBytes(data, count * sizeof(Contained));
+	}
+	void writeJson(const Json& data);
+	// Returns the number of bytes written. Write errors are sticky, they are checked here and reported by throwing BinaryArchiveError.
+	[[nodiscard]] std::size_t close();
+};
+class BinaryArchiveReader
+{
+	std::filesystem::path m_path;
+	const std::byte* m_data = nullptr;
+	std::size_t m_size = 0;
+	std::size_t m_position = 0;
+	int m_fileDescriptor = -1;
+public:
+	// Maps the file read only. Throws BinaryArchiveError if it cannot be mapped or the header does not match.
+	BinaryArchiveReader(const std::filesystem::path& path, const uint32_t magic);
+	BinaryArchiveReader(const BinaryArchiveReader&) = delete;
+	~BinaryArchiveReader();
+	// Throws BinaryArchiveError if fewer then size bytes remain.
+	void readBytes(void* destination, const std::size_t size);
+	template<typename T>
+	[[nodiscard]] T read()
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		T output;
+		readBytes(&output, sizeof(T));
+		return output;
+	}
+	// Reads the header written by writeBlock and checks that it's elements are Contained and that they all remain, so the count is safe to size a destination with. Returns the count.
+	template<typename Contained>
+	[[nodiscard]] std::size_t readBlockHeader()
+	{
+		static_assert(std::is_trivially_copyable_v<Contained>);
+		const std::size_t count = readBlockCount();
+		checkElementSize(read<uint32_t>(), sizeof(Contained));
+		checkRemaining(count, sizeof(Contained));
+		return count;
+	}
+	// Count must come from readBlockHeader.
+	template<typename Contained>
+	void readBlockInto(Contained* destination, const std::size_t count)
+	{
+		static_assert(std::is_trivially_copyable_v<Contained>);
+		if(count != 0)
+			readBytes(destination, count * sizeof(Contained));
+	}
+	template<typename Contained>
+	void readBlock(std::vector<Contained>& destination)
+	{
+		const std::size_t count = readBlockHeader<Contained>();
+		destination.resize(count);
+		readBlockInto(destination.data(), count);
+	}
+	[[nodiscard]] Json readJson();
+	// Skips a block or json written by writeBlock or writeJson without reading it.
+	void skipBlock();
+	[[nodiscard]] bool atEnd() const { return m_position == m_size; }
+	// Throw BinaryArchiveError, used by the templates above.
+	void checkElementSize(const uint32_t elementSize, const std::size_t expected) const;
+	// Checks that count elements of elementSize remain without overflowing.
+	void checkRemaining(const std::size_t count, const std::size_t elementSize) const;
+	[[noreturn]] void fail(const std::string& message) const;
+private:
+	// Unchecked, use readBlockHeader.
+	[[nodiscard]] std::size_t readBlockCount();
+};
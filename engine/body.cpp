@@ -23,10 +23,10 @@ Wound::Wound(Area& area, const ActorIndex a, const WoundType wt, BodyPart& bp, H
 	maxPercentTemporaryImpairment = WoundCalculations::getPercentTemporaryImpairment(hit, bodyPart.bodyPartType, scale);
 	maxPercentPermanantImpairment = WoundCalculations::getPercentPermanentImpairment(hit, bodyPart.bodyPartType, scale);
 }
-Wound::Wound(const Json& data, DeserializationMemo& deserializationMemo, BodyPart& bp) :
+Wound::Wound(const Json& data, Area& area, BodyPart& bp) :
 	woundType(woundTypeByName(data["woundType"].get<std::string>())),
 	bodyPart(bp), hit(data["hit"]), bleedVolumeRate(data["bleedVolumeRate"].get<int>()),
-	percentHealed(data["percentHealed"].get<Percent>()), healEvent(deserializationMemo.m_simulation.m_eventSchedule) { }
+	percentHealed(data["percentHealed"].get<Percent>()), healEvent(area.m_eventSchedule) { }
 Json Wound::toJson() const
 {
 	Json data;
@@ -47,13 +47,13 @@ Percent Wound::impairPercent() const
 {
 	return Percent::create(util::scaleByInversePercent(maxPercentTemporaryImpairment.get(), getPercentHealed())) + maxPercentPermanantImpairment;
 }
-BodyPart::BodyPart(const Json data, DeserializationMemo& deserializationMemo) :
+BodyPart::BodyPart(const Json data, Area& area) :
 	bodyPartType(BodyPartType::byName(data["bodyPartType"].get<std::string>())),
 	materialType(MaterialType::byName(data["materialType"].get<std::string>())),
 	severed(data["severed"].get<bool>())
 {
 	for(const Json& wound : data["wounds"])
-		wounds.emplace_back(wound, deserializationMemo, *this);
+		wounds.emplace_back(wound, area, *this);
 }
 Json BodyPart::toJson() const
 {
@@ -78,9 +78,9 @@ void Body::initialize(Area& area)
 	}
 	m_volumeOfBlood = healthyBloodVolume();
 }
-Body::Body(const Json& data, DeserializationMemo& deserializationMemo, const ActorIndex a) :
-	m_bleedEvent(deserializationMemo.m_simulation.m_eventSchedule),
-	m_woundsCloseEvent(deserializationMemo.m_simulation.m_eventSchedule),
+Body::Body(const Json& data, DeserializationMemo& deserializationMemo, Area& area, const ActorIndex a) :
+	m_bleedEvent(area.m_eventSchedule),
+	m_woundsCloseEvent(area.m_eventSchedule),
 	m_actor(a),
 	m_solid(MaterialType::byName(data["materialType"].get<std::string>())),
 	m_totalVolume(data["totalVolume"].get<FullDisplacement>()),
@@ -91,7 +91,7 @@ Body::Body(const Json& data, DeserializationMemo& deserializationMemo, const Act
 	m_isBleeding(data["isBleeding"].get<bool>())
 {
 	for(const Json& bodyPart : data["bodyParts"])
-		m_bodyParts.emplace_back(bodyPart, deserializationMemo);
+		m_bodyParts.emplace_back(bodyPart, area);
 	if(data.contains("woundsCloseEventStart"))
 		m_woundsCloseEvent.schedule(deserializationMemo.m_simulation, data["woundsCloseEventDuration"].get<Step>(), *this, data["woundsCloseEventStart"].get<Step>());
 	if(data.contains("bleedEventStart"))
@@ -125,9 +125,9 @@ Json Body::toJson() const
 		data["bodyParts"].push_back(bodyPart.toJson());
 	return data;
 }
-BodyPart& Body::pickABodyPartByVolume(Simulation& simulation)
+BodyPart& Body::pickABodyPartByVolume(Area& area)
 {
-	Random& random = simulation.m_random;
+	Random& random = area.m_random;
 	int roll = random.getInRange(0, m_totalVolume.get());
 	for(BodyPart& bodyPart : m_bodyParts)
 	{
@@ -30,7 +30,7 @@ struct Wound final
 	Percent maxPercentPermanantImpairment;
 	HasScheduledEvent<WoundHealEvent> healEvent;
 	Wound(Area& area, const ActorIndex a, const WoundType wt, BodyPart& bp, Hit h, const int bvr, const Percent ph = Percent::create(0));
-	Wound(const Json& data, DeserializationMemo& deserializationMemo, BodyPart& bp);
+	Wound(const Json& data, Area& area, BodyPart& bp);
 	bool operator==(const Wound& other) const { return &other == this; }
 	Percent getPercentHealed() const;
 	Percent impairPercent() const;
@@ -43,7 +43,7 @@ struct BodyPart final
 	std::list<Wound> wounds;
 	bool severed;
 	BodyPart(const BodyPartTypeId bpt, const MaterialTypeId mt) : bodyPartType(bpt), materialType(mt), severed(false) {}
-	BodyPart(const Json data, DeserializationMemo& deserializationMemo);
+	BodyPart(const Json data, Area& area);
 	[[nodiscard]] Json toJson() const;
 };
 /*
@@ -65,9 +65,9 @@ class Body final
 public:
 	std::list<BodyPart> m_bodyParts;
 	Body(Area& area, const ActorIndex a);
-	Body(const Json& data, DeserializationMemo& deserializationMemo, const ActorIndex a);
+	Body(const Json& data, DeserializationMemo& deserializationMemo, Area& area, const ActorIndex a);
 	void initialize(Area& area);
-	BodyPart& pickABodyPartByVolume(Simulation& simulation);
+	BodyPart& pickABodyPartByVolume(Area& area);
 	BodyPart& pickABodyPartByType(const BodyPartTypeId bodyPartType);
 	// Armor has already been applied, calculate hit depth.
 	void getHitDepth(Hit& hit, const BodyPart& bodyPart);
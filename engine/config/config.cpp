@@ -26,6 +26,7 @@ void Config::load()
 	data["attackCoolDownDurationBaseDextarity"].get_to(attackCoolDownDurationBaseDextarity);
 	attackCoolDownDurationBaseSteps = Step::create(data["attackCoolDownDurationBaseSeconds"].get<float>() * stepsPerSecond.get());
 	data["attackSkillCombatModifier"].get_to(attackSkillCombatModifier);
+	data["autosaveDeltasBetweenFullSaves"].get_to(autosaveDeltasBetweenFullSaves);
 	data["averageItemQuality"].get_to(averageItemQuality);
 	data["averageLandHeight"].get_to(averageLandHeight);
 	data["averageNumberOfRiversPerCandidate"].get_to(averageNumberOfRiversPerCandidate);
@@ -181,6 +182,7 @@ void Config::load()
 	data["piercePercentTemporaryImparmentModifier"].get_to(piercePercentTemporaryImparmentModifier);
 	data["pierceSkinModifier"].get_to(pierceSkinModifier);
 	data["pierceStepsTillHealedModifier"].get_to(pierceStepsTillHealedModifier);
+	plantCohortInterval = Step::create(data["plantCohortIntervalMinutes"].get<float>() * stepsPerMinute.get());
 	data["plantSortEntropyThreashold"].get_to(plantSortEntropyThreashold);
 	data["pointsOfCombatScorePerUnitOfAgility"].get_to(pointsOfCombatScorePerUnitOfAgility);
 	data["pointsOfCombatScorePerUnitOfDextarity"].get_to(pointsOfCombatScorePerUnitOfDextarity);
@@ -206,6 +208,9 @@ void Config::load()
 	data["rollingMassModifier"].get_to(rollingMassModifier);
 	data["floatingMassModifier"].get_to(floatingMassModifier);
 	data["rowForcePerUnitStrength"].get_to(rowForcePerUnitStrength);
+	data["rtreeCombBudget"].get_to(rtreeCombBudget);
+	data["rtreeDefragmentBudget"].get_to(rtreeDefragmentBudget);
+	data["rtreeUnsortedFractionToSort"].get_to(rtreeUnsortedFractionToSort);
 	data["scaleOfHumanBody"].get_to(scaleOfHumanBody);
 	data["skinPierceForceCost"].get_to(skinPierceForceCost);
 	data["skillPointsToAddWhenChastised"].get_to(skillPointsToAddWhenChastised);
@@ -216,6 +221,8 @@ void Config::load()
 	sowSeedsStepsDuration = Step::create(data["sowSeedsStepsDurationSeconds"].get<float>() * stepsPerSecond.get());
 	data["staminaPointsPerRestPeriod"].get_to(staminaPointsPerRestPeriod);
 	data["stationPriority"].get_to(stationPriority);
+	data["stepAreasConcurrently"].get_to(stepAreasConcurrently);
+	stepsFrequencyToAutosave = Step::create(data["minutesFrequencyToAutosave"].get<float>() * stepsPerMinute.get());
 	stepsFrequencyToLookForHaulSubprojects = Step::create(data["secondsFrequencyToLookForHaulSubprojects"].get<float>() * stepsPerSecond.get());
 	stepsFrequencyToRunRelationshipEvent = Step::create(data["minutesFrequencyToRunRelationshipEvent"].get<float>() * stepsPerMinute.get());
 	stepsTillDiePlantPriorityOveride = Step::create(data["hoursTillDiePlantPriorityOveride"].get<int>() * stepsPerHour.get());
@@ -227,6 +234,7 @@ void Config::load()
 	stepsToEat = Step::create(data["secondsToEat"].get<float>() * stepsPerSecond.get());
 	data["stockPilePriority"].get_to(stockPilePriority);
 	data["targetedHaulPriority"].get_to(targetedHaulPriority);
+	data["temperatureTileSize"].get_to(temperatureTileSize);
 	data["threadedTaskBatchSize"].get_to(threadedTaskBatchSize);
 	data["unarmedCombatScoreBase"].get_to(unarmedCombatScoreBase);
 	data["unarmedCombatSkillModifier"].get_to(unarmedCombatSkillModifier);
@@ -12,16 +12,25 @@ namespace Config
 	// sort command for vim:
 	// 	sort /\t/w* /w* /w* /
 	inline constexpr int actorDoVisionInterval = 3;
+	inline constexpr int adaptiveContainerIndexThreshold = 32;
 	inline constexpr int bytesPerCacheLine = 64;
 	inline constexpr bool fluidPiston = false;
 	inline constexpr float dataStoreVectorResizeFactor = 1.5;
 	inline constexpr float dataStoreVectorinitialSize = 10;
+	inline constexpr int eventScheduleWheelBits = 10;
 	inline constexpr float goldenRatio = 1.61834f;
+	// See IdRegistry.
+	inline constexpr int idsPerBlock = 16384;
+	inline constexpr int idsReservedBeforeConcurrentStep = 1024;
 	inline constexpr int maxActorsPerPoint = 4;
+	inline constexpr int maxCachedRoutesPerMoveType = 256;
 	inline constexpr int maxItemsPerPoint = 4;
 	inline constexpr Distance maxDepthExteriorPortalPenetration = Distance::create(6);
+	inline constexpr int objectPoolChunkBytes = 16384;
+	inline constexpr int objectPoolLargestSize = 512;
 	inline constexpr int rtreeNodeSize = {64};
 	inline constexpr std::size_t soldiersPerMoraleCheckThread = 64;
+	inline constexpr int stepProfilerHistory = 256;
 	inline constexpr bool validateFluidTotals = false;
 
 	// sort command for vim:
@@ -33,6 +42,7 @@ namespace Config
 	inline int attackCoolDownDurationBaseDextarity;
 	inline Step attackCoolDownDurationBaseSteps;
 	inline float attackSkillCombatModifier;
+	inline int autosaveDeltasBetweenFullSaves;
 	inline Quality averageItemQuality;
 	inline size_t averageLandHeight;
 	inline float averageNumberOfRiversPerCandidate;
@@ -190,6 +200,8 @@ namespace Config
 	inline int piercePercentTemporaryImparmentModifier;
 	inline float pierceSkinModifier;
 	inline int pierceStepsTillHealedModifier;
+	// Plant growth and fluid checks are rounded up to a multiple of this so the cohort pass in Plants::doStep runs at most once per interval.
+	inline Step plantCohortInterval;
 	inline int plantSortEntropyThreashold;
 	inline float pointsOfCombatScorePerUnitOfAgility;
 	inline float pointsOfCombatScorePerUnitOfDextarity;
@@ -215,6 +227,9 @@ namespace Config
 	inline float rollingMassModifier;
 	inline float floatingMassModifier;
 	inline float rowForcePerUnitStrength;
+	inline int rtreeCombBudget;
+	inline int rtreeDefragmentBudget;
+	inline float rtreeUnsortedFractionToSort;
 	inline int scaleOfHumanBody;
 	inline int secondsPerMinute;
 	inline float skinPierceForceCost;
@@ -226,6 +241,8 @@ namespace Config
 	inline Step sowSeedsStepsDuration;
 	inline int staminaPointsPerRestPeriod;
 	inline Priority stationPriority;
+	inline bool stepAreasConcurrently;
+	inline Step stepsFrequencyToAutosave;
 	inline Step stepsFrequencyToLookForHaulSubprojects;
 	inline Step stepsFrequencyToRunRelationshipEvent;
 	inline Step stepsPerDay;
@@ -243,6 +260,7 @@ namespace Config
 	inline Step stepsToEat;
 	inline Priority stockPilePriority;
 	inline Priority targetedHaulPriority;
+	inline int temperatureTileSize;
 	inline int threadedTaskBatchSize;
 	inline int unarmedCombatScoreBase;
 	inline float unarmedCombatSkillModifier;
@@ -0,0 +1,133 @@
+#pragma once
+/*
+ * Shared parts of AdaptiveSet and AdaptiveMap.
+ * AdaptiveIndex is an open addressing hash from keys to their position in a vector owned by the container.
+ * Linear probing with backward shift deletion, so there are no tombstones to clean up.
+ * The index does not store keys, it reads them from the owning vector through the keyAt callback.
+ */
+#include "../config/config.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+// Counts how many times an instance reached a size, in power of two buckets: 1, 2-3, 4-7, ... , 512 and up.
+// Recorded on insert, so it shows how large an instance gets rather then how large it usually is.
+class AdaptiveSizeHistogram
+{
+	static constexpr int bucketCount = 10;
+	std::array<uint32_t, bucketCount> m_data = {};
+public:
+	void record(const int size)
+	{
+		assert(size != 0);
+		const int bucket = std::min((int)std::bit_width((uint32_t)size) - 1, bucketCount - 1);
+		++m_data[bucket];
+	}
+	void clear() { m_data = {}; }
+	// Bucket n counts sizes from 2^n to 2^(n+1) - 1, the last bucket has no upper bound.
+	[[nodiscard]] const std::array<uint32_t, bucketCount>& get() const { return m_data; }
+	[[nodiscard]] static int getBucketCount() { return bucketCount; }
+};
+template<typename Key, typename Hash>
+class AdaptiveIndex
+{
+	// Position + 1 in the owning vector, 0 is empty.
+	std::vector<int> m_slots;
+	int m_shift = 64;
+	int m_count = 0;
+	[[nodiscard]] int home(const Key& key) const
+	{
+		// Fibonacci hashing spreads keys whose hash is a sequential index.
+		return ((uint64_t)Hash{}(key) * 11400714819323198485ull) >> m_shift;
+	}
+	[[nodiscard]] int mask() const { return m_slots.size() - 1; }
+	void insertWithoutGrowing(const Key& key, const int position)
+	{
+		int slot = home(key);
+		while(m_slots[slot] != 0)
+			slot = (slot + 1) & mask();
+		m_slots[slot] = position + 1;
+		++m_count;
+	}
+	[[nodiscard]] int findSlot(const Key& key, const auto& keyAt) const
+	{
+		int slot = home(key);
+		while(m_slots[slot] != 0)
+		{
+			if(keyAt(m_slots[slot] - 1) == key)
+				return slot;
+			slot = (slot + 1) & mask();
+		}
+		return -1;
+	}
+public:
+	// Builds from positions 0 through size - 1, with room to grow to twice size before rebuilding.
+	void build(const int size, const auto& keyAt)
+	{
+		const int capacity = std::bit_ceil((uint32_t)std::max(size * 4, Config::adaptiveContainerIndexThreshold * 2));
+		m_slots.assign(capacity, 0);
+		m_shift = 64 - std::countr_zero((uint32_t)capacity);
+		m_count = 0;
+		for(int position = 0; position != size; ++position)
+			insertWithoutGrowing(keyAt(position), position);
+	}
+	void clear()
+	{
+		m_slots = {};
+		m_shift = 64;
+		m_count = 0;
+	}
+	// Called after the entry has been appended to the owning vector at position.
+	void insert(const Key& key, const int position, const auto& keyAt)
+	{
+		assert(!empty());
+		// Keep load factor at or below one half.
+		if((m_count + 1) * 2 > (int)m_slots.size())
+			build(position + 1, keyAt);
+		else
+			insertWithoutGrowing(key, position);
+	}
+	// Must be called before the entry at position is overwritten or popped, neighbouring keys are read to decide what to shift back.
+	void erase(const Key& key, const auto& keyAt)
+	{
+		int slot = findSlot(key, keyAt);
+		assert(slot != -1);
+		int next = slot;
+		while(true)
+		{
+			next = (next + 1) & mask();
+			if(m_slots[next] == 0)
+				break;
+			const int nextHome = home(keyAt(m_slots[next] - 1));
+			// Shift back unless next's home lies cyclically within (slot, next].
+			const bool homeIsBetween = slot <= next ?
+				(slot < nextHome && nextHome <= next) :
+				(slot < nextHome || nextHome <= next);
+			if(!homeIsBetween)
+			{
+				m_slots[slot] = m_slots[next];
+				slot = next;
+			}
+		}
+		m_slots[slot] = 0;
+		--m_count;
+	}
+	// Called when the entry with key is about to be moved to newPosition, such as when the back is moved into an erased position.
+	// Must be called before the move, while keyAt still finds key at its old position.
+	void updatePosition(const Key& key, const int newPosition, const auto& keyAt)
+	{
+		const int slot = findSlot(key, keyAt);
+		assert(slot != -1);
+		m_slots[slot] = newPosition + 1;
+	}
+	[[nodiscard]] int find(const Key& key, const auto& keyAt) const
+	{
+		const int slot = findSlot(key, keyAt);
+		return slot == -1 ? -1 : m_slots[slot] - 1;
+	}
+	[[nodiscard]] bool empty() const { return m_slots.empty(); }
+	[[nodiscard]] int size() const { return m_count; }
+};
@@ -0,0 +1,155 @@
+#pragma once
+/*
+ * A SmallMap which stays a flat vector of pairs while small and builds an AdaptiveIndex on the keys once it reaches Config::adaptiveContainerIndexThreshold.
+ * Iteration order is the order of the vector, erase moves the back into the erased position, same as SmallMap.
+ * Values may be modified in place, keys may not.
+ * Not pointer stable.
+ */
+#include "adaptiveIndex.h"
+#include "../json.h"
+#include "../concepts.h"
+#include <algorithm>
+#include <vector>
+#include <cassert>
+
+template<typename K, MoveConstructible V, typename Hash>
+class AdaptiveMap
+{
+	using This = AdaptiveMap<K, V, Hash>;
+public:
+	using Pair = std::pair<K, V>;
+	using Data = std::vector<Pair>;
+private:
+	Data m_data;
+	AdaptiveIndex<K, Hash> m_index;
+	AdaptiveSizeHistogram m_sizeHistogram;
+	[[nodiscard]] auto keyAt() const { return [this](const int position) -> const K& { return m_data[position].first; }; }
+	void onInsert()
+	{
+		const int size = m_data.size();
+		m_sizeHistogram.record(size);
+		if(!m_index.empty())
+			m_index.insert(m_data.back().first, size - 1, keyAt());
+		else if(size >= Config::adaptiveContainerIndexThreshold)
+			m_index.build(size, keyAt());
+	}
+	void eraseIndex(const int position)
+	{
+		const int last = m_data.size() - 1;
+		if(!m_index.empty())
+		{
+			m_index.erase(m_data[position].first, keyAt());
+			if(position != last)
+				m_index.updatePosition(m_data.back().first, position, keyAt());
+		}
+		if(position != last)
+		{
+			m_data[position].first = m_data.back().first;
+			m_data[position].second = std::move(m_data.back().second);
+		}
+		m_data.pop_back();
+		// Wait until the map is well below the threshold before dropping the index, to avoid rebuilding it over and over while hovering around the threshold.
+		if(!m_index.empty() && size() < Config::adaptiveContainerIndexThreshold / 2)
+			m_index.clear();
+	}
+	[[nodiscard]] int findIndex(const K& key) const
+	{
+		if(!m_index.empty())
+			return m_index.find(key, keyAt());
+		const auto found = std::ranges::find(m_data, key, &Pair::first);
+		return found == m_data.end() ? -1 : std::distance(m_data.begin(), found);
+	}
+public:
+	using iterator = Data::iterator;
+	using const_iterator = Data::const_iterator;
+	AdaptiveMap() = default;
+	AdaptiveMap(const This& other) = default;
+	AdaptiveMap(This&& other) noexcept = default;
+	This& operator=(const This& other) = default;
+	This& operator=(This&& other) noexcept = default;
+	void insert(const K key, V&& value)
+	{
+		assert(!contains(key));
+		m_data.emplace_back(key, std::move(value));
+		onInsert();
+	}
+	void maybeInsert(const K key, V&& value) { if(!contains(key)) insert(key, std::move(value)); }
+	template<typename ...Args>
+	V& emplace(const K key, Args&& ...args)
+	{
+		assert(!contains(key));
+		m_data.emplace_back(key, V{std::forward<Args>(args)...});
+		onInsert();
+		return m_data.back().second;
+	}
+	void erase(const K key)
+	{
+		const int index = findIndex(key);
+		assert(index != -1);
+		eraseIndex(index);
+	}
+	void erase(const iterator iter) { eraseIndex(std::distance(m_data.begin(), iter)); }
+	void maybeErase(const K key)
+	{
+		const int index = findIndex(key);
+		if(index != -1)
+			eraseIndex(index);
+	}
+	void clear()
+	{
+		m_data.clear();
+		m_index.clear();
+	}
+	void reserve(const int size) { m_data.reserve(size); }
+	// Sort by key, same as SmallMap::sort.
+	template<typename Condition>
+	void sort(Condition&& condition) { sortPairs([&](const Pair& a, const Pair& b) { return condition(a.first, b.first); }); }
+	template<typename Condition>
+	void sortByValue(Condition&& condition) { sortPairs([&](const Pair& a, const Pair& b) { return condition(a.second, b.second); }); }
+	template<typename Condition>
+	void sortPairs(Condition&& condition)
+	{
+		std::ranges::sort(m_data, condition);
+		if(!m_index.empty())
+			m_index.build(size(), keyAt());
+	}
+	[[nodiscard]] int size() const { return m_data.size(); }
+	[[nodiscard]] bool empty() const { return m_data.empty(); }
+	[[nodiscard]] bool contains(const K key) const { return findIndex(key) != -1; }
+	[[nodiscard]] bool isIndexed() const { return !m_index.empty(); }
+	[[nodiscard]] const Pair& front() const { return m_data.front(); }
+	[[nodiscard]] const Pair& back() const { return m_data.back(); }
+	[[nodiscard]] V& operator[](const K key)
+	{
+		const int index = findIndex(key);
+		assert(index != -1);
+		return m_data[index].second;
+	}
+	[[nodiscard]] const V& operator[](const K key) const { return const_cast<This&>(*this)[key]; }
+	[[nodiscard]] V& getOrCreate(const K key)
+	{
+		const int index = findIndex(key);
+		if(index == -1)
+			return emplace(key);
+		return m_data[index].second;
+	}
+	// For iterating by position, such as when splitting the map into segments for threads.
+	[[nodiscard]] V& getValueAtIndex(const int index) { return m_data[index].second; }
+	[[nodiscard]] const V& getValueAtIndex(const int index) const { return m_data[index].second; }
+	[[nodiscard]] iterator find(const K key)
+	{
+		const int index = findIndex(key);
+		return index == -1 ? m_data.end() : m_data.begin() + index;
+	}
+	[[nodiscard]] const_iterator find(const K key) const { return const_cast<This&>(*this).find(key); }
+	template<typename Condition>
+	[[nodiscard]] iterator findIf(Condition&& condition) { return std::ranges::find_if(m_data, condition); }
+	template<typename Condition>
+	[[nodiscard]] const_iterator findIf(Condition&& condition) const { return std::ranges::find_if(m_data, condition); }
+	// Keys must not be changed through these.
+	[[nodiscard]] iterator begin() { return m_data.begin(); }
+	[[nodiscard]] iterator end() { return m_data.end(); }
+	[[nodiscard]] const_iterator begin() const { return m_data.begin(); }
+	[[nodiscard]] const_iterator end() const { return m_data.end(); }
+	[[nodiscard]] const AdaptiveSizeHistogram& getSizeHistogram() const { return m_sizeHistogram; }
+};
@@ -0,0 +1,179 @@
+#pragma once
+/*
+ * A SmallSet which stays a flat vector while small and builds an AdaptiveIndex once it reaches Config::adaptiveContainerIndexThreshold.
+ * To be used for sets which are usually small but can grow large, such as the actors which one actor can see when a crowd gathers.
+ * Iteration order is the order of the vector, erase moves the back into the erased position, same as SmallSet.
+ * Values may not be modified in place because the index would not know, there are no non const iterators.
+ * Not pointer stable.
+ */
+#include "adaptiveIndex.h"
+#include "smallSet.h"
+#include "../json.h"
+#include <algorithm>
+#include <vector>
+#include <cassert>
+
+template<typename T, typename Hash>
+class AdaptiveSet
+{
+	using This = AdaptiveSet<T, Hash>;
+	std::vector<T> m_data;
+	AdaptiveIndex<T, Hash> m_index;
+	AdaptiveSizeHistogram m_sizeHistogram;
+	[[nodiscard]] auto keyAt() const { return [this](const int position) -> const T& { return m_data[position]; }; }
+	void onInsert()
+	{
+		const int size = m_data.size();
+		m_sizeHistogram.record(size);
+		if(!m_index.empty())
+			m_index.insert(m_data.back(), size - 1, keyAt());
+		else if(size >= Config::adaptiveContainerIndexThreshold)
+			m_index.build(size, keyAt());
+	}
+	void maybeBuildOrClearIndex()
+	{
+		if(size() >= Config::adaptiveContainerIndexThreshold)
+			m_index.build(size(), keyAt());
+		else
+			m_index.clear();
+	}
+	void eraseIndex(const int position)
+	{
+		const int last = m_data.size() - 1;
+		if(!m_index.empty())
+		{
+			m_index.erase(m_data[position], keyAt());
+			if(position != last)
+				m_index.updatePosition(m_data.back(), position, keyAt());
+		}
+		if(position != last)
+			m_data[position] = std::move(m_data.back());
+		m_data.pop_back();
+		// Wait until the set is well below the threshold before dropping the index, to avoid rebuilding it over and over while hovering around the threshold.
+		if(!m_index.empty() && size() < Config::adaptiveContainerIndexThreshold / 2)
+			m_index.clear();
+	}
+	[[nodiscard]] int findIndex(const T& value) const
+	{
+		if(!m_index.empty())
+			return m_index.find(value, keyAt());
+		const auto found = std::ranges::find(m_data, value);
+		return found == m_data.end() ? -1 : std::distance(m_data.begin(), found);
+	}
+public:
+	using const_iterator = std::vector<T>::const_iterator;
+	AdaptiveSet() = default;
+	AdaptiveSet(std::initializer_list<T> i) { for(const T& value : i) insert(value); }
+	AdaptiveSet(const This& other) = default;
+	AdaptiveSet(This&& other) noexcept = default;
+	This& operator=(const This& other) = default;
+	This& operator=(This&& other) noexcept = default;
+	[[nodiscard]] Json toJson() const { return m_data; }
+	void fromJson(const Json& data)
+	{
+		for(const Json& valueData : data)
+			insert(T(valueData));
+	}
+	void insert(const T& value)
+	{
+		assert(!contains(value));
+		m_data.push_back(value);
+		onInsert();
+	}
+	void maybeInsert(const T& value)
+	{
+		if(!contains(value))
+		{
+			m_data.push_back(value);
+			onInsert();
+		}
+	}
+	void maybeInsertAll(const auto& source) { for(const T& value : source) maybeInsert(value); }
+	// Replaces the contents with a set which is known to be unique, such as one produced by SmallSet::makeUnique.
+	void assign(SmallSet<T>&& values)
+	{
+		assert(values.isUnique());
+		m_data = std::move(values.getVector());
+		if(!m_data.empty())
+			m_sizeHistogram.record(size());
+		maybeBuildOrClearIndex();
+	}
+	void erase(const T& value)
+	{
+		const int index = findIndex(value);
+		assert(index != -1);
+		eraseIndex(index);
+	}
+	void maybeErase(const T& value)
+	{
+		const int index = findIndex(value);
+		if(index != -1)
+			eraseIndex(index);
+	}
+	void erase(const_iterator iter) { eraseIndex(std::distance(m_data.cbegin(), iter)); }
+	template<typename Predicate>
+	void eraseIf(Predicate&& predicate)
+	{
+		std::erase_if(m_data, predicate);
+		maybeBuildOrClearIndex();
+	}
+	void clear()
+	{
+		m_data.clear();
+		m_index.clear();
+	}
+	void reserve(const int size) { m_data.reserve(size); }
+	template<typename Predicate>
+	void sort(Predicate&& predicate)
+	{
+		std::ranges::sort(m_data, predicate);
+		if(!m_index.empty())
+			m_index.build(size(), keyAt());
+	}
+	void swap(This& other)
+	{
+		m_data.swap(other.m_data);
+		std::swap(m_index, other.m_index);
+		std::swap(m_sizeHistogram, other.m_sizeHistogram);
+	}
+	[[nodiscard]] bool contains(const T& value) const { return findIndex(value) != -1; }
+	[[nodiscard]] const_iterator find(const T& value) const
+	{
+		const int index = findIndex(value);
+		return index == -1 ? m_data.end() : m_data.begin() + index;
+	}
+	template<typename Predicate>
+	[[nodiscard]] const_iterator findIf(Predicate&& predicate) const { return std::ranges::find_if(m_data, predicate); }
+	template<typename Predicate>
+	[[nodiscard]] bool anyOf(Predicate&& predicate) const { return findIf(predicate) != end(); }
+	[[nodiscard]] const T& operator[](const int index) const { return m_data[index]; }
+	[[nodiscard]] const T& front() const { return m_data.front(); }
+	[[nodiscard]] const T& back() const { return m_data.back(); }
+	[[nodiscard]] bool empty() const { return m_data.empty(); }
+	[[nodiscard]] int size() const { return m_data.size(); }
+	[[nodiscard]] bool isIndexed() const { return !m_index.empty(); }
+	[[nodiscard]] const_iterator begin() const { return m_data.begin(); }
+	[[nodiscard]] const_iterator end() const { return m_data.end(); }
+	[[nodiscard]] const std::vector<T>& getVector() const { return m_data; }
+	[[nodiscard]] const AdaptiveSizeHistogram& getSizeHistogram() const { return m_sizeHistogram; }
+	// First set is values to remove, second is values to insert, when transitioning from this to other.
+	// Not const argument because it will be sorted. The first set is in the order of this, the second in sorted order.
+	[[nodiscard]] std::pair<SmallSet<T>, SmallSet<T>> getDeltaPair(SmallSet<T>& other) const
+	{
+		std::pair<SmallSet<T>, SmallSet<T>> output;
+		other.sort();
+		const std::vector<T>& otherData = other.getVector();
+		for(const T& value : m_data)
+			if(!std::ranges::binary_search(otherData, value))
+				output.first.insertNonunique(value);
+		for(const T& value : otherData)
+			if(!contains(value))
+				output.second.insertNonunique(value);
+		return output;
+	}
+	static This create(const auto& source) { This output; for(const T& value : source) output.insert(value); return output; }
+};
+template<typename T, typename Hash>
+inline void to_json(Json& data, const AdaptiveSet<T, Hash>& set) { data = set.toJson(); }
+template<typename T, typename Hash>
+inline void from_json(const Json& data, AdaptiveSet<T, Hash>& set) { set.fromJson(data); }
@@ -0,0 +1,105 @@
+#pragma once
+/*
+ * Maps Simulation wide ids, such as ActorId and ItemId, to where their data is stored.
+ * Ids are handed to each Area in blocks of Config::idsPerBlock. Before Areas are stepped concurrently SimulationHasAreas tops up each Area's block in Area order, so Areas allocate without synchronization and the ids they get do not depend on how their steps interleave.
+ * An Area which uses up its block during a concurrent step takes another under a mutex. Those ids are unique but depend on timing, Config::idsReservedBeforeConcurrentStep is large enough that this should not happen.
+ * Each block of ids has it's own array of locations and the table of blocks is sized once for every possible id, so recording never moves a location and lookups take no lock.
+ * Ids are only recorded by the Area they were allocated to or while loading, so concurrent steps write different locations.
+ * Location must have a store pointer which is null in a default constructed Location.
+ */
+#include "../config/config.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+struct IdBlock
+{
+	int next = 0;
+	int end = 0;
+	[[nodiscard]] int remaining() const { return end - next; }
+};
+
+template<typename Id, typename Location>
+class IdRegistry final
+{
+	static constexpr int blockCount = INT32_MAX / Config::idsPerBlock + 1;
+	std::unique_ptr<std::unique_ptr<Location[]>[]> m_blocks = std::make_unique<std::unique_ptr<Location[]>[]>(blockCount);
+	// Every block before this one has been handed out or holds loaded ids.
+	int m_nextBlock = 0;
+	std::mutex m_reserveMutex;
+	void allocateBlock(const int blockIndex)
+	{
+		if(m_blocks[blockIndex] == nullptr)
+			m_blocks[blockIndex] = std::make_unique<Location[]>(Config::idsPerBlock);
+	}
+	[[nodiscard]] Location& getSlot(const Id id) const
+	{
+		const std::unique_ptr<Location[]>& block = m_blocks[id.get() / Config::idsPerBlock];
+		assert(block != nullptr);
+		return block[id.get() % Config::idsPerBlock];
+	}
+public:
+	IdRegistry() = default;
+	IdRegistry(const IdRegistry&) = delete;
+	// Takes a new block if the current one is used up.
+	[[nodiscard]] Id allocate(IdBlock& block)
+	{
+		if(block.remaining() == 0)
+			reserve(block);
+		return Id::create(block.next++);
+	}
+	// Called between steps, in Area order.
+	void topUp(IdBlock& block)
+	{
+		if(block.remaining() < Config::idsReservedBeforeConcurrentStep)
+			reserve(block);
+	}
+	// Any ids left in block are abandoned.
+	void reserve(IdBlock& block)
+	{
+		std::lock_guard lock(m_reserveMutex);
+		assert(m_nextBlock != blockCount);
+		const int blockIndex = m_nextBlock++;
+		allocateBlock(blockIndex);
+		const int64_t begin = int64_t(blockIndex) * Config::idsPerBlock;
+		// Id 0 is never used and INT32_MAX is null.
+		block.next = std::max<int64_t>(1, begin);
+		block.end = std::min<int64_t>(INT32_MAX, begin + Config::idsPerBlock);
+	}
+	void record(const Id id, const Location& location)
+	{
+		const int blockIndex = id.get() / Config::idsPerBlock;
+		if(m_blocks[blockIndex] == nullptr)
+		{
+			// A loaded id. Loading is not concurrent, but blocks are reserved under the lock.
+			std::lock_guard lock(m_reserveMutex);
+			allocateBlock(blockIndex);
+			m_nextBlock = std::max(m_nextBlock, blockIndex + 1);
+		}
+		Location& slot = getSlot(id);
+		assert(slot.store == nullptr);
+		slot = location;
+	}
+	void remove(const Id id)
+	{
+		Location& slot = getSlot(id);
+		assert(slot.store != nullptr);
+		slot = {};
+	}
+	[[nodiscard]] const Location& get(const Id id) const
+	{
+		const Location& output = getSlot(id);
+		assert(output.store != nullptr);
+		return output;
+	}
+	[[nodiscard]] bool contains(const Id id) const
+	{
+		const std::unique_ptr<Location[]>& block = m_blocks[id.get() / Config::idsPerBlock];
+		return block != nullptr && block[id.get() % Config::idsPerBlock].store != nullptr;
+	}
+	// The highest id which has been reserved, zero if none. Saved so that after loading new blocks start past every id in use.
+	[[nodiscard]] int getLastReserved() const { return m_nextBlock == 0 ? 0 : std::min<int64_t>(INT32_MAX - 1, int64_t(m_nextBlock) * Config::idsPerBlock - 1); }
+	void setLastReserved(const int id) { if(id != 0) m_nextBlock = std::max(m_nextBlock, id / Config::idsPerBlock + 1); }
+};
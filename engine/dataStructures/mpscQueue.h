@@ -0,0 +1,54 @@
+#pragma once
+/*
+ * Unbounded lock free queue for many producer threads and one consumer thread, after Dmitry Vyukov's intrusive MPSC node queue.
+ * push may be called from any thread, tryPop only from the consumer.
+ * Values are popped in the order their pushes exchanged the head, so values pushed by one thread keep their order.
+ * A producer which has exchanged the head but not yet linked its node hides the nodes after it until it finishes, tryPop returns false meanwhile. This is brief and only delays those values, none are lost.
+ * One allocation per push, for low volume traffic between threads such as player commands.
+ */
+#include <atomic>
+#include <cassert>
+#include <utility>
+
+template<typename T>
+class MpscQueue
+{
+	struct Node
+	{
+		std::atomic<Node*> next = nullptr;
+		T value;
+	};
+	// Most recently pushed node, written by producers.
+	alignas(64) std::atomic<Node*> m_head;
+	// Already consumed node whose next is the oldest value, read and written only by the consumer.
+	alignas(64) Node* m_tail;
+public:
+	MpscQueue() : m_head(new Node), m_tail(m_head.load(std::memory_order_relaxed)) { }
+	MpscQueue(const MpscQueue&) = delete;
+	MpscQueue(MpscQueue&&) = delete;
+	~MpscQueue()
+	{
+		T discard;
+		while(tryPop(discard)) { }
+		delete m_tail;
+	}
+	void push(T&& value)
+	{
+		Node* node = new Node;
+		node->value = std::move(value);
+		Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+		previous->next.store(node, std::memory_order_release);
+	}
+	[[nodiscard]] bool tryPop(T& output)
+	{
+		Node* next = m_tail->next.load(std::memory_order_acquire);
+		if(next == nullptr)
+			return false;
+		output = std::move(next->value);
+		delete m_tail;
+		m_tail = next;
+		return true;
+	}
+	// May be stale as soon as it returns if producers are active. Consumer only.
+	[[nodiscard]] bool empty() const { return m_tail->next.load(std::memory_order_acquire) == nullptr; }
+};
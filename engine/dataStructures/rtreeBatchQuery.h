@@ -0,0 +1,102 @@
+/*
+	Node major traversal shared by the batch queries of RTreeData and RTreeBoolean.
+	The tree is walked once for all shapes: each node is visited once, with every shape which intersected it's boundry in the parent, so it's cuboids are loaded once for all of them.
+	Traversal is depth first. Candidate shape indices for each open node are stored contiguously in one vector, the node on top of the stack always owns the end of it and replaces it's own candidates with it's children's.
+*/
+#pragma once
+#include "../numericTypes/index.h"
+#include "bitset.h"
+#include <array>
+#include <cassert>
+#include <numeric>
+#include <vector>
+
+namespace RTreeBatchQuery
+{
+	// Node must provide getCuboids and getLeafCount, getChild(node, arrayIndex) returns the node index stored at arrayIndex.
+	// leafAction(shapeIndex, node, arrayIndex) is called for each intersected leaf, returning true ends the query for that shape.
+	template<int nodeSize>
+	void forEachLeaf(const auto& nodes, const auto& shapes, auto&& getChild, auto&& leafAction)
+	{
+		const int shapeCount = shapes.size();
+		if(shapeCount == 0)
+			return;
+		struct OpenNode
+		{
+			RTreeNodeIndex index;
+			int begin;
+			int end;
+		};
+		std::vector<OpenNode> openList;
+		std::vector<int> candidates(shapeCount);
+		std::iota(candidates.begin(), candidates.end(), 0);
+		std::vector<bool> finished(shapeCount);
+		// Shapes which intersect children of the current node, with the children they intersect.
+		std::vector<std::pair<int, BitSet64>> childHits;
+		std::array<int, nodeSize> childOffsets;
+		openList.emplace_back(RTreeNodeIndex::create(0), 0, shapeCount);
+		while(!openList.empty())
+		{
+			const OpenNode open = openList.back();
+			openList.pop_back();
+			const auto& node = nodes[open.index];
+			const auto& nodeCuboids = node.getCuboids();
+			const int leafCount = node.getLeafCount();
+			childHits.clear();
+			for(int i = open.begin; i != open.end; ++i)
+			{
+				const int shapeIndex = candidates[i];
+				if(finished[shapeIndex])
+					continue;
+				BitSet64 intersectMask = nodeCuboids.intersectionBits(shapes[shapeIndex]);
+				BitSet64 leafMask = intersectMask;
+				if(leafCount != nodeSize)
+					leafMask.clearAllAfterInclusive(leafCount);
+				while(!leafMask.empty())
+				{
+					const RTreeArrayIndex arrayIndex{leafMask.getNextAndClear()};
+					if(leafAction(shapeIndex, node, arrayIndex))
+					{
+						finished[shapeIndex] = true;
+						break;
+					}
+				}
+				if(finished[shapeIndex])
+					continue;
+				intersectMask.clearAllBefore(leafCount);
+				if(!intersectMask.empty())
+					childHits.emplace_back(shapeIndex, intersectMask);
+			}
+			assert(open.end == (int)candidates.size());
+			candidates.resize(open.begin);
+			if(childHits.empty())
+				continue;
+			// Count shapes per child, then give each child a contiguous range.
+			childOffsets.fill(0);
+			for(const auto& [shapeIndex, mask] : childHits)
+			{
+				BitSet64 copy = mask;
+				while(!copy.empty())
+					++childOffsets[copy.getNextAndClear()];
+			}
+			const int childrenBegin = candidates.size();
+			int end = childrenBegin;
+			for(int arrayIndex = leafCount; arrayIndex != nodeSize; ++arrayIndex)
+			{
+				const int count = childOffsets[arrayIndex];
+				if(count == 0)
+					continue;
+				childOffsets[arrayIndex] = end;
+				openList.emplace_back(getChild(node, RTreeArrayIndex::create(arrayIndex)), end, end + count);
+				end += count;
+			}
+			candidates.resize(end);
+			for(const auto& [shapeIndex, mask] : childHits)
+			{
+				BitSet64 copy = mask;
+				while(!copy.empty())
+					candidates[childOffsets[copy.getNextAndClear()]++] = shapeIndex;
+			}
+		}
+	}
+}
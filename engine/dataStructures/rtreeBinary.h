@@ -0,0 +1,46 @@
+/*
+	Checks shared by the loadBinary of RTreeData and RTreeBoolean.
+	Node arrays are copied straight out of the file, so a corrupt file could leave indices which point outside of the array. They are checked once after loading rather then on every access.
+*/
+#pragma once
+#include "../binaryArchive.h"
+#include "../numericTypes/index.h"
+#include <string>
+
+namespace RTreeBinary
+{
+	// getChild(node, arrayIndex) returns the node index stored at arrayIndex. Throws BinaryArchiveError.
+	template<int nodeSize>
+	void checkLoaded(const BinaryArchiveReader& reader, const auto& nodes, const auto& emptySlots, const auto& toComb, auto&& getChild)
+	{
+		const int nodeCount = nodes.size();
+		// There is always a root, even when the tree is empty.
+		if(nodeCount == 0)
+			reader.fail("R-tree has no nodes");
+		const auto isInRange = [nodeCount](const RTreeNodeIndex index) { return index.exists() && index.get() < nodeCount; };
+		for(int i = 0; i != nodeCount; ++i)
+		{
+			const auto& node = nodes[RTreeNodeIndex::create(i)];
+			const int childBegin = node.offsetOfFirstChild().get();
+			if(node.getLeafCount() < 0 || node.getLeafCount() > childBegin || childBegin > nodeSize)
+				reader.fail("R-tree node " + std::to_string(i) + " has invalid leaf and child counts");
+			// The root has no parent. Empty slots may have a stale one, which is never read.
+			const RTreeNodeIndex parent = node.getParent();
+			if(parent.exists() && !isInRange(parent))
+				reader.fail("R-tree node " + std::to_string(i) + " has parent out of range");
+			for(RTreeArrayIndex arrayIndex = node.offsetOfFirstChild(); arrayIndex != nodeSize; ++arrayIndex)
+			{
+				const RTreeNodeIndex child = getChild(node, arrayIndex);
+				// The root is never a child.
+				if(!isInRange(child) || child.get() == 0)
+					reader.fail("R-tree node " + std::to_string(i) + " has child out of range");
+			}
+		}
+		for(const RTreeNodeIndex index : emptySlots)
+			if(!isInRange(index) || index.get() == 0)
+				reader.fail("R-tree empty slot out of range");
+		for(const RTreeNodeIndex index : toComb)
+			if(!isInRange(index))
+				reader.fail("R-tree node to comb out of range");
+	}
+}
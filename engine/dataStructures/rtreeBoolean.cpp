@@ -2,6 +2,8 @@
 #include "strongVector.hpp"
 #include "../geometry/paramaterizedLine.h"
 #include "../geometry/sphere.h"
+#include "rtreeBinary.h"
+#include "../util.h"
 RTreeArrayIndex RTreeBoolean::Node::offsetFor(const RTreeNodeIndex index) const
 {
 	return RTreeArrayIndex::create(m_childIndices.indexOf(index));
@@ -161,6 +163,49 @@ std::string RTreeBoolean::Node::toS() const
 	return output;
 }
 void RTreeBoolean::beforeJsonLoad() { m_nodes.clear(); }
+void RTreeBoolean::writeBinary(BinaryArchiveWriter& writer) const
+{
+	writer.writeBlock(m_nodes.toVector().data(), m_nodes.size());
+	writer.writeBlock(m_emptySlots.getVector().data(), m_emptySlots.size());
+	writer.writeBlock(m_toComb.getVector().data(), m_toComb.size());
+}
+void RTreeBoolean::loadBinary(BinaryArchiveReader& reader)
+{
+	reader.readBlock(m_nodes.getVector());
+	reader.readBlock(m_emptySlots.getVector());
+	reader.readBlock(m_toComb.getVector());
+	RTreeBinary::checkLoaded<nodeSize>(reader, m_nodes, m_emptySlots, m_toComb, [](const Node& node, const RTreeArrayIndex arrayIndex) { return node.getChildIndices()[arrayIndex]; });
+}
+RTreeBoolean::Changes RTreeBoolean::takeChanges()
+{
+	assert(m_trackChanges);
+	CuboidSet regions;
+	for(const Cuboid cuboid : m_changed)
+		regions.maybeAdd(cuboid);
+	m_changed.clear();
+	Changes output;
+	for(const Cuboid region : regions)
+	{
+		output.regions.push_back(region);
+		queryForEach(region, [&](const Cuboid cuboid) { output.leafCuboids.push_back(cuboid.intersection(region)); });
+	}
+	return output;
+}
+void RTreeBoolean::writeChanges(const Changes& changes, BinaryArchiveWriter& writer)
+{
+	writer.writeBlock(changes.regions.data(), changes.regions.size());
+	writer.writeBlock(changes.leafCuboids.data(), changes.leafCuboids.size());
+}
+void RTreeBoolean::applyChanges(BinaryArchiveReader& reader)
+{
+	Changes changes;
+	reader.readBlock(changes.regions);
+	reader.readBlock(changes.leafCuboids);
+	for(const Cuboid region : changes.regions)
+		maybeRemove(region);
+	for(const Cuboid cuboid : changes.leafCuboids)
+		maybeInsert(cuboid);
+}
 std::tuple<Cuboid, RTreeArrayIndex, RTreeArrayIndex> RTreeBoolean::findPairWithLeastNewVolumeWhenExtended(const CuboidArray<nodeSize + 1>& cuboids) const
 {
 	// May be negitive because resulting cuboids may intersect.
@@ -350,6 +395,7 @@ void RTreeBoolean::addToNodeRecursive(const RTreeNodeIndex index, const Cuboid c
 					const RTreeNodeIndex indexCopy = index;
 					// create a new node to hold first and second. Invalidates parent and index.
 					m_nodes.add();
+					++m_unsortedNodes;
 					Node& newNode = m_nodes.back();
 					newNode.setParent(indexCopy);
 					const RTreeNodeIndex newIndex = RTreeNodeIndex::create(m_nodes.size() - 1);
@@ -467,7 +513,7 @@ void RTreeBoolean::merge(const RTreeNodeIndex destination, const RTreeNodeIndex
 	for(const Cuboid leaf : leaves)
 		addToNodeRecursive(destination, leaf);
 }
-void RTreeBoolean::comb()
+void RTreeBoolean::comb(int budget)
 {
 	// Attempt to merge leaves and child nodes.
 	// Don't comb empty slots.
@@ -479,8 +525,17 @@ void RTreeBoolean::comb()
 	{
 		auto copy = std::move(m_toComb);
 		m_toComb.clear();
-		for(const RTreeNodeIndex index : copy)
+		for(auto iter = copy.begin(); iter != copy.end(); ++iter)
 		{
+			if(budget == 0)
+			{
+				// Leave the remainder for the next call.
+				for(; iter != copy.end(); ++iter)
+					m_toComb.maybeInsert(*iter);
+				return;
+			}
+			--budget;
+			const RTreeNodeIndex index = *iter;
 			Node& node = m_nodes[index];
 			tryToMergeLeaves(node);
 			// Try to merge child branches into this branch.
@@ -522,12 +577,12 @@ void RTreeBoolean::comb()
 		}
 	}
 }
-void RTreeBoolean::defragment()
+void RTreeBoolean::defragment(int budget)
 {
 	// Copy nodes from then end of m_nodes over empty slots.
 	// Update parent and child indices.
 	assert(m_toComb.empty());
-	while(!m_emptySlots.empty())
+	for(; budget != 0 && !m_emptySlots.empty(); --budget)
 	{
 		const RTreeNodeIndex last = RTreeNodeIndex::create(m_nodes.size() - 1);
 		auto found = m_emptySlots.find(last);
@@ -545,6 +600,7 @@ void RTreeBoolean::defragment()
 		const auto& newNode = m_nodes[empty] = m_nodes[last];
 		// Discard now copied from node.
 		m_nodes.popBack();
+		++m_unsortedNodes;
 		if(parentIndex.exists())
 			// Update stored index in parent
 			m_nodes[parentIndex].updateChildIndex(last, empty);
@@ -598,6 +654,7 @@ void RTreeBoolean::sort()
 		}
 	}
 	m_nodes = std::move(sortedNodes);
+	m_unsortedNodes = 0;
 }
 void RTreeBoolean::addIntersectedChildrenToOpenList(const Node& node, BitSet& intersectMask, OpenList& openList)
 {
@@ -613,11 +670,15 @@ void RTreeBoolean::addIntersectedChildrenToOpenList(const Node& node, BitSet& in
 }
 void RTreeBoolean::maybeInsert(const Cuboid cuboid)
 {
+	if(m_trackChanges)
+		m_changed.push_back(cuboid);
 	constexpr RTreeNodeIndex zeroIndex = RTreeNodeIndex::create(0);
 	addToNodeRecursive(zeroIndex, cuboid);
 }
 void RTreeBoolean::maybeRemove(const Cuboid cuboid)
 {
+	if(m_trackChanges)
+		m_changed.push_back(cuboid);
 	// Erase all contained branches and leaves.
 	constexpr RTreeNodeIndex rootIndex = RTreeNodeIndex::create(0);
 	clearAllContained(rootIndex, cuboid);
@@ -650,14 +711,18 @@ void RTreeBoolean::maybeRemove(const Cuboid cuboid)
 }
 void RTreeBoolean::clear()
 {
+	if(m_trackChanges && !m_nodes.front().empty())
+		m_changed.push_back(m_nodes.front().getCuboids().boundry());
 	m_nodes.resize(1);
 	m_emptySlots.clear();
 	m_toComb.clear();
 	m_nodes.front().clear();
+	m_unsortedNodes = 0;
 }
 void RTreeBoolean::prepare()
 {
-	bool toSort = false;
+	const std::chrono::microseconds start = util::getCurrentTimeInMicroSeconds();
+	bool toSort = needsSort();
 	if(!m_toComb.empty())
 	{
 		toSort = true;
@@ -670,10 +735,50 @@ void RTreeBoolean::prepare()
 	}
 	if(toSort)
 		sort();
+	m_lastPrepareDuration = util::getCurrentTimeInMicroSeconds() - start;
+}
+void RTreeBoolean::prepareIncremental()
+{
+	const std::chrono::microseconds start = util::getCurrentTimeInMicroSeconds();
+	if(!m_toComb.empty())
+		comb(Config::rtreeCombBudget);
+	// Defragmenting moves nodes, which would invalidate indices still waiting in m_toComb.
+	if(m_toComb.empty() && !m_emptySlots.empty())
+		defragment(Config::rtreeDefragmentBudget);
+	if(m_toComb.empty() && m_emptySlots.empty() && needsSort())
+		sort();
+	m_lastPrepareDuration = util::getCurrentTimeInMicroSeconds() - start;
 }
 bool RTreeBoolean::canPrepare() const
 {
-	return !m_toComb.empty() || !m_emptySlots.empty();
+	return !m_toComb.empty() || !m_emptySlots.empty() || needsSort();
+}
+RTreeMetrics RTreeBoolean::getMetrics() const
+{
+	RTreeMetrics output;
+	output.lastPrepareDuration = m_lastPrepareDuration;
+	output.emptySlots = m_emptySlots.size();
+	output.toComb = m_toComb.size();
+	output.unsortedNodes = m_unsortedNodes;
+	int usedSlots = 0;
+	// Walk from the root rather then iterating m_nodes so empty slots are not counted.
+	std::vector<std::pair<RTreeNodeIndex, int>> openList;
+	openList.emplace_back(RTreeNodeIndex::create(0), 1);
+	while(!openList.empty())
+	{
+		const auto [index, depth] = openList.back();
+		openList.pop_back();
+		const Node& node = m_nodes[index];
+		++output.nodeCount;
+		output.depth = std::max(output.depth, depth);
+		output.leafCount += node.getLeafCount();
+		usedSlots += node.getLeafCount() + node.getChildCount();
+		const auto& children = node.getChildIndices();
+		for(RTreeArrayIndex i = node.offsetOfFirstChild(); i != nodeSize; ++i)
+			openList.emplace_back(children[i], depth + 1);
+	}
+	output.fillFactor = (float)usedSlots / (float)(output.nodeCount * nodeSize);
+	return output;
 }
 CuboidSet RTreeBoolean::toCuboidSet() const
 {
@@ -818,49 +923,19 @@ template Point3D RTreeBoolean::queryGetPoint(const CuboidSet& shape) const;
 template<typename ShapeT>
 std::vector<bool> RTreeBoolean::batchQuery(const ShapeT& shapes) const
 {
-	std::vector<bool> output;
-	output.resize(shapes.size());
-	SmallSet<int> topLevelCandidates;
-	topLevelCandidates.resize(shapes.size());
-	std::iota(topLevelCandidates.m_data.begin(), topLevelCandidates.m_data.end(), 0);
-	SmallMap<RTreeNodeIndex, SmallSet<int>> openlist;
-	openlist.insert(RTreeNodeIndex::create(0), std::move(topLevelCandidates));
-	while(!openlist.empty())
-	{
-		const auto& [index, candidates] = openlist.back();
-		const Node& node = m_nodes[index];
-		const auto& nodeCuboids = node.getCuboids();
-		const auto& nodeChildren = node.getChildIndices();
-		const auto offsetOfFirstChild = node.offsetOfFirstChild();
-		for(const int shapeIndex : candidates)
-		{
-			if(output[shapeIndex])
-				// this shape has already intersected with a leaf, no need to check further.
-				continue;
-			const auto& intersectMask = nodeCuboids.indicesOfIntersectingCuboids(shapes[shapeIndex]);
-			// record all leaf intersections.
-			const auto leafCount = node.getLeafCount();
-			if(leafCount != 0 && intersectMask.head(leafCount).any())
-			{
-				output[shapeIndex] = true;
-				continue;
-			}
-			// record all node intersections.
-			BitSet intersectBitSet = BitSet::create(intersectMask);
-			intersectBitSet.clearAllBefore(offsetOfFirstChild.get());
-			while(!intersectBitSet.empty())
-			{
-				const RTreeArrayIndex arrayIndex{intersectBitSet.getNext()};
-				openlist.getOrCreate(nodeChildren[arrayIndex]).insert(shapeIndex);
-			}
-		}
-		openlist.popBack();
-	}
+	std::vector<bool> output(shapes.size());
+	batchQueryForEachLeaf(shapes, [&](const int shapeIndex, const Node&, const RTreeArrayIndex) {
+		output[shapeIndex] = true;
+		// This shape has intersected with a leaf, no need to check further.
+		return true;
+	});
 	return output;
 }
 template std::vector<bool> RTreeBoolean::batchQuery(const SmallSet<Point3D>& shapes) const;
 template std::vector<bool> RTreeBoolean::batchQuery(const CuboidSet& shapes) const;
 template std::vector<bool> RTreeBoolean::batchQuery(const std::vector<ParamaterizedLine>& shapes) const;
+template std::vector<bool> RTreeBoolean::batchQuery(const std::vector<Sphere>& shapes) const;
+template std::vector<bool> RTreeBoolean::batchQuery(const std::vector<Cuboid>& shapes) const;
 template<typename ShapeT>
 CuboidSet RTreeBoolean::queryGetLeavesBody(ShapeT shape) const
 {
@@ -11,8 +11,12 @@
 #include "smallMap.h"
 #include "smallSet.h"
 #include "bitset.h"
+#include "rtreeBatchQuery.h"
+#include "rtreeMetrics.h"
 #include "strongArray.h"
 
+class BinaryArchiveWriter;
+class BinaryArchiveReader;
 class RTreeBoolean
 {
 	static constexpr int nodeSize = Config::rtreeNodeSize;
@@ -59,6 +63,12 @@ class RTreeBoolean
 	StrongVector<Node, RTreeNodeIndex> m_nodes;
 	SmallSet<RTreeNodeIndex> m_emptySlots;
 	SmallSet<RTreeNodeIndex> m_toComb;
+	// See RTreeData::m_changed.
+	std::vector<Cuboid> m_changed;
+	std::chrono::microseconds m_lastPrepareDuration = std::chrono::microseconds(0);
+	// See RTreeData::m_unsortedNodes.
+	int m_unsortedNodes = 0;
+	bool m_trackChanges = false;
 	[[nodiscard]] std::tuple<Cuboid, RTreeArrayIndex, RTreeArrayIndex> findPairWithLeastNewVolumeWhenExtended(const CuboidArray<nodeSize + 1>& cuboids) const;
 	[[nodiscard]] SmallSet<Cuboid> gatherLeavesRecursive(const RTreeNodeIndex parent) const;
 	void destroyWithChildren(const RTreeNodeIndex index);
@@ -71,17 +81,33 @@ class RTreeBoolean
 	// Iterate m_toComb and try to recursively merge leaves.
 	// Then check for single child nodes and splice them out. If the child is a leaf re-add the parent to m_toComb.
 	// Finally check for child branches that can be merged upwards. If any are merged re-add parent to m_toComb.
-	void comb();
+	// Stops after combing budget nodes, the rest are left in m_toComb.
+	void comb(int budget = INT_MAX);
 	// Copy over empty slots, while updating stored childIndices in parents of nodes moved. Then truncate m_nodes.
-	void defragment();
+	// Stops after filling or discarding budget slots.
+	void defragment(int budget = INT_MAX);
 	// Sort m_nodes by hilbert order of center. The node in position 0 is the top level and never moves.
 	void sort();
+	[[nodiscard]] bool needsSort() const { return m_unsortedNodes > m_nodes.size() * Config::rtreeUnsortedFractionToSort; }
 	static void addIntersectedChildrenToOpenList(const Node& node, BitSet& intersecting, OpenList& openList);
 	// Customization point.
 	[[nodiscard]] bool canMerge(const Cuboid, const Cuboid) const { return true; }
 public:
 	RTreeBoolean() { m_nodes.add(); m_nodes.back().setParent(RTreeNodeIndex::null()); }
 	void beforeJsonLoad();
+	void writeBinary(BinaryArchiveWriter& writer) const;
+	void loadBinary(BinaryArchiveReader& reader);
+	struct Changes
+	{
+		std::vector<Cuboid> regions;
+		std::vector<Cuboid> leafCuboids;
+	};
+	// See RTreeData::takeChanges.
+	void setTrackChanges(const bool track) { m_trackChanges = track; m_changed.clear(); }
+	[[nodiscard]] bool isTrackingChanges() const { return m_trackChanges; }
+	[[nodiscard]] Changes takeChanges();
+	static void writeChanges(const Changes& changes, BinaryArchiveWriter& writer);
+	void applyChanges(BinaryArchiveReader& reader);
 	void insert(const auto& shape) { assert(!query(shape)); maybeInsert(shape); }
 	void remove(const auto& shape) { assert(query(shape)); maybeRemove(shape); }
 	void maybeInsert(const Cuboid cuboid);
@@ -92,7 +118,9 @@ public:
 	void maybeInsert(const Point3D point) { const Cuboid cuboid = Cuboid(point, point); maybeInsert(cuboid); }
 	void maybeRemove(const Point3D point) { const Cuboid cuboid = Cuboid(point, point); maybeRemove(cuboid); }
 	void clear();
+	// See RTreeData::prepare and RTreeData::prepareIncremental.
 	void prepare();
+	void prepareIncremental();
 	void queryForEach(const auto& shape, auto&& action) const
 	{
 		OpenList openList;
@@ -131,6 +159,7 @@ public:
 			}
 	}
 	[[nodiscard]] bool canPrepare() const;
+	[[nodiscard]] RTreeMetrics getMetrics() const;
 	[[nodiscard]] bool empty() const { return nodeCount() == 1 && leafCount() == 0; }
 	[[nodiscard]] CuboidSet toCuboidSet() const;
 private:
@@ -151,10 +180,25 @@ public:
 	Cuboid queryGetLeaf(const CuboidSet& cuboids) const;
 	template<typename ShapeT>
 	[[nodiscard]] Point3D queryGetPoint(ShapeT&& shape) const;
-	// Shapes should be an iterable collection supported by CuboidArray's intersection check.
+private:
+	void batchQueryForEachLeaf(const auto& shapes, auto&& leafAction) const
+	{
+		const auto getChild = [](const Node& node, const RTreeArrayIndex arrayIndex) { return node.getChildIndices()[arrayIndex]; };
+		RTreeBatchQuery::forEachLeaf<nodeSize>(m_nodes, shapes, getChild, leafAction);
+	}
+public:
+	// Shapes should be an indexable collection supported by CuboidArray's intersection check. The tree is walked once for all shapes, see RTreeBatchQuery.
 	// Returns a bitset with 1 set for each shape which intersects something.
 	template<typename ShapeT>
 	[[nodiscard]] std::vector<bool> batchQuery(const ShapeT& shapes) const;
+	// Action is called with each intersected leaf and the index of the shape which intersects it.
+	void batchQueryForEach(const auto& shapes, auto&& action) const
+	{
+		batchQueryForEachLeaf(shapes, [&](const int shapeIndex, const Node& node, const RTreeArrayIndex arrayIndex) {
+			action(node.getCuboids()[arrayIndex.get()], shapeIndex);
+			return false;
+		});
+	}
 private:
 	template<typename ShapeT>
 	[[nodiscard]] CuboidSet queryGetLeavesBody(ShapeT shape) const;
@@ -15,6 +15,7 @@ template class RTreeData<PlantIndex>;
 template class RTreeData<TemperatureDelta>;
 template class RTreeData<TemperatureSource, RTreeDataConfigs::noMerge>;
 template class RTreeData<DistanceFractional>;
+template class RTreeData<ConnectivityComponentId>;
 template class RTreeData<RTreeDataWrapper<Project*, nullptr>>;
 template class RTreeData<RTreeDataWrapper<StockPile*, nullptr>>;
 template class RTreeData<ActorIndex, RTreeDataConfigs::canOverlapNoMerge>;
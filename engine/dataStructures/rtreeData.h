@@ -13,6 +13,10 @@
 #include "smallMap.h"
 #include "smallSet.hpp"
 #include "bitset.h"
+#include "rtreeBatchQuery.h"
+#include "rtreeMetrics.h"
+class BinaryArchiveWriter;
+class BinaryArchiveReader;
 struct RTreeDataConfig
 {
 	bool splitAndMerge = true;
@@ -92,6 +96,25 @@ class RTreeData
 	StrongVector<Node, RTreeNodeIndex> m_nodes;
 	SmallSet<RTreeNodeIndex> m_emptySlots;
 	SmallSet<RTreeNodeIndex> m_toComb;
+	// Regions modified since the last call to takeChanges, only recorded while m_trackChanges is set.
+	// Regions rather then node indices are recorded because prepare moves nodes.
+	std::vector<Cuboid> m_changed;
+	std::chrono::microseconds m_lastPrepareDuration = std::chrono::microseconds(0);
+	// Nodes added or moved since the last sort, see prepareIncremental.
+	int m_unsortedNodes = 0;
+	bool m_trackChanges = false;
+	void recordChanged(const auto& shape)
+	{
+		if(!m_trackChanges)
+			return;
+		using Shape = std::decay_t<decltype(shape)>;
+		if constexpr(std::is_same_v<Shape, Cuboid>)
+			m_changed.push_back(shape);
+		else if constexpr(std::is_same_v<Shape, Point3D>)
+			m_changed.push_back(Cuboid{shape, shape});
+		else
+			m_changed.push_back(shape.boundry());
+	}
 	[[nodiscard]] std::tuple<Cuboid, RTreeArrayIndex, RTreeArrayIndex> findPairWithLeastNewVolumeWhenExtended(const CuboidArray<nodeSize + 1>& cuboids) const;
 	[[nodiscard]] SmallSet<std::pair<Cuboid, T>> gatherLeavesRecursive(const RTreeNodeIndex parent) const;
 	void destroyWithChildren(const RTreeNodeIndex index);
@@ -109,11 +132,14 @@ class RTreeData
 	// Iterate m_toComb and try to recursively merge leaves.
 	// Then check for single child nodes and splice them out. If the child is a leaf re-add the parent to m_toComb.
 	// Finally check for child branches that can be merged upwards. If any are merged re-add parent to m_toComb.
-	void comb();
+	// Stops after combing budget nodes, the rest are left in m_toComb.
+	void comb(int budget = INT_MAX);
 	// Copy over empty slots, while updating stored childIndices in parents of nodes moved. Then truncate m_nodes.
-	void defragment();
+	// Stops after filling or discarding budget slots.
+	void defragment(int budget = INT_MAX);
 	// Sort m_nodes by hilbert order of center. The node in position 0 is the top level and never moves.
 	void sort();
+	[[nodiscard]] bool needsSort() const { return m_unsortedNodes > m_nodes.size() * Config::rtreeUnsortedFractionToSort; }
 	static void addIntersectedChildrenToOpenList(const Node& node, const BitSet intersecting, OpenList& openList);
 	[[nodiscard]] bool canOverlap(const T&, const T&) const { return true; }
 	[[nodiscard]] bool canMerge(const Cuboid, const Cuboid) const { return true; }
@@ -150,9 +176,15 @@ public:
 	}
 	void removeAll(const auto& shape, const T& value) { assert(queryAnyEqual(shape, value)); maybeRemove(shape, value); }
 	void removeAll(const auto& shape) { assert(queryAny(shape)); maybeRemove(shape); }
+	// Combs, defragments and sorts completely, used before saving.
 	void prepare();
+	// Called every step. Combs up to Config::rtreeCombBudget nodes, then once combing is finished defragments up to Config::rtreeDefragmentBudget slots.
+	// Sorting copies every node so it waits untill Config::rtreeUnsortedFractionToSort of them have been added or moved.
+	// Budgets count work rather then time so node order, and with it the order of query results, does not depend on the speed of the machine.
+	void prepareIncremental();
 	void clear();
 	[[nodiscard]] bool canPrepare() const;
+	[[nodiscard]] RTreeMetrics getMetrics() const;
 	GDB_CALLABLE static T nullValue() { return T::create(nullPrimitive); }
 	[[nodiscard]] bool empty() const { return leafCount() == 0; }
 	GDB_CALLABLE bool anyLeafOverlapsAnother() const;
@@ -161,8 +193,13 @@ public:
 	[[nodiscard]] SmallSet<T> getAllWithCondition(auto&& condition) const
 	{
 		SmallSet<T> output;
-		for(const Node& node : m_nodes)
+		const int nodeEnd = m_nodes.size();
+		for(RTreeNodeIndex nodeIndex{0}; nodeIndex != nodeEnd; ++nodeIndex)
 		{
+			// Empty slots may still hold leaves which have been merged into another node.
+			if(m_emptySlots.contains(nodeIndex))
+				continue;
+			const Node& node = m_nodes[nodeIndex];
 			const int leafCount = node.getLeafCount();
 			const auto& nodeDataAndChildIndices = node.getDataAndChildIndices();
 			const RTreeArrayIndex end = RTreeArrayIndex::create(leafCount);
@@ -176,6 +213,23 @@ public:
 		return output;
 	}
 	void load(const Json& data);
+	// Nodes are written as one raw block, so values must not hold pointers.
+	void writeBinary(BinaryArchiveWriter& writer) const;
+	void loadBinary(BinaryArchiveReader& reader);
+	// The contents of each region changed since the last call to takeChanges, leaves are clipped to the region which they were found in.
+	struct Changes
+	{
+		std::vector<Cuboid> regions;
+		std::vector<Cuboid> leafCuboids;
+		std::vector<typename T::Primitive> leafValues;
+	};
+	// Starting or stopping tracking discards any recorded changes.
+	void setTrackChanges(const bool track) { m_trackChanges = track; m_changed.clear(); }
+	[[nodiscard]] bool isTrackingChanges() const { return m_trackChanges; }
+	[[nodiscard]] Changes takeChanges();
+	static void writeChanges(const Changes& changes, BinaryArchiveWriter& writer);
+	// Replaces the contents of each region read with the leaves read.
+	void applyChanges(BinaryArchiveReader& reader);
 	void validate() const;
 	void removeWithCondition(const auto& shape, const auto& condition)
 	{
@@ -219,6 +273,7 @@ public:
 	template<UpdateActionConfig queryConfig>
 	void updateActionWithCondition(const auto& shape, auto&& action, const auto& condition)
 	{
+		recordChanged(shape);
 		OpenList openList;
 		openList.insert(RTreeNodeIndex::create(0));
 		bool found = false;
@@ -785,125 +840,55 @@ public:
 		output.erase(unique(output.begin(), output.end()), output.end());
 		return output;
 	}
+private:
+	void batchQueryForEachLeaf(const auto& shapes, auto&& leafAction) const
+	{
+		const auto getChild = [](const Node& node, const RTreeArrayIndex arrayIndex) { return RTreeNodeIndex::create(node.getDataAndChildIndices()[arrayIndex].child); };
+		RTreeBatchQuery::forEachLeaf<nodeSize>(m_nodes, shapes, getChild, leafAction);
+	}
+public:
+	// Batch queries walk the tree once for all shapes, see RTreeBatchQuery.
 	[[nodiscard]] bool batchQueryAny(const auto& shapes) const
 	{
-		std::vector<bool> output;
-		output.resize(shapes.size());
-		SmallMap<RTreeNodeIndex, SmallSet<int>> openList;
-		SmallSet<int> topLevelCandidates;
-		topLevelCandidates.resize(shapes.size());
-		std::iota(topLevelCandidates.m_data.begin(), topLevelCandidates.m_data.end(), 0);
-		openList.insert(RTreeNodeIndex::create(0), std::move(topLevelCandidates));
-		while(!openList.empty())
-		{
-			const auto& [index, candidates] = openList.back();
-			const Node& node = m_nodes[index];
-			const auto& nodeCuboids = node.getCuboids();
-			const auto& nodeDataAndChildIndices = node.getDataAndChildIndices();
-			for(const int shapeIndex : candidates)
-			{
-				if(output[shapeIndex])
-					// This shape has already intersected with a leaf, no need to check further.
-					continue;
-				const auto& intersectMask = nodeCuboids.indicesOfIntersectingCuboids(shapes[shapeIndex]);
-				// Record a leaf intersection.
-				const auto leafCount = node.getLeafCount();
-				if(leafCount != 0 && intersectMask.head(leafCount).any())
-					return true;
-				// Record intersected children in openList.
-				BitSet intersectBitMask = BitSet::create(intersectMask);
-				while(!intersectBitMask.empty())
-				{
-					const RTreeArrayIndex arrayIndex{intersectBitMask.getNextAndClear()};
-					openList.getOrCreate(RTreeNodeIndex::create(nodeDataAndChildIndices[arrayIndex].child)).insert(shapeIndex);
-				}
-			}
-			// Pop back at the end so we can use candidates as a reference and not have to make a move-copy.
-			openList.popBack();
-		}
-		return false;
+		constexpr auto condition = [](const T&) { return true; };
+		return batchQueryWithConditionAny(shapes, condition);
 	}
 	[[nodiscard]] bool batchQueryWithConditionAny(const auto& shapes, const auto& condition) const
 	{
-		std::vector<bool> output;
-		output.resize(shapes.size());
-		SmallMap<RTreeNodeIndex, SmallSet<int>> openList;
-		SmallSet<int> topLevelCandidates;
-		topLevelCandidates.resize(shapes.size());
-		std::iota(topLevelCandidates.m_data.begin(), topLevelCandidates.m_data.end(), 0);
-		openList.insert(RTreeNodeIndex::create(0), std::move(topLevelCandidates));
-		while(!openList.empty())
-		{
-			const auto& [index, candidates] = openList.back();
-			const Node& node = m_nodes[index];
-			const auto& nodeCuboids = node.getCuboids();
-			for(const int shapeIndex : candidates)
-			{
-				if(output[shapeIndex])
-					// This shape has already intersected with a leaf, no need to check further.
-					continue;
-				const auto& intersectMask = nodeCuboids.indicesOfIntersectingCuboids(shapes[shapeIndex]);
-				BitSet intersectBitMask = BitSet::create(intersectMask);
-				BitSet leafBitMask = intersectBitMask;
-				const auto leafCount = node.getLeafCount();
-				leafBitMask.clearAllAfterInclusive(leafCount);
-				const auto& nodeDataAndChildIndices = node.getDataAndChildIndices();
-				while(!leafBitMask.empty())
-				{
-					const RTreeArrayIndex arrayIndex{leafBitMask.getNextAndClear()};
-					if(condition(T::create(nodeDataAndChildIndices[arrayIndex].data)))
-						return true;
-				}
-				// Record intersected children in openList.
-				intersectBitMask.clearAllBefore(leafCount);
-				while(!intersectBitMask.empty())
-				{
-					const RTreeArrayIndex arrayIndex{intersectBitMask.getNextAndClear()};
-					openList.getOrCreate(RTreeNodeIndex::create(nodeDataAndChildIndices[arrayIndex].child)).insert(shapeIndex);
-				}
-			}
-			// Pop back at the end so we can use candidates as a reference and not have to make a move-copy.
-			openList.popBack();
-		}
-		return false;
+		// There is no way to stop the traversal for all shapes, mark each one finished instead.
+		bool output = false;
+		batchQueryForEachLeaf(shapes, [&](const int, const Node& node, const RTreeArrayIndex arrayIndex) {
+			if(output || condition(T::create(node.getDataAndChildIndices()[arrayIndex].data)))
+				output = true;
+			return output;
+		});
+		return output;
+	}
+	// Returns true for each shape which intersects a leaf.
+	[[nodiscard]] std::vector<bool> batchQueryAnyPerShape(const auto& shapes) const
+	{
+		constexpr auto condition = [](const T&) { return true; };
+		return batchQueryWithConditionAnyPerShape(shapes, condition);
+	}
+	[[nodiscard]] std::vector<bool> batchQueryWithConditionAnyPerShape(const auto& shapes, const auto& condition) const
+	{
+		std::vector<bool> output(shapes.size());
+		batchQueryForEachLeaf(shapes, [&](const int shapeIndex, const Node& node, const RTreeArrayIndex arrayIndex) {
+			if(!condition(T::create(node.getDataAndChildIndices()[arrayIndex].data)))
+				return false;
+			output[shapeIndex] = true;
+			return true;
+		});
+		return output;
 	}
 	void batchQueryForEachWithCondition(const auto& shapes, auto&& action, auto&& condition) const
 	{
-		SmallMap<RTreeNodeIndex, SmallSet<int>> openList;
-		SmallSet<int> topLevelCandidates;
-		topLevelCandidates.resize(shapes.size());
-		std::iota(topLevelCandidates.m_data.begin(), topLevelCandidates.m_data.end(), 0);
-		openList.insert(RTreeNodeIndex::create(0), std::move(topLevelCandidates));
-		while(!openList.empty())
-		{
-			const auto& [index, candidates] = openList.back();
-			const Node& node = m_nodes[index];
-			const auto& nodeCuboids = node.getCuboids();
-			const auto& nodeDataAndChildIndices = node.getDataAndChildIndices();
-			for(const int shapeIndex : candidates)
-			{
-				BitSet intersectMask = BitSet::create(nodeCuboids.indicesOfIntersectingCuboids(shapes[shapeIndex]));
-				BitSet leafMask = intersectMask;
-				const int leafCount = node.getLeafCount();
-				leafMask.clearAllAfterInclusive(leafCount);
-				// Handle all leaf intersections.
-				while(!leafMask.empty())
-				{
-					const RTreeArrayIndex arrayIndex{leafMask.getNextAndClear()};
-					const T value = T::create(nodeDataAndChildIndices[arrayIndex].data);
-					if(condition(value))
-						action(value, nodeCuboids[arrayIndex.get()], shapeIndex);
-				}
-				// record all node intersections.
-				intersectMask.clearAllBefore(leafCount);
-				while(!intersectMask.empty())
-				{
-					const RTreeArrayIndex arrayIndex{intersectMask.getNextAndClear()};
-					openList.getOrCreate(RTreeNodeIndex::create(nodeDataAndChildIndices[arrayIndex].child)).insert(shapeIndex);
-				}
-			}
-			openList.popBack();
-		}
+		batchQueryForEachLeaf(shapes, [&](const int shapeIndex, const Node& node, const RTreeArrayIndex arrayIndex) {
+			const T value = T::create(node.getDataAndChildIndices()[arrayIndex].data);
+			if(condition(value))
+				action(value, node.getCuboids()[arrayIndex.get()], shapeIndex);
+			return false;
+		});
 	}
 	void batchQueryForEach(const auto& shapes, auto&& action) const
 	{
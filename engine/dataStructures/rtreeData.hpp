@@ -1,6 +1,8 @@
 #pragma once
 #include "rtreeData.h"
 #include "../geometry/mapWithCuboidKeys.hpp"
+#include "rtreeBinary.h"
+#include "../util.h"
 #include<iostream>
 template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
 RTreeArrayIndex RTreeData<T, config_, nullPrimitive>::Node::offsetFor(const RTreeNodeIndex index) const
@@ -611,6 +613,7 @@ void RTreeData<T, config_, nullPrimitive>::addToNodeRecursive(const RTreeNodeInd
 					const RTreeNodeIndex indexCopy = index;
 					// create a new node to hold first and second. Invalidates parent and index.
 					m_nodes.add();
+					++m_unsortedNodes;
 					Node& newNode = m_nodes.back();
 					newNode.setParent(indexCopy);
 					Node& parent2 = m_nodes[indexCopy];
@@ -842,7 +845,7 @@ void RTreeData<T, config_, nullPrimitive>::merge(const RTreeNodeIndex destinatio
 }
 // This method is identical to the one in rTreeBoolean, other then calling a different tryToMergeLeaves
 template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
-void RTreeData<T, config_, nullPrimitive>::comb()
+void RTreeData<T, config_, nullPrimitive>::comb(int budget)
 {
 	// Attempt to merge leaves and child nodes.
 	// Don't comb empty slots.
@@ -854,8 +857,18 @@ void RTreeData<T, config_, nullPrimitive>::comb()
 	{
 		auto copy = std::move(m_toComb);
 		m_toComb.clear();
-		for(const RTreeNodeIndex index : copy)
+		for(auto iter = copy.begin(); iter != copy.end(); ++iter)
 		{
+			if(budget == 0)
+			{
+				// Leave the remainder for the next call.
+				for(; iter != copy.end(); ++iter)
+					m_toComb.maybeInsert(*iter);
+				validate();
+				return;
+			}
+			--budget;
+			const RTreeNodeIndex index = *iter;
 			Node& node = m_nodes[index];
 			if constexpr(config_.splitAndMerge)
 				tryToMergeLeaves(node);
@@ -901,12 +914,12 @@ void RTreeData<T, config_, nullPrimitive>::comb()
 }
 // This method is identical to the one in rTreeBoolean.
 template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
-void RTreeData<T, config_, nullPrimitive>::defragment()
+void RTreeData<T, config_, nullPrimitive>::defragment(int budget)
 {
 	// Copy nodes from then end of m_nodes over empty slots.
 	// Update parent and child indices.
 	assert(m_toComb.empty());
-	while(!m_emptySlots.empty())
+	for(; budget != 0 && !m_emptySlots.empty(); --budget)
 	{
 		const RTreeNodeIndex last = RTreeNodeIndex::create(m_nodes.size() - 1);
 		auto found = m_emptySlots.find(last);
@@ -924,6 +937,7 @@ void RTreeData<T, config_, nullPrimitive>::defragment()
 		const auto& newNode = m_nodes[empty] = m_nodes[last];
 		// Discard now copied from node.
 		m_nodes.popBack();
+		++m_unsortedNodes;
 		if(parentIndex.exists())
 			// Update stored index in parent
 			m_nodes[parentIndex].updateChildIndex(last, empty);
@@ -995,6 +1009,7 @@ void RTreeData<T, config_, nullPrimitive>::sort()
 		}
 	}
 	m_nodes = std::move(sortedNodes);
+	m_unsortedNodes = 0;
 }
 template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
 void RTreeData<T, config_, nullPrimitive>::addIntersectedChildrenToOpenList(const Node& node, BitSet interceptMask, OpenList& openList)
@@ -1019,6 +1034,7 @@ template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
 void RTreeData<T, config_, nullPrimitive>::maybeInsert(const Cuboid cuboid, const T& value)
 {
 	assert(value != T::create(nullPrimitive));
+	recordChanged(cuboid);
 	if constexpr(!config_.leavesCanOverlap)
 		assert(!queryAny(cuboid));
 	else
@@ -1032,6 +1048,7 @@ void RTreeData<T, config_, nullPrimitive>::maybeInsert(const Cuboid cuboid, cons
 template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
 void RTreeData<T, config_, nullPrimitive>::maybeRemove(const Cuboid cuboid)
 {
+	recordChanged(cuboid);
 	// Erase all contained branches and leaves.
 	constexpr RTreeNodeIndex rootIndex = RTreeNodeIndex::create(0);
 	clearAllContained(rootIndex, cuboid);
@@ -1073,6 +1090,7 @@ template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
 void RTreeData<T, config_, nullPrimitive>::maybeRemove(const Cuboid cuboid, const T& value)
 {
 	assert(value != T::create(nullPrimitive));
+	recordChanged(cuboid);
 	// Erase all contained branches and leaves.
 	constexpr RTreeNodeIndex rootIndex = RTreeNodeIndex::create(0);
 	clearAllContainedWithValueRecursive(m_nodes[rootIndex], cuboid, value);
@@ -1103,7 +1121,8 @@ void RTreeData<T, config_, nullPrimitive>::maybeInsertOrOverwrite(const Point3D
 template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
 void RTreeData<T, config_, nullPrimitive>::prepare()
 {
-	bool toSort = false;
+	const std::chrono::microseconds start = util::getCurrentTimeInMicroSeconds();
+	bool toSort = needsSort();
 	if(!m_toComb.empty())
 	{
 		toSort = true;
@@ -1117,14 +1136,32 @@ void RTreeData<T, config_, nullPrimitive>::prepare()
 	if(toSort)
 		sort();
 	validate();
+	m_lastPrepareDuration = util::getCurrentTimeInMicroSeconds() - start;
+}
+template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
+void RTreeData<T, config_, nullPrimitive>::prepareIncremental()
+{
+	const std::chrono::microseconds start = util::getCurrentTimeInMicroSeconds();
+	if(!m_toComb.empty())
+		comb(Config::rtreeCombBudget);
+	// Defragmenting moves nodes, which would invalidate indices still waiting in m_toComb.
+	if(m_toComb.empty() && !m_emptySlots.empty())
+		defragment(Config::rtreeDefragmentBudget);
+	if(m_toComb.empty() && m_emptySlots.empty() && needsSort())
+		sort();
+	validate();
+	m_lastPrepareDuration = util::getCurrentTimeInMicroSeconds() - start;
 }
 template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
 void RTreeData<T, config_, nullPrimitive>::clear()
 {
+	if(m_trackChanges && !m_nodes.front().empty())
+		recordChanged(m_nodes.front().getCuboids().boundry());
 	m_nodes.resize(1);
 	m_nodes[RTreeNodeIndex::create(0)].clear();
 	m_emptySlots.clear();
 	m_toComb.clear();
+	m_unsortedNodes = 0;
 }
 template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
 bool RTreeData<T, config_, nullPrimitive>::anyLeafOverlapsAnother() const
@@ -1156,8 +1193,13 @@ template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
 CuboidSet RTreeData<T, config_, nullPrimitive>::getLeafCuboids() const
 {
 	CuboidSet output;
-	for(const Node& node : m_nodes)
+	const int end = m_nodes.size();
+	for(RTreeNodeIndex index{0}; index != end; ++index)
 	{
+		// Empty slots may still hold leaves which have been merged into another node.
+		if(m_emptySlots.contains(index))
+			continue;
+		const Node& node = m_nodes[index];
 		const int leafCount = node.getLeafCount();
 		const auto& cuboids = node.getCuboids();
 		for(RTreeArrayIndex i{0}; i < leafCount; ++i)
@@ -1168,7 +1210,35 @@ CuboidSet RTreeData<T, config_, nullPrimitive>::getLeafCuboids() const
 template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
 bool RTreeData<T, config_, nullPrimitive>::canPrepare() const
 {
-	return !m_toComb.empty() || !m_emptySlots.empty();
+	return !m_toComb.empty() || !m_emptySlots.empty() || needsSort();
+}
+template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
+RTreeMetrics RTreeData<T, config_, nullPrimitive>::getMetrics() const
+{
+	RTreeMetrics output;
+	output.lastPrepareDuration = m_lastPrepareDuration;
+	output.emptySlots = m_emptySlots.size();
+	output.toComb = m_toComb.size();
+	output.unsortedNodes = m_unsortedNodes;
+	int usedSlots = 0;
+	// Walk from the root rather then iterating m_nodes so empty slots are not counted.
+	std::vector<std::pair<RTreeNodeIndex, int>> openList;
+	openList.emplace_back(RTreeNodeIndex::create(0), 1);
+	while(!openList.empty())
+	{
+		const auto [index, depth] = openList.back();
+		openList.pop_back();
+		const Node& node = m_nodes[index];
+		++output.nodeCount;
+		output.depth = std::max(output.depth, depth);
+		output.leafCount += node.getLeafCount();
+		usedSlots += node.getLeafCount() + node.getChildCount();
+		const auto& dataAndChildren = node.getDataAndChildIndices();
+		for(RTreeArrayIndex i = node.offsetOfFirstChild(); i != nodeSize; ++i)
+			openList.emplace_back(RTreeNodeIndex::create(dataAndChildren[i].child), depth + 1);
+	}
+	output.fillFactor = (float)usedSlots / (float)(output.nodeCount * nodeSize);
+	return output;
 }
 template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
 void RTreeData<T, config_, nullPrimitive>::validate() const
@@ -1238,6 +1308,95 @@ void RTreeData<T, config_, nullPrimitive>::load(const Json& data)
 	data["toComb"].get_to(m_toComb);
 }
 template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
+void RTreeData<T, config_, nullPrimitive>::writeBinary(BinaryArchiveWriter& writer) const
+{
+	if constexpr(!std::is_pointer_v<typename T::Primitive>)
+	{
+		writer.writeBlock(m_nodes.toVector().data(), m_nodes.size());
+		writer.writeBlock(m_emptySlots.getVector().data(), m_emptySlots.size());
+		writer.writeBlock(m_toComb.getVector().data(), m_toComb.size());
+	}
+	else
+	{
+		assert(false);
+		std::unreachable();
+	}
+}
+template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
+void RTreeData<T, config_, nullPrimitive>::loadBinary(BinaryArchiveReader& reader)
+{
+	if constexpr(!std::is_pointer_v<typename T::Primitive>)
+	{
+		// Child and parent indices are positions in m_nodes, so nodes are valid as soon as they are copied in.
+		reader.readBlock(m_nodes.getVector());
+		reader.readBlock(m_emptySlots.getVector());
+		reader.readBlock(m_toComb.getVector());
+		RTreeBinary::checkLoaded<nodeSize>(reader, m_nodes, m_emptySlots, m_toComb, [](const Node& node, const RTreeArrayIndex arrayIndex) { return RTreeNodeIndex::create(node.getDataAndChildIndices()[arrayIndex].child); });
+	}
+	else
+	{
+		assert(false);
+		std::unreachable();
+	}
+}
+template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
+typename RTreeData<T, config_, nullPrimitive>::Changes RTreeData<T, config_, nullPrimitive>::takeChanges()
+{
+	assert(m_trackChanges);
+	// Merge overlapping records so each leaf is only written once per region.
+	CuboidSet regions;
+	for(const Cuboid cuboid : m_changed)
+		regions.maybeAdd(cuboid);
+	m_changed.clear();
+	Changes output;
+	for(const Cuboid region : regions)
+	{
+		output.regions.push_back(region);
+		queryForEachWithCuboids(region, [&](const Cuboid cuboid, const T& value)
+		{
+			output.leafCuboids.push_back(cuboid.intersection(region));
+			output.leafValues.push_back(value.get());
+		});
+	}
+	return output;
+}
+template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
+void RTreeData<T, config_, nullPrimitive>::writeChanges(const Changes& changes, BinaryArchiveWriter& writer)
+{
+	if constexpr(!std::is_pointer_v<typename T::Primitive>)
+	{
+		writer.writeBlock(changes.regions.data(), changes.regions.size());
+		writer.writeBlock(changes.leafCuboids.data(), changes.leafCuboids.size());
+		writer.writeBlock(changes.leafValues.data(), changes.leafValues.size());
+	}
+	else
+	{
+		assert(false);
+		std::unreachable();
+	}
+}
+template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
+void RTreeData<T, config_, nullPrimitive>::applyChanges(BinaryArchiveReader& reader)
+{
+	if constexpr(!std::is_pointer_v<typename T::Primitive>)
+	{
+		Changes changes;
+		reader.readBlock(changes.regions);
+		reader.readBlock(changes.leafCuboids);
+		reader.readBlock(changes.leafValues);
+		assert(changes.leafCuboids.size() == changes.leafValues.size());
+		for(const Cuboid region : changes.regions)
+			maybeRemove(region);
+		for(size_t i = 0; i != changes.leafCuboids.size(); ++i)
+			maybeInsert(changes.leafCuboids[i], T::create(changes.leafValues[i]));
+	}
+	else
+	{
+		assert(false);
+		std::unreachable();
+	}
+}
+template<Sortable T, RTreeDataConfig config_, T::Primitive nullPrimitive>
 int RTreeData<T, config_, nullPrimitive>::nodeCount() const
 {
 	return m_nodes.size() - m_emptySlots.size();
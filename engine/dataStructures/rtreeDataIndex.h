@@ -74,7 +74,9 @@ public:
 	}
 	void clear();
 	void prepare();
+	void prepareIncremental();
 	[[nodiscard]] bool canPrepare() const;
+	[[nodiscard]] RTreeMetrics getMetrics() const { return m_tree.getMetrics(); }
 	[[nodiscard]] bool empty() const;
 	[[nodiscard]] bool queryAny(const auto& shape) const { return m_tree.queryAny(shape); }
 	[[nodiscard]] bool queryAnyWithCondition(const auto& shape, const auto& condition) const
@@ -34,6 +34,8 @@ void RTreeDataIndex<T, config>::clear() { m_tree.clear(); m_data.clear(); }
 template<typename T, RTreeDataConfig config>
 void RTreeDataIndex<T, config>::prepare() { m_tree.prepare(); }
 template<typename T, RTreeDataConfig config>
+void RTreeDataIndex<T, config>::prepareIncremental() { m_tree.prepareIncremental(); }
+template<typename T, RTreeDataConfig config>
 bool RTreeDataIndex<T, config>::canPrepare() const { return m_tree.canPrepare(); }
 template<typename T, RTreeDataConfig config>
 bool RTreeDataIndex<T, config>::empty() const { return m_tree.empty(); }
@@ -0,0 +1,19 @@
+#pragma once
+#include <chrono>
+
+// The shape of an R-tree and how much preparation it is waiting for, see Space::getRTreeMetrics.
+struct RTreeMetrics
+{
+	std::chrono::microseconds lastPrepareDuration = std::chrono::microseconds(0);
+	// Nodes reachable from the root.
+	int nodeCount = 0;
+	int leafCount = 0;
+	// Levels from the root to the deepest node, a tree with only a root has a depth of 1.
+	int depth = 0;
+	int emptySlots = 0;
+	int toComb = 0;
+	// Nodes added or moved since the last sort.
+	int unsortedNodes = 0;
+	// Slots holding a leaf or a child divided by the capacity of all reachable nodes.
+	float fillFactor = 0.f;
+};
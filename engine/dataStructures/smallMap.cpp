@@ -97,7 +97,7 @@ template struct SmallMap<ItemReference, Quantity>;
 template struct SmallMap<ItemReference, SmallSet<StockPileProject*>>;
 template struct SmallMap<ItemReference, std::pair<ProjectRequirementCounts*, Quantity>>;
 template struct SmallMap<ItemTypeId, ItemTypeParamaters>;
-template struct SmallMap<ItemTypeId, SmallMap<MaterialTypeId, SmallSet<ItemIndex>>>;
+template struct SmallMap<ItemTypeId, SmallMap<MaterialTypeId, AdaptiveSet<ItemIndex, ItemIndex::Hash>>>;
 template struct SmallMap<ItemTypeId, SmallSet<ItemReference>>;
 template struct SmallMap<ItemTypeId, SmallSet<StockPile*>>;
 template struct SmallMap<Offset3D, MaterialTypeId>;
@@ -12,6 +12,8 @@ public:
 	using const_iterator = std::vector<Contained>::const_iterator;
 	using const_reverse_iterator = std::vector<Contained>::const_reverse_iterator;
 	[[nodiscard]] const std::vector<Contained>& toVector() const;
+	// For reading directly into, as with SmallSet::getVector.
+	[[nodiscard]] std::vector<Contained>& getVector() { return data; }
 	[[nodiscard]] Contained& operator[](const Index index);
 	[[nodiscard]] const Contained& operator[](const Index index) const;
 	[[nodiscard]] int size() const;
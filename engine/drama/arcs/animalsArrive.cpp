@@ -33,7 +33,7 @@ Json AnimalsArriveDramaArc::toJson() const
 }
 void AnimalsArriveDramaArc::callback()
 {
-	auto& random = m_area->m_simulation.m_random;
+	auto& random = m_area->m_random;
 	if(m_isActive)
 	{
 		SmallSet<Point3D> exclude;
@@ -97,7 +97,7 @@ void AnimalsArriveDramaArc::callback()
 			m_isActive = true;
 			// Anounce.
 			std::string message = std::to_string(m_quantity.get()) + " " + AnimalSpecies::getName(m_species) + " spotted nearby.";
-			m_engine.getSimulation().m_hasDialogues.createMessageBox(message, m_entrancePoint);
+			m_area->writeToSimulation([&simulation = m_engine.getSimulation(), message, location = m_entrancePoint]{ simulation.m_hasDialogues.createMessageBox(message, location); });
 			// Reenter.
 			callback();
 		}
@@ -106,14 +106,14 @@ void AnimalsArriveDramaArc::callback()
 void AnimalsArriveDramaArc::scheduleArrive()
 {
 	assert(!m_isActive);
-	auto& random = m_area->m_simulation.m_random;
+	auto& random = m_area->m_random;
 	Step duration = Step::create(random.getInRange((5u * Config::stepsPerDay.get()), (15u * Config::stepsPerDay.get())));
 	m_scheduledEvent.schedule(*this, m_area->m_simulation, duration);
 }
 void AnimalsArriveDramaArc::scheduleDepart()
 {
 	assert(m_isActive);
-	auto& random = m_area->m_simulation.m_random;
+	auto& random = m_area->m_random;
 	Step duration = Step::create(random.getInRange((5u * Config::stepsPerHour.get()), (5 * Config::stepsPerDay.get())));
 	m_scheduledEvent.schedule(*this, m_area->m_simulation, duration);
 }
@@ -126,7 +126,7 @@ void AnimalsArriveDramaArc::scheduleContinue()
 std::pair<AnimalSpeciesId, Quantity> AnimalsArriveDramaArc::getSpeciesAndQuantity() const
 {
 	// TODO: Species by biome.
-	auto& random = m_area->m_simulation.m_random;
+	auto& random = m_area->m_random;
 	Quantity quantity = Quantity::create(0);
 	AnimalSpeciesId species;
 	Percent roll = Percent::create(random.getInRange(0, 100));
@@ -35,7 +35,7 @@ Json BanditsArriveDramaArc::toJson() const
 }
 void BanditsArriveDramaArc::callback()
 {
-	auto& random = m_area->m_simulation.m_random;
+	auto& random = m_area->m_random;
 	static std::vector<AnimalSpeciesId> sentientSpecies = getSentientSpecies();
 	constexpr Distance maxPointDistance = Distance::create(40);
 	Actors& actors = m_area->getActors();
@@ -119,7 +119,7 @@ void BanditsArriveDramaArc::callback()
 			m_isActive = true;
 			// Anounce.
 			std::string message = std::to_string(m_quantity.get()) + " bandits spotted nearby.";
-			m_engine.getSimulation().m_hasDialogues.createMessageBox(message, m_entrancePoint);
+			m_area->writeToSimulation([&simulation = m_engine.getSimulation(), message, location = m_entrancePoint]{ simulation.m_hasDialogues.createMessageBox(message, location); });
 			// Reenter.
 			callback();
 		}
@@ -128,14 +128,14 @@ void BanditsArriveDramaArc::callback()
 void BanditsArriveDramaArc::scheduleArrive()
 {
 	assert(!m_isActive);
-	auto& random = m_area->m_simulation.m_random;
+	auto& random = m_area->m_random;
 	Step duration = Step::create(random.getInRange((Config::stepsPerDay.get() * 150), (Config::stepsPerYear.get() * 2)));
 	m_scheduledEvent.schedule(*this, m_area->m_simulation, duration);
 }
 void BanditsArriveDramaArc::scheduleDepart()
 {
 	assert(m_isActive);
-	auto& random = m_area->m_simulation.m_random;
+	auto& random = m_area->m_random;
 	Step duration = Step::create(random.getInRange(Config::stepsPerHour.get(), (Config::stepsPerHour.get() * 5)));
 	m_scheduledEvent.schedule(*this, m_area->m_simulation, duration);
 }
@@ -29,7 +29,7 @@ Json MistakeAtWorkDramaArc::toJson() const
 }
 void MistakeAtWorkDramaArc::schedule()
 {
-	auto& random = m_area->m_simulation.m_random;
+	auto& random = m_area->m_random;
 	Step duration = Step::create(random.getInRange((5u * Config::stepsPerDay.get()), (15u * Config::stepsPerDay.get())));
 	m_scheduledEvent.schedule(duration, *this, m_area->m_simulation);
 }
@@ -81,14 +81,14 @@ std::pair<ActorReference, std::string> MistakeAtWorkDramaArc::doSwitchMaybeRetur
 		}
 		case MistakeAtWorkType::HurtSomeone:
 		{
-			const auto& actorRefAndProjectWorker = m_area->m_simulation.m_random.getInVector(project.getWorkers().m_data);
+			const auto& actorRefAndProjectWorker = m_area->m_random.getInVector(project.getWorkers().m_data);
 			victim = actorRefAndProjectWorker.first;
 			const ActorIndex victimIndex = victim.getIndex(actors.m_referenceData);
 			const ItemIndex tool = project.getRandomUnconsumedItem();
 			const Force hitForce = Force::create(actors.getStrength(perpetrator).get() * Config::unitsOfAttackForcePerUnitOfStrength);
 			// TODO: Higher skill selects more important body parts to hit.
 			BodyPart& bodyPart = actors.body_pickABodyPartByVolume(victimIndex);
-			auto& random = m_area->m_simulation.m_random;
+			auto& random = m_area->m_random;
 			int hitArea = random.getInRange(Config::accidentalHitSmallestArea, Config::accidentalHitLargestArea);
 			// TODO: Generate wountType from hit area.
 			const WoundType woundType = random.getInEnum<WoundType>();
@@ -118,9 +118,9 @@ void MistakeAtWorkDramaArc::callback()
 			continue;
 		Project& project = *projectPtr;
 		std::string description;
-		const ActorIndex perpetrator = m_area->m_simulation.m_random.getInVector(project.getWorkers().m_data).first.getIndex(actors.m_referenceData);
+		const ActorIndex perpetrator = m_area->m_random.getInVector(project.getWorkers().m_data).first.getIndex(actors.m_referenceData);
 		description += actors.getName(perpetrator) + " made a mistake while working on " + project.description() + " resulting in ";
-		MistakeAtWorkType mistakeType = m_area->m_simulation.m_random.getInEnum<MistakeAtWorkType>();
+		MistakeAtWorkType mistakeType = m_area->m_random.getInEnum<MistakeAtWorkType>();
 		// Make a copy before maybe reseting the project.
 		SmallSet<ActorIndex> coworkers;
 		for(const auto& [worker, projectWorker] : project.getWorkers())
@@ -186,7 +186,7 @@ void MistakeAtWorkDramaArc::callback()
 		}
 		if(chastiser.exists())
 		{
-			int duration = m_area->m_simulation.m_random.getInRange(Config::Social::minimumDurationToChastiseCycles, Config::Social::maximumDurationToChastiseCycles);
+			int duration = m_area->m_random.getInRange(Config::Social::minimumDurationToChastiseCycles, Config::Social::maximumDurationToChastiseCycles);
 			if(death)
 				duration *= Config::Social::multipleForChastiseDurationIfSomeoneWasKilled;
 			else if(mistakeType == MistakeAtWorkType::HurtSomeone)
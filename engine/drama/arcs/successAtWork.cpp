@@ -30,7 +30,7 @@ Json SuccessAtWorkDramaArc::toJson() const
 }
 void SuccessAtWorkDramaArc::schedule()
 {
-	auto& random = m_area->m_simulation.m_random;
+	auto& random = m_area->m_random;
 	Step duration = Step::create(random.getInRange((5u * Config::stepsPerDay.get()), (15u * Config::stepsPerDay.get())));
 	m_scheduledEvent.schedule(duration, *this, m_area->m_simulation);
 }
@@ -89,10 +89,10 @@ void SuccessAtWorkDramaArc::callback()
 		if(projects.empty())
 			continue;
 		std::string description;
-		Project& project = *m_area->m_simulation.m_random.getInVector(projects.m_data).get();
-		const ActorIndex worker = m_area->m_simulation.m_random.getInVector(project.getWorkers().m_data).first.getIndex(actors.m_referenceData);
+		Project& project = *m_area->m_random.getInVector(projects.m_data).get();
+		const ActorIndex worker = m_area->m_random.getInVector(project.getWorkers().m_data).first.getIndex(actors.m_referenceData);
 		description += actors.getName(worker) + " made a success while working on " + project.description() + " resulting in ";
-		SuccessAtWorkType successType = m_area->m_simulation.m_random.getInEnum<SuccessAtWorkType>();
+		SuccessAtWorkType successType = m_area->m_random.getInEnum<SuccessAtWorkType>();
 		// Make a copy before maybe completing the project.
 		SmallSet<ActorIndex> coworkers;
 		const auto& projectWorkers = project.getWorkers();
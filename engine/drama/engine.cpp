@@ -141,7 +141,7 @@ Point3D DramaArc::getEntranceToArea(const ShapeId shape, const MoveTypeId moveTy
 		}
 		if(candidates.empty())
 			return Point3D::null();
-		candidate = candidates[m_area->m_simulation.m_random.getInRange(0u, candidates.size() - 1u)];
+		candidate = candidates[m_area->m_random.getInRange(0u, candidates.size() - 1u)];
 	}
 	while (!pointIsConnectedToAtLeast(candidate, shape, moveType, minimumConnectedCount));
 	assert(candidate.exists());
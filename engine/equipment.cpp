@@ -133,7 +133,7 @@ void EquipmentSet::modifyImpact(Area& area, Hit& hit, const BodyPartTypeId bodyP
 		ItemIndex itemIndex = equipment.getIndex(items.m_referenceData);
 		ItemTypeId itemType = area.getItems().getItemType(itemIndex);
 		MaterialTypeId materialType = area.getItems().getMaterialType(itemIndex);
-		Random& random = area.m_simulation.m_random;
+		Random& random = area.m_random;
 		auto& bodyPartsCovered = ItemType::getWearable_bodyPartsCovered(itemType);
 		auto chance = ItemType::getWearable_percentCoverage(itemType);
 		if(std::ranges::find(bodyPartsCovered, bodyPartType) != bodyPartsCovered.end() && random.percentChance(chance))
@@ -3,7 +3,11 @@
 #include "numericTypes/types.h"
 #include "util.h"
 #include "area/area.h"
+#include "threads.h"
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <utility>
 ScheduledEvent::ScheduledEvent(Simulation& simulation, const Step delay, const Step start) :
 	m_startStep(start.empty() ? simulation.m_step : start), m_step(m_startStep + delay)
 {
@@ -37,50 +41,235 @@ float ScheduledEvent::fractionComplete(Simulation& simulation) const
 }
 
 Step ScheduledEvent::duration() const { return Step::create(m_step.get() - m_startStep.get()); }
-void EventSchedule::schedule(std::unique_ptr<ScheduledEvent> scheduledEvent)
+EventSchedule::EventSchedule(Simulation& s, Area* area) :
+	m_simulation(s),
+	m_area(area),
+	m_fine(slotCount),
+	m_coarse(slotCount)
+{ }
+EventSchedule::Slot& EventSchedule::getSlot(const Step step)
 {
-	m_data[scheduledEvent->m_step].push_back(std::move(scheduledEvent));
+	return const_cast<Slot&>(std::as_const(*this).getSlot(step));
+}
+const EventSchedule::Slot& EventSchedule::getSlot(const Step step) const
+{
+	assert(step >= m_now);
+	const StepWidth block = step.get() >> slotBits;
+	const StepWidth currentBlock = m_now.get() >> slotBits;
+	if(block == currentBlock)
+		return m_fine[step.get() & slotMask];
+	if((block >> slotBits) == (currentBlock >> slotBits))
+		return m_coarse[block & slotMask];
+	return m_overflow;
+}
+void EventSchedule::setOccupied(const Step step, const bool occupied)
+{
+	const StepWidth block = step.get() >> slotBits;
+	const StepWidth currentBlock = m_now.get() >> slotBits;
+	Occupancy* occupancy;
+	int index;
+	if(block == currentBlock)
+	{
+		occupancy = &m_fineOccupancy;
+		index = step.get() & slotMask;
+	}
+	else if((block >> slotBits) == (currentBlock >> slotBits))
+	{
+		occupancy = &m_coarseOccupancy;
+		index = block & slotMask;
+	}
+	else
+		return;
+	const uint64_t bit = uint64_t(1) << (index % 64);
+	if(occupied)
+		(*occupancy)[index / 64] |= bit;
+	else
+		(*occupancy)[index / 64] &= ~bit;
+}
+void EventSchedule::insert(Pooled<ScheduledEvent> scheduledEvent)
+{
+	const Step step = scheduledEvent->m_step;
+	Slot& slot = getSlot(step);
+	scheduledEvent->m_scheduleIndex = slot.size();
+	slot.push_back(std::move(scheduledEvent));
+	if(slot.size() == 1)
+		setOccupied(step, true);
+	++m_size;
+}
+Pooled<ScheduledEvent> EventSchedule::remove(ScheduledEvent& scheduledEvent)
+{
+	Slot& slot = getSlot(scheduledEvent.m_step);
+	assert(slot[scheduledEvent.m_scheduleIndex].get() == &scheduledEvent);
+	Pooled<ScheduledEvent> output = swapRemove(slot, scheduledEvent.m_scheduleIndex);
+	if(slot.empty())
+		setOccupied(scheduledEvent.m_step, false);
+	--m_size;
+	return output;
+}
+void EventSchedule::advance(const Step step)
+{
+	assert(step >= m_now);
+	const StepWidth oldBlock = m_now.get() >> slotBits;
+	const StepWidth newBlock = step.get() >> slotBits;
+	m_now = step;
+	if(oldBlock == newBlock)
+		return;
+	// Everything before step has been executed, so the fine level is empty and the coarse level has nothing before the new block.
+	assert(findOccupied(m_fineOccupancy, 0) == -1);
+	Slot toSpread;
+	const StepWidth newSuperBlock = newBlock >> slotBits;
+	if((oldBlock >> slotBits) == newSuperBlock)
+	{
+		const int index = newBlock & slotMask;
+		toSpread = std::move(m_coarse[index]);
+		m_coarse[index].clear();
+		m_coarseOccupancy[index / 64] &= ~(uint64_t(1) << (index % 64));
+	}
+	else
+	{
+		assert(findOccupied(m_coarseOccupancy, 0) == -1);
+		for(int i = 0; i < (int)m_overflow.size();)
+			if((m_overflow[i]->m_step.get() >> (slotBits * 2)) == newSuperBlock)
+				toSpread.push_back(swapRemove(m_overflow, i));
+			else
+				++i;
+	}
+	m_size -= toSpread.size();
+	for(Pooled<ScheduledEvent>& scheduledEvent : toSpread)
+		insert(std::move(scheduledEvent));
+}
+Pooled<ScheduledEvent> EventSchedule::swapRemove(Slot& slot, const int index)
+{
+	Pooled<ScheduledEvent> output = std::move(slot[index]);
+	if(index != (int)slot.size() - 1)
+	{
+		slot[index] = std::move(slot.back());
+		slot[index]->m_scheduleIndex = index;
+	}
+	slot.pop_back();
+	return output;
+}
+int EventSchedule::findOccupied(const Occupancy& occupancy, const int begin)
+{
+	if(begin >= slotCount)
+		return -1;
+	int word = begin / 64;
+	uint64_t bits = occupancy[word] & (~uint64_t(0) << (begin % 64));
+	while(bits == 0)
+	{
+		++word;
+		if(word == (int)occupancy.size())
+			return -1;
+		bits = occupancy[word];
+	}
+	return word * 64 + std::countr_zero(bits);
+}
+Step EventSchedule::getMinimumStep(const Slot& slot)
+{
+	assert(!slot.empty());
+	Step output = slot.front()->m_step;
+	for(const Pooled<ScheduledEvent>& scheduledEvent : slot)
+		output = std::min(output, scheduledEvent->m_step);
+	return output;
+}
+void EventSchedule::schedule(Pooled<ScheduledEvent> scheduledEvent)
+{
+	threads::assertNotInReadPhase();
+	if(m_area == nullptr)
+		threads::assertNotInConcurrentAreaStep();
+	insert(std::move(scheduledEvent));
 }
 void EventSchedule::unschedule(ScheduledEvent& scheduledEvent)
 {
-	assert(m_data.contains(scheduledEvent.m_step));
+	threads::assertNotInReadPhase();
+	if(m_area == nullptr)
+		threads::assertNotInConcurrentAreaStep();
 	scheduledEvent.m_cancel = true;
 	scheduledEvent.clearReferences(m_simulation, m_area);
+	// Events due this step are owned by m_executing untill the step is finished.
+	if(scheduledEvent.m_step == m_executingStep)
+		return;
+	// Destroyed when removed goes out of scope.
+	[[maybe_unused]] Pooled<ScheduledEvent> removed = remove(scheduledEvent);
+}
+void EventSchedule::reschedule(ScheduledEvent& scheduledEvent, const Step step)
+{
+	Pooled<ScheduledEvent> owned = take(scheduledEvent);
+	owned->m_step = step;
+	schedule(std::move(owned));
+}
+Pooled<ScheduledEvent> EventSchedule::take(ScheduledEvent& scheduledEvent)
+{
+	threads::assertNotInReadPhase();
+	if(scheduledEvent.m_step == m_executingStep)
+	{
+		// Leaves nullptr in m_executing, which doStep skips.
+		assert(m_executing[scheduledEvent.m_scheduleIndex].get() == &scheduledEvent);
+		return std::move(m_executing[scheduledEvent.m_scheduleIndex]);
+	}
+	return remove(scheduledEvent);
 }
 void EventSchedule::doStep(const Step stepNumber)
 {
-	if(m_data.begin()->first > stepNumber)
+	// Tests may run a schedule ahead of the simulation step.
+	if(stepNumber < m_now)
 		return;
-	assert(m_data.begin()->first == stepNumber);
-	for(std::unique_ptr<ScheduledEvent>& scheduledEvent : m_data.begin()->second)
-		if(!scheduledEvent->m_cancel)
+	advance(stepNumber);
+	const int index = stepNumber.get() & slotMask;
+	if(m_fine[index].empty())
+		return;
+	assert(m_executing.empty());
+	m_executing = std::move(m_fine[index]);
+	m_fine[index].clear();
+	m_fineOccupancy[index / 64] &= ~(uint64_t(1) << (index % 64));
+	m_size -= m_executing.size();
+	m_executingStep = stepNumber;
+	// Events never schedule for the current step, so m_executing does not grow while iterating.
+	for(Pooled<ScheduledEvent>& scheduledEvent : m_executing)
+		if(scheduledEvent != nullptr && !scheduledEvent->m_cancel)
 		{
 			// Clear references first so events can reschedule themselves in the same slots.
 			scheduledEvent->clearReferences(m_simulation, m_area);
 			scheduledEvent->execute(m_simulation, m_area);
 		}
-	m_data.erase(m_data.begin());
+	m_executing.clear();
+	m_executingStep.clear();
 }
 void EventSchedule::clear()
 {
-	for(auto& [step, events] : m_data)
-		for(std::unique_ptr<ScheduledEvent>& scheduledEvent : events)
-			if(!scheduledEvent->m_cancel)
+	auto clearReferences = [&](Slot& slot)
+	{
+		for(Pooled<ScheduledEvent>& scheduledEvent : slot)
+			if(scheduledEvent != nullptr && !scheduledEvent->m_cancel)
 				scheduledEvent->clearReferences(m_simulation, m_area);
+	};
+	for(Slot& slot : m_fine)
+		clearReferences(slot);
+	for(Slot& slot : m_coarse)
+		clearReferences(slot);
+	clearReferences(m_overflow);
+	clearReferences(m_executing);
 }
 Step EventSchedule::getNextEventStep() const
 {
-	if(m_data.empty())
+	if(m_size == 0)
 		return Step::null();
-	return m_data.begin()->first;
+	const StepWidth currentBlock = m_now.get() >> slotBits;
+	int index = findOccupied(m_fineOccupancy, m_now.get() & slotMask);
+	if(index != -1)
+		return Step::create((currentBlock << slotBits) + index);
+	index = findOccupied(m_coarseOccupancy, (currentBlock & slotMask) + 1);
+	if(index != -1)
+		return getMinimumStep(m_coarse[index]);
+	return getMinimumStep(m_overflow);
 }
-int EventSchedule::count()
+int EventSchedule::countForStep(const Step step) const
 {
-	int output = 0;
-	for(auto& pair : m_data)
-		for(auto& event : pair.second)
-			if(!event->m_cancel)
-				output++;
-	return output;
+	if(step < m_now)
+		return 0;
+	if(step == m_executingStep)
+		return std::ranges::count_if(m_executing, [](const Pooled<ScheduledEvent>& scheduledEvent) { return scheduledEvent != nullptr; });
+	const Slot& slot = getSlot(step);
+	return std::ranges::count_if(slot, [step](const Pooled<ScheduledEvent>& scheduledEvent) { return scheduledEvent->m_step == step; });
 }
-Step EventSchedule::simulationStep() const { return m_simulation.m_step; }
+Step EventSchedule::simulationStep() const { return m_simulation.m_step; }
\ No newline at end of file
@@ -8,7 +8,10 @@
 #include "config/config.h"
 #include "numericTypes/types.h"
 #include "numericTypes/index.h"
+#include "allocators/sizeClassPool.h"
 
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <memory>
@@ -22,6 +25,8 @@ class ScheduledEvent
 public:
 	Step m_startStep;
 	Step m_step;
+	// Position within the EventSchedule slot which holds this event.
+	int m_scheduleIndex = -1;
 	bool m_cancel = false;
 	// If the value 0 is passed then the current step is used for start
 	// Passing a differernt start is for deserializing.
@@ -44,21 +49,64 @@ public:
 	ScheduledEvent(ScheduledEvent&&) = delete;
 	NLOHMANN_DEFINE_TYPE_INTRUSIVE(ScheduledEvent, m_startStep, m_step, m_cancel);
 };
+/*
+ * Events are held in a two level timing wheel.
+ * The fine level has a slot for each step of the block of 2^Config::eventScheduleWheelBits steps which contains the current step.
+ * The coarse level has a slot for each block of the current super block, which is 2^Config::eventScheduleWheelBits blocks. Anything further out is held in an unsorted overflow list.
+ * When the current step enters a new block the coarse slot for that block is spread into the fine level, when it enters a new super block the overflow list is scanned for events which belong to it.
+ * Each event stores it's index within it's slot so schedule and unschedule are O(1).
+ * Cancelled events are destroyed immediately, except those due on the step being executed, which are destroyed when the step is finished.
+ */
 class EventSchedule
 {
+	static constexpr int slotBits = Config::eventScheduleWheelBits;
+	static constexpr int slotCount = 1 << slotBits;
+	static constexpr StepWidth slotMask = slotCount - 1;
+	using Slot = std::vector<Pooled<ScheduledEvent>>;
+	using Occupancy = std::array<uint64_t, slotCount / 64>;
 	Simulation& m_simulation;
 	Area* m_area = nullptr;
+	// Declared before the slots so it outlives the events they hold.
+	SizeClassPool m_pool;
+	std::vector<Slot> m_fine;
+	std::vector<Slot> m_coarse;
+	Slot m_overflow;
+	Occupancy m_fineOccupancy = {};
+	Occupancy m_coarseOccupancy = {};
+	// Events due on the step being executed are moved here so the slot can be reused. They may still be cancelled or taken by events which execute before them.
+	Slot m_executing;
+	Step m_executingStep;
+	// Every event before this step has been executed.
+	Step m_now = Step::create(0);
+	int m_size = 0;
+	[[nodiscard]] Slot& getSlot(const Step step);
+	[[nodiscard]] const Slot& getSlot(const Step step) const;
+	void setOccupied(const Step step, const bool occupied);
+	void insert(Pooled<ScheduledEvent> scheduledEvent);
+	[[nodiscard]] Pooled<ScheduledEvent> remove(ScheduledEvent& scheduledEvent);
+	// Move the current step forward, spreading coarse slots and overflow into the fine level as needed.
+	void advance(const Step step);
+	[[nodiscard]] static Pooled<ScheduledEvent> swapRemove(Slot& slot, const int index);
+	[[nodiscard]] static int findOccupied(const Occupancy& occupancy, const int begin);
+	[[nodiscard]] static Step getMinimumStep(const Slot& slot);
 public:
-	EventSchedule(Simulation& s, Area* area) : m_simulation(s), m_area(area) { }
-	std::map<Step, std::vector<std::unique_ptr<ScheduledEvent>>> m_data;
-	void schedule(std::unique_ptr<ScheduledEvent> scheduledEvent);
+	EventSchedule(Simulation& s, Area* area);
+	void schedule(Pooled<ScheduledEvent> scheduledEvent);
+	// Adopts an event which was not created by getPool.
+	void schedule(std::unique_ptr<ScheduledEvent> scheduledEvent) { schedule(Pooled<ScheduledEvent>(scheduledEvent.release())); }
 	void unschedule(ScheduledEvent& scheduledEvent);
+	void reschedule(ScheduledEvent& scheduledEvent, const Step step);
+	// Remove without cancelling, for running an event early.
+	[[nodiscard]] Pooled<ScheduledEvent> take(ScheduledEvent& scheduledEvent);
 	void doStep(const Step stepNumber);
 	void clear();
 	[[nodiscard]] Step getNextEventStep() const;
 	[[nodiscard]] Simulation& getSimulation() { return m_simulation; }
 	[[nodiscard]] Area* getArea() { return m_area; }
+	[[nodiscard]] SizeClassPool& getPool() { return m_pool; }
+	[[nodiscard]] const SizeClassPool& getPool() const { return m_pool; }
 	[[nodiscard]] Step simulationStep() const;
-	// For testing.
-	[[maybe_unused, nodiscard]]int count();
-};
+	[[nodiscard]] bool empty() const { return m_size == 0; }
+	[[nodiscard]] int count() const { return m_size; }
+	[[nodiscard]] int countForStep(const Step step) const;
+};
\ No newline at end of file
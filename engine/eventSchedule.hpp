@@ -22,7 +22,7 @@ public:
 	void schedule(Args&& ...args)
 	{
 		assert(!exists());
-		std::unique_ptr<ScheduledEvent> event = std::make_unique<EventType>(args...);
+		Pooled<ScheduledEvent> event = m_schedule->getPool().create<EventType>(args...);
 		m_event = event.get();
 		m_schedule->schedule(std::move(event));
 	}
@@ -40,22 +40,11 @@ public:
 	void clearPointer() { assert(exists()); m_event = nullptr; }
 	void updateStep(const Step to)
 	{
-		// It is safe to move events from one step to another because they are refered to only via their addresses, which are not changing as their unique_ptr handles are moved,
 		assert(exists());
-		Step& from = m_event->m_step;
-		assert(from != to);
+		assert(m_event->m_step != to);
 		// This assertation is commented out because simulation is not avalible in this TU.
-		//assert(from > m_schedule->getSimulation().m_step);
-		const auto found = std::ranges::find(m_schedule->m_data[from], m_event, [&](const std::unique_ptr<ScheduledEvent>& ptr) { return ptr.get(); });
-		assert(found != m_schedule->m_data[from].end());
-		// Update m_step recorded in the ScheduledEvent.
-		std::unique_ptr<ScheduledEvent>& event = *found;
-		event->m_step = to;
-		// Move and erase.
-		m_schedule->m_data[to].push_back(std::move(event));
-		auto& fromVector = m_schedule->m_data[from];
-		(*found) = std::move(fromVector.back());
-		fromVector.pop_back();
+		//assert(m_event->m_step > m_schedule->getSimulation().m_step);
+		m_schedule->reschedule(*m_event, to);
 	}
 	void bonusPercent(const Percent percent, const Step currentStep)
 	{
@@ -64,11 +53,7 @@ public:
 		if(to >= m_event->m_step)
 		{
 			// Run event now.
-			auto& vector = m_schedule->m_data[m_event->m_step];
-			const auto found = std::ranges::find(vector, m_event, [&](const std::unique_ptr<ScheduledEvent>& ptr) { return ptr.get(); });
-			std::unique_ptr<ScheduledEvent> event = std::move(*found);
-			(*found) = std::move(vector.back());
-			vector.pop_back();
+			Pooled<ScheduledEvent> event = m_schedule->take(*m_event);
 			clearPointer();
 			event->execute(m_schedule->getSimulation(), m_schedule->getArea());
 		}
@@ -146,7 +131,7 @@ public:
 		for(auto iter = data.begin(); iter != data.end(); ++iter)
 		{
 			const Index index = Index::create(std::stoi(iter.key()));
-			auto event = std::make_unique<EventType>(simulation, iter.value());
+			Pooled<EventType> event = m_schedule.getPool().create<EventType>(simulation, iter.value());
 			m_events[index] = event.get();
 			m_schedule.schedule(std::move(event));
 		}
@@ -160,7 +145,7 @@ public:
 	{
 		assert(m_events.size() > index.get());
 		assert(m_events[index] == nullptr);
-		std::unique_ptr<ScheduledEvent> event = std::make_unique<EventType>(args...);
+		Pooled<ScheduledEvent> event = m_schedule.getPool().create<EventType>(args...);
 		m_events[index] = static_cast<EventType*>(event.get());
 		m_schedule.schedule(std::move(event));
 	}
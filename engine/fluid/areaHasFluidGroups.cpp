@@ -9,32 +9,30 @@ void AreaHasFluidGroups::doStep()
 	// Collect groups created by split in newGroups so they can be instanced after iteration completes.
 	SmallMap<FluidTypeId, std::vector<std::pair<CuboidSet, int64_t>>> newGroups;
 	Space& space = m_area.getSpace();
+	findIndependent();
+	threads::forEachWorkStealing(m_workStealingRanges, m_independent.size(), [&](const int index)
+	{
+		threads::ReadPhaseGuard guard;
+		FluidGroup& group = *m_independent[index];
+		computeFlow(group);
+		group.m_flowComputed = true;
+	});
+	// Apply independent groups before computing any other, so everything computed sequentially sees their changes.
+	for(FluidGroup& group : m_groups)
+		if(group.m_flowComputed)
+			applyFlow(group, newGroups);
+	// Groups which were not independent are computed here in order, as are stable groups made unstable by groups before them.
 	for(FluidGroup& group : m_groups)
 	{
-		if(group.m_stable)
-			continue;
-		// Prepare.
-		group.m_occupied.prepare();
-		// Flow.
-		group.maybeDisplaceFromMoreDenseFluid(m_area);
-		group.maybeExpand(m_area);
-		group.maybeConsolidate();
-		if(group.m_newlyAdded.empty() && group.m_noLongerOccupied.empty())
-			group.m_stable = true;
-		else
-		{
-			space.fluid_flowInto(group.m_newlyAdded, group.m_fluidType, group);
-			space.fluid_flowOutFrom(group.m_noLongerOccupied, group.m_fluidType);
-			group.maybeSetLowerDensityAdjacentUnstable(m_area);
-		}
-		// Find new groups to split.
-		std::vector<std::pair<CuboidSet, int64_t>> newGroupsFromThisGroup = group.maybeSplit();
-		if(!newGroupsFromThisGroup.empty())
+		if(group.m_flowComputed)
 		{
-			std::vector<std::pair<CuboidSet, int64_t>>& groupsForFluidType = newGroups.getOrCreate(group.m_fluidType);
-			for(auto& [cuboidSet, volume] : newGroupsFromThisGroup)
-				groupsForFluidType.emplace_back(std::move(cuboidSet), volume);
+			group.m_flowComputed = false;
+			continue;
 		}
+		if(group.m_stable)
+			continue;
+		computeFlow(group);
+		applyFlow(group, newGroups);
 	}
 	// Create newly split off groups.
 	for(auto [fluidType, groups] : newGroups)
@@ -55,6 +53,64 @@ void AreaHasFluidGroups::doStep()
 		group.m_noLongerOccupied.clear();
 	}
 }
+void AreaHasFluidGroups::findIndependent()
+{
+	m_independent.clear();
+	// Sweep along x over the boundries of unstable groups, inflated by one for the points each may flow into.
+	std::vector<std::pair<Cuboid, FluidGroup*>> candidates;
+	for(FluidGroup& group : m_groups)
+		if(!group.m_stable)
+			candidates.emplace_back(group.m_occupied.boundry().inflated({1}), &group);
+	if(candidates.size() < 2)
+		return;
+	std::ranges::sort(candidates, {}, [](const auto& pair){ return pair.first.m_low.x(); });
+	std::vector<bool> isIndependent(candidates.size(), true);
+	std::vector<int> active;
+	for(int i = 0; i != (int)candidates.size(); ++i)
+	{
+		const Cuboid& cuboid = candidates[i].first;
+		std::erase_if(active, [&](const int other){ return candidates[other].first.m_high.x() < cuboid.m_low.x(); });
+		for(const int other : active)
+			if(candidates[other].first.intersects(cuboid))
+			{
+				isIndependent[i] = false;
+				isIndependent[other] = false;
+			}
+		active.push_back(i);
+	}
+	for(int i = 0; i != (int)candidates.size(); ++i)
+		if(isIndependent[i])
+			m_independent.push_back(candidates[i].second);
+}
+void AreaHasFluidGroups::computeFlow(FluidGroup& group)
+{
+	// Prepare.
+	group.m_occupied.prepare();
+	// Flow.
+	group.maybeDisplaceFromMoreDenseFluid(m_area);
+	group.maybeExpand(m_area);
+	group.maybeConsolidate();
+}
+void AreaHasFluidGroups::applyFlow(FluidGroup& group, SmallMap<FluidTypeId, std::vector<std::pair<CuboidSet, int64_t>>>& newGroups)
+{
+	Space& space = m_area.getSpace();
+	if(group.m_newlyAdded.empty() && group.m_noLongerOccupied.empty())
+		group.m_stable = true;
+	else
+	{
+		space.fluid_flowInto(group.m_newlyAdded, group.m_fluidType, group);
+		space.fluid_flowOutFrom(group.m_noLongerOccupied, group.m_fluidType);
+		group.maybeSetLowerDensityAdjacentUnstable(m_area);
+	}
+	// Find new groups to split.
+	std::vector<std::pair<CuboidSet, int64_t>> newGroupsFromThisGroup = group.maybeSplit();
+	if(!newGroupsFromThisGroup.empty())
+	{
+		std::vector<std::pair<CuboidSet, int64_t>>& groupsForFluidType = newGroups.getOrCreate(group.m_fluidType);
+		for(auto& [cuboidSet, volume] : newGroupsFromThisGroup)
+			groupsForFluidType.emplace_back(std::move(cuboidSet), volume);
+	}
+}
 void AreaHasFluidGroups::createGroup(const CuboidSet& occupied, int64_t volume, FluidTypeId type)
 {
 	m_groups.emplace_back(occupied, volume, type, m_nextId++);
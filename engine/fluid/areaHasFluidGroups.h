@@ -1,7 +1,9 @@
 #pragma once
 #include "fluidGroup.h"
 #include "../geometry/cuboidSet.h"
+#include "../dataStructures/smallMap.h"
 #include "../numericTypes/idTypes.h"
+#include "../threads.h"
 class Area;
 struct AreaHasFluidGroups
 {
@@ -9,8 +11,16 @@ struct AreaHasFluidGroups
 	// A reference to Area is stored here inorder to deserialize fluid data.
 	Area& m_area;
 	FluidGroupId m_nextId{0};
+	// Unstable groups which do not interact with any other unstable group this step. Stored here rather then per step so the buffer is reused.
+	std::vector<FluidGroup*> m_independent;
+	threads::WorkStealingRanges m_workStealingRanges;
 	AreaHasFluidGroups(Area& area);
+	// Flow is computed in parallel for independent groups and sequentially for the rest. Changes to Space are applied sequentially in group order.
 	void doStep();
+	// Find unstable groups which are not within two points of any other unstable group. Reading and writing Space for such a group does not touch anything read by another.
+	void findIndependent();
+	void computeFlow(FluidGroup& group);
+	void applyFlow(FluidGroup& group, SmallMap<FluidTypeId, std::vector<std::pair<CuboidSet, int64_t>>>& newGroups);
 	void createGroup(const CuboidSet& occupied, int64_t volume, FluidTypeId type);
 	void destroyGroup(FluidGroupId id);
 	void clearMerged();
@@ -19,6 +19,8 @@ struct FluidGroup
 	bool m_aboveGround = false;
 	// Used only on the first step after a group is created.
 	bool m_checkMergeAll = true;
+	// Set when flow has been computed in parallel this step but not yet applied.
+	bool m_flowComputed = false;
 	FluidGroup(const CuboidSet& occupied, int64_t volume, FluidTypeId type, FluidGroupId id);
 	void maybeDisplaceFromMoreDenseFluid(Area& area);
 	void maybeExpand(Area& area);
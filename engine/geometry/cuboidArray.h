@@ -1,6 +1,7 @@
 #pragma once
 #include "cuboid.h"
 #include "../dataStructures/smallSet.h"
+#include "../dataStructures/bitset.h"
 
 struct Sphere;
 struct ParamaterizedLine;
@@ -20,6 +21,7 @@ public:
 private:
 	PointArray m_high;
 	PointArray m_low;
+	[[nodiscard]] uint64_t intersectionBitsBetween(const Coordinates& low, const Coordinates& high) const;
 public:
 	CuboidArray();
 	CuboidArray(const CuboidArray&) = default;
@@ -39,6 +41,11 @@ public:
 	[[nodiscard]] BoolArray indicesOfIntersectingCuboids(const CuboidSet& cuboids) const;
 	[[nodiscard]] BoolArray indicesOfIntersectingCuboids(const Sphere& sphere) const;
 	[[nodiscard]] BoolArray indicesOfIntersectingCuboids(const ParamaterizedLine& line) const;
+	// Bit i is set when cuboid i intersects, the same as BitSet64::create(indicesOfIntersectingCuboids(shape)).
+	// Points and cuboids are tested with AVX-512 or AVX2 when available, other shapes use indicesOfIntersectingCuboids. Only valid for a capacity of 64.
+	[[nodiscard]] uint64_t intersectionBits(const Point3D point) const { return intersectionBitsBetween(point.data, point.data); }
+	[[nodiscard]] uint64_t intersectionBits(const Cuboid cuboid) const { return intersectionBitsBetween(cuboid.m_low.data, cuboid.m_high.data); }
+	[[nodiscard]] uint64_t intersectionBits(const auto& shape) const { return BitSet64::create(indicesOfIntersectingCuboids(shape)).data; }
 	[[nodiscard]] BoolArray indicesOfContainedCuboids(const Cuboid cuboid) const;
 	[[nodiscard]] BoolArray indicesOfContainedCuboids(const CuboidSet& cuboids) const;
 	[[nodiscard]] BoolArray indicesOfContainedCuboids(const Sphere& sphere) const;
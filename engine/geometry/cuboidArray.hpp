@@ -4,6 +4,24 @@
 #include "sphere.h"
 #include "cuboidSet.h"
 
+#if (defined(__AVX512BW__) || defined(__AVX2__)) && defined(__BMI2__)
+ #include <immintrin.h>
+namespace
+{
+	// Bits 3i, 3i + 1 and 3i + 2 of a 64 bit word.
+	constexpr uint64_t everyThirdBit[3] = {0x9249249249249249ull, 0x2492492492492492ull, 0x4924924924924924ull};
+	// Words hold one bit for each of x, y and z of 64 cuboids, in the order PointArray stores them. Returns one bit for each cuboid, set when all three of it's bits are.
+	[[nodiscard]] uint64_t allThreeDimensions(const uint64_t (&words)[3])
+	{
+		// The second and third words begin at 64 and 128, which are 1 and 2 mod 3, so each dimension uses a different mask in each word.
+		const uint64_t x = _pext_u64(words[0], everyThirdBit[0]) | (_pext_u64(words[1], everyThirdBit[2]) << 22) | (_pext_u64(words[2], everyThirdBit[1]) << 43);
+		const uint64_t y = _pext_u64(words[0], everyThirdBit[1]) | (_pext_u64(words[1], everyThirdBit[0]) << 21) | (_pext_u64(words[2], everyThirdBit[2]) << 43);
+		const uint64_t z = _pext_u64(words[0], everyThirdBit[2]) | (_pext_u64(words[1], everyThirdBit[1]) << 21) | (_pext_u64(words[2], everyThirdBit[0]) << 42);
+		return x & y & z;
+	}
+}
+#endif
+
 
 template<int capacity>
 CuboidArray<capacity>::CuboidArray() : m_high(Distance::null().get()), m_low(Distance::null().get()) { }
@@ -77,6 +95,88 @@ CuboidArray<capacity>::BoolArray CuboidArray<capacity>::indicesOfIntersectingCub
 	);
 }
 template<int capacity>
+uint64_t CuboidArray<capacity>::intersectionBitsBetween(const Coordinates& low, const Coordinates& high) const
+{
+	if constexpr(capacity != 64)
+	{
+		assert(false);
+		std::unreachable();
+	}
+	else
+	{
+	#if (defined(__AVX512BW__) || defined(__AVX2__)) && defined(__BMI2__)
+		static_assert(std::is_same_v<DistanceWidth, int16_t>);
+		// Coordinates are stored interleaved as x, y, z, x, y, z..., so the query is repeated the same way. Registers don't hold a multiple of 3 lanes, each one starts at an offset into the pattern.
+		DistanceWidth lowPattern[34];
+		DistanceWidth highPattern[34];
+		for(int i = 0; i < 34; ++i)
+		{
+			lowPattern[i] = low[i % 3];
+			highPattern[i] = high[i % 3];
+		}
+		const DistanceWidth* cuboidHighs = m_high.data();
+		const DistanceWidth* cuboidLows = m_low.data();
+		#if defined(__AVX512BW__)
+			// ---- AVX-512 path ----
+			// 6 registers of 32 lanes, 32 is 2 mod 3.
+			uint64_t words[3];
+			for(int word = 0; word < 3; ++word)
+			{
+				uint64_t bits = 0;
+				for(int half = 0; half < 2; ++half)
+				{
+					const int registerIndex = word * 2 + half;
+					const int phase = (registerIndex * 2) % 3;
+					const __m512i queryLow = _mm512_loadu_si512(lowPattern + phase);
+					const __m512i queryHigh = _mm512_loadu_si512(highPattern + phase);
+					const __m512i cuboidHigh = _mm512_loadu_si512(cuboidHighs + registerIndex * 32);
+					const __m512i cuboidLow = _mm512_loadu_si512(cuboidLows + registerIndex * 32);
+					const __mmask32 mask = _mm512_mask_cmple_epi16_mask(_mm512_cmpge_epi16_mask(cuboidHigh, queryLow), cuboidLow, queryHigh);
+					bits |= static_cast<uint64_t>(mask) << (half * 32);
+				}
+				words[word] = bits;
+			}
+			return allThreeDimensions(words);
+		#else
+			// ---- AVX2 path ----
+			// 12 registers of 16 lanes, 16 is 1 mod 3. Pairs of registers are packed to bytes to make 32 bit masks.
+			uint64_t words[3];
+			for(int word = 0; word < 3; ++word)
+			{
+				uint64_t bits = 0;
+				for(int pair = 0; pair < 2; ++pair)
+				{
+					__m256i missed[2];
+					for(int half = 0; half < 2; ++half)
+					{
+						const int registerIndex = word * 4 + pair * 2 + half;
+						const int phase = registerIndex % 3;
+						const __m256i queryLow = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lowPattern + phase));
+						const __m256i queryHigh = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(highPattern + phase));
+						const __m256i cuboidHigh = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cuboidHighs + registerIndex * 16));
+						const __m256i cuboidLow = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cuboidLows + registerIndex * 16));
+						// AVX2 only has greater then, so find the lanes which miss and invert.
+						missed[half] = _mm256_or_si256(_mm256_cmpgt_epi16(queryLow, cuboidHigh), _mm256_cmpgt_epi16(cuboidLow, queryHigh));
+					}
+					// Packing interleaves 128 bit lanes, the permute puts them back in order.
+					const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(missed[0], missed[1]), 0b11011000);
+					const uint32_t hit = ~static_cast<uint32_t>(_mm256_movemask_epi8(packed));
+					bits |= static_cast<uint64_t>(hit) << (pair * 32);
+				}
+				words[word] = bits;
+			}
+			return allThreeDimensions(words);
+		#endif
+	#else
+		const BoolArray mask = (
+			(m_high >= low.replicate(1, capacity)).colwise().all() &&
+			(m_low <= high.replicate(1, capacity)).colwise().all()
+		);
+		return BitSet64::create(mask).data;
+	#endif
+	}
+}
+template<int capacity>
 CuboidArray<capacity>::BoolArray CuboidArray<capacity>::indicesOfIntersectingCuboids(const CuboidSet& cuboids) const
 {
 	BoolArray output;
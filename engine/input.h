@@ -1,44 +1,32 @@
 /*
- * To be used for multiplayer. Not being used currently.
+ * Commands from threads other than the one stepping the simulation, such as the UI, scripting or a network peer.
+ * Any thread may insert without waiting for a step to finish, Simulation::doStep flushes the queue on the stepping thread after each step.
+ * Actions inserted by one thread execute in the order they were inserted.
+ * Actions name actors by ActorId and areas by AreaId because indices may change before the action executes. An action whose target no longer exists does nothing.
  */
 #pragma once
 
-#include "numericTypes/types.h"
-#include "onDestroy.h"
-#include "numericTypes/index.h"
+#include "dataStructures/mpscQueue.h"
 #include <memory>
-#include <queue>
-#include <mutex>
 
-class InputQueue;
-class InputAction;
-class Objective;
+class Simulation;
 enum class NewObjectiveEmplacementType { Replace, Before, After };
 
-using Queue = std::deque<std::unique_ptr<InputAction>>;
-//TODO: for multiplayer, multiple input queues sorted by player id. Serialization.
 class InputAction
 {
-	NewObjectiveEmplacementType m_emplacementType;
-	Queue::iterator m_iterator;
-protected:
-	HasOnDestroySubscriptions m_onDestroySubscriptions;
-	SmallSet<ActorIndex> m_actors;
-	InputAction(SmallSet<ActorIndex>& m_actors, NewObjectiveEmplacementType m_emplacementType, InputQueue& inputQueue);
-	InputAction(InputQueue& inputQueue);
-	void insertObjective(std::unique_ptr<Objective> objective, ActorIndex actor);
 public:
-	virtual void execute() = 0;
+	virtual void execute(Simulation& simulation) = 0;
 	virtual ~InputAction() = default;
-	friend class InputQueue;
 };
-
-class InputQueue
+//TODO: for multiplayer, multiple input queues sorted by player id. Serialization.
+class InputQueue final
 {
-	Queue m_actions;
-	std::mutex m_mutex;
+	MpscQueue<std::unique_ptr<InputAction>> m_actions;
 public:
-	Queue::iterator insert(std::unique_ptr<InputAction> action);
-	void remove(Queue::iterator action);
-	void flush();
+	// Thread safe, lock free.
+	void insert(std::unique_ptr<InputAction> action);
+	// Stepping thread only. Actions inserted by executing actions wait for the next flush.
+	void flush(Simulation& simulation);
+	// Stepping thread only.
+	[[nodiscard]] bool empty() const { return m_actions.empty(); }
 };
@@ -120,8 +120,9 @@ void ConstructedShape::setLocationAndFacingDynamic(Area& area, const Facing4 cur
 		assert(boundry.contains(relativeOffsetCuboid));
 		const Cuboid cuboid = Cuboid::create(relativeOffsetCuboid);
 		assert(space.shape_anythingCanEnterEver(cuboid));
-		space.pointFeature_add(cuboid, feature);
+		// Set dynamic first so the feature is not anchored by Support::onAdd.
 		space.setDynamic(cuboid);
+		space.pointFeature_add(cuboid, feature);
 		occupied.maybeAdd(cuboid);
 	}
 }
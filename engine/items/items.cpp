@@ -5,6 +5,7 @@
 #include "../simulation/simulation.h"
 #include "../simulation/hasItems.h"
 #include "../util.h"
+#include "../threads.h"
 #include "../actors/actors.h"
 #include "../numericTypes/index.h"
 #include "../definitions/moveType.h"
@@ -84,6 +85,7 @@ Items::Items(Area& area) :
 { }
 ItemIndex Items::create(ItemParamaters itemParamaters)
 {
+	threads::assertNotInReadPhase();
 	// Detect stacks combining, add to quantity and bail without creating a new item.
 	if(ItemType::getGeneric(itemParamaters.itemType))
 	{
@@ -114,7 +116,7 @@ ItemIndex Items::create(ItemParamaters itemParamaters)
 	assert(m_canBeStockPiled[index] == nullptr);
 	m_craftJobForWorkPiece[index] = itemParamaters.craftJob;
 	assert(m_hasCargo[index] == nullptr);
-	m_id[index] = itemParamaters.id.exists() ? itemParamaters.id : m_area.m_simulation.m_items.getNextId();
+	m_id[index] = itemParamaters.id.exists() ? itemParamaters.id : m_area.m_simulation.m_items.getNextId(m_area.m_itemIds);
 	m_installed.set(index, itemParamaters.installed);
 	const ItemTypeId itemType = m_itemType[index] = itemParamaters.itemType;
 	m_solid[index] = itemParamaters.materialType;
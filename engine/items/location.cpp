@@ -3,9 +3,11 @@
 #include "../space/space.h"
 #include "../definitions/moveType.h"
 #include "../portables.h"
+#include "../threads.h"
 
 ItemIndex Items::location_set(const ItemIndex index, const Point3D location, Facing4 facing)
 {
+	threads::assertNotInReadPhase();
 	if(isStatic(index))
 		return location_setStatic(index, location, facing);
 	else
@@ -204,4 +204,13 @@ public:
 	struct Hash { [[nodiscard]] size_t operator()(const FluidGroupId index) const { return index.get(); } };
 };
 void to_json(Json& data, const FluidGroupId& index);
-void from_json(const Json& data, FluidGroupId& index);
\ No newline at end of file
+void from_json(const Json& data, FluidGroupId& index);
+
+using ConnectivityComponentIdWidth = int32_t;
+class ConnectivityComponentId : public StrongInteger<ConnectivityComponentId, ConnectivityComponentIdWidth, INT32_MAX, 0>
+{
+public:
+	struct Hash { [[nodiscard]] size_t operator()(const ConnectivityComponentId index) const { return index.get(); } };
+};
+inline void to_json(Json& data, const ConnectivityComponentId& index) { data = index.get(); }
+inline void from_json(const Json& data, ConnectivityComponentId& index) { index = ConnectivityComponentId::create(data.get<ConnectivityComponentIdWidth>()); }
\ No newline at end of file
@@ -32,16 +32,13 @@
 #include <numbers>
 
 // Input.
-/*
-void ObjectiveTypeSetPriorityInputAction::execute()
+void ObjectiveTypeSetPriorityInputAction::execute(Simulation& simulation)
 {
-	m_actor.m_hasObjectives.m_prioritySet.setPriority(m_objectiveType, m_priority);
-}
-void ObjectiveTypeRemoveInputAction::execute()
-{
-	m_actor.m_hasObjectives.m_prioritySet.remove(m_objectiveType);
+	if(!simulation.m_actors.contains(m_actor))
+		return;
+	const auto& [actors, actor] = simulation.m_actors.getDataLocation(m_actor);
+	actors->objective_setPriority(actor, m_objectiveType, m_priority);
 }
-*/
 void ObjectiveTypePrioritySet::load(const Json& data, [[maybe_unused]] DeserializationMemo& deserializationMemo)
 {
 	m_data = data["data"].get<std::vector<ObjectivePriority>>();
@@ -77,21 +74,8 @@ void ObjectiveTypePrioritySet::remove(const ObjectiveTypeId objectiveType)
 void ObjectiveTypePrioritySet::setObjectiveFor(Area& area, const ActorIndex actor)
 {
 	assert(!area.getActors().objective_exists(actor));
-	Step currentStep = area.m_simulation.m_step;
-	for(auto& objectivePriority : m_data)
-	{
-		const ObjectiveType& objectiveType = ObjectiveType::getById(objectivePriority.objectiveType);
-		if(currentStep > objectivePriority.doNotAssignAgainUntil && objectiveType.canBeAssigned(area, actor))
-		{
-			area.getActors().objective_addTaskToStart(actor, objectiveType.makeFor(area, actor));
-			return;
-		}
-	}
-	// No assignable tasks, do an idle task.
-	if(!area.getActors().stamina_isFull(actor))
-		area.getActors().objective_addTaskToStart(actor, std::make_unique<RestObjective>(area));
-	else
-		area.getActors().objective_addTaskToStart(actor, std::make_unique<WanderObjective>());
+	// Matched against this set by the job board, with an idle task if nothing is assignable.
+	area.m_hasJobs.setObjectiveFor(area, actor);
 }
 void ObjectiveTypePrioritySet::setDelay(Area& area, const ObjectiveTypeId objectiveTypeId)
 {
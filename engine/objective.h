@@ -6,7 +6,8 @@
 #include "eventSchedule.hpp"
 #include "reservable.h"
 #include "numericTypes/types.h"
-//#include "input.h"
+#include "input.h"
+#include "designations.h"
 
 #include <memory>
 #include <vector>
@@ -38,6 +39,12 @@ public:
 	static const ObjectiveType& getByName(std::string name);
 	ObjectiveTypeId getId() const;
 	[[nodiscard]] virtual bool canBeAssigned(Area& area, const ActorIndex actor) const = 0;
+	// The part of canBeAssigned which does not depend on the actor. Checked by AreaHasJobs once per matching pass rather than once per idle actor.
+	[[nodiscard]] virtual bool hasWorkForFaction(Area&, const FactionId) const { return true; }
+	// The designation which marks job sites for this objective type, if any. See AreaHasJobs.
+	[[nodiscard]] virtual SpaceDesignation getJobSiteDesignation() const { return SpaceDesignation::Null; }
+	// How many idle actors AreaHasJobs may match with one job site in one pass.
+	[[nodiscard]] virtual int getActorsPerJobSite() const { return 1; }
 	[[nodiscard]] virtual std::unique_ptr<Objective> makeFor(Area& area, const ActorIndex actor) const = 0;
 	[[nodiscard]] virtual std::string name() const = 0;
 	ObjectiveType(const ObjectiveTypeId) = delete;
@@ -113,11 +120,23 @@ public:
 	void setObjectiveFor(Area& area, const ActorIndex actor);
 	void setDelay(Area& area, const ObjectiveTypeId objectiveTypeId);
 	[[nodiscard]] Json toJson() const;
+	// Sorted by descending priority.
+	[[nodiscard]] const std::vector<ObjectivePriority>& getAll() const { return m_data; }
 	[[nodiscard]] Priority getPriorityFor(const ObjectiveTypeId objectiveTypeId) const;
 	// For testing.
 	[[nodiscard]] bool isOnDelay(Area& area, const ObjectiveTypeId objectiveTypeId) const;
 	[[nodiscard]] Step getDelayEndFor(const ObjectiveTypeId objectiveTypeId) const;
 };
+class ObjectiveTypeSetPriorityInputAction final : public InputAction
+{
+	ActorId m_actor;
+	ObjectiveTypeId m_objectiveType;
+	Priority m_priority;
+public:
+	ObjectiveTypeSetPriorityInputAction(const ActorId actor, const ObjectiveTypeId objectiveType, const Priority priority) :
+		m_actor(actor), m_objectiveType(objectiveType), m_priority(priority) { }
+	void execute(Simulation& simulation);
+};
 class SupressedNeed final
 {
 	std::unique_ptr<Objective> m_objective;
@@ -177,6 +177,10 @@ bool ConstructObjectiveType::canBeAssigned(Area& area, const ActorIndex actor) c
 	// Pilots and passengers onDeck cannot construct.
 	if(actors.mount_exists(actor))
 		return false;
-	return area.m_hasConstructionDesignations.areThereAnyForFaction(actors.getFaction(actor));
+	return hasWorkForFaction(area, actors.getFaction(actor));
+}
+bool ConstructObjectiveType::hasWorkForFaction(Area& area, const FactionId faction) const
+{
+	return area.m_hasConstructionDesignations.areThereAnyForFaction(faction);
 }
 std::unique_ptr<Objective> ConstructObjectiveType::makeFor(Area&, const ActorIndex) const { return std::make_unique<ConstructObjective>(); }
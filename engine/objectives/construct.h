@@ -15,6 +15,9 @@ public:
 	ConstructObjectiveType(const Json&, DeserializationMemo&){ }
 	[[nodiscard]] std::unique_ptr<Objective> makeFor(Area& area, const ActorIndex actor) const;
 	[[nodiscard]] bool canBeAssigned(Area& area, const ActorIndex actor) const;
+	[[nodiscard]] bool hasWorkForFaction(Area& area, const FactionId faction) const;
+	[[nodiscard]] SpaceDesignation getJobSiteDesignation() const { return SpaceDesignation::Construct; }
+	[[nodiscard]] int getActorsPerJobSite() const { return Config::maxNumberOfWorkersForConstructionProject.get(); }
 	[[nodiscard]] std::string name() const { return "construct"; }
 };
 class ConstructObjective final : public Objective
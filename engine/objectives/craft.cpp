@@ -106,7 +106,11 @@ bool CraftObjectiveType::canBeAssigned(Area& area, const ActorIndex actor) const
 	// Pilots and passengers onDeck cannot craft.
 	if(actors.mount_exists(actor))
 		return false;
-	auto& hasCrafting = area.m_hasCraftingLocationsAndJobs.getForFaction(actors.getFaction(actor));
+	return hasWorkForFaction(area, actors.getFaction(actor));
+}
+bool CraftObjectiveType::hasWorkForFaction(Area& area, const FactionId faction) const
+{
+	auto& hasCrafting = area.m_hasCraftingLocationsAndJobs.getForFaction(faction);
 	if(!hasCrafting.m_unassignedProjectsBySkill.contains(m_skillType))
 	{
 		// No jobs needing this skill.
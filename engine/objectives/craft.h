@@ -13,6 +13,7 @@ public:
 	CraftObjectiveType(SkillTypeId skillType) : m_skillType(skillType) { }
 	CraftObjectiveType(const Json& data, DeserializationMemo& deserializationMemo);
 	[[nodiscard]] bool canBeAssigned(Area& area, const ActorIndex actor) const;
+	[[nodiscard]] bool hasWorkForFaction(Area& area, const FactionId faction) const;
 	[[nodiscard]] std::unique_ptr<Objective> makeFor(Area& area, const ActorIndex actor) const;
 	[[nodiscard]] std::string name() const override;
 };
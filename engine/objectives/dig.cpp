@@ -156,7 +156,11 @@ bool DigObjectiveType::canBeAssigned(Area& area, const ActorIndex actor) const
 	if(actors.mount_exists(actor))
 		return false;
 	//TODO: check for any picks?
-	return area.m_hasDigDesignations.areThereAnyForFaction(actors.getFaction(actor));
+	return hasWorkForFaction(area, actors.getFaction(actor));
+}
+bool DigObjectiveType::hasWorkForFaction(Area& area, const FactionId faction) const
+{
+	return area.m_hasDigDesignations.areThereAnyForFaction(faction);
 }
 std::unique_ptr<Objective> DigObjectiveType::makeFor(Area&, const ActorIndex) const
 {
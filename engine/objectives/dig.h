@@ -12,6 +12,9 @@ class DigObjectiveType final : public ObjectiveType
 {
 public:
 	[[nodiscard]] bool canBeAssigned(Area& area, const ActorIndex actor) const;
+	[[nodiscard]] bool hasWorkForFaction(Area& area, const FactionId faction) const;
+	[[nodiscard]] SpaceDesignation getJobSiteDesignation() const { return SpaceDesignation::Dig; }
+	[[nodiscard]] int getActorsPerJobSite() const { return Config::maxNumberOfWorkersForDigProject.get(); }
 	[[nodiscard]] std::unique_ptr<Objective> makeFor(Area& area, const ActorIndex actor) const;
 	DigObjectiveType() = default;
 	DigObjectiveType([[maybe_unused]] const Json& data, [[maybe_unused]] DeserializationMemo& deserializationMemo){ }
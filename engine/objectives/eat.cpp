@@ -333,7 +333,7 @@ EatObjective::EatObjective(Area &area) :
 {}
 EatObjective::EatObjective(const Json &data, DeserializationMemo &deserializationMemo, Area &area, const ActorIndex actor) :
 	Objective(data, deserializationMemo),
-	m_eatEvent(deserializationMemo.m_simulation.m_eventSchedule),
+	m_eatEvent(area.m_eventSchedule),
 	m_noFoodFound(data["noFoodFound"].get<bool>())
 {
 	if(data.contains("destination"))
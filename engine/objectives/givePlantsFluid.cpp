@@ -68,7 +68,11 @@ bool GivePlantsFluidObjectiveType::canBeAssigned(Area& area, const ActorIndex ac
 	// Pilots and passengers onDeck cannot give plants fluid.
 	if(actors.onDeck_getIsOnDeckOf(actor).exists())
 		return false;
-	return area.m_hasFarmFields.hasGivePlantsFluidDesignations(actors.getFaction(actor));
+	return hasWorkForFaction(area, actors.getFaction(actor));
+}
+bool GivePlantsFluidObjectiveType::hasWorkForFaction(Area& area, const FactionId faction) const
+{
+	return area.m_hasFarmFields.hasGivePlantsFluidDesignations(faction);
 }
 std::unique_ptr<Objective> GivePlantsFluidObjectiveType::makeFor(Area&, const ActorIndex) const
 {
@@ -30,6 +30,8 @@ class GivePlantsFluidObjectiveType final : public ObjectiveType
 {
 public:
 	bool canBeAssigned(Area& area, const ActorIndex actor) const;
+	[[nodiscard]] bool hasWorkForFaction(Area& area, const FactionId faction) const;
+	[[nodiscard]] SpaceDesignation getJobSiteDesignation() const { return SpaceDesignation::GivePlantFluid; }
 	std::unique_ptr<Objective> makeFor(Area& area, const ActorIndex actor) const;
 	GivePlantsFluidObjectiveType() = default;
 	GivePlantsFluidObjectiveType([[maybe_unused]] const Json& data, [[maybe_unused]] DeserializationMemo& deserializationMemo){ }
@@ -51,7 +51,11 @@ bool HarvestObjectiveType::canBeAssigned(Area& area, const ActorIndex actor) con
 	// Pilots and passengers onDeck cannot harvest.
 	if(actors.onDeck_getIsOnDeckOf(actor).exists())
 		return false;
-	return area.m_hasFarmFields.hasHarvestDesignations(area.getActors().getFaction(actor));
+	return hasWorkForFaction(area, actors.getFaction(actor));
+}
+bool HarvestObjectiveType::hasWorkForFaction(Area& area, const FactionId faction) const
+{
+	return area.m_hasFarmFields.hasHarvestDesignations(faction);
 }
 std::unique_ptr<Objective> HarvestObjectiveType::makeFor(Area& area, const ActorIndex) const
 {
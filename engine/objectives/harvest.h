@@ -13,6 +13,8 @@ class HarvestObjectiveType final : public ObjectiveType
 {
 public:
 	[[nodiscard]] bool canBeAssigned(Area& area, const ActorIndex actor) const;
+	[[nodiscard]] bool hasWorkForFaction(Area& area, const FactionId faction) const;
+	[[nodiscard]] SpaceDesignation getJobSiteDesignation() const { return SpaceDesignation::Harvest; }
 	[[nodiscard]] std::unique_ptr<Objective> makeFor(Area& area, const ActorIndex actor) const;
 	HarvestObjectiveType() = default;
 	HarvestObjectiveType(const Json&, DeserializationMemo&);
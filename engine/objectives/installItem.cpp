@@ -89,7 +89,11 @@ void InstallItemObjective::execute(Area& area, const ActorIndex actor)
 void InstallItemObjective::cancel(Area& area, const ActorIndex actor) { area.getActors().move_pathRequestMaybeCancel(actor); m_project->removeWorker(actor); }
 bool InstallItemObjectiveType::canBeAssigned(Area& area, const ActorIndex actor) const
 {
-	return !area.m_hasInstallItemDesignations.getForFaction(area.getActors().getFaction(actor)).empty();
+	return hasWorkForFaction(area, area.getActors().getFaction(actor));
+}
+bool InstallItemObjectiveType::hasWorkForFaction(Area& area, const FactionId faction) const
+{
+	return !area.m_hasInstallItemDesignations.getForFaction(faction).empty();
 }
 std::unique_ptr<Objective> InstallItemObjectiveType::makeFor(Area&, const ActorIndex) const
 {
@@ -9,6 +9,7 @@ class InstallItemObjectiveType final : public ObjectiveType
 {
 public:
 	bool canBeAssigned(Area& area, const ActorIndex actor) const;
+	[[nodiscard]] bool hasWorkForFaction(Area& area, const FactionId faction) const;
 	std::unique_ptr<Objective> makeFor(Area& area, const ActorIndex actor) const;
 	std::string name() const override { return "install Item"; }
 };
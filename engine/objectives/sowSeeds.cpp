@@ -41,7 +41,11 @@ bool SowSeedsObjectiveType::canBeAssigned(Area& area, const ActorIndex actor) co
 	// Pilots and passengers onDeck cannot sow.
 	if(actors.onDeck_getIsOnDeckOf(actor).exists())
 		return false;
-	return area.m_hasFarmFields.hasSowSeedsDesignations(area.getActors().getFaction(actor));
+	return hasWorkForFaction(area, actors.getFaction(actor));
+}
+bool SowSeedsObjectiveType::hasWorkForFaction(Area& area, const FactionId faction) const
+{
+	return area.m_hasFarmFields.hasSowSeedsDesignations(faction);
 }
 std::unique_ptr<Objective> SowSeedsObjectiveType::makeFor(Area& area, const ActorIndex) const
 {
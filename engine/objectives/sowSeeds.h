@@ -16,6 +16,8 @@ class SowSeedsObjectiveType final : public ObjectiveType
 {
 public:
 	[[nodiscard]] bool canBeAssigned(Area& area, const ActorIndex actor) const;
+	[[nodiscard]] bool hasWorkForFaction(Area& area, const FactionId faction) const;
+	[[nodiscard]] SpaceDesignation getJobSiteDesignation() const { return SpaceDesignation::SowSeeds; }
 	[[nodiscard]] std::unique_ptr<Objective> makeFor(Area& area, const ActorIndex actor) const;
 	SowSeedsObjectiveType() = default;
 	SowSeedsObjectiveType(const Json&, DeserializationMemo&);
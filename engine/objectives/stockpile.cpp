@@ -15,6 +15,10 @@ bool StockPileObjectiveType::canBeAssigned(Area& area, const ActorIndex actor) c
 		return false;
 	return area.m_hasStockPiles.getForFaction(actors.getFaction(actor)).isAnyHaulingAvailableFor(actor);
 }
+bool StockPileObjectiveType::hasWorkForFaction(Area& area, const FactionId faction) const
+{
+	return area.m_hasStockPiles.getForFaction(faction).isAnyHaulingAvailable();
+}
 std::unique_ptr<Objective> StockPileObjectiveType::makeFor(Area&, const ActorIndex) const
 {
 	return std::make_unique<StockPileObjective>();
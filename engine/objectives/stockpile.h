@@ -12,6 +12,9 @@ class StockPileObjectiveType final : public ObjectiveType
 {
 public:
 	bool canBeAssigned(Area& area, const ActorIndex actor) const;
+	[[nodiscard]] bool hasWorkForFaction(Area& area, const FactionId faction) const;
+	[[nodiscard]] SpaceDesignation getJobSiteDesignation() const { return SpaceDesignation::StockPileHaulFrom; }
+	[[nodiscard]] int getActorsPerJobSite() const { return Config::maxWorkersForStockPileProject.get(); }
 	std::unique_ptr<Objective> makeFor(Area& area, const ActorIndex actor) const;
 	StockPileObjectiveType() = default;
 	[[nodiscard]] std::string name() const { return "stockpile"; }
@@ -26,7 +26,10 @@ WanderPathRequest::WanderPathRequest(const Json& data, Area& area, Deserializati
 { }
 PathResult WanderPathRequest::readStep(Area& area, const AreaHasPathsForMoveType& hasPaths)
 {
-	Random& random = area.m_simulation.m_random;
+	// Read steps run in parallel, so draw from a stream for this actor rather then from area.m_random.
+	Actors& actors = area.getActors();
+	const ActorId actorId = actors.getId(actor.getIndex(actors.m_referenceData));
+	RandomStream random = area.m_random.getStream(area.m_simulation.m_step, actorId.get(), RandomPurpose::Wander);
 	m_pointCounter = random.getInRange(Config::wanderMinimimNumberOfPoints, Config::wanderMaximumNumberOfPoints);
 	auto shortRangeCondition = [this](const Point3D point, const Facing4) -> Point3D
 	{
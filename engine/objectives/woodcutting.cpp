@@ -184,7 +184,11 @@ bool WoodCuttingObjectiveType::canBeAssigned(Area& area, const ActorIndex actor)
 	if(actors.mount_exists(actor))
 		return false;
 	//TODO: check for any axes?
-	return area.m_hasWoodCuttingDesignations.areThereAnyForFaction(actors.getFaction(actor));
+	return hasWorkForFaction(area, actors.getFaction(actor));
+}
+bool WoodCuttingObjectiveType::hasWorkForFaction(Area& area, const FactionId faction) const
+{
+	return area.m_hasWoodCuttingDesignations.areThereAnyForFaction(faction);
 }
 std::unique_ptr<Objective> WoodCuttingObjectiveType::makeFor(Area&, const ActorIndex) const
 {
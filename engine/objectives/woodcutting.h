@@ -10,6 +10,9 @@ class WoodCuttingObjectiveType final : public ObjectiveType
 {
 public:
 	[[nodiscard]] bool canBeAssigned(Area& area, const ActorIndex actor) const;
+	[[nodiscard]] bool hasWorkForFaction(Area& area, const FactionId faction) const;
+	[[nodiscard]] SpaceDesignation getJobSiteDesignation() const { return SpaceDesignation::WoodCutting; }
+	[[nodiscard]] int getActorsPerJobSite() const { return Config::maxNumberOfWorkersForWoodCuttingProject.get(); }
 	[[nodiscard]] std::unique_ptr<Objective> makeFor(Area& area, const ActorIndex actor) const;
 	[[nodiscard]] std::string name() const { return "woodcutting"; }
 };
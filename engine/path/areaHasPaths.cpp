@@ -5,6 +5,8 @@
 #include "../actors/actors.h"
 #include "../space/space.h"
 #include "../definitions/moveType.h"
+#include "../threads.h"
+#include "../util.h"
 AreaHasPathsForMoveType::AreaHasPathsForMoveType(Area& area, const MoveTypeId moveType) :
 	m_enterable(area.getSpace()),
 	m_moveType(moveType)
@@ -32,13 +34,20 @@ void AreaHasPathsForMoveType::writeStep(Area& area)
 }
 void AreaHasPathsForMoveType::update(Area& area, const Cuboid cuboid)
 {
+	threads::assertNotInReadPhase();
 	Space& space = area.getSpace();
+	// Inflated to include routes which enter cuboid from adjacent.
+	m_routeCache.invalidate(cuboid.inflated({1}));
 	// Update enterable cuboids.
 	m_enterable.maybeRemove(cuboid);
+	m_connectivity.remove(cuboid);
 	CuboidSet enterable = space.move_queryPathable(cuboid, m_moveType);
 	for(const Cuboid enterableCuboid : enterable)
 		for(const Cuboid partitionedCuboid : space.move_splitCuboidByPartitions(enterableCuboid))
+		{
 			m_enterable.insert(partitionedCuboid);
+			m_connectivity.insert(partitionedCuboid);
+		}
 	m_enterable.prepare();
 	// Update vertical clearance below.
 	CuboidSet levelBelow = CuboidSet::create(cuboid.getFaceBelow());
@@ -68,10 +77,13 @@ void AreaHasPathsForMoveType::update(Area& area, const Cuboid cuboid)
 		if(levelBelow.empty())
 			break;
 	}
+	for(const Cuboid updated : toUpdate)
+		m_routeCache.invalidate(updated);
 	m_enterable.updateVerticalClearance(toUpdate);
 }
 void AreaHasPathsForMoveType::recordPathRequest(std::unique_ptr<PathRequest> pathRequest)
 {
+	threads::assertNotInReadPhase();
 	m_pathRequests.push_back(std::move(pathRequest));
 }
 void AreaHasPathsForMoveType::cancelPathRequest(PathRequest& pathRequest)
@@ -85,6 +97,8 @@ void AreaHasPathsForMoveType::cancelPathRequest(PathRequest& pathRequest)
 PathResult AreaHasPathsForMoveType::pathTo(const PathParamaters& params) const
 {
 	const Point3D destination = params.huristicDestination;
+	if(canRuleOut(CuboidSet::create(destination), params))
+		return {};
 	auto longRangeCondition = [destination](const Cuboid cuboid) -> bool { return cuboid.contains(destination); };
 	if(params.anyOccupiedPoint)
 	{
@@ -100,9 +114,51 @@ PathResult AreaHasPathsForMoveType::pathTo(const PathParamaters& params) const
 	else
 	{
 		auto shortRangeCondition = [destination](const Point3D point, const Facing4) -> Point3D { return point == destination ? point : Point3D::null(); };
-		return longRangePath::getPath(m_enterable, longRangeCondition, shortRangeCondition, params);
+		// Detour depends on the location of dynamic shapes, which change without calling update.
+		// GoTo requests pass Distance::max() as maxRange, which is not a limit.
+		const bool hasMaxRange = params.maxRange.exists() && params.maxRange != Distance::max();
+		if(params.detour || hasMaxRange || !params.returnPath)
+			return longRangePath::getPath(m_enterable, longRangeCondition, shortRangeCondition, params);
+		const Cuboid startCuboid = m_enterable.queryGetOneCuboid(params.start);
+		const std::vector<Cuboid>* cached = m_routeCache.find(startCuboid, destination, params.shape);
+		if(cached != nullptr)
+		{
+			PathResult result = longRangePath::getPathFromIntermediateResult(shortRangeCondition, params, {*cached, destination});
+			if(!isReservedAtEnd(result, params))
+			{
+				m_routeCache.recordHit();
+				return result;
+			}
+		}
+		longRangePath::IntermediateResult intermediateResult = longRangePath::getPathUnreserved(m_enterable, longRangeCondition, shortRangeCondition, params);
+		if(intermediateResult.target.exists() && !longRangePath::checkCuboidNotFreelyNavigable(m_enterable, startCuboid, params))
+			m_routeCache.record(startCuboid, destination, params.shape, intermediateResult.cuboids);
+		return longRangePath::getPathFromIntermediateResult(shortRangeCondition, params, intermediateResult);
 	}
 }
+bool AreaHasPathsForMoveType::canRuleOut(const CuboidSet& destination, const PathParamaters& params) const
+{
+	if(params.start.empty())
+		return false;
+	if(!params.adjacent && !params.anyOccupiedPoint)
+		return m_connectivity.canRuleOut(params.start, destination);
+	// The path may end anywhere the shape would be adjacent to or overlap destination. Any dimension of the shape's boundry is at least as far as the pivot can be from its edge.
+	const OffsetCuboid boundry = Shape::getOffsetCuboidBoundryWithFacing(params.shape, Facing4::North);
+	const Distance reach = Distance::create(std::max({boundry.sizeX().get(), boundry.sizeY().get(), boundry.sizeZ().get()}) + 1);
+	CuboidSet inflated = destination;
+	inflated.inflate(reach);
+	return m_connectivity.canRuleOut(params.start, inflated);
+}
+bool AreaHasPathsForMoveType::isReservedAtEnd(const PathResult& result, const PathParamaters& params)
+{
+	if(params.faction.empty() || result.m_path.empty())
+		return false;
+	const Space& space = params.area.getSpace();
+	// Path is stored from end to start.
+	const Point3D beforeEnd = result.m_path.size() == 1 ? params.start : result.m_path[1];
+	const Facing4 facing = beforeEnd.getFacingTwords(result.m_target);
+	return space.isReservedAny(Shape::getCuboidsOccupiedAt(params.shape, space, result.m_target, facing), params.faction);
+}
 PathResult AreaHasPathsForMoveType::pathToEdge(const PathParamaters& params) const
 {
 	const Space& space = params.area.getSpace();
@@ -118,6 +174,8 @@ PathResult AreaHasPathsForMoveType::pathToEdge(const PathParamaters& params) con
 PathResult AreaHasPathsForMoveType::pathToDesignation(SpaceDesignation designation, const PathParamaters& params) const
 {
 	const Space& space = params.area.getSpace();
+	if(canRuleOut(space.designation_queryForFaction(space.boundry(), params.faction, designation), params))
+		return {};
 	auto longRangeCondition = [&space, &params, designation](const Cuboid cuboid) -> bool
 	{
 		return space.designation_has(cuboid, params.faction, designation);
@@ -152,19 +210,29 @@ void AreaHasPaths::doStep(Area& area)
 	Actors& actors = area.getActors();
 	// instead of clearing each request as it is processed we clear all of them now.
 	actors.move_clearAllPathRequests();
-	// Read step inner iteration is done here rather then AreaHasPathsForMoveType having a readStep method so omp can paralelize the two for loops together.
-	// Because the 2d iteration space is jagged we need to collect index pairs for omp to get a total count.
-	m_outerAndInnerIndices.clear();
+	// Relabel components split since the last step before they are read concurrently.
+	for(AreaHasPathsForMoveType& hasPathsForMoveType : m_data)
+		hasPathsForMoveType.m_connectivity.prepare();
+	// Read step inner iteration is done here rather then AreaHasPathsForMoveType having a readStep method so requests for all move types can be balanced together.
+	m_batch.clear();
 	for(int i = 0; i < (int)m_data.size(); ++i)
 		for(int j = 0; j != (int)m_data[i].m_pathRequests.size(); ++j)
-			m_outerAndInnerIndices.emplace_back(i, j);
-	#pragma omp parallel for
-	for(int i = 0; i != (int)m_outerAndInnerIndices.size(); ++i)
+		{
+			const Point3D start = m_data[i].m_pathRequests[j]->start;
+			m_batch.emplace_back(start.exists() ? start.hilbertNumber() : 0, i, j);
+		}
+	std::ranges::sort(m_batch);
+	const std::chrono::microseconds startTime = util::getCurrentTimeInMicroSeconds();
+	// Each thread starts with a contiguous, and so spatially local, range of requests. Path costs vary by orders of magnitude so idle threads steal from busy ones.
+	threads::forEachWorkStealing(m_workStealingRanges, m_batch.size(), [&](const int index)
 	{
-		int outer = m_outerAndInnerIndices[i].first;
-		int inner = m_outerAndInnerIndices[i].second;
+		threads::ReadPhaseGuard guard;
+		const auto& [hilbertNumber, outer, inner] = m_batch[index];
 		m_data[outer].readStepForRequest(area, *m_data[outer].m_pathRequests[inner]);
-	}
+	});
+	m_lastStepStats = {(int)m_batch.size(), util::getCurrentTimeInMicroSeconds() - startTime};
+	for(AreaHasPathsForMoveType& hasPathsForMoveType : m_data)
+		hasPathsForMoveType.m_routeCache.commit();
 	// WriteStep.
 	for(AreaHasPathsForMoveType& hasPathsForMoveType : m_data)
 		hasPathsForMoveType.writeStep(area);
@@ -174,6 +242,8 @@ AreaHasPathsForMoveType& AreaHasPaths::get(Area& area, const MoveTypeId moveType
 	auto found = std::ranges::find(m_data, moveType, &AreaHasPathsForMoveType::m_moveType);
 	if(found == m_data.end())
 	{
+		// Adding a move type invalidates references held by other threads.
+		threads::assertNotInReadPhase();
 		m_data.emplace_back(area, moveType);
 		return m_data.back();
 	}
@@ -198,5 +268,9 @@ void AreaHasPaths::update(Area& area, const CuboidSet& cuboids)
 void AreaHasPaths::maybeSetImpassable(const Cuboid cuboid)
 {
 	for(AreaHasPathsForMoveType& forMoveType : m_data)
+	{
+		forMoveType.m_routeCache.invalidate(cuboid.inflated({1}));
 		forMoveType.m_enterable.maybeRemove(cuboid);
+		forMoveType.m_connectivity.remove(cuboid);
+	}
 }
\ No newline at end of file
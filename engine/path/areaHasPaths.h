@@ -4,6 +4,11 @@
 #include "../dataStructures/smallSet.h"
 #include "longRange.h"
 #include "enterable.h"
+#include "routeCache.h"
+#include "connectivity.h"
+#include "../threads.h"
+#include <chrono>
+#include <tuple>
 struct PathRequest;
 class Area;
 
@@ -11,6 +16,10 @@ struct AreaHasPathsForMoveType
 {
 	AreaHasPathsForMoveType(Area& area, const MoveTypeId moveType);
 	Enterable m_enterable;
+	// Mutable because routes are recorded by pathTo, which is const.
+	mutable RouteCache m_routeCache;
+	// Mirrors m_enterable, used to reject requests for unreachable destinations without searching.
+	Connectivity m_connectivity;
 	MoveTypeId m_moveType;
 	std::vector<std::unique_ptr<PathRequest>> m_pathRequests;
 	void readStepForRequest(Area& area, PathRequest& pathRequest);
@@ -22,6 +31,10 @@ struct AreaHasPathsForMoveType
 	[[nodiscard]] PathResult pathToEdge(const PathParamaters& params) const;
 	[[nodiscard]] PathResult pathToDesignation(SpaceDesignation designation, const PathParamaters& params) const;
 	[[nodiscard]] bool accessable(const PathParamaters& params) const;
+	// True if no point from which the destination could be satisfied is connected to start.
+	[[nodiscard]] bool canRuleOut(const CuboidSet& destination, const PathParamaters& params) const;
+	// Cached routes do not account for reservations, check that the end point found with one is not reserved.
+	[[nodiscard]] static bool isReservedAtEnd(const PathResult& result, const PathParamaters& params);
 	template<bool adjacent, bool anyOccupied, longRangePath::LongRangeCondition LongRangeConditionT, longRangePath::ShortRangeConditionPointOrCuboid ShortRangeConditionT>
 	[[nodiscard]] Point3D accessableCondition(LongRangeConditionT& longRangeCondition, ShortRangeConditionT& shortRangeCondition, const PathParamaters& params) const;
 	template<bool adjacent, bool anyOccupied, longRangePath::LongRangeCondition LongRangeConditionT, longRangePath::ShortRangeConditionPointOrCuboid ShortRangeConditionT>
@@ -29,11 +42,20 @@ struct AreaHasPathsForMoveType
 	template<bool adjacent, bool anyOccupiedPoint, longRangePath::LongRangeCondition LongRangeConditionT, longRangePath::ShortRangeConditionPointOrCuboid ShortRangeConditionT>
 	[[nodiscard]] PathResult pathToConditionWithDesignation(SpaceDesignation designation, LongRangeConditionT& longRangeCondition, ShortRangeConditionT& shortRangeCondition, const PathParamaters& params) const;
 };
+struct PathStepStats
+{
+	int pathCount = 0;
+	std::chrono::microseconds solveTime = std::chrono::microseconds(0);
+};
 class AreaHasPaths
 {
 	std::vector<AreaHasPathsForMoveType> m_data;
-	std::vector<std::pair<int, int>> m_outerAndInnerIndices;
+	// Hilbert number of start, index of AreaHasPathsForMoveType, index of PathRequest.
+	std::vector<std::tuple<int, int, int>> m_batch;
+	threads::WorkStealingRanges m_workStealingRanges;
+	PathStepStats m_lastStepStats;
 public:
+	// Requests for all move types are solved together as one batch, sorted by start point so requests which are solved on the same thread are likely to visit the same rtree nodes.
 	void doStep(Area& area);
 	void clearPathRequests();
 	void update(Area& area, const Cuboid cuboid);
@@ -41,4 +63,5 @@ public:
 	void maybeSetImpassable(const Cuboid cuboid);
 	[[nodiscard]] AreaHasPathsForMoveType& get(Area& area, const MoveTypeId id);
 	[[nodiscard]] bool empty() const { return m_data.empty(); }
+	[[nodiscard]] const PathStepStats& getLastStepStats() const { return m_lastStepStats; }
 };
\ No newline at end of file
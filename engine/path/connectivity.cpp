@@ -0,0 +1,173 @@
+#include "connectivity.h"
+#include <algorithm>
+#include <map>
+#include <numeric>
+ConnectivityComponentId Connectivity::createComponent()
+{
+	ConnectivityComponentId output = ConnectivityComponentId::create(m_parents.size());
+	m_parents.push_back(output);
+	return output;
+}
+void Connectivity::unite(const ConnectivityComponentId a, const ConnectivityComponentId b)
+{
+	assert(m_parents[a.get()] == a);
+	assert(m_parents[b.get()] == b);
+	m_parents[b.get()] = a;
+	m_unitedSinceFlatten = true;
+}
+void Connectivity::insert(const Cuboid cuboid)
+{
+	// Touching includes edges and corners, diagonal moves may cross them.
+	SmallSet<ConnectivityComponentId> roots;
+	m_labels.queryForEach(cuboid.inflated({1}), [&](const ConnectivityComponentId& id){ roots.maybeInsert(find(id)); });
+	ConnectivityComponentId component;
+	if(roots.empty())
+		component = createComponent();
+	else
+	{
+		component = roots.front();
+		for(const ConnectivityComponentId root : roots)
+			if(root != component)
+				unite(component, root);
+	}
+	m_labels.insert(cuboid, component);
+}
+void Connectivity::remove(const Cuboid cuboid)
+{
+	bool any = false;
+	m_labels.queryForEachCuboid(cuboid, [&](const Cuboid){ any = true; });
+	if(!any)
+		return;
+	m_removed.push_back(cuboid);
+	m_labels.maybeRemove(cuboid);
+}
+void Connectivity::split(const std::vector<Cuboid>& seeds)
+{
+	struct Flood
+	{
+		std::vector<Cuboid> open;
+		std::vector<Cuboid> visited;
+	};
+	std::vector<Flood> floods(seeds.size());
+	// Floods which meet are merged into one, mergedInto is resolved like a union find.
+	std::vector<int> mergedInto(seeds.size());
+	std::iota(mergedInto.begin(), mergedInto.end(), 0);
+	const auto findFlood = [&](int index) { while(mergedInto[index] != index) index = mergedInto[index]; return index; };
+	// The flood which reached each labeled cuboid first.
+	std::map<Cuboid, int> reachedBy;
+	for(int i = 0; i != (int)seeds.size(); ++i)
+	{
+		floods[i].open.push_back(seeds[i]);
+		floods[i].visited.push_back(seeds[i]);
+		reachedBy.emplace(seeds[i], i);
+	}
+	int live = seeds.size();
+	// Each live flood takes one cuboid in turn, so a piece which has been split off is found in about as many turns as it has cuboids. The last live flood keeps the existing labels without being walked to completion.
+	while(live > 1)
+		for(int i = 0; i != (int)floods.size() && live > 1; ++i)
+		{
+			Flood& flood = floods[i];
+			// Merged or split off.
+			if(mergedInto[i] != i || flood.open.empty())
+				continue;
+			const Cuboid current = flood.open.back();
+			flood.open.pop_back();
+			m_labels.queryForEachCuboid(current.inflated({1}), [&](const Cuboid neighbor)
+			{
+				const auto [found, inserted] = reachedBy.try_emplace(neighbor, i);
+				if(inserted)
+				{
+					flood.open.push_back(neighbor);
+					flood.visited.push_back(neighbor);
+					return;
+				}
+				const int other = findFlood(found->second);
+				if(other == i)
+					return;
+				// Still connected.
+				Flood& otherFlood = floods[other];
+				flood.open.insert(flood.open.end(), otherFlood.open.begin(), otherFlood.open.end());
+				flood.visited.insert(flood.visited.end(), otherFlood.visited.begin(), otherFlood.visited.end());
+				otherFlood = {};
+				mergedInto[other] = i;
+				--live;
+			});
+			if(flood.open.empty() && live > 1)
+			{
+				// Nothing left to reach, this piece is no longer connected to the others.
+				const ConnectivityComponentId component = createComponent();
+				for(const Cuboid cuboid : flood.visited)
+				{
+					m_labels.maybeRemove(cuboid);
+					m_labels.insert(cuboid, component);
+				}
+				flood.visited = {};
+				--live;
+			}
+		}
+}
+void Connectivity::prepare()
+{
+	if(!m_removed.empty())
+	{
+		// Only labeled cuboids touching removed space can have lost a connection. Grouped by component, each group is checked separately.
+		std::vector<std::pair<ConnectivityComponentId, std::vector<Cuboid>>> seedsByComponent;
+		for(const Cuboid removed : m_removed)
+			m_labels.queryForEachWithCuboids(removed.inflated({1}), [&](const Cuboid cuboid, const ConnectivityComponentId& id)
+			{
+				const ConnectivityComponentId root = find(id);
+				auto found = std::ranges::find(seedsByComponent, root, &std::pair<ConnectivityComponentId, std::vector<Cuboid>>::first);
+				if(found == seedsByComponent.end())
+					seedsByComponent.emplace_back(root, std::vector<Cuboid>{cuboid});
+				else if(std::ranges::find(found->second, cuboid) == found->second.end())
+					found->second.push_back(cuboid);
+			});
+		m_removed.clear();
+		// A single seed cannot have been split from anything.
+		for(const auto& [root, seeds] : seedsByComponent)
+			if(seeds.size() > 1)
+				split(seeds);
+	}
+	if(m_unitedSinceFlatten)
+	{
+		// Flatten the forest so find takes at most one step. Parents may have higher indices than children so find is used rather then copying the parent's parent.
+		for(ConnectivityComponentId& parent : m_parents)
+			parent = find(parent);
+		m_unitedSinceFlatten = false;
+	}
+	m_labels.prepare();
+}
+void Connectivity::clear()
+{
+	m_labels.clear();
+	m_parents.clear();
+	m_removed.clear();
+	m_unitedSinceFlatten = false;
+}
+ConnectivityComponentId Connectivity::find(ConnectivityComponentId id) const
+{
+	while(m_parents[id.get()] != id)
+		id = m_parents[id.get()];
+	return id;
+}
+ConnectivityComponentId Connectivity::getComponent(const Point3D point) const
+{
+	const ConnectivityComponentId id = m_labels.queryGetOne(point);
+	if(id.empty())
+		return id;
+	return find(id);
+}
+bool Connectivity::canRuleOut(const Point3D start, const Cuboid destination) const
+{
+	const ConnectivityComponentId component = getComponent(start);
+	if(component.empty())
+		return false;
+	return !m_labels.queryAnyWithCondition(destination, [&](const ConnectivityComponentId& id){ return find(id) == component; });
+}
+bool Connectivity::canRuleOut(const Point3D start, const CuboidSet& destination) const
+{
+	const ConnectivityComponentId component = getComponent(start);
+	if(component.empty())
+		return false;
+	return !m_labels.queryAnyWithCondition(destination, [&](const ConnectivityComponentId& id){ return find(id) == component; });
+}
@@ -0,0 +1,39 @@
+/*
+	Connected components of the enterable cuboids for one move type, used by AreaHasPathsForMoveType to reject requests which cannot succeed without doing a search.
+	Labeled cuboids are considered connected when they touch, including at edges and corners. This is a superset of the moves which are actually possible, so a request is only ruled out when it is certainly impossible.
+	Inserting enterable space unions components immediately. Removing it may split a component, which is left over connected untill prepare checks it.
+	Prepare only looks at the neighborhood of removed space: it flood fills from each labeled cuboid touching it at once and stops as soon as the floods have met, so removing space from a large component which stays connected costs about as much as the local detour around it. Only pieces which were actually split off are relabeled.
+*/
+#pragma once
+#include "../dataStructures/rtreeData.h"
+#include "../dataStructures/smallSet.h"
+#include "../geometry/cuboidSet.h"
+#include "../numericTypes/idTypes.h"
+#include <vector>
+class Connectivity
+{
+	RTreeData<ConnectivityComponentId> m_labels;
+	// Union find forest, indexed by component id. Labels store the id they were created with, find maps it to the current root.
+	std::vector<ConnectivityComponentId> m_parents;
+	// Space removed since the last prepare.
+	std::vector<Cuboid> m_removed;
+	// Set by unite, prepare only flattens the forest when it has changed.
+	bool m_unitedSinceFlatten = false;
+	[[nodiscard]] ConnectivityComponentId createComponent();
+	void unite(const ConnectivityComponentId a, const ConnectivityComponentId b);
+	// Seeds are labeled cuboids of one component which touch removed space. Gives a new component to each piece which is no longer connected to the others.
+	void split(const std::vector<Cuboid>& seeds);
+public:
+	void insert(const Cuboid cuboid);
+	void remove(const Cuboid cuboid);
+	// Relabel pieces split off by remove and flatten the forest if it has changed. Not thread safe.
+	void prepare();
+	void clear();
+	// Does not compress paths, so may be called during the read step.
+	[[nodiscard]] ConnectivityComponentId find(ConnectivityComponentId id) const;
+	[[nodiscard]] ConnectivityComponentId getComponent(const Point3D point) const;
+	// True if start is labeled and no labeled point within destination is in the same component.
+	[[nodiscard]] bool canRuleOut(const Point3D start, const Cuboid destination) const;
+	[[nodiscard]] bool canRuleOut(const Point3D start, const CuboidSet& destination) const;
+	[[nodiscard]] bool needsPrepare() const { return !m_removed.empty(); }
+};
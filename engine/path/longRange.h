@@ -13,7 +13,7 @@
 #include "paramaters.h"
 #include "closedListWithFacing.h"
 #include "closedListLongRange.h"
-#include <omp.h>
+#include "../threads.h"
 class Area;
 class Enterable;
 namespace longRangePath
@@ -65,7 +65,7 @@ namespace longRangePath
 	// This vector is allocated during initalization and then never changed. Addresses within it are stable.
 	inline std::vector<LongRangeMemo> memos;
 	void init();
-	inline LongRangeMemo& getMemo() { return memos[omp_get_thread_num()]; }
+	inline LongRangeMemo& getMemo() { return memos[threads::getIndex()]; }
 	// Pass IntermediateResult out from inner templates to make testing easier.
 	struct IntermediateResult
 	{
@@ -84,6 +84,9 @@ namespace longRangePath
 	// Destination is passed as PathParamaters::huristicDestination
 	template<LongRangeCondition LongRangeConditionT, ShortRangeCondition ShortRangeConditionT>
 	[[nodiscard]] PathResult getPath(const Enterable& rtree, LongRangeConditionT&& longRangeCondition, ShortRangeConditionT&& shortRangeCondition, const PathParamaters& params);
+	// Second half of getPath: generates a point path within the bounds of a cuboid path. Also used with cuboid paths from RouteCache.
+	template<ShortRangeCondition ShortRangeConditionT>
+	[[nodiscard]] PathResult getPathFromIntermediateResult(ShortRangeConditionT&& shortRangeCondition, const PathParamaters& params, const IntermediateResult& intermediateResult);
 	// Wraps condition for unreserved by faction, if any faction is supplied.
 	template<LongRangeCondition LongRangeConditionT, ShortRangeCondition ShortRangeConditionT>
 	[[nodiscard]] IntermediateResult getPathUnreserved(const Enterable& rtree,LongRangeConditionT&& longRangeCondition, ShortRangeConditionT&& shortRangeCondition, const PathParamaters& params);
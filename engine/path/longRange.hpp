@@ -356,6 +356,11 @@ template<longRangePath::LongRangeCondition LongRangeConditionT, longRangePath::S
 {
 	// Coarse result first: cuboid path and target location.
 	IntermediateResult intermediateResult = getPathUnreserved(rtree, longRangeCondition, shortRangeCondition, params);
+	return getPathFromIntermediateResult(shortRangeCondition, params, intermediateResult);
+}
+template<longRangePath::ShortRangeCondition ShortRangeConditionT>
+[[nodiscard]] PathResult longRangePath::getPathFromIntermediateResult(ShortRangeConditionT&& shortRangeCondition, const PathParamaters& params, const IntermediateResult& intermediateResult)
+{
 	if(intermediateResult.target.empty())
 		return {{}, Point3D::null()};
 	if(!params.returnPath || intermediateResult.target == params.start)
@@ -171,6 +171,8 @@ GoToAnyPathRequest::GoToAnyPathRequest(const Json& data, Area& area) :
 }
 PathResult GoToAnyPathRequest::readStep(Area& area, const AreaHasPathsForMoveType& hasPaths)
 {
+	if(hasPaths.canRuleOut(destinations, toParamaters(area)))
+		return {};
 	auto longRangeCondition = [&](const Cuboid cuboid) -> bool { return destinations.intersects(cuboid); };
 	if(adjacent || anyOccupiedPoint)
 	{
@@ -242,6 +244,8 @@ PathResult GoToSpaceDesignationPathRequest::readStep(Area& area, const AreaHasPa
 {
 	assert(!huristicDestination.exists());
 	Space& space = area.getSpace();
+	if(hasPaths.canRuleOut(space.designation_queryForFaction(space.boundry(), faction, designation), toParamaters(area)))
+		return {};
 	auto longRangeCondition = [&](const Cuboid cuboid) -> bool { return space.designation_hasPoint(cuboid, faction, designation) != Point3D::null(); };
 	if(adjacent || anyOccupiedPoint)
 	{
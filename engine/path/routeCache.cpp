@@ -0,0 +1,72 @@
+#include "routeCache.h"
+#include "../config/config.h"
+#include "../threads.h"
+#include <algorithm>
+// threads::init runs in main, before any Area exists.
+RouteCache::RouteCache() :
+	m_pending(std::max(1, threads::max)),
+	m_hits(m_pending.size())
+{ }
+const std::vector<Cuboid>* RouteCache::find(const Cuboid start, const Point3D destination, const ShapeId shape) const
+{
+	auto found = std::ranges::find_if(m_routes, [&](const CachedRoute& route) { return route.start == start && route.destination == destination && route.shape == shape; });
+	if(found == m_routes.end())
+		return nullptr;
+	return &found->cuboids;
+}
+void RouteCache::record(const Cuboid start, const Point3D destination, const ShapeId shape, const std::vector<Cuboid>& cuboids)
+{
+	assert(!cuboids.empty());
+	assert(cuboids.back() == start);
+	assert(cuboids.front().contains(destination));
+	Cuboid boundry = cuboids.front();
+	for(const Cuboid cuboid : cuboids)
+		boundry.maybeExpand(cuboid);
+	assert(threads::getIndex() < (int)m_pending.size());
+	m_pending[threads::getIndex()].emplace_back(start, destination, shape, boundry, cuboids);
+}
+void RouteCache::recordHit()
+{
+	assert(threads::getIndex() < (int)m_hits.size());
+	++m_hits[threads::getIndex()];
+}
+int RouteCache::getHitCount() const
+{
+	threads::assertNotInReadPhase();
+	int output = 0;
+	for(const int hits : m_hits)
+		output += hits;
+	return output;
+}
+void RouteCache::commit()
+{
+	threads::assertNotInReadPhase();
+	for(std::vector<CachedRoute>& pending : m_pending)
+	{
+		for(CachedRoute& route : pending)
+			// Two threads may have found the same route.
+			if(find(route.start, route.destination, route.shape) == nullptr)
+				m_routes.push_back(std::move(route));
+		pending.clear();
+	}
+	// Discard the oldest routes.
+	if((int)m_routes.size() > Config::maxCachedRoutesPerMoveType)
+		m_routes.erase(m_routes.begin(), m_routes.end() - Config::maxCachedRoutesPerMoveType);
+}
+void RouteCache::invalidate(const Cuboid cuboid)
+{
+	threads::assertNotInReadPhase();
+	auto passesThrough = [cuboid](const CachedRoute& route)
+	{
+		return route.boundry.intersects(cuboid) && std::ranges::any_of(route.cuboids, [cuboid](const Cuboid routeCuboid) { return routeCuboid.intersects(cuboid); });
+	};
+	std::erase_if(m_routes, passesThrough);
+	for(std::vector<CachedRoute>& pending : m_pending)
+		std::erase_if(pending, passesThrough);
+}
+void RouteCache::clear()
+{
+	m_routes.clear();
+	for(std::vector<CachedRoute>& pending : m_pending)
+		pending.clear();
+}
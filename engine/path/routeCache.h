@@ -0,0 +1,42 @@
+/*
+	Cuboid routes from a start cuboid to a destination point, recorded by AreaHasPathsForMoveType::pathTo so repeated trips can skip the long range search.
+	Routes are only recorded when the start cuboid is freely navigable by shape, so the route is valid from any point within it.
+	Changes to enterable space invalidate every route which passes through the changed cuboid.
+*/
+#pragma once
+#include "../geometry/cuboid.h"
+#include "../numericTypes/idTypes.h"
+#include <vector>
+struct CachedRoute
+{
+	Cuboid start;
+	Point3D destination;
+	ShapeId shape;
+	// Used to skip checking each cuboid when invalidating.
+	Cuboid boundry;
+	// In the same order as IntermediateResult::cuboids: destination first, start last.
+	std::vector<Cuboid> cuboids;
+};
+class RouteCache
+{
+	std::vector<CachedRoute> m_routes;
+	// Routes recorded during the parallel read step are held per thread untill commit. Sized by the constructor so the read step never resizes.
+	std::vector<std::vector<CachedRoute>> m_pending;
+	// Indexed by thread, sized with m_pending.
+	std::vector<int> m_hits;
+public:
+	RouteCache();
+	[[nodiscard]] const std::vector<Cuboid>* find(const Cuboid start, const Point3D destination, const ShapeId shape) const;
+	// May be called from multiple threads at once.
+	void record(const Cuboid start, const Point3D destination, const ShapeId shape, const std::vector<Cuboid>& cuboids);
+	// Called by pathTo when a route from find is used. May be called from multiple threads at once.
+	void recordHit();
+	// Move pending routes into the cache. Not thread safe.
+	void commit();
+	// Remove all routes, including pending, which pass through cuboid.
+	void invalidate(const Cuboid cuboid);
+	void clear();
+	[[nodiscard]] int size() const { return m_routes.size(); }
+	// For testing and profiling.
+	[[nodiscard]] int getHitCount() const;
+};
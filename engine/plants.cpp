@@ -13,8 +13,6 @@
 
 Plants::Plants(Area& area) :
 	HasShapes<Plants, PlantIndex>(area),
-	m_growthEvent(area.m_eventSchedule),
-	m_shapeGrowthEvent(area.m_eventSchedule),
 	m_fluidEvent(area.m_eventSchedule),
 	m_temperatureEvent(area.m_eventSchedule),
 	m_endOfHarvestEvent(area.m_eventSchedule),
@@ -26,6 +24,85 @@ void Plants::moveIndex(const PlantIndex oldIndex, const PlantIndex newIndex)
 	Space& space = m_area.getSpace();
 	space.plant_updateIndex(this->boundry(newIndex), oldIndex, newIndex);
 }
+void Plants::doStep()
+{
+	const Step now = m_area.m_simulation.m_step;
+	if(m_nextCohortStep.empty() || m_nextCohortStep > now)
+		return;
+	// Find the cohort and the earliest step of the remaining plants in one pass over a single column.
+	std::vector<PlantIndex> cohort;
+	StepWidth next = Step::nullPrimitive();
+	const StepWidth nowWidth = now.get();
+	for(auto index = PlantIndex::create(0); index < size(); ++index)
+	{
+		const StepWidth step = m_cohortStep[index].get();
+		if(step <= nowWidth)
+			cohort.push_back(index);
+		else
+			next = std::min(next, step);
+	}
+	m_nextCohortStep = Step::create(next);
+	// Update in reverse order: a plant which dies is replaced by the last plant, which has either already been updated or is not in the cohort.
+	for(auto iter = cohort.rbegin(); iter != cohort.rend(); ++iter)
+		cohortUpdate(*iter);
+}
+void Plants::cohortUpdate(const PlantIndex index)
+{
+	const Step now = m_area.m_simulation.m_step;
+	if(m_growthStart[index].exists())
+	{
+		if(m_growthStart[index] + growthDuration(index) <= now)
+			completeGrowth(index);
+		else
+			updateShape(index);
+	}
+	if(m_fluidCheck[index].exists() && m_fluidCheck[index] <= now)
+		// Plants with a fluid check are not waiting for fluid so this will not kill them.
+		setMaybeNeedsFluid(index);
+	updateCohortStep(index);
+}
+void Plants::updateCohortStep(const PlantIndex index)
+{
+	Step next = m_fluidCheck[index];
+	const Step growthStart = m_growthStart[index];
+	if(growthStart.exists())
+	{
+		Step growth = growthStart + growthDuration(index);
+		if(canGrowShape(index))
+		{
+			const Step perShape = stepsPerShapeChange(index);
+			const Step elapsed = m_area.m_simulation.m_step - growthStart;
+			growth = std::min(growth, growthStart + perShape * ((elapsed / perShape).get() + 1));
+		}
+		if(next.empty() || growth < next)
+			next = growth;
+	}
+	if(next.exists())
+	{
+		const StepWidth interval = Config::plantCohortInterval.get();
+		next = Step::create(((next.get() + interval - 1) / interval) * interval);
+		if(m_nextCohortStep.empty() || next < m_nextCohortStep)
+			m_nextCohortStep = next;
+	}
+	m_cohortStep[index] = next;
+}
+void Plants::completeGrowth(const PlantIndex index)
+{
+	m_percentGrown[index] = Percent::create(100);
+	m_growthStart[index].clear();
+	updateShape(index);
+	if(PlantSpecies::getAnnual(m_species[index]))
+		setQuantityToHarvest(index);
+}
+Step Plants::growthDuration(const PlantIndex index) const
+{
+	return Step::create(util::scaleByInversePercent(PlantSpecies::getStepsTillFullyGrown(m_species[index]).get(), m_percentGrown[index]));
+}
+bool Plants::canGrowShape(const PlantIndex index) const
+{
+	const PlantSpeciesId species = m_species[index];
+	return (m_shape[index] != PlantSpecies::getShapes(species).back() && !m_wildGrowth[index]) || m_wildGrowth[index] < PlantSpecies::getMaxWildGrowth(species);
+}
 void Plants::onChangeAmbiantSurfaceTemperature(Temperature newAmbiant, const CuboidSet& exclude)
 {
 	for(const PlantIndex index : m_onSurface)
@@ -49,18 +126,21 @@ PlantIndex Plants::create(PlantParamaters paramaters)
 	m_quantityToHarvest[index] = paramaters.quantityToHarvest.empty() ? Quantity::create(0) : paramaters.quantityToHarvest;
 	m_wildGrowth[index] = 0;
 	m_volumeFluidRequested[index] = CollisionVolume::create(0);
+	m_growthStart[index].clear();
+	m_cohortStep[index].clear();
 	auto& space = m_area.getSpace();
 	assert(space.plant_canGrowHereEver(location, species));
 	location_set(index, location, Facing4::North);
 	int wildGrowth = PlantSpecies::wildGrowthForPercentGrown(species, getPercentGrown(index));
 	if(wildGrowth != 0)
 		doWildGrowth(index, wildGrowth);
-	// TODO: Generate event start steps from paramaters for fluid and temperature.
-	m_fluidEvent.schedule(index, m_area, PlantSpecies::getStepsNeedsFluidFrequency(species), index);
+	// TODO: Generate fluid check and temperature event start steps from paramaters.
+	m_fluidCheck[index] = m_area.m_simulation.m_step + PlantSpecies::getStepsNeedsFluidFrequency(species);
 	Temperature temperature = space.temperature_get(location);
 	if(temperature < PlantSpecies::getMinimumGrowingTemperature(species) || temperature > PlantSpecies::getMaximumGrowingTemperature(species))
 		m_temperatureEvent.schedule(index, m_area, PlantSpecies::getStepsTillDieFromTemperature(species), index);
 	updateGrowingStatus(index);
+	updateCohortStep(index);
 	m_area.m_hasFarmFields.removeAllSowSeedsDesignations(location);
 	// Fruit.
 	if(PlantSpecies::getStepsDurationHarvest(species).exists())
@@ -105,8 +185,6 @@ void Plants::destroyAll(const Cuboid cuboid)
 void Plants::die(const PlantIndex index)
 {
 	auto& space = m_area.getSpace();
-	m_growthEvent.maybeUnschedule(index);
-	m_shapeGrowthEvent.maybeUnschedule(index);
 	m_fluidEvent.maybeUnschedule(index);
 	m_temperatureEvent.maybeUnschedule(index);
 	m_endOfHarvestEvent.maybeUnschedule(index);
@@ -135,20 +213,20 @@ void Plants::setTemperature(const PlantIndex index, const Temperature temperatur
 void Plants::setHasFluidForNow(const PlantIndex index)
 {
 	m_volumeFluidRequested[index] = CollisionVolume::create(0);
-	if(m_fluidEvent.exists(index))
-		m_fluidEvent.unschedule(index);
-	m_fluidEvent.schedule(index, m_area, PlantSpecies::getStepsNeedsFluidFrequency(getSpecies(index)), index);
+	m_fluidEvent.maybeUnschedule(index);
+	m_fluidCheck[index] = m_area.m_simulation.m_step + PlantSpecies::getStepsNeedsFluidFrequency(getSpecies(index));
 	updateGrowingStatus(index);
+	updateCohortStep(index);
 	m_area.getSpace().farm_removeAllGiveFluidDesignations(m_location[index]);
 }
 void Plants::setMaybeNeedsFluid(const PlantIndex index)
 {
-	Step stepsTillNextFluidEvent;
 	PlantSpeciesId species = m_species[index];
 	if(hasFluidSource(index))
 	{
 		m_volumeFluidRequested[index] = CollisionVolume::create(0);
-			stepsTillNextFluidEvent = PlantSpecies::getStepsNeedsFluidFrequency(species);
+		m_fluidEvent.maybeUnschedule(index);
+		m_fluidCheck[index] = m_area.m_simulation.m_step + PlantSpecies::getStepsNeedsFluidFrequency(species);
 	}
 	else if(m_volumeFluidRequested[index] != 0)
 	{
@@ -158,12 +236,13 @@ void Plants::setMaybeNeedsFluid(const PlantIndex index)
 	else // Needs fluid, stop growing and set death timer.
 	{
 		updateFluidVolumeRequested(index);
-		stepsTillNextFluidEvent = PlantSpecies::getStepsTillDieWithoutFluid(species);
+		m_fluidCheck[index].clear();
+		m_fluidEvent.maybeUnschedule(index);
+		m_fluidEvent.schedule(index, m_area, PlantSpecies::getStepsTillDieWithoutFluid(species), index);
 		m_area.getSpace().farm_designateForGiveFluidIfPartOfFarmField(m_location[index], index);
 	}
-	m_fluidEvent.maybeUnschedule(index);
-	m_fluidEvent.schedule(index, m_area, stepsTillNextFluidEvent, index);
 	updateGrowingStatus(index);
+	updateCohortStep(index);
 }
 void Plants::addFluid(const PlantIndex index, const CollisionVolume volume, [[maybe_unused]] const FluidTypeId fluidType)
 {
@@ -190,11 +269,25 @@ bool Plants::hasFluidSource(const PlantIndex index)
 			}
 	return false;
 }
-void Plants::setDayOfYear(const PlantIndex index, int dayOfYear)
+void Plants::setDayOfYear(int dayOfYear)
 {
-	PlantSpeciesId species = m_species[index];
-	if(PlantSpecies::getItemQuantityToHarvest(species).exists() && dayOfYear == PlantSpecies::getDayOfYearToStartHarvest(species))
-		setQuantityToHarvest(index);
+	// Harvest starts on the same day for every plant of a species, check species first so most days do not look at any plants.
+	StrongBitSet<PlantSpeciesId> starting;
+	const PlantSpeciesId speciesCount = PlantSpecies::size();
+	starting.resize(speciesCount);
+	bool any = false;
+	for(auto species = PlantSpeciesId::create(0); species < speciesCount; ++species)
+		if(PlantSpecies::getItemQuantityToHarvest(species).exists() && dayOfYear == PlantSpecies::getDayOfYearToStartHarvest(species))
+		{
+			starting.set(species);
+			any = true;
+		}
+	if(!any)
+		return;
+	// setQuantityToHarvest does not destroy plants so indices are stable.
+	for(auto index = PlantIndex::create(0); index < size(); ++index)
+		if(starting[m_species[index]])
+			setQuantityToHarvest(index);
 }
 void Plants::setQuantityToHarvest(const PlantIndex index)
 {
@@ -238,39 +331,42 @@ void Plants::updateGrowingStatus(const PlantIndex index)
 			getPercentFoliage(index) >= Config::minimumPercentFoliageForGrow
 	)
 	{
-		if(!m_growthEvent.exists(index))
+		if(m_growthStart[index].empty())
 		{
 			// Start growing.
-			Step delay = (m_percentGrown[index] == 0 ?
-					PlantSpecies::getStepsTillFullyGrown(species) :
-					Step::create(util::scaleByPercent(PlantSpecies::getStepsTillFullyGrown(species).get(), m_percentGrown[index])));
-			m_growthEvent.schedule(index, m_area, delay, index);
-			if((m_shape[index] != PlantSpecies::getShapes(species).back() && !m_wildGrowth[index]) || m_wildGrowth[index] < PlantSpecies::getMaxWildGrowth(species))
-				m_shapeGrowthEvent.schedule(index, m_area, stepsPerShapeChange(index), index);
+			m_growthStart[index] = m_area.m_simulation.m_step;
+			updateCohortStep(index);
 		}
 	}
 	else
 	{
-		if(m_growthEvent.exists(index))
+		if(m_growthStart[index].exists())
 		{
-			// Stop growing.
-			m_percentGrown[index] = getPercentGrown(index);
-			m_growthEvent.unschedule(index);
-			m_shapeGrowthEvent.maybeUnschedule(index);
-			// Run updateShape here in case we are overdue, for example because the update shape event keeps getting canceled but the growth percentage has accumulated enough anyway.
-			updateShape(index);
+			// Stop growing. Growth may have finished since the last cohort pass.
+			const Percent percentGrown = getPercentGrown(index);
+			if(percentGrown == 100)
+				completeGrowth(index);
+			else
+			{
+				m_percentGrown[index] = percentGrown;
+				m_growthStart[index].clear();
+				// Run updateShape here in case we are overdue, the cohort pass may not have reached this plant's shape change yet but the growth percentage has accumulated enough anyway.
+				updateShape(index);
+			}
+			updateCohortStep(index);
 		}
 	}
 }
 Percent Plants::getPercentGrown(const PlantIndex index) const
 {
 	Percent output = m_percentGrown[index];
-	if(m_growthEvent.exists(index))
+	const Step growthStart = m_growthStart[index];
+	if(growthStart.exists())
 	{
-		if(m_percentGrown[index] != 0)
-			output += (m_growthEvent.percentComplete(index) * (Percent::create(100) - m_percentGrown[index])) / 100;
-		else
-			output = m_growthEvent.percentComplete(index);
+		// Completion is only applied by the cohort pass, which may be up to Config::plantCohortInterval later.
+		const float fraction = std::min(1.f, (float)(m_area.m_simulation.m_step - growthStart).get() / (float)growthDuration(index).get());
+		const Percent complete = Percent::create(fraction * 100);
+		output += (complete * (Percent::create(100) - m_percentGrown[index])) / 100;
 	}
 	return output;
 }
@@ -316,10 +412,6 @@ bool Plants::fluidEventExists(const PlantIndex index) const
 {
 	return m_fluidEvent.exists(index);
 }
-bool Plants::growthEventExists(const PlantIndex index) const
-{
-	return m_growthEvent.exists(index);
-}
 void Plants::removeFoliageMass(const PlantIndex index, const Mass mass)
 {
 	Mass maxFoliageForType = Mass::create(util::scaleByPercent(PlantSpecies::getAdultMass(getSpecies(index)).get(), Config::percentOfPlantMassWhichIsFoliage));
@@ -338,7 +430,6 @@ void Plants::doWildGrowth(const PlantIndex index, int count)
 	auto& space = m_area.getSpace();
 	m_wildGrowth[index] += count;
 	assert(m_wildGrowth[index] <= PlantSpecies::getMaxWildGrowth(species));
-	Simulation& simulation = m_area.m_simulation;
 	while(count)
 	{
 		count--;
@@ -355,7 +446,7 @@ void Plants::doWildGrowth(const PlantIndex index, int count)
 			m_wildGrowth[index] = PlantSpecies::getMaxWildGrowth(species);
 		else
 		{
-			const Point3D toGrowInto = candidates[simulation.m_random.getInRange(0, (int)candidates.size() - 1)];
+			const Point3D toGrowInto = candidates[m_area.m_random.getInRange(0, (int)candidates.size() - 1)];
 			const Offset3D offset = m_location[index].offsetTo(toGrowInto);
 			// Use the volume of the location position as the volume of the new growth position.
 			const std::pair<OffsetCuboid, CollisionVolume> pair = {OffsetCuboid{offset, offset}, Shape::getCollisionVolumeAtLocation(m_shape[index])};
@@ -467,8 +558,6 @@ Json Plants::toJson() const
 	Json output;
 	to_json(output, static_cast<const HasShapes&>(*this));
 	output.update({
-		{"m_growthEvent", m_growthEvent},
-		{"m_shapeGrowthEvent", m_shapeGrowthEvent},
 		{"m_fluidEvent", m_fluidEvent},
 		{"m_temperatureEvent", m_temperatureEvent},
 		{"m_endOfHarvestEvent", m_endOfHarvestEvent},
@@ -480,6 +569,8 @@ Json Plants::toJson() const
 		{"m_percentFoliage", m_percentFoliage},
 		{"m_wildGrowth", m_wildGrowth},
 		{"m_volumeFluidRequested", m_volumeFluidRequested},
+		{"m_growthStart", m_growthStart},
+		{"m_fluidCheck", m_fluidCheck},
 	});
 	return output;
 }
@@ -487,8 +578,6 @@ void Plants::load(const Json& data)
 {
 	nlohmann::from_json(data, static_cast<HasShapes&>(*this));
 	PlantIndex size = PlantIndex::create(m_shape.size());
-	m_growthEvent.load(m_area.m_simulation, data["m_growthEvent"], size);
-	m_shapeGrowthEvent.load(m_area.m_simulation, data["m_shapeGrowthEvent"], size);
 	m_fluidEvent.load(m_area.m_simulation, data["m_fluidEvent"], size);
 	m_temperatureEvent.load(m_area.m_simulation, data["m_temperatureEvent"], size);
 	m_endOfHarvestEvent.load(m_area.m_simulation, data["m_endOfHarvestEvent"], size);
@@ -500,10 +589,16 @@ void Plants::load(const Json& data)
 	m_percentFoliage = data["m_percentFoliage"].get<StrongVector<Percent, PlantIndex>>();
 	m_wildGrowth = data["m_wildGrowth"].get<StrongVector<int, PlantIndex>>();
 	m_volumeFluidRequested = data["m_volumeFluidRequested"].get<StrongVector<CollisionVolume, PlantIndex>>();
+	m_growthStart = data["m_growthStart"].get<StrongVector<Step, PlantIndex>>();
+	m_fluidCheck = data["m_fluidCheck"].get<StrongVector<Step, PlantIndex>>();
+	m_cohortStep.resize(size);
 	Space& space = m_area.getSpace();
 	for(const PlantIndex index : getAll())
+	{
 		for(const Cuboid cuboid : m_occupied[index])
 			space.plant_set(cuboid, index);
+		updateCohortStep(index);
+	}
 }
 void to_json(Json& data, const Plants& plants)
 {
@@ -520,34 +615,6 @@ SmallSet<PlantIndex> Plants::getAll() const
 	return output;
 }
 // Events.
-PlantGrowthEvent::PlantGrowthEvent(Area& area, const Step delay, const PlantIndex p, const Step start) :
-	ScheduledEvent(area.m_simulation, delay, start), m_plant(p) {}
-PlantGrowthEvent::PlantGrowthEvent(Simulation& simulation, const Json& data) :
-	ScheduledEvent(simulation, data["delay"].get<Step>(), data["start"].get<Step>()), m_plant(data["plant"].get<PlantIndex>()) { }
-void PlantGrowthEvent::execute(Simulation&, Area* area)
-{
-	Plants& plants = area->getPlants();
-	plants.m_percentGrown[m_plant] = Percent::create(100);
-	if(PlantSpecies::getAnnual(plants.m_species[m_plant]))
-		plants.setQuantityToHarvest(m_plant);
-}
-void PlantGrowthEvent::clearReferences(Simulation&, Area* area) { area->getPlants().m_growthEvent.clearPointer(m_plant); }
-Json PlantGrowthEvent::toJson() const { return {{"delay", duration()}, {"start", m_startStep}, {"plant", m_plant}}; }
-
-PlantShapeGrowthEvent::PlantShapeGrowthEvent(Area& area, const Step delay, const PlantIndex p, const Step start) :
-	ScheduledEvent(area.m_simulation, delay, start), m_plant(p) {}
-PlantShapeGrowthEvent::PlantShapeGrowthEvent(Simulation& simulation, const Json& data) :
-	ScheduledEvent(simulation, data["delay"].get<Step>(), data["start"].get<Step>()), m_plant(data["plant"].get<PlantIndex>()) { }
-void PlantShapeGrowthEvent::execute(Simulation&, Area* area)
-{
-	Plants& plants = area->getPlants();
-	plants.updateShape(m_plant);
-	if(plants.getPercentGrown(m_plant) != 100)
-		plants.m_shapeGrowthEvent.schedule(m_plant, *area, plants.stepsPerShapeChange(m_plant), m_plant);
-}
-void PlantShapeGrowthEvent::clearReferences(Simulation&, Area* area) { area->getPlants().m_shapeGrowthEvent.clearPointer(m_plant); }
-Json PlantShapeGrowthEvent::toJson() const { return {{"delay", duration()}, {"start", m_startStep}, {"plant", m_plant}}; }
-
 PlantFoliageGrowthEvent::PlantFoliageGrowthEvent(Area& area, const Step delay, const PlantIndex p, const Step start) :
 	ScheduledEvent(area.m_simulation, delay, start), m_plant(p) {}
 PlantFoliageGrowthEvent::PlantFoliageGrowthEvent(Simulation& simulation, const Json& data) :
@@ -10,8 +10,6 @@
 
 struct PlantSpecies;
 struct FluidType;
-class PlantGrowthEvent;
-class PlantShapeGrowthEvent;
 class PlantFluidEvent;
 class PlantTemperatureEvent;
 class PlantEndOfHarvestEvent;
@@ -33,11 +31,14 @@ struct PlantParamaters
 	Percent percentFoliageGrowth = Percent::null();
 	FactionId faction = FactionId::null();
 };
+/*
+	Growth, shape growth and periodic fluid checks are not scheduled events. Each plant records when it started growing and when it next looks for fluid, and the earliest step at which either needs attention, rounded up to Config::plantCohortInterval.
+	doStep handles every plant due in the same interval as one cohort: a single pass over m_cohortStep finds them and the minimum for the next pass.
+	Per plant events are only created once a threshold is crossed: running out of fluid, unsafe temperature, losing foliage or becoming harvestable.
+*/
 class Plants final : public HasShapes<Plants, PlantIndex>
 {
-	HasScheduledEvents<PlantGrowthEvent, PlantIndex> m_growthEvent;
-	//TODO: Why is this a seperate event from plant growth?
-	HasScheduledEvents<PlantShapeGrowthEvent, PlantIndex> m_shapeGrowthEvent;
+	// Only exists while the plant needs fluid, it is the step at which the plant dies.
 	HasScheduledEvents<PlantFluidEvent, PlantIndex> m_fluidEvent;
 	HasScheduledEvents<PlantTemperatureEvent, PlantIndex> m_temperatureEvent;
 	HasScheduledEvents<PlantEndOfHarvestEvent, PlantIndex> m_endOfHarvestEvent;
@@ -49,12 +50,24 @@ class Plants final : public HasShapes<Plants, PlantIndex>
 	StrongVector<Percent, PlantIndex> m_percentFoliage;
 	StrongVector<int, PlantIndex> m_wildGrowth;
 	StrongVector<CollisionVolume, PlantIndex> m_volumeFluidRequested;
+	// Null when not growing. m_percentGrown holds the percent at this step.
+	StrongVector<Step, PlantIndex> m_growthStart;
+	// Null while the plant needs fluid.
+	StrongVector<Step, PlantIndex> m_fluidCheck;
+	StrongVector<Step, PlantIndex> m_cohortStep;
+	// May be earlier then any m_cohortStep if the plant which set it has since been destroyed, this only costs an empty pass.
+	Step m_nextCohortStep;
 	PlantIndex m_incrementalSortPosition;
 	std::chrono::microseconds m_averageSortTimePerPlant = std::chrono::microseconds(10);
 	int m_averageSortTimeSampleSize = 0;
 	int m_sortEntropy = 0;
 	void moveIndex(const PlantIndex oldIndex, const PlantIndex newIndex);
 	void updateFluidVolumeRequested(const PlantIndex index);
+	void updateCohortStep(const PlantIndex index);
+	void cohortUpdate(const PlantIndex index);
+	void completeGrowth(const PlantIndex index);
+	[[nodiscard]] Step growthDuration(const PlantIndex index) const;
+	[[nodiscard]] bool canGrowShape(const PlantIndex index) const;
 public:
 	Plants(Area& area);
 	void load(const Json& data);
@@ -63,8 +76,6 @@ public:
 	void forEachData(Action&& action)
 	{
 		forEachDataHasShapes(action);
-		action(m_growthEvent);
-		action(m_shapeGrowthEvent);
 		action(m_fluidEvent);
 		action(m_temperatureEvent);
 		action(m_endOfHarvestEvent);
@@ -76,8 +87,12 @@ public:
 		action(m_percentFoliage);
 		action(m_wildGrowth);
 		action(m_volumeFluidRequested);
+		action(m_growthStart);
+		action(m_fluidCheck);
+		action(m_cohortStep);
 		action(m_onSurface);
 	}
+	void doStep();
 	PlantIndex create(PlantParamaters paramaters);
 	void destroy(const PlantIndex index);
 	void destroyAll(const Cuboid cuboid);
@@ -87,7 +102,8 @@ public:
 	void setHasFluidForNow(const PlantIndex index);
 	void setMaybeNeedsFluid(const PlantIndex index);
 	void addFluid(const PlantIndex index, const CollisionVolume volume, const FluidTypeId fluidType);
-	void setDayOfYear(const PlantIndex index, int dayOfYear);
+	// Called once per day by Area::updateClimate.
+	void setDayOfYear(int dayOfYear);
 	void setQuantityToHarvest(const PlantIndex index);
 	void harvest(const PlantIndex index, const Quantity quantity);
 	void endOfHarvest(const PlantIndex index);
@@ -109,12 +125,16 @@ public:
 	[[nodiscard]] Mass getFruitMass(const PlantIndex index) const;
 	// Not const: updates cache.
 	[[nodiscard]] bool hasFluidSource(const PlantIndex index);
-	[[nodiscard]] bool isGrowing(const PlantIndex index) const { return m_growthEvent.exists(index); }
+	[[nodiscard]] bool isGrowing(const PlantIndex index) const { return m_growthStart[index].exists(); }
 	[[nodiscard]] Percent getPercentGrown(const PlantIndex index) const;
 	[[nodiscard]] Distance getRootRange(const PlantIndex index) const;
 	[[nodiscard]] Percent getPercentFoliage(const PlantIndex index) const;
 	[[nodiscard]] Mass getFoliageMass(const PlantIndex index) const;
 	[[nodiscard]] Step getStepAtWhichPlantWillDieFromLackOfFluid(const PlantIndex index) const;
+	[[nodiscard]] Step getStepOfNextFluidCheck(const PlantIndex index) const { return m_fluidCheck[index]; }
+	[[nodiscard]] Step getCohortStep(const PlantIndex index) const { return m_cohortStep[index]; }
+	// Null when no plant is waiting for the cohort pass.
+	[[nodiscard]] Step getNextCohortStep() const { return m_nextCohortStep; }
 	[[nodiscard]] Quantity getQuantityToHarvest(const PlantIndex index) const { return m_quantityToHarvest[index]; }
 	[[nodiscard]] Step stepsPerShapeChange(const PlantIndex index) const;
 	[[nodiscard]] bool readyToHarvest(const PlantIndex index) const { return m_quantityToHarvest[index] != 0; }
@@ -122,11 +142,8 @@ public:
 	[[nodiscard]] bool temperatureEventExists(const PlantIndex index) const;
 	[[nodiscard]] bool fluidEventExists(const PlantIndex index) const;
 	[[nodiscard]] Percent getFluidEventPercentComplete(const PlantIndex index) const { return m_fluidEvent.percentComplete(index); }
-	[[nodiscard]] bool growthEventExists(const PlantIndex index) const;
 	[[nodiscard]] Json toJson() const;
 	void log(const PlantIndex index) const;
-	friend class PlantGrowthEvent;
-	friend class PlantShapeGrowthEvent;
 	friend class PlantFoliageGrowthEvent;
 	friend class PlantEndOfHarvestEvent;
 	friend class PlantFluidEvent;
@@ -135,28 +152,6 @@ public:
 	Plants(Plants&&) = delete;
 };
 void to_json(Json& data, const Plants& plants);
-class PlantGrowthEvent final : public ScheduledEvent
-{
-	PlantIndex m_plant;
-public:
-	PlantGrowthEvent(Area& area, const Step delay, const PlantIndex p, const Step start = Step::null());
-	PlantGrowthEvent(Simulation& simulation, const Json& data);
-	void execute(Simulation&, Area* area);
-	void clearReferences(Simulation&, Area* area);
-	void onMoveIndex([[maybe_unused]] const HasShapeIndex oldIndex, const HasShapeIndex newIndex) { assert(m_plant == oldIndex.toPlant()); m_plant = PlantIndex::create(newIndex.get()); }
-	[[nodiscard]] Json toJson() const;
-};
-class PlantShapeGrowthEvent final : public ScheduledEvent
-{
-	PlantIndex m_plant;
-public:
-	PlantShapeGrowthEvent(Area& area, const Step delay, const PlantIndex p, const Step start = Step::null());
-	PlantShapeGrowthEvent(Simulation& simulation, const Json& data);
-	void execute(Simulation&, Area* area);
-	void clearReferences(Simulation&, Area* area);
-	void onMoveIndex([[maybe_unused]] const HasShapeIndex oldIndex, const HasShapeIndex newIndex) { assert(m_plant == oldIndex.toPlant()); m_plant = PlantIndex::create(newIndex.get()); }
-	[[nodiscard]] Json toJson() const;
-};
 class PlantFoliageGrowthEvent final : public ScheduledEvent
 {
 	PlantIndex m_plant;
@@ -14,7 +14,6 @@
 #include "actorOrItemIndex.h"
 
 struct MoveType;
-class MoveEvent;
 class Area;
 class PathThreadedTask;
 class HasOnDestroySubscriptions;
@@ -1448,14 +1448,14 @@ ItemIndex Project::getRandomItemToConsume() const
 {
 	if(m_toConsume.empty())
 		return ItemIndex::null();
-	const ItemReference ref = m_area.m_simulation.m_random.getInVector(m_toConsume.m_data).first;
+	const ItemReference ref = m_area.m_random.getInVector(m_toConsume.m_data).first;
 	return ref.getIndex(m_area.getItems().m_referenceData);
 }
 ItemIndex Project::getRandomUnconsumedItem() const
 {
 	if(m_unconsumed.empty())
 		return ItemIndex::null();
-	const ItemReference ref = m_area.m_simulation.m_random.getInVector(m_unconsumed.m_data);
+	const ItemReference ref = m_area.m_random.getInVector(m_unconsumed.m_data);
 	return ref.getIndex(m_area.getItems().m_referenceData);
 }
 SmallSet<ActorIndex> Project::getWorkersAndCandidates()
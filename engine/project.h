@@ -330,5 +330,7 @@ public:
 	void readStep(Simulation& simulation, Area* area);
 	void writeStep(Simulation& simulation, Area* area);
 	void clearReferences(Simulation& simulation, Area* area);
+	// Records items to pickup on the project during read step.
+	[[nodiscard]] bool readStepIsThreadSafe() const { return false; }
 	[[nodiscard]] bool validate();
 };
\ No newline at end of file
@@ -44,7 +44,7 @@ std::vector<ActorReference> DigProject::getActors() const { return {}; }
 std::vector<std::tuple<ItemTypeId, MaterialTypeId, Quantity>> DigProject::getByproducts() const
 {
 	std::vector<std::tuple<ItemTypeId, MaterialTypeId, Quantity>> output;
-	Random& random = m_area.m_simulation.m_random;
+	Random& random = m_area.m_random;
 	auto& space = m_area.getSpace();
 	MaterialTypeId materialType = space.solid_get(m_location);
 	if(materialType.empty())
@@ -141,10 +141,11 @@ void Psycology::checkThreasholds(Area& area, const ActorIndex actor)
 		}
 	}
 }
-void Psycology::setExpiration(const Step duration, Simulation& simulation, const ActorId actor, const PsycologyEventType& eventType, const PsycologyData& eventDeltas)
+void Psycology::setExpiration(const Step duration, Area& area, const ActorId actor, const PsycologyEventType& eventType, const PsycologyData& eventDeltas, const Step start)
 {
-		std::unique_ptr<HasScheduledEvent<PsycologyEventExpiresScheduledEvent>> holder = std::make_unique<HasScheduledEvent<PsycologyEventExpiresScheduledEvent>>(simulation.m_eventSchedule);
-		holder->schedule(duration, eventType, eventDeltas, actor, simulation);
+		// Scheduled with the Area rather then the Simulation because this is called while Areas may be stepping concurrently.
+		std::unique_ptr<HasScheduledEvent<PsycologyEventExpiresScheduledEvent>> holder = std::make_unique<HasScheduledEvent<PsycologyEventExpiresScheduledEvent>>(area.m_eventSchedule);
+		holder->schedule(duration, eventType, eventDeltas, actor, area.m_simulation, start);
 		m_expirationEvents.insert(std::move(holder));
 }
 void Psycology::apply(PsycologyEvent& event, Area& area, const ActorIndex actor, const Step duration, const Step cooldown)
@@ -171,7 +172,7 @@ void Psycology::apply(PsycologyEvent& event, Area& area, const ActorIndex actor,
 	m_current += event.deltas;
 	checkThreasholds(area, actor);
 	if(duration.exists())
-		setExpiration(duration, area.m_simulation, area.getActors().getId(actor), event.type, event.deltas);
+		setExpiration(duration, area, area.getActors().getId(actor), event.type, event.deltas);
 	if(cooldown.exists())
 		m_cooldowns.getOrCreate(event.type) = cooldown;
 	else
@@ -301,8 +302,9 @@ Json Psycology::toJson() const
 	}
 	return output;
 }
-Psycology Psycology::load(const Json& data, Simulation& simulation)
+Psycology Psycology::load(const Json& data, Area& area)
 {
+	Simulation& simulation = area.m_simulation;
 	Psycology output;
 	data["current"].get_to(output.m_current);
 	data["highTriggers"].get_to(output.m_highTriggers);
@@ -323,7 +325,7 @@ Psycology Psycology::load(const Json& data, Simulation& simulation)
 	data["family"].get_to(output.m_family);
 	data["relationships"].get_to(output.m_relationships);
 	for(const Json& eventData : data["expirationEvents"])
-		output.setExpiration(eventData["duration"].get<Step>(), simulation, eventData["actor"].get<ActorId>(), eventData["type"].get<PsycologyEventType>(), eventData["deltas"].get<PsycologyData>());
+		output.setExpiration(eventData["duration"].get<Step>(), area, eventData["actor"].get<ActorId>(), eventData["type"].get<PsycologyEventType>(), eventData["deltas"].get<PsycologyData>(), eventData["start"].get<Step>());
 	data["cooldowns"].get_to(output.m_cooldowns);
 	return output;
 }
\ No newline at end of file
@@ -71,7 +71,7 @@ class Psycology final
 	SmallMap<PsycologyEventType, Step> m_cooldowns;
 	// Possibly trigger callbacks.
 	void checkThreasholds(Area& area, const ActorIndex actor);
-	void setExpiration(const Step duration, Simulation& simulation, const ActorId actor, const PsycologyEventType& eventType, const PsycologyData& eventDeltas);
+	void setExpiration(const Step duration, Area& area, const ActorId actor, const PsycologyEventType& eventType, const PsycologyData& eventDeltas, const Step start = Step::null());
 public:
 	void initialize();
 	// Record callbacks, modify current, check threasholds.
@@ -90,7 +90,7 @@ public:
 	[[nodiscard]] const SmallMap<ActorId, FamilyRelationship>& getFamily() const { return m_family; }
 	[[nodiscard]] PsycologyWeight getValueFor(const PsycologyAttribute& attribute) const;
 	[[nodiscard]] Json toJson() const;
-	static Psycology load(const Json& data, Simulation& simulation);
+	static Psycology load(const Json& data, Area& area);
 	friend class PsycologyEventExpiresScheduledEvent;
 };
 
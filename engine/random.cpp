@@ -2,6 +2,7 @@
 #include "geometry/cuboid.h"
 bool Random::percentChance(const Percent percent)
 {
+	threads::assertNotInReadPhase();
 	if(percent >= 100)
 		return true;
 	if(percent <= 0)
@@ -11,6 +12,7 @@ bool Random::percentChance(const Percent percent)
 }
 bool Random::chance(double chance)
 {
+	threads::assertNotInReadPhase();
 	assert(chance >= 0.0);
 	assert(chance <= 1.0);
 	std::uniform_real_distribution<double> dist(0.0, 1.0);
@@ -18,6 +20,7 @@ bool Random::chance(double chance)
 }
 bool Random::chance(float chance)
 {
+	threads::assertNotInReadPhase();
 	assert(chance >= 0.0f);
 	assert(chance <= 1.0f);
 	std::uniform_real_distribution<float> dist(0.0, 1.0);
@@ -25,6 +28,7 @@ bool Random::chance(float chance)
 }
 Point3D Random::getInCuboid(const Cuboid cuboid)
 {
+	threads::assertNotInReadPhase();
 	std::uniform_int_distribution<DistanceWidth> rangeX(cuboid.m_low.x().get(), cuboid.m_high.x().get());
 	std::uniform_int_distribution<DistanceWidth> rangeY(cuboid.m_low.y().get(), cuboid.m_high.y().get());
 	std::uniform_int_distribution<DistanceWidth> rangeZ(cuboid.m_low.z().get(), cuboid.m_high.z().get());
@@ -34,3 +38,61 @@ Point3D Random::getInCuboid(const Cuboid cuboid)
 		rangeZ(rng)
 	);
 }
+RandomStream::RandomStream(const uint32_t seed, const Step step, const uint32_t entity, const RandomPurpose purpose) :
+	// The first word counts blocks drawn from this stream.
+	m_counter({0, entity, (uint32_t)step.get(), (uint32_t)((uint64_t)step.get() >> 32)}),
+	m_key({seed, (uint32_t)purpose})
+{
+	assert(step.exists());
+	assert(purpose != RandomPurpose::Null);
+}
+uint32_t RandomStream::next()
+{
+	if(m_blockPosition == 4)
+	{
+		m_block = philox(m_counter, m_key);
+		++m_counter[0];
+		// A stream would need 2^34 draws to wrap.
+		assert(m_counter[0] != 0);
+		m_blockPosition = 0;
+	}
+	return m_block[m_blockPosition++];
+}
+bool RandomStream::percentChance(const Percent percent)
+{
+	if(percent >= 100)
+		return true;
+	if(percent <= 0)
+		return false;
+	return getInRange(1, 100) <= (int)percent.get();
+}
+bool RandomStream::chance(const double chance)
+{
+	assert(chance >= 0.0);
+	assert(chance <= 1.0);
+	return getInRange(0.0, 1.0) < chance;
+}
+std::array<uint32_t, 4> RandomStream::philox(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key)
+{
+	constexpr uint64_t multiplier0 = 0xD2511F53;
+	constexpr uint64_t multiplier1 = 0xCD9E8D57;
+	constexpr uint32_t weyl0 = 0x9E3779B9;
+	constexpr uint32_t weyl1 = 0xBB67AE85;
+	for(int round = 0; round != 10; ++round)
+	{
+		if(round != 0)
+		{
+			key[0] += weyl0;
+			key[1] += weyl1;
+		}
+		const uint64_t product0 = multiplier0 * counter[0];
+		const uint64_t product1 = multiplier1 * counter[2];
+		counter = {
+			(uint32_t)(product1 >> 32) ^ counter[1] ^ key[0],
+			(uint32_t)product1,
+			(uint32_t)(product0 >> 32) ^ counter[3] ^ key[1],
+			(uint32_t)product0,
+		};
+	}
+	return counter;
+}
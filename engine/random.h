@@ -1,21 +1,88 @@
 #pragma once
 
 #include "numericTypes/types.h"
+#include "threads.h"
 
 #include <random>
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
 
 struct Cuboid;
 struct Point3D;
 
+// Separates streams drawn for the same entity on the same step.
+enum class RandomPurpose : uint32_t
+{
+	CourageTest,
+	Wander,
+	Null
+};
+/*
+	Counter based random numbers for parallel phases, using the Philox4x32-10 block function.
+	A stream is identified by seed, step, entity and purpose. The nth value of a stream depends only on those and n, not on which thread draws it or on the order streams are drawn in, so results are identical for any thread count.
+	Streams are cheap to create and are not shared: make one per entity where it is needed.
+	Ranges are mapped with multiply and reject rather then std distributions, so results are the same with every standard library.
+*/
+class RandomStream
+{
+	std::array<uint32_t, 4> m_counter;
+	std::array<uint32_t, 4> m_block;
+	std::array<uint32_t, 2> m_key;
+	int m_blockPosition = 4;
+public:
+	RandomStream(const uint32_t seed, const Step step, const uint32_t entity, const RandomPurpose purpose);
+	[[nodiscard]] uint32_t next();
+	[[nodiscard]] uint64_t next64() { const uint64_t high = next(); return (high << 32) | next(); }
+	template<typename T>
+	T getInRange(T lowest, T highest)
+	{
+		assert(lowest <= highest);
+		if constexpr(std::is_integral_v<T>)
+		{
+			// Lemire's nearly divisionless method, the range is highest - lowest + 1 which is 0 when it covers every 64 bit value.
+			const uint64_t range = (uint64_t)highest - (uint64_t)lowest + 1;
+			if(range == 0)
+				return (T)next64();
+			unsigned __int128 product = (unsigned __int128)next64() * range;
+			if((uint64_t)product < range)
+			{
+				const uint64_t threshold = -range % range;
+				while((uint64_t)product < threshold)
+					product = (unsigned __int128)next64() * range;
+			}
+			return (T)((uint64_t)lowest + (uint64_t)(product >> 64));
+		}
+		else
+			// 53 random bits in [0, 1).
+			return lowest + (T)((next64() >> 11) * 0x1.0p-53) * (highest - lowest);
+	}
+	bool percentChance(const Percent percent);
+	bool chance(const double chance);
+	template<typename T>
+	T applyRandomFuzzPlusOrMinusRatio(const T& input, const float ratio)
+	{
+		int maxPlus = ratio * (float)input.get();
+		return input + getInRange(-maxPlus, maxPlus);
+	}
+	// Exposed for testing against published known answers.
+	[[nodiscard]] static std::array<uint32_t, 4> philox(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key);
+};
 class Random
 {
 	std::mt19937 rng;
+	uint32_t m_seed = std::mt19937::default_seed;
 public:
+	void seed(const uint32_t value) { rng.seed(value); m_seed = value; }
+	[[nodiscard]] uint32_t getSeed() const { return m_seed; }
+	// For parallel phases, does not advance this generator. See RandomStream.
+	[[nodiscard]] RandomStream getStream(const Step step, const uint32_t entity, const RandomPurpose purpose) const { return {m_seed, step, entity, purpose}; }
 	template<typename T>
 	T getInRange(T lowest, T highest)
 	{
+		// Drawing advances shared state, read steps use getStream instead.
+		threads::assertNotInReadPhase();
 		assert(lowest <= highest);
 		//TODO: should uniform distribution be static?
 		if constexpr(std::is_integral_v<T>)
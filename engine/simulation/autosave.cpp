@@ -0,0 +1,141 @@
+#include "autosave.h"
+#include "simulation.h"
+#include "hasAreas.h"
+#include "../area/area.h"
+#include "../binaryArchive.h"
+#include "../space/space.h"
+#include "../util.h"
+#include <cassert>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+struct Autosave::AreaSnapshot
+{
+	AreaId id;
+	Json data;
+	Step checkpoint;
+	int fileGeneration = 0;
+	// Zero for a full save, which uses rtrees, otherwise the index of the delta file, which uses changes.
+	int deltaIndex = 0;
+	SpaceRTreeSnapshot rtrees;
+	SpaceRTreeChanges changes;
+};
+Autosave::Autosave() = default;
+Autosave::~Autosave() { wait(); }
+void Autosave::maybeBegin(Simulation& simulation)
+{
+	if(m_frequency.empty())
+		return;
+	if(m_lastStep.empty())
+	{
+		// Count from the first step after autosave was enabled rather then saving immediately.
+		m_lastStep = simulation.m_step;
+		return;
+	}
+	if(simulation.m_step - m_lastStep < m_frequency || isWriting())
+		return;
+	begin(simulation);
+}
+void Autosave::begin(Simulation& simulation)
+{
+	wait();
+	const std::chrono::microseconds start = util::getCurrentTimeInMicroSeconds();
+	// Deltas continue from the last generation written, after a failure there may not be one.
+	const bool previousFailed = !m_lastError.empty();
+	m_path = simulation.getPath();
+	m_simulationData = simulation.toJson();
+	m_simulationData["areaFiles"] = Json::array();
+	m_areas.clear();
+	// Shared by every Area written in full.
+	const int fileGeneration = simulation.getAreas().takeFileGeneration();
+	for(auto& [areaId, area] : simulation.getAreas().getAll())
+	{
+		Space& space = area->getSpace();
+		// Ensure spatial compression prior to serialization.
+		space.prepareRtrees();
+		AreaSnapshot& snapshot = m_areas.emplace_back(areaId, area->toJson(false));
+		if(!previousFailed && space.delta_isTracking() && space.delta_getCount() < Config::autosaveDeltasBetweenFullSaves)
+		{
+			snapshot.changes = space.delta_takeChanges();
+			snapshot.checkpoint = space.delta_getCheckpoint();
+			snapshot.fileGeneration = space.delta_getFileGeneration();
+			snapshot.deltaIndex = space.delta_getCount();
+		}
+		else
+		{
+			// A full save replaces the base file and all deltas, compacting them. Tracking restarts first so the copy does not include old change records.
+			if(Config::autosaveDeltasBetweenFullSaves != 0)
+				space.delta_startTracking(simulation.m_step, fileGeneration);
+			snapshot.rtrees = space.snapshotRTrees();
+			snapshot.checkpoint = simulation.m_step;
+			snapshot.fileGeneration = fileGeneration;
+		}
+		m_simulationData["areaFiles"].push_back(SimulationHasAreas::getAreaFilesEntry(areaId, snapshot.fileGeneration, snapshot.deltaIndex));
+	}
+	m_lastStep = simulation.m_step;
+	m_lastPause = util::getCurrentTimeInMicroSeconds() - start;
+	m_writing.store(true, std::memory_order_relaxed);
+	m_thread = std::thread([this]{ write(); });
+}
+void Autosave::write()
+{
+	const std::chrono::microseconds start = util::getCurrentTimeInMicroSeconds();
+	// An exception escaping a thread would terminate, and a failed autosave should not stop the game.
+	try
+	{
+		m_lastBytesWritten = writeFiles();
+		m_lastError.clear();
+	}
+	catch(const std::exception& error)
+	{
+		m_lastBytesWritten = 0;
+		m_lastError = error.what();
+	}
+	// Release the snapshot now rather then holding it untill the next autosave.
+	m_areas = {};
+	m_simulationData = {};
+	m_lastWriteDuration = util::getCurrentTimeInMicroSeconds() - start;
+	m_writing.store(false, std::memory_order_release);
+}
+std::size_t Autosave::writeFiles()
+{
+	std::size_t output = 0;
+	const std::filesystem::path directory = m_path/"area";
+	std::filesystem::create_directories(directory);
+	for(const AreaSnapshot& area : m_areas)
+	{
+		const std::filesystem::path basePath = SimulationHasAreas::getAreaPath(directory, area.id, area.fileGeneration);
+		const bool isDelta = area.deltaIndex != 0;
+		const std::filesystem::path path = isDelta ? SimulationHasAreas::getAreaDeltaPath(basePath, area.deltaIndex) : basePath;
+		std::filesystem::path temporary = path;
+		temporary += ".tmp";
+		BinaryArchiveWriter writer(temporary, isDelta ? binaryArchive::areaDeltaMagic : binaryArchive::areaMagic);
+		writer.write(area.checkpoint.get());
+		writer.writeJson(area.data);
+		if(isDelta)
+			area.changes.writeBinary(writer);
+		else
+			area.rtrees.writeBinary(writer);
+		output += writer.close();
+		std::filesystem::rename(temporary, path);
+	}
+	const std::string text = m_simulationData.dump();
+	const std::filesystem::path temporary = m_path/"simulation.json.tmp";
+	{
+		std::ofstream file(temporary);
+		file << text;
+		file.close();
+		if(!file)
+			throw std::runtime_error("failed to write " + temporary.string());
+	}
+	// The commit point, everything before this only wrote files which nothing refers to yet.
+	std::filesystem::rename(temporary, m_path/"simulation.json");
+	output += text.size();
+	SimulationHasAreas::removeUnreferencedAreaFiles(directory, m_simulationData["areaFiles"]);
+	return output;
+}
+void Autosave::wait()
+{
+	if(m_thread.joinable())
+		m_thread.join();
+}
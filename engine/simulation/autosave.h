@@ -0,0 +1,62 @@
+/*
+	Writes the same files as Simulation::save from a background thread while stepping continues.
+	begin runs on the stepping thread between steps. It compresses R-trees, converts each Area to json without the R-trees stored as raw blocks, and copies those R-trees instead. Copying node arrays is much cheaper then encoding them, getLastPause reports how long this took.
+	Once an Area has been written in full its R-tree changes are tracked, and following autosaves write only the changed regions to a delta file, see Space::delta_takeChanges. Every Config::autosaveDeltasBetweenFullSaves deltas the base file is written in full again, which compacts them.
+	The background thread encodes the snapshot and writes each file to a temporary path which is renamed when complete. Area files are named by save generation, so they never replace the files the current simulation.json refers to.
+	simulation.json is written last and lists the files to load for each Area, renaming it over the previous one switches to the new generation at once. Files no longer referred to are removed after.
+	If anything fails the generation is abandoned and the previous one stays current. The error is recorded for getLastError and the next autosave writes every Area in full, because the changes taken for the failed deltas are gone.
+*/
+#pragma once
+#include "../json.h"
+#include "../numericTypes/types.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Simulation;
+
+class Autosave final
+{
+	struct AreaSnapshot;
+	std::thread m_thread;
+	std::filesystem::path m_path;
+	Json m_simulationData;
+	std::vector<AreaSnapshot> m_areas;
+	Step m_frequency = Step::null();
+	Step m_lastStep = Step::null();
+	std::chrono::microseconds m_lastPause = std::chrono::microseconds(0);
+	// Written by the background thread, published by m_writing.
+	std::chrono::microseconds m_lastWriteDuration = std::chrono::microseconds(0);
+	std::size_t m_lastBytesWritten = 0;
+	// Empty if the most recent autosave succeeded.
+	std::string m_lastError;
+	std::atomic<bool> m_writing = false;
+	void write();
+	// Returns the number of bytes written. Throws on failure.
+	[[nodiscard]] std::size_t writeFiles();
+public:
+	Autosave();
+	Autosave(const Autosave&) = delete;
+	~Autosave();
+	// Null, the default, disables maybeBegin.
+	void setFrequency(const Step frequency) { m_frequency = frequency; }
+	// Called by Simulation::doStep between steps. Skipped rather then waiting if the previous autosave is still writing.
+	void maybeBegin(Simulation& simulation);
+	// Waits for any previous autosave to finish writing first.
+	void begin(Simulation& simulation);
+	void wait();
+	[[nodiscard]] bool isWriting() const { return m_writing.load(std::memory_order_acquire); }
+	[[nodiscard]] Step getFrequency() const { return m_frequency; }
+	[[nodiscard]] Step getLastStep() const { return m_lastStep; }
+	// How long stepping was stopped for the most recent autosave.
+	[[nodiscard]] std::chrono::microseconds getLastPause() const { return m_lastPause; }
+	// Only valid while isWriting is false.
+	[[nodiscard]] std::chrono::microseconds getLastWriteDuration() const { assert(!isWriting()); return m_lastWriteDuration; }
+	[[nodiscard]] std::size_t getLastBytesWritten() const { assert(!isWriting()); return m_lastBytesWritten; }
+	[[nodiscard]] const std::string& getLastError() const { assert(!isWriting()); return m_lastError; }
+};
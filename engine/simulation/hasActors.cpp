@@ -3,23 +3,25 @@
 #include "deserializationMemo.h"
 void SimulationHasActors::registerActor(const ActorId id, Actors& store, const ActorIndex index)
 {
-	assert(!m_actors.contains(id));
-	m_actors.try_emplace(id, &store, index);
+	m_actors.record(id, {&store, index});
 }
 void SimulationHasActors::removeActor(const ActorId id)
 {
-	assert(m_actors.contains(id));
-	m_actors.erase(id);
+	m_actors.remove(id);
 }
 const ActorIndex SimulationHasActors::getIndexForId(const ActorId id) const
 {
-	return m_actors.at(id).index;
+	return m_actors.get(id).index;
 }
 Area& SimulationHasActors::getAreaForId(const ActorId id) const
 {
-	return m_actors.at(id).store->getArea();
+	return m_actors.get(id).store->getArea();
+}
+bool SimulationHasActors::contains(const ActorId id) const
+{
+	return m_actors.contains(id);
 }
 const ActorDataLocation& SimulationHasActors::getDataLocation(const ActorId id) const
 {
-	return m_actors.at(id);
+	return m_actors.get(id);
 }
@@ -2,6 +2,7 @@
 
 #include "../numericTypes/types.h"
 #include "../config/config.h"
+#include "../dataStructures/idRegistry.h"
 
 struct DeserializationMemo;
 class Actors;
@@ -9,21 +10,23 @@ class Area;
 
 struct ActorDataLocation
 {
-	Actors* store;
+	Actors* store = nullptr;
 	ActorIndex index;
 };
 
 class SimulationHasActors final
 {
-	ActorId m_nextId = ActorId::create(0);
-	// TODO: Use boost unordered_map.
-	std::unordered_map<ActorId, ActorDataLocation, ActorId::Hash> m_actors;
+	IdRegistry<ActorId, ActorDataLocation> m_actors;
 public:
-	[[nodiscard]] ActorId getNextId() { return ++m_nextId; }
+	// Each Area allocates from it's own block, see IdRegistry.
+	[[nodiscard]] ActorId getNextId(IdBlock& block) { return m_actors.allocate(block); }
+	void topUpIds(IdBlock& block) { m_actors.topUp(block); }
 	void registerActor(const ActorId id, Actors& store, const ActorIndex index);
 	void removeActor(const ActorId id);
 	[[nodiscard]] const ActorIndex getIndexForId(const ActorId id) const;
 	[[nodiscard]] Area& getAreaForId(const ActorId id) const;
 	[[nodiscard]] const ActorDataLocation& getDataLocation(const ActorId id) const;
-	NLOHMANN_DEFINE_TYPE_INTRUSIVE(SimulationHasActors, m_nextId);
+	[[nodiscard]] bool contains(const ActorId id) const;
+	friend void to_json(Json& data, const SimulationHasActors& hasActors) { data = {{"m_nextId", hasActors.m_actors.getLastReserved()}}; }
+	friend void from_json(const Json& data, SimulationHasActors& hasActors) { hasActors.m_actors.setLastReserved(data["m_nextId"].get<int>()); }
 };
@@ -8,8 +8,15 @@
 #include "../space/space.h"
 #include "../items/items.h"
 #include "../plants.h"
+#include "../threads.h"
+#include "../binaryArchive.h"
 #include "numericTypes/types.h"
+#include <algorithm>
 #include <fstream>
+#include <omp.h>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 SimulationHasAreas::SimulationHasAreas(const Json& data, DeserializationMemo&, Simulation& simulation) : m_simulation(simulation)
 {
@@ -17,15 +24,68 @@ SimulationHasAreas::SimulationHasAreas(const Json& data, DeserializationMemo&, S
 }
 void SimulationHasAreas::doStep()
 {
+	// In Area order, so the ids each Area allocates are the same whether or not Areas are stepped concurrently.
 	for(auto& pair : m_areas)
-		pair.second->doStep();
+	{
+		m_simulation.m_actors.topUpIds(pair.second->m_actorIds);
+		m_simulation.m_items.topUpIds(pair.second->m_itemIds);
+	}
+	if(Config::stepAreasConcurrently && m_areas.size() > 1)
+		doStepConcurrently();
+	else
+		for(auto& pair : m_areas)
+			pair.second->doStep();
+}
+void SimulationHasAreas::doStepConcurrently()
+{
+	m_areasForStep.clear();
+	for(auto& pair : m_areas)
+		m_areasForStep.push_back(pair.second.get());
+	m_steppingConcurrently = true;
+	// Areas form the outer team and each Area's parallel phases form a nested team. Threads are split evenly so the combined team never exceeds threads::max and threads::getIndex stays unique.
+	// The trade off is that a thread whose Areas are done idles rather then joining the phases of an Area which is still stepping.
+	const int areaThreads = std::min((int)m_areasForStep.size(), std::max(1, threads::max));
+	const int phaseThreads = std::max(1, threads::max / areaThreads);
+	const int previousActiveLevels = omp_get_max_active_levels();
+	omp_set_max_active_levels(2);
+	#pragma omp parallel num_threads(areaThreads)
+	{
+		omp_set_num_threads(phaseThreads);
+		// Step times vary widely between Areas so hand them out one at a time.
+		#pragma omp for schedule(dynamic, 1)
+		for(int i = 0; i < (int)m_areasForStep.size(); ++i)
+		{
+			threads::ConcurrentAreaStepGuard guard;
+			m_areasForStep[i]->doStep();
+		}
+	}
+	omp_set_max_active_levels(previousActiveLevels);
+	m_steppingConcurrently = false;
+	for(Area* area : m_areasForStep)
+		area->applyDeferredSimulationWrites();
 }
 void SimulationHasAreas::incrementHour()
 {
 	for(auto& pair : m_areas)
 		pair.second->updateClimate();
 }
-void SimulationHasAreas::save()
+Json SimulationHasAreas::save()
+{
+	Json output = Json::array();
+	const int fileGeneration = takeFileGeneration();
+	for(auto& [areaId, area] : m_areas)
+	{
+		const std::filesystem::path path = getAreaPath(m_simulation.m_path/"area", areaId, fileGeneration);
+		const std::size_t size = saveAreaBinary(*area, path);
+		Space& space = area->getSpace();
+		if(space.delta_isTracking())
+			space.delta_startTracking(m_simulation.m_step, fileGeneration);
+		output.push_back(getAreaFilesEntry(areaId, fileGeneration, 0));
+		std::cout << "Wrote " << size << " bytes to " << path << std::endl;
+	}
+	return output;
+}
+void SimulationHasAreas::exportJson()
 {
 	for(auto& [areaId, area] : m_areas)
 	{
@@ -43,6 +103,57 @@ void SimulationHasAreas::save()
 		std::cout << "Wrote " << text.size() << " bytes to " << m_simulation.m_path/"area"/(std::to_string(areaId.get()) + ".json") << std::endl;
 	}
 }
+std::size_t SimulationHasAreas::saveAreaBinary(Area& area, const std::filesystem::path& path)
+{
+	Space& space = area.getSpace();
+	// Ensure spatial compression prior to serialization.
+	space.prepareRtrees();
+	const Step checkpoint = m_simulation.m_step;
+	std::filesystem::path temporary = path;
+	temporary += ".tmp";
+	BinaryArchiveWriter writer(temporary, binaryArchive::areaMagic);
+	writer.write(checkpoint.get());
+	writer.writeJson(area.toJson(false));
+	space.writeBinary(writer);
+	const std::size_t output = writer.close();
+	std::filesystem::rename(temporary, path);
+	return output;
+}
+std::filesystem::path SimulationHasAreas::getAreaDeltaPath(const std::filesystem::path& basePath, const int index)
+{
+	return basePath.parent_path()/(basePath.stem().string() + "." + std::to_string(index) + ".delta");
+}
+std::filesystem::path SimulationHasAreas::getAreaPath(const std::filesystem::path& directory, const AreaId id, const int fileGeneration)
+{
+	return directory/(std::to_string(id.get()) + "." + std::to_string(fileGeneration) + ".area");
+}
+Json SimulationHasAreas::getAreaFilesEntry(const AreaId id, const int fileGeneration, const int deltaCount)
+{
+	return {{"id", id}, {"generation", fileGeneration}, {"deltas", deltaCount}};
+}
+void SimulationHasAreas::removeUnreferencedAreaFiles(const std::filesystem::path& directory, const Json& areaFiles)
+{
+	std::unordered_set<std::string> referenced;
+	for(const Json& entry : areaFiles)
+	{
+		const std::filesystem::path basePath = getAreaPath(directory, entry["id"].get<AreaId>(), entry["generation"].get<int>());
+		referenced.insert(basePath.filename().string());
+		const int deltaCount = entry["deltas"].get<int>();
+		for(int index = 1; index <= deltaCount; ++index)
+			referenced.insert(getAreaDeltaPath(basePath, index).filename().string());
+	}
+	std::error_code error;
+	std::vector<std::filesystem::path> toRemove;
+	for(std::filesystem::directory_iterator iter(directory, error), end; !error && iter != end; iter.increment(error))
+	{
+		const std::filesystem::path& path = iter->path();
+		const std::filesystem::path extension = path.extension();
+		if((extension == ".area" || extension == ".delta" || extension == ".tmp") && !referenced.contains(path.filename().string()))
+			toRemove.push_back(path);
+	}
+	for(const std::filesystem::path& path : toRemove)
+		std::filesystem::remove(path, error);
+}
 Area& SimulationHasAreas::createArea(const Distance x, const Distance y, const Distance z, bool createDrama)
 {
 	AreaId id = ++m_nextId;
@@ -77,10 +188,55 @@ Area& SimulationHasAreas::loadAreaFromJson(const Json& data, DeserializationMemo
 }
 Area& SimulationHasAreas::loadAreaFromPath(const AreaId id, DeserializationMemo& deserializationMemo)
 {
-	std::ifstream af(m_simulation.m_path/"area"/(std::to_string(id.get()) + ".json"));
+	const std::filesystem::path path = m_simulation.m_path/"area"/std::to_string(id.get());
+	if(std::filesystem::exists(path.string() + ".area"))
+		return loadAreaFromBinary(path.string() + ".area", deserializationMemo);
+	std::ifstream af(path.string() + ".json");
 	Json areaData = Json::parse(af);
 	return loadAreaFromJson(areaData, deserializationMemo);
 }
+Area& SimulationHasAreas::loadAreaFromBinary(const std::filesystem::path& path, DeserializationMemo& deserializationMemo, const int deltaCount)
+{
+	BinaryArchiveReader reader(path, binaryArchive::areaMagic);
+	const StepWidth checkpoint = reader.read<StepWidth>();
+	std::vector<std::unique_ptr<BinaryArchiveReader>> deltas;
+	for(int index = 1; index <= deltaCount; ++index)
+	{
+		const std::filesystem::path deltaPath = getAreaDeltaPath(path, index);
+		auto delta = std::make_unique<BinaryArchiveReader>(deltaPath, binaryArchive::areaDeltaMagic);
+		if(delta->read<StepWidth>() != checkpoint)
+			throw BinaryArchiveError(deltaPath, "checkpoint does not match the base file");
+		deltas.push_back(std::move(delta));
+	}
+	// Each file holds a complete copy of the non R-tree data, only the most recent is parsed.
+	Json data;
+	if(deltas.empty())
+		data = reader.readJson();
+	else
+	{
+		reader.skipBlock();
+		for(auto iter = deltas.begin(); iter != deltas.end() - 1; ++iter)
+			(*iter)->skipBlock();
+		data = deltas.back()->readJson();
+	}
+	std::vector<BinaryArchiveReader*> rtreeDeltas;
+	for(const auto& delta : deltas)
+		rtreeDeltas.push_back(delta.get());
+	const AreaId id = AreaId::create(data["id"].get<int>());
+	Area& output = m_areas.insert(id, std::make_unique<Area>(data, deserializationMemo, m_simulation, &reader, rtreeDeltas));
+	if(!reader.atEnd() || !std::ranges::all_of(deltas, [](const auto& delta) { return delta->atEnd(); }))
+		throw BinaryArchiveError(path, "unread data after the area");
+	return output;
+}
+void SimulationHasAreas::loadAreaFiles(const Json& areaFiles, const std::filesystem::path& directory, DeserializationMemo& deserializationMemo)
+{
+	for(const Json& entry : areaFiles)
+	{
+		const int fileGeneration = entry["generation"].get<int>();
+		loadAreaFromBinary(getAreaPath(directory, entry["id"].get<AreaId>(), fileGeneration), deserializationMemo, entry["deltas"].get<int>());
+		m_nextFileGeneration = std::max(m_nextFileGeneration, fileGeneration + 1);
+	}
+}
 void SimulationHasAreas::clearAll()
 {
 	for(auto& pair : m_areas)
@@ -99,6 +255,10 @@ Step SimulationHasAreas::getNextEventStep() const
 		Step step = pair.second->m_eventSchedule.getNextEventStep();
 		if(output.empty() || step < output)
 			output = step;
+		// Moves are not scheduled events but fasterForward must not skip over them.
+		const Step moveStep = pair.second->getActors().move_getNextMoveStep();
+		if(moveStep.exists() && (output.empty() || moveStep < output))
+			output = moveStep;
 	}
 	return output;
 }
@@ -113,6 +273,12 @@ Step SimulationHasAreas::getNextStepToSimulate() const
 		Step step = area.m_eventSchedule.getNextEventStep();
 		if(output.empty() || step < output)
 			output = step;
+		const Step plantStep = area.getPlants().getNextCohortStep();
+		if(plantStep.exists() && (output.empty() || plantStep < output))
+			output = plantStep;
+		const Step moveStep = area.getActors().move_getNextMoveStep();
+		if(moveStep.exists() && (output.empty() || moveStep < output))
+			output = moveStep;
 	}
 	return output;
 }
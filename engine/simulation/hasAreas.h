@@ -4,7 +4,9 @@
 #include "../numericTypes/types.h"
 #include "../config/config.h"
 
+#include <filesystem>
 #include <string>
+#include <vector>
 
 class Simulation;
 struct DeserializationMemo;
@@ -13,8 +15,14 @@ class SimulationHasAreas final
 {
 	Simulation& m_simulation;
 	AreaId m_nextId = AreaId::create(0);
+	// Not serialized, loadAreaFiles continues from the generations in use.
+	int m_nextFileGeneration = 1;
 	SmallMap<AreaId, Area*> m_areasById;
 	SmallMapStable<AreaId, Area> m_areas;
+	// Stored here rather then per step so the buffer is reused.
+	std::vector<Area*> m_areasForStep;
+	bool m_steppingConcurrently = false;
+	void doStepConcurrently();
 public:
 	SimulationHasAreas(Simulation& simulation) : m_simulation(simulation) { }
 	SimulationHasAreas(const Json& data, DeserializationMemo& deserializationMemo, Simulation& simulation);
@@ -22,18 +30,41 @@ public:
 	Area& createArea(int x, int y, int z, bool createDrama = false);
 	Area& loadArea(const AreaId id, std::string name, const Distance x, const Distance y, const Distance z);
 	Area& loadAreaFromJson(const Json& data, DeserializationMemo& deserializationMemo);
+	// For saves without areaFiles in simulation.json: loads <id>.area if it exists, otherwise the json export.
 	Area& loadAreaFromPath(const AreaId id, DeserializationMemo& deserializationMemo);
+	// Replays deltaCount delta files written since the base file, as recorded by areaFiles.
+	Area& loadAreaFromBinary(const std::filesystem::path& path, DeserializationMemo& deserializationMemo, const int deltaCount = 0);
+	// Loads each entry of areaFiles, see save.
+	void loadAreaFiles(const Json& areaFiles, const std::filesystem::path& directory, DeserializationMemo& deserializationMemo);
 	void destroyArea(Area& area);
 	void loadAreas(const Json& data, DeserializationMemo& deserializationMemo);
 	void loadAreas(const Json& data, std::filesystem::path path);
+	// When Config::stepAreasConcurrently is set Areas are stepped in parallel and then writes to Simulation which they deferred are applied in Area order.
 	void doStep();
 	void incrementHour();
-	void save();
+	// Writes each Area in the binary format, see binaryArchive.h, and returns the areaFiles entries which the caller stores in simulation.json.
+	// simulation.json names the files to load, so existing files are not replaced until it is. See removeUnreferencedAreaFiles.
+	[[nodiscard]] Json save();
+	// Writes each Area as text json, for debugging.
+	void exportJson();
+	// Returns the number of bytes written. Writes to a temporary file which is renamed when complete.
+	std::size_t saveAreaBinary(Area& area, const std::filesystem::path& path);
+	// Each save which writes base files takes a new generation.
+	[[nodiscard]] int takeFileGeneration() { return m_nextFileGeneration++; }
+	// Base files are named <id>.<generation>.area so writing a new one never replaces the one an existing simulation.json refers to.
+	[[nodiscard]] static std::filesystem::path getAreaPath(const std::filesystem::path& directory, const AreaId id, const int fileGeneration);
+	// Delta files are named <id>.<generation>.<index>.delta, beside their base file, with indices counting from 1 since the last full save.
+	[[nodiscard]] static std::filesystem::path getAreaDeltaPath(const std::filesystem::path& basePath, const int index);
+	[[nodiscard]] static Json getAreaFilesEntry(const AreaId id, const int fileGeneration, const int deltaCount);
+	// Called after simulation.json has been replaced. Removes .area, .delta and temporary files which areaFiles does not refer to, such as older generations or those left by a failed save. Does not throw, a file which can't be removed is tried again next time.
+	static void removeUnreferencedAreaFiles(const std::filesystem::path& directory, const Json& areaFiles);
 	void clearAll();
 	void recordId(Area& area);
+	[[nodiscard]] bool isSteppingConcurrently() const { return m_steppingConcurrently; }
 	[[nodiscard]] Step getNextStepToSimulate() const;
 	[[nodiscard]] Step getNextEventStep() const;
 	[[nodiscard]] Area& getById(const AreaId id) const {return *m_areasById[id]; }
+	[[nodiscard]] bool contains(const AreaId id) const { return m_areasById.contains(id); }
 	[[nodiscard]] Json toJson() const;
 	[[nodiscard]] SmallMapStable<AreaId, Area>& getAll() { return m_areas; }
 };
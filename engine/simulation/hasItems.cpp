@@ -2,19 +2,17 @@
 #include "../items/items.h"
 void SimulationHasItems::registerItem(const ItemId id, Items& store, const ItemIndex index)
 {
-	assert(!m_items.contains(id));
-	m_items.try_emplace(id, &store, index);
+	m_items.record(id, {&store, index});
 }
 void SimulationHasItems::removeItem(const ItemId id)
 {
-	assert(m_items.contains(id));
-	m_items.erase(id);
+	m_items.remove(id);
 }
 ItemIndex SimulationHasItems::getIndexForId(const ItemId id) const
 {
-	return m_items.at(id).index;
+	return m_items.get(id).index;
 }
 Area& SimulationHasItems::getAreaForId(const ItemId id) const
 {
-	return m_items.at(id).store->getArea();
+	return m_items.get(id).store->getArea();
 }
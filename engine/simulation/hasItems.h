@@ -2,7 +2,7 @@
 
 #include "../numericTypes/types.h"
 #include "../config/config.h"
-#include <unordered_map>
+#include "../dataStructures/idRegistry.h"
 
 class Items;
 struct DeserializationMemo;
@@ -10,22 +10,23 @@ class Area;
 
 struct ItemDataLocation
 {
-	Items* store;
+	Items* store = nullptr;
 	ItemIndex index;
 };
 
 class SimulationHasItems final
 {
-	ItemId m_nextId = ItemId::create(0);
-	// TODO: Use boost unordered_map.
-	std::unordered_map<ItemId, ItemDataLocation, ItemId::Hash> m_items;
+	IdRegistry<ItemId, ItemDataLocation> m_items;
 public:
 	SimulationHasItems() = default;
 	SimulationHasItems(const Json& data, DeserializationMemo& deserializationMemo);
 	void registerItem(const ItemId id, Items& store, const ItemIndex index);
 	void removeItem(const ItemId id);
-	[[nodiscard]] ItemId getNextId() { return ++m_nextId; }
+	// Each Area allocates from it's own block, see IdRegistry.
+	[[nodiscard]] ItemId getNextId(IdBlock& block) { return m_items.allocate(block); }
+	void topUpIds(IdBlock& block) { m_items.topUp(block); }
 	[[nodiscard]] ItemIndex getIndexForId(const ItemId id) const;
 	[[nodiscard]] Area& getAreaForId(const ItemId id) const;
-	NLOHMANN_DEFINE_TYPE_INTRUSIVE(SimulationHasItems, m_nextId);
+	friend void to_json(Json& data, const SimulationHasItems& hasItems) { data = {{"m_nextId", hasItems.m_items.getLastReserved()}}; }
+	friend void from_json(const Json& data, SimulationHasItems& hasItems) { hasItems.m_items.setLastReserved(data["m_nextId"].get<int>()); }
 };
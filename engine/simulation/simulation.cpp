@@ -12,6 +12,7 @@
 #include "simulation/hasActors.h"
 #include "simulation/hasAreas.h"
 #include "simulation/hasItems.h"
+#include "simulation/snapshot.h"
 #include "threadedTask.h"
 #include "numericTypes/types.h"
 #include "util.h"
@@ -38,8 +39,11 @@ Simulation::Simulation(std::filesystem::path path) : Simulation(Json::parse(std:
 {
 	m_path = path;
 	const Json& data = Json::parse(std::ifstream{m_path/"simulation.json"});
-	for(const Json& areaId : data["hasAreas"]["areaIds"])
-		m_hasAreas->loadAreaFromPath(areaId, m_deserializationMemo);
+	if(data.contains("areaFiles"))
+		m_hasAreas->loadAreaFiles(data["areaFiles"], m_path/"area", m_deserializationMemo);
+	else
+		for(const Json& areaId : data["hasAreas"]["areaIds"])
+			m_hasAreas->loadAreaFromPath(areaId, m_deserializationMemo);
 	//TODO: DramaEngine should probably be able to load before hasAreas.
 	m_dramaEngine = std::make_unique<DramaEngine>(data["drama"], m_deserializationMemo, *this);
 }
@@ -52,6 +56,8 @@ Simulation::Simulation(const Json& data) :
 	data["step"].get_to(m_step);
 	//if(data["world"])
 	//m_world = std::make_unique<World>(data["world"], deserializationMemo);
+	data["hasActors"].get_to(m_actors);
+	data["hasItems"].get_to(m_items);
 	data["uniforms"].get_to(m_hasUniforms);
 	data["factions"].get_to(m_hasFactions);
 	data["constructedItemTypes"].get_to(m_constructedItemTypes);
@@ -63,23 +69,35 @@ Simulation::Simulation(const Json& data) :
 void Simulation::doStep(int count)
 {
 	assert(count);
-	bool locked = false;
 	for(int i = 0; i < count; ++i)
 	{
-		// Aquire UI read mutex on first iteration,
-		if(!locked)
-		{
-			m_uiReadMutex.lock();
-			locked = true;
-		}
+		// Released between steps so readers are not blocked for the whole batch.
+		std::lock_guard lock(m_uiReadMutex);
+		m_stepProfiler.beginStep(m_step);
+		m_stepProfiler.beginPhase();
+		const int threadedTaskCount = m_threadedTaskEngine.count();
 		m_threadedTaskEngine.doStep(*this, nullptr);
+		m_stepProfiler.endPhase(StepPhase::SimulationThreadedTasks, threadedTaskCount);
+		m_stepProfiler.beginPhase();
 		m_hasAreas->doStep();
+		m_stepProfiler.endPhase(StepPhase::Areas, m_hasAreas->getAll().size());
+		m_stepProfiler.beginPhase();
+		const int eventCount = m_eventSchedule.countForStep(m_step);
 		m_eventSchedule.doStep(m_step);
+		m_stepProfiler.endPhase(StepPhase::SimulationEvents, eventCount);
+		m_stepProfiler.endStep();
 		// Apply user input.
-		//m_inputQueue.flush();
+		m_inputQueue.flush(*this);
+		m_publishedStep.store(m_step, std::memory_order_release);
+		if(m_snapshotFrequency.exists())
+		{
+			const std::shared_ptr<const SimulationSnapshot> previous = getSnapshot();
+			if(previous == nullptr || m_step - previous->step >= m_snapshotFrequency)
+				m_snapshot.store(std::make_shared<const SimulationSnapshot>(SimulationSnapshot::create(*this)), std::memory_order_release);
+		}
 		++m_step;
+		m_autosave.maybeBegin(*this);
 	}
-	m_uiReadMutex.unlock();
 }
 void Simulation::incrementHour()
 {
@@ -88,11 +106,28 @@ void Simulation::incrementHour()
 }
 void Simulation::save()
 {
+	m_autosave.wait();
+	std::filesystem::create_directories(m_path/"area");
+	Json data = toJson();
+	data["areaFiles"] = m_hasAreas->save();
+	// Replacing simulation.json switches to the new area files, the old ones are removed after.
+	{
+		std::ofstream f(m_path/"simulation.json.tmp");
+		f << data;
+		f.close();
+		assert(f);
+	}
+	std::filesystem::rename(m_path/"simulation.json.tmp", m_path/"simulation.json");
+	SimulationHasAreas::removeUnreferencedAreaFiles(m_path/"area", data["areaFiles"]);
+}
+void Simulation::exportJson()
+{
+	m_autosave.wait();
 	std::filesystem::create_directories(m_path);
 	std::ofstream f(m_path/"simulation.json");
 	f << toJson();
 	std::filesystem::create_directories(m_path/"area");
-	m_hasAreas->save();
+	m_hasAreas->exportJson();
 }
 FactionId Simulation::createFaction(std::string name) { return m_hasFactions.createFaction(name); }
 DateTime Simulation::getDateTime() const { return DateTime(m_step); }
@@ -138,7 +173,7 @@ Simulation::~Simulation()
 void Simulation::fasterForward(Step steps)
 {
 	Step targetStep = m_step + steps;
-	while(!m_eventSchedule.m_data.empty())
+	while(!m_eventSchedule.empty())
 	{
 		Step nextStep = getNextEventStep();
 		if(nextStep <= targetStep)
@@ -154,7 +189,7 @@ void Simulation::fasterForward(Step steps)
 void Simulation::fastForward(Step steps)
 {
 	Step targetStep = m_step + steps;
-	while(!m_eventSchedule.m_data.empty())
+	while(!m_eventSchedule.empty())
 	{
 		Step nextStep = getNextStepToSimulate();
 		if(nextStep <= targetStep)
@@ -234,7 +269,7 @@ void Simulation::fastForwardUntillPredicate(std::function<bool()>& predicate, in
 {
 	assert(!predicate());
 	[[maybe_unused]] Step lastStep = m_step + (Config::stepsPerMinute * minutes);
-	while(!m_eventSchedule.m_data.empty())
+	while(!m_eventSchedule.empty())
 	{
 		if(m_threadedTaskEngine.count() == 0)
 			m_step = getNextStepToSimulate();
@@ -248,7 +283,7 @@ void Simulation::fasterForwardUntillPredicate(std::function<bool()>& predicate,
 {
 	assert(!predicate());
 	[[maybe_unused]] Step lastStep = m_step + (Config::stepsPerMinute * minutes);
-	while(!m_eventSchedule.m_data.empty())
+	while(!m_eventSchedule.empty())
 	{
 		m_step = getNextEventStep();
 		assert(m_step <= lastStep);
@@ -267,8 +302,7 @@ void Simulation::fasterForwardUntillPredicate(std::function<bool()>&& predicate,
 }
 void Simulation::fastForwardUntillNextEvent()
 {
-	auto& pair = *m_eventSchedule.m_data.begin();
-	fastForward(pair.first - m_step);
+	fastForward(m_eventSchedule.getNextEventStep() - m_step);
 }
 Json Simulation::toJson() const
 {
@@ -6,17 +6,20 @@
 #include "../dialogueBox.h"
 #include "../eventSchedule.hpp"
 #include "../faction.h"
-//#include "input.h"
+#include "../input.h"
 #include "../random.h"
+#include "../stepProfiler.h"
 #include "../threadedTask.h"
 #include "../uniform.h"
 #include "../definitions/shape.h"
 #include "../numericTypes/types.h"
+#include "autosave.h"
 #include "hasActors.h"
 #include "hasItems.h"
 #include "hasConstructedItemTypes.h"
 #include "hasSquads.h"
 
+#include <atomic>
 #include <future>
 #include <list>
 #include <memory>
@@ -26,6 +29,7 @@
 class HourlyEvent;
 class DramaEngine;
 class SimulationHasAreas;
+struct SimulationSnapshot;
 
 class Simulation final
 {
@@ -34,7 +38,10 @@ public:
 	ThreadedTaskEngine m_threadedTaskEngine;
 	HasScheduledEvent<HourlyEvent> m_hourlyEvent;
 	Random m_random;
-	//InputQueue m_inputQueue;
+	// Disabled by default, each Area has it's own for area phases.
+	StepProfiler m_stepProfiler{{&m_eventSchedule.getPool(), &m_threadedTaskEngine.getPool()}};
+	// Commands from the UI and scripting threads, flushed after each step.
+	InputQueue m_inputQueue;
 	SimulationHasUniforms m_hasUniforms;
 	SimulationHasFactions m_hasFactions;
 	SimulationHasActors m_actors;
@@ -55,7 +62,16 @@ public:
 	std::unique_ptr<SimulationHasAreas> m_hasAreas;
 	// Drama engine must be created after hasAreas.
 	std::unique_ptr<DramaEngine> m_dramaEngine;
+	// Held by doStep for one step at a time, readers which need a consistent view of the world lock it between steps.
 	std::mutex m_uiReadMutex;
+	// The last step which has finished, including flushing m_inputQueue. May be read from any thread without locking m_uiReadMutex.
+	std::atomic<Step> m_publishedStep;
+	// Null, the default, disables publishing snapshots.
+	Step m_snapshotFrequency = Step::null();
+	// Replaced by doStep every m_snapshotFrequency steps, after m_publishedStep.
+	std::atomic<std::shared_ptr<const SimulationSnapshot>> m_snapshot;
+	// Disabled by default, see Autosave::setFrequency.
+	Autosave m_autosave;
 	// Default dateTime provided for testing: mid day, so not too cold, 1000 years, so even the oldest living things are born at a positive numbered step.
 	Simulation(const std::string& name = "", const DateTime& dateTime = DateTime(12, 160, 1000));
 	Simulation(const std::string& name, const Step step);
@@ -63,8 +79,15 @@ public:
 	Simulation(const Json& data);
 	Json toJson() const;
 	void doStep(int count = 1);
+	// Stepping thread only.
+	void setSnapshotFrequency(const Step frequency) { m_snapshotFrequency = frequency; }
+	// May be called from any thread. Null untill the first snapshot is published.
+	[[nodiscard]] std::shared_ptr<const SimulationSnapshot> getSnapshot() const { return m_snapshot.load(std::memory_order_acquire); }
 	void incrementHour();
+	// Areas are written in the binary format, simulation.json remains text. Waits for an autosave which is still writing.
 	void save();
+	// Writes everything as text json, for debugging. Loading prefers binary area files when both exist.
+	void exportJson();
 	FactionId createFaction(std::string name);
 	//TODO: latitude, longitude, altitude.
 	[[nodiscard]] std::filesystem::path getPath() const { return m_path; }
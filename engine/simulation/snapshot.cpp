@@ -0,0 +1,26 @@
+#include "snapshot.h"
+#include "simulation.h"
+#include "hasAreas.h"
+#include "../area/area.h"
+#include <algorithm>
+#include <cassert>
+SimulationSnapshot SimulationSnapshot::create(Simulation& simulation)
+{
+	SimulationSnapshot output;
+	output.step = simulation.m_step;
+	output.data = simulation.toJson();
+	for(auto& [areaId, area] : simulation.getAreas().getAll())
+	{
+		Space& space = area->getSpace();
+		// Same as Autosave::begin, copy the R-trees compressed.
+		space.prepareRtrees();
+		output.areas.emplace_back(areaId, area->toJson(false), space.snapshotRTrees());
+	}
+	return output;
+}
+const AreaSnapshot& SimulationSnapshot::getArea(const AreaId id) const
+{
+	auto found = std::ranges::find(areas, id, &AreaSnapshot::id);
+	assert(found != areas.end());
+	return *found;
+}
@@ -0,0 +1,29 @@
+/*
+	A read only copy of the world, published by Simulation::doStep between steps so UI and scripting threads can read a consistent view without locking m_uiReadMutex.
+	Each Area is copied the way Autosave copies it: Area::toJson without the space R-trees, which are copied as raw node arrays and can be queried directly.
+	A snapshot never changes once published. Readers keep the one they loaded for as long as they hold the shared_ptr, even after a newer one replaces it.
+	Copying pauses stepping for about as long as Autosave::getLastPause, so publishing is disabled by default, see Simulation::setSnapshotFrequency.
+*/
+#pragma once
+#include "../json.h"
+#include "../numericTypes/types.h"
+#include "../space/space.h"
+#include <vector>
+
+class Simulation;
+
+struct AreaSnapshot
+{
+	AreaId id;
+	Json data;
+	SpaceRTreeSnapshot space;
+};
+struct SimulationSnapshot
+{
+	Step step;
+	Json data;
+	std::vector<AreaSnapshot> areas;
+	// Called on the stepping thread between steps.
+	[[nodiscard]] static SimulationSnapshot create(Simulation& simulation);
+	[[nodiscard]] const AreaSnapshot& getArea(const AreaId id) const;
+};
@@ -13,7 +13,13 @@ public:
 	void unset(Area& area, const Point3D point);
 	void maybeUnsetBeneathTopLayer(Area& area, const Cuboid cuboid);
 	void prepare() { m_data.prepare(); }
+	void prepareIncremental() { m_data.prepareIncremental(); }
 	void beforeJsonLoad() { m_data.beforeJsonLoad(); }
+	void writeBinary(BinaryArchiveWriter& writer) const { m_data.writeBinary(writer); }
+	void loadBinary(BinaryArchiveReader& reader) { m_data.loadBinary(reader); }
+	void setTrackChanges(const bool track) { m_data.setTrackChanges(track); }
+	[[nodiscard]] RTreeBoolean::Changes takeChanges() { return m_data.takeChanges(); }
+	void applyChanges(BinaryArchiveReader& reader) { m_data.applyChanges(reader); }
 	[[nodiscard]] bool check(const CuboidSet& cuboids) const;
 	[[nodiscard]] bool check(const Cuboid cuboid) const;
 	GDB_CALLABLE bool check(const Point3D point) const;
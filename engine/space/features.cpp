@@ -26,6 +26,7 @@ void Space::pointFeature_remove(const Point3D point, PointFeatureTypeId pointFea
 	const bool transmitedTemperaturePreviously = temperature_transmits(point);
 	const auto condition = [&](const PointFeature& feature){ return feature.pointFeatureType == pointFeatureType; };
 	m_features.maybeRemoveWithConditionOne(point, condition);
+	m_support.onRemove(*this, {point, point});
 	m_area.m_opacityFacade.update(m_area, point);
 	m_area.m_visionRequests.maybeGenerateRequestsForAllWithLineOfSightTo(Cuboid::create(point, point));
 	m_area.m_hasPaths.update(m_area, getAdjacentWithEdgeAndCornerAdjacent(point));
@@ -38,6 +39,7 @@ void Space::pointFeature_removeAll(const Point3D point)
 	assert(!solid_isAny(point));
 	const bool transmitedTemperaturePreviously = temperature_transmits(point);
 	m_features.maybeRemove(point);
+	m_support.onRemove(*this, {point, point});
 	m_area.m_opacityFacade.update(m_area, point);
 	m_area.m_visionRequests.maybeGenerateRequestsForAllWithLineOfSightTo(Cuboid::create(point, point));
 	m_area.m_hasPaths.update(m_area, getAdjacentWithEdgeAndCornerAdjacent(point));
@@ -57,6 +59,8 @@ void Space::pointFeature_add(Cuboid cuboid, PointFeature feature)
 	plant_erase(cuboid);
 	m_area.m_visionRequests.maybeGenerateRequestsForAllWithLineOfSightTo(cuboid);
 	m_features.insert(cuboid, feature);
+	if(PointFeatureType::byId(feature.pointFeatureType).isSupportAgainstCaveIn)
+		m_support.onAdd(*this, cuboid);
 	const bool materialTypeIsTransparent = MaterialType::getTransparent(feature.materialType);
 	if(PointFeatureType::byId(feature.pointFeatureType).opaque && !materialTypeIsTransparent && cuboid.m_high.z() != 0)
 		m_exposedToSky.maybeUnsetBeneathTopLayer(m_area, cuboid);
@@ -88,6 +92,8 @@ void Space::pointFeature_construct(Cuboid cuboid, PointFeatureTypeId pointFeatur
 		if(feature.blocksVerticalTravel())
 			assert(!m_features.queryAnyWithCondition(point, [&](const PointFeature existingFeature){ return existingFeature.blocksVerticalTravelEver(); }));
 		m_features.insert(point, feature);
+		if(PointFeatureType::byId(pointFeatureType).isSupportAgainstCaveIn)
+			m_support.onAdd(*this, {point, point});
 		m_area.m_opacityFacade.update(m_area, point);
 		if(PointFeatureType::byId(pointFeatureType).opaque && !materialTypeIsTransparent)
 		{
@@ -108,7 +114,7 @@ void Space::pointFeature_hew(const Point3D point, PointFeatureTypeId pointFeatur
 	if(feature.blocksVerticalTravel())
 		assert(!m_features.queryAnyWithCondition(point, [&](const PointFeature existingFeature){ return existingFeature.blocksVerticalTravelEver(); }));
 	m_features.insert(point, feature);
-	// Solid_setNot will handle calling AreaHasTemperatures::onCuboidCanTransmitTemperature.
+	// Solid_setNot will handle calling AreaHasTemperatures::onCuboidCanTransmitTemperature and Support::onRemove, which anchors the feature if it supports.
 	// TODO: There is no support for hewing hatches or flaps. This is ok because those things can't be hewn. Could be fixed anyway?
 	const Point3D above = point.above();
 	auto actorsCopy = actor_getAll(above);
@@ -128,6 +134,8 @@ MapWithCuboidKeys<PointFeature> Space::pointFeature_getAllWithCuboidsAndRemove(c
 		for(const auto& [subCuboid, pointFeature] : m_features.queryGetAllWithCuboids(cuboid))
 			output.insertOrMerge(subCuboid, pointFeature);
 	m_features.maybeRemove(cuboids);
+	for(const Cuboid cuboid : cuboids)
+		m_support.onRemove(*this, cuboid);
 	return output;
 }
 void Space::pointFeature_lock(const Point3D point, PointFeatureTypeId pointFeatureType)
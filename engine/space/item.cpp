@@ -81,8 +81,8 @@ void Space::item_disperseAll(const Point3D point)
 	for(auto item : copy)
 	{
 		//TODO: split up stacks of generics, prefer space with more empty space.
-		const Point3D newLocation = points[m_area.m_simulation.m_random.getInRange(0u, points.size() - 1u)];
-		const Facing4 facing = (Facing4)(m_area.m_simulation.m_random.getInRange(0, 3));
+		const Point3D newLocation = points[m_area.m_random.getInRange(0u, points.size() - 1u)];
+		const Facing4 facing = (Facing4)(m_area.m_random.getInRange(0, 3));
 		// TODO: use location_tryToSetStatic and find another location on fail.
 		items.location_setStatic(item, newLocation, facing);
 	}
@@ -9,6 +9,7 @@
 #include "../items/items.h"
 #include "../plants.h"
 #include "../portables.h"
+#include "../threads.h"
 
 void Space::solid_set(const Point3D point, const MaterialTypeId materialType, bool constructed)
 {
@@ -22,6 +23,7 @@ void Space::solid_setAll(const CuboidSet& cuboids, const MaterialTypeId material
 }
 void Space::solid_setCuboid(const Cuboid cuboid, const MaterialTypeId materialType, bool constructed)
 {
+	threads::assertNotInReadPhase();
 	assert(!m_items.queryAny(cuboid));
 	// TODO: This assumes previous is all one type.
 	const MaterialTypeId previous = m_solid.queryGetOne(cuboid);
@@ -58,7 +60,7 @@ void Space::solid_setCuboid(const Cuboid cuboid, const MaterialTypeId materialTy
 	// Remove fluids and shift them elsewhere.
 	fluid_onSetSolid(cuboid.toSet());
 	m_exposedToSky.maybeUnsetBeneathTopLayer(m_area, cuboid);
-	m_support.set(cuboid);
+	m_support.onAdd(*this, cuboid);
 	// Vision cuboid.
 	if(!MaterialType::getTransparent(materialType) && wasTransparent)
 		m_area.m_opacityFacade.maybeInsertFull(cuboid);
@@ -72,6 +74,7 @@ void Space::solid_setNotAll(const CuboidSet& cuboidSet)
 }
 void Space::solid_setNotCuboid(const Cuboid cuboid)
 {
+	threads::assertNotInReadPhase();
 	const auto& previous = m_solid.queryGetAll(cuboid);
 	if(previous.empty())
 		return;
@@ -90,7 +93,7 @@ void Space::solid_setNotCuboid(const Cuboid cuboid)
 	m_area.m_visionRequests.maybeGenerateRequestsForAllWithLineOfSightTo(cuboid);
 	const MaterialTypeId materialType = m_solid.queryGetOne(cuboid);
 	m_solid.maybeRemove(cuboid);
-	m_support.unset(cuboid);
+	m_support.onRemove(*this, cuboid);
 	Cuboid inflated = cuboid;
 	inflated.inflate({1});
 	Cuboid spaceBoundry = boundry();
@@ -116,6 +119,8 @@ MapWithCuboidKeys<MaterialTypeId> Space::solid_getAllWithCuboidsAndRemove(const
 		for(const auto& [materialCuboid, materialType] : m_solid.queryGetAllWithCuboids(cuboid))
 			output.insertOrMerge(materialCuboid, materialType);
 	m_solid.maybeRemove(cuboids);
+	for(const Cuboid cuboid : cuboids)
+		m_support.onRemove(*this, cuboid);
 	return output;
 }
 Mass Space::solid_getMass(const Point3D point) const
@@ -10,6 +10,7 @@
 #include "../items/items.h"
 #include "../plants.h"
 #include "../portables.h"
+#include "../binaryArchive.h"
 #include <string>
 
 Space::Space(Area& area, const Distance x, const Distance y, const Distance z) :
@@ -25,16 +26,37 @@ Space::Space(Area& area, const Distance x, const Distance y, const Distance z) :
 {
 	m_exposedToSky.initialize(Cuboid{Point3D(x - 1, y - 1, z - 1), Point3D::create(0,0,0)});
 }
-void Space::load(const Json& data, DeserializationMemo& deserializationMemo)
+void Space::load(const Json& data, DeserializationMemo& deserializationMemo, BinaryArchiveReader* rtrees, const std::vector<BinaryArchiveReader*>& rtreeDeltas)
 {
-	// The constructors for the rtrees insert an empty root node. This is correct for 'normal' initialization but not for deserialization.
-	// Delete these root nodes prior to deserializing.
-	m_solid.beforeJsonLoad();
-	data["solid"].get_to(m_solid);
-	m_features.beforeJsonLoad();
-	data["features"].get_to(m_features);
-	m_exposedToSky.beforeJsonLoad();
-	data["exposedToSky"].get_to(m_exposedToSky);
+	if(rtrees != nullptr)
+	{
+		m_solid.loadBinary(*rtrees);
+		m_features.loadBinary(*rtrees);
+		m_exposedToSky.loadBinary(*rtrees);
+		for(BinaryArchiveReader* delta : rtreeDeltas)
+		{
+			m_solid.applyChanges(*delta);
+			m_features.applyChanges(*delta);
+			m_exposedToSky.applyChanges(*delta);
+		}
+		if(!rtreeDeltas.empty())
+		{
+			m_solid.prepare();
+			m_features.prepare();
+			m_exposedToSky.prepare();
+		}
+	}
+	else
+	{
+		// The constructors for the rtrees insert an empty root node. This is correct for 'normal' initialization but not for deserialization.
+		// Delete these root nodes prior to deserializing.
+		m_solid.beforeJsonLoad();
+		data["solid"].get_to(m_solid);
+		m_features.beforeJsonLoad();
+		data["features"].get_to(m_features);
+		m_exposedToSky.beforeJsonLoad();
+		data["exposedToSky"].get_to(m_exposedToSky);
+	}
 	// serialization of m_fluid is not handled here. Instead it is reconstructed by the deserialization of Area::m_hasFluidGroups.
 	for(const Json& pair : data["reservables"])
 	{
@@ -43,9 +65,43 @@ void Space::load(const Json& data, DeserializationMemo& deserializationMemo)
 		deserializationMemo.m_reservables[pair[1].get<uintptr_t>()] = reservable.get();
 		m_reservables.insert(cuboid, std::move(reservable));
 	}
+	m_support.rebuild(*this);
 	m_area.m_opacityFacade.rebuildAfterLoad(m_area);
 }
-Json Space::toJson() const
+void Space::writeBinary(BinaryArchiveWriter& writer) const
+{
+	m_solid.writeBinary(writer);
+	m_features.writeBinary(writer);
+	m_exposedToSky.writeBinary(writer);
+}
+void SpaceRTreeSnapshot::writeBinary(BinaryArchiveWriter& writer) const
+{
+	solid.writeBinary(writer);
+	features.writeBinary(writer);
+	exposedToSky.writeBinary(writer);
+}
+void SpaceRTreeChanges::writeBinary(BinaryArchiveWriter& writer) const
+{
+	RTreeData<MaterialTypeId>::writeChanges(solid, writer);
+	PointFeatureBase::writeChanges(features, writer);
+	RTreeBoolean::writeChanges(exposedToSky, writer);
+}
+void Space::delta_startTracking(const Step checkpoint, const int fileGeneration)
+{
+	m_deltaCheckpoint = checkpoint;
+	m_deltaCount = 0;
+	m_deltaFileGeneration = fileGeneration;
+	m_solid.setTrackChanges(true);
+	m_features.setTrackChanges(true);
+	m_exposedToSky.setTrackChanges(true);
+}
+SpaceRTreeChanges Space::delta_takeChanges()
+{
+	assert(delta_isTracking());
+	++m_deltaCount;
+	return {m_solid.takeChanges(), m_features.takeChanges(), m_exposedToSky.takeChanges()};
+}
+Json Space::toJson(const bool includeRTrees) const
 {
 	Json output{
 		{"x", m_sizeX},
@@ -53,9 +109,12 @@ Json Space::toJson() const
 		{"z", m_sizeZ},
 		{"reservables", Json::array()},
 	};
-	output["exposedToSky"] = m_exposedToSky;
-	output["solid"] = m_solid;
-	output["features"] = m_features;
+	if(includeRTrees)
+	{
+		output["exposedToSky"] = m_exposedToSky;
+		output["solid"] = m_solid;
+		output["features"] = m_features;
+	}
 	for(const auto& [data, cuboid] : m_reservables.queryGetAllWithCuboids(boundry()))
 		output["reservables"].push_back(std::pair(cuboid, reinterpret_cast<uintptr_t>(data.get())));
 	return output;
@@ -231,64 +290,86 @@ void Space::maybeContentsFalls(Cuboid cuboid)
 	for(const ActorReference actor : actorsCopy)
 		actors.maybeFall(actor.getIndex(actors.m_referenceData));
 }
-void Space::prepareRtrees()
+void Space::prepareRtreesWith(auto&& prepare)
 {
 	#pragma omp parallel
 	#pragma omp single nowait
 	{
 		#pragma omp task
 			for(auto& pair : m_projects)
-				pair.second.prepare();
+				prepare(pair.second);
 		if(m_reservables.canPrepare())
 			#pragma omp task
-				m_reservables.prepare();
+				prepare(m_reservables);
 		if(m_fires.canPrepare())
 			#pragma omp task
-				m_fires.prepare();
+				prepare(m_fires);
 		if(m_solid.canPrepare())
 			#pragma omp task
-				m_solid.prepare();
+				prepare(m_solid);
 		if(m_features.canPrepare())
 			#pragma omp task
-				m_features.prepare();
+				prepare(m_features);
 		if(m_actors.canPrepare())
 			#pragma omp task
-				m_actors.prepare();
+				prepare(m_actors);
 		if(m_items.canPrepare())
 			#pragma omp task
-				m_items.prepare();
+				prepare(m_items);
 		if(m_fluid.canPrepare())
 			#pragma omp task
-				m_fluid.prepare();
+				prepare(m_fluid);
 		if(m_plants.canPrepare())
 			#pragma omp task
-				m_plants.prepare();
+				prepare(m_plants);
 		if(m_dynamicVolume.canPrepare())
 			#pragma omp task
-				m_dynamicVolume.prepare();
+				prepare(m_dynamicVolume);
 		if(m_staticVolume.canPrepare())
 			#pragma omp task
-				m_staticVolume.prepare();
+				prepare(m_staticVolume);
 		if(m_unrevealed.canPrepare())
 			#pragma omp task
-				m_unrevealed.prepare();
+				prepare(m_unrevealed);
 		if(m_constructed.canPrepare())
 			#pragma omp task
-				m_constructed.prepare();
+				prepare(m_constructed);
 		if(m_dynamic.canPrepare())
 			#pragma omp task
-				m_dynamic.prepare();
+				prepare(m_dynamic);
 		if(m_support.canPrepare())
 			#pragma omp task
-				m_support.prepare();
+				prepare(m_support);
 		if(m_exposedToSky.canPrepare())
 			#pragma omp task
-				m_exposedToSky.prepare();
+				prepare(m_exposedToSky);
 		if(m_area.m_spaceDesignations.canPrepare())
 			#pragma omp task
-				m_area.m_spaceDesignations.prepare();
+				prepare(m_area.m_spaceDesignations);
 	}
 }
+void Space::prepareRtrees() { prepareRtreesWith([](auto& rtree) { rtree.prepare(); }); }
+void Space::prepareRtreesIncremental() { prepareRtreesWith([](auto& rtree) { rtree.prepareIncremental(); }); }
+std::vector<std::pair<std::string_view, RTreeMetrics>> Space::getRTreeMetrics() const
+{
+	return {
+		{"reservables", m_reservables.getMetrics()},
+		{"fires", m_fires.getMetrics()},
+		{"solid", m_solid.getMetrics()},
+		{"features", m_features.getMetrics()},
+		{"fluid", m_fluid.getMetrics()},
+		{"actors", m_actors.getMetrics()},
+		{"items", m_items.getMetrics()},
+		{"plants", m_plants.getMetrics()},
+		{"dynamicVolume", m_dynamicVolume.getMetrics()},
+		{"staticVolume", m_staticVolume.getMetrics()},
+		{"unrevealed", m_unrevealed.getMetrics()},
+		{"constructed", m_constructed.getMetrics()},
+		{"dynamic", m_dynamic.getMetrics()},
+		{"support", m_support.getMetrics()},
+		{"exposedToSky", m_exposedToSky.get().getMetrics()},
+	};
+}
 bool Space::canSeeThrough(const Cuboid cuboid) const
 {
 	const MaterialTypeId material = solid_get(cuboid);
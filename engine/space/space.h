@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <memory>
+#include <string_view>
 
 class FluidGroup;
 
@@ -74,6 +75,24 @@ public:
 	[[nodiscard]] bool canOverlap(const PointFeature& a, const PointFeature& b) const;
 };
 using PointHasFires = RTreeDataWrapper<SmallMap<MaterialTypeId, Fire>*, nullptr>;
+// Copies of the R-trees which Space::writeBinary writes, so they can be written from another thread while the originals continue to change.
+struct SpaceRTreeSnapshot
+{
+	RTreeData<MaterialTypeId> solid;
+	PointFeatureRTree features;
+	PointsExposedToSky exposedToSky;
+	// Same order as Space::writeBinary.
+	void writeBinary(BinaryArchiveWriter& writer) const;
+};
+// Changes to the same R-trees since the previous checkpoint, see Space::delta_takeChanges.
+struct SpaceRTreeChanges
+{
+	RTreeData<MaterialTypeId>::Changes solid;
+	PointFeatureBase::Changes features;
+	RTreeBoolean::Changes exposedToSky;
+	// Read by Space::load in the same order.
+	void writeBinary(BinaryArchiveWriter& writer) const;
+};
 class Space
 {
 	RTreeDataIndex<std::unique_ptr<Reservable>, RTreeDataConfigs::noMergeOrOverlap> m_reservables;
@@ -95,6 +114,12 @@ class Space
 	SmallMap<FactionId, RTreeData<RTreeDataWrapper<StockPile*, nullptr>>> m_stockPiles;
 	SmallMap<FactionId, RTreeData<RTreeDataWrapper<Project*, nullptr>>> m_projects;
 	Area& m_area;
+	// Checkpoint is the step when the base file for incremental saves was written, deltaCount is the number of delta files written since.
+	Step m_deltaCheckpoint;
+	int m_deltaCount = 0;
+	int m_deltaFileGeneration = 0;
+	// Runs prepare on each R-tree which can be prepared, as OpenMP tasks.
+	void prepareRtreesWith(auto&& prepare);
 public:
 	PointsExposedToSky m_exposedToSky;
 	const Coordinates m_pointToIndexConversionMultipliers;
@@ -107,15 +132,34 @@ public:
 	const Distance m_sizeZ;
 	const DistanceWidth m_zLevelSize;
 	Space(Area& area, const Distance x, const Distance y, const Distance z);
-	void load(const Json& data, DeserializationMemo& deserializationMemo);
+	// When rtrees is provided solid, features and exposedToSky are read from it rather then from data, followed by any changes in rtreeDeltas.
+	void load(const Json& data, DeserializationMemo& deserializationMemo, BinaryArchiveReader* rtrees = nullptr, const std::vector<BinaryArchiveReader*>& rtreeDeltas = {});
+	// Writes the R-trees which toJson omits when includeRTrees is false, in the order load reads them.
+	void writeBinary(BinaryArchiveWriter& writer) const;
+	// Copies node arrays only, call prepareRtrees first.
+	[[nodiscard]] SpaceRTreeSnapshot snapshotRTrees() const { return {m_solid, m_features, m_exposedToSky}; }
+	// Incremental saves. After a full save starts tracking, each delta file holds only the regions of solid, features and exposedToSky which changed since the previous file.
+	// fileGeneration names the base file the deltas apply to, see SimulationHasAreas::getAreaPath.
+	void delta_startTracking(const Step checkpoint, const int fileGeneration);
+	// Call prepareRtrees first. Increments the delta count.
+	[[nodiscard]] SpaceRTreeChanges delta_takeChanges();
+	[[nodiscard]] bool delta_isTracking() const { return m_deltaCheckpoint.exists(); }
+	[[nodiscard]] Step delta_getCheckpoint() const { return m_deltaCheckpoint; }
+	[[nodiscard]] int delta_getCount() const { return m_deltaCount; }
+	[[nodiscard]] int delta_getFileGeneration() const { return m_deltaFileGeneration; }
 	void moveContentsTo(const Point3D point, const Point3D other);
 	void maybeContentsFalls(Cuboid cuboid);
 	void setDynamic(const auto& shape) { m_dynamic.maybeInsert(shape); }
 	void unsetDynamic(const auto& shape) { m_dynamic.maybeRemove(shape); }
 	void doSupportStep() { m_support.doStep(m_area); }
+	// Prepares completely, used before saving.
 	void prepareRtrees();
+	// Used every step, see RTreeData::prepareIncremental.
+	void prepareRtreesIncremental();
+	// Solid, features, fluid and the other R-trees held for every Area, not those held per faction.
+	[[nodiscard]] std::vector<std::pair<std::string_view, RTreeMetrics>> getRTreeMetrics() const;
 	[[nodiscard]] int size() const { return m_dimensions.prod(); }
-	[[nodiscard]] Json toJson() const;
+	[[nodiscard]] Json toJson(const bool includeRTrees = true) const;
 	[[nodiscard]] Cuboid boundry() const;
 	[[nodiscard]] OffsetCuboid offsetBoundry() const;
 	[[nodiscard]] Point3D getCenterAtGroundLevel() const;
@@ -614,7 +658,7 @@ public:
 	[[nodiscard]] Project* project_randomForFactionWithCondition(const FactionId faction, auto&& condition, AreaT& area) const
 	{
 		auto wrappedCondition = [&](const RTreeDataWrapper<Project*, nullptr>& wrappedProject) { return condition(*wrappedProject.get()); };
-		return area.m_simulation.m_random.getInVector(m_projects[faction].getAllWithCondition(wrappedCondition).m_data).get();
+		return area.m_random.getInVector(m_projects[faction].getAllWithCondition(wrappedCondition).m_data).get();
 	}
 	[[nodiscard]] const auto& project_getAll() const { return m_projects; }
 	// -Temperature
@@ -4,7 +4,24 @@
 #include "../dataStructures/smallSet.h"
 #include "../space/space.h"
 #include "../items/items.h"
+#include <vector>
 
+namespace
+{
+	// Overlap happens when a feature is hewn from solid.
+	bool connects(const Cuboid a, const Cuboid b) { return a.intersects(b) || (a.isTouching(b) && a.isTouchingFace(b)); }
+	struct AnchorSearch
+	{
+		CuboidSet openList;
+		CuboidSet closedList;
+		Cuboid seed;
+		bool anchored = false;
+		// Exhausted searches have visited their entire region without reaching the edge.
+		bool exhausted = false;
+		bool merged = false;
+		[[nodiscard]] bool isRunning() const { return !anchored && !exhausted && !merged; }
+	};
+}
 void Support::doStep(Area& area)
 {
 	Items& items = area.getItems();
@@ -25,15 +42,182 @@ void Support::doStep(Area& area)
 	// Points in maybeFall which have not fallen due to being empty must be cleared.
 	m_maybeFall.clear();
 }
+CuboidSet Support::getSupport(const Space& space, const Cuboid cuboid)
+{
+	CuboidSet output = space.solid_queryCuboids(cuboid);
+	for(const auto& [featureCuboid, pointFeature] : space.pointFeature_getAllWithCuboids(cuboid))
+		if(PointFeatureType::byId(pointFeature.pointFeatureType).isSupportAgainstCaveIn)
+			output.maybeAdd(featureCuboid);
+	// Moving platforms do not support or get supported by the terrain.
+	if(space.isDynamic(cuboid))
+		space.getDynamic().queryRemove(output);
+	return output;
+}
+CuboidSet Support::getConnectedSupport(const Space& space, const Cuboid cuboid)
+{
+	const Cuboid adjacentCuboid = space.boundry().intersection(cuboid.inflated({1}));
+	CuboidSet output;
+	for(const Cuboid adjacent : getSupport(space, adjacentCuboid))
+		if(connects(cuboid, adjacent))
+			output.maybeAdd(adjacent);
+	return output;
+}
+void Support::anchor(const Space& space, CuboidSet openList)
+{
+	for(const Cuboid cuboid : openList)
+		m_anchored.maybeInsert(cuboid);
+	while(!openList.empty())
+	{
+		const Cuboid candidate = openList.back();
+		openList.popBack();
+		for(const Cuboid adjacent : getConnectedSupport(space, candidate))
+		{
+			// Solid cuboids merge, so part of adjacent may be anchored already.
+			CuboidSet unanchored = CuboidSet::create(adjacent);
+			m_anchored.queryRemove(unanchored);
+			for(const Cuboid cuboid : unanchored)
+			{
+				m_anchored.maybeInsert(cuboid);
+				openList.maybeAdd(cuboid);
+			}
+		}
+	}
+}
+void Support::onAdd(const Space& space, const Cuboid cuboid)
+{
+	if(space.isDynamic(cuboid))
+		return;
+	bool anchored = cuboid.isTouchingFaceFromInside(space.boundry());
+	if(!anchored)
+		for(const Cuboid adjacent : getConnectedSupport(space, cuboid))
+			// Any anchored part of adjacent is connected to cuboid through adjacent.
+			if(m_anchored.query(adjacent))
+			{
+				anchored = true;
+				break;
+			}
+	if(!anchored)
+		return;
+	CuboidSet unanchored = CuboidSet::create(cuboid);
+	m_anchored.queryRemove(unanchored);
+	anchor(space, unanchored);
+}
+void Support::onRemove(const Space& space, const Cuboid cuboid)
+{
+	if(!m_anchored.query(cuboid))
+		// Removing part of an unanchored region cannot anchor anything.
+		return;
+	m_anchored.maybeRemove(cuboid);
+	const Cuboid boundry = space.boundry();
+	std::vector<AnchorSearch> searches;
+	for(const Cuboid adjacent : getConnectedSupport(space, cuboid))
+	{
+		AnchorSearch& search = searches.emplace_back();
+		search.openList.maybeAdd(adjacent);
+		search.closedList.maybeAdd(adjacent);
+		search.seed = adjacent;
+	}
+	const bool oneMustStayAnchored = !cuboid.isTouchingFaceFromInside(boundry);
+	const int searchCount = searches.size();
+	while(true)
+	{
+		int running = 0;
+		int lastRunning = -1;
+		bool anyAnchored = false;
+		for(int i = 0; i != searchCount; ++i)
+		{
+			if(searches[i].isRunning())
+			{
+				++running;
+				lastRunning = i;
+			}
+			else if(searches[i].anchored)
+				anyAnchored = true;
+		}
+		if(running == 0)
+			break;
+		if(running == 1 && oneMustStayAnchored && !anyAnchored)
+		{
+			searches[lastRunning].anchored = true;
+			break;
+		}
+		// Advance each running search by one candidate.
+		for(int i = 0; i != searchCount; ++i)
+		{
+			AnchorSearch& search = searches[i];
+			if(!search.isRunning())
+				continue;
+			const Cuboid candidate = search.openList.back();
+			search.openList.popBack();
+			if(candidate.isTouchingFaceFromInside(boundry))
+			{
+				search.anchored = true;
+				continue;
+			}
+			for(const Cuboid adjacent : getConnectedSupport(space, candidate))
+			{
+				if(search.closedList.contains(adjacent))
+					continue;
+				int other = -1;
+				for(int j = 0; j != searchCount; ++j)
+					if(j != i && !searches[j].merged && searches[j].closedList.intersects(adjacent))
+					{
+						other = j;
+						break;
+					}
+				if(other != -1)
+				{
+					AnchorSearch& otherSearch = searches[other];
+					if(otherSearch.anchored)
+					{
+						search.anchored = true;
+						break;
+					}
+					// Both searches are in the same region.
+					search.openList.maybeAddAll(otherSearch.openList);
+					search.closedList.maybeAddAll(otherSearch.closedList);
+					otherSearch.merged = true;
+					otherSearch.openList.clear();
+					otherSearch.closedList.clear();
+					if(search.closedList.contains(adjacent))
+						continue;
+				}
+				search.closedList.maybeAdd(adjacent);
+				search.openList.maybeAdd(adjacent);
+			}
+			if(!search.anchored && search.openList.empty())
+				search.exhausted = true;
+		}
+	}
+	for(const AnchorSearch& search : searches)
+		if(search.exhausted)
+		{
+			for(const Cuboid unanchored : search.closedList)
+				m_anchored.maybeRemove(unanchored);
+			m_maybeFall.maybeAdd(search.seed);
+		}
+	// Support remaining within cuboid, such as a feature hewn from it, was unanchored along with it.
+	for(const Cuboid remaining : getSupport(space, cuboid))
+		onAdd(space, remaining.intersection(cuboid));
+}
+void Support::rebuild(const Space& space)
+{
+	m_anchored.clear();
+	const Cuboid boundry = space.boundry();
+	CuboidSet openList;
+	for(Facing6 facing = Facing6::Below; facing != Facing6::Null; facing = (Facing6)((int)facing + 1))
+		openList.maybeAddAll(getSupport(space, boundry.getFace(facing)));
+	anchor(space, openList);
+}
 CuboidSet Support::getUnsupported(const Area& area, const Cuboid cuboid) const
 {
 	const Cuboid boundry = area.getSpace().boundry();
 	assert(boundry.contains(cuboid));
 	const Space& space = area.getSpace();
-	CuboidSet openList = space.solid_queryCuboids(cuboid);
-	for(const auto& [featureCuboid, pointFeature] : space.pointFeature_getAllWithCuboids(cuboid))
-		if(PointFeatureType::byId(pointFeature.pointFeatureType).isSupportAgainstCaveIn)
-			openList.maybeAdd(featureCuboid);
+	CuboidSet openList = getSupport(space, cuboid);
+	// Anchored regions are supported, the search below only visits regions which are not.
+	if(m_anchored.query(openList))
+		return {};
 	CuboidSet closedList;
 	closedList.maybeAddAll(openList);
 	while(!openList.empty())
@@ -43,24 +227,23 @@ CuboidSet Support::getUnsupported(const Area& area, const Cuboid cuboid) const
 		if(candidate.isTouchingFaceFromInside(boundry))
 			// If candidate is touching the edge of the space then all are supported.
 			return {};
-		Cuboid adjacentCuboid = candidate;
-		adjacentCuboid.inflate({1});
-		for(const Cuboid adjacentToCandidiate : space.solid_queryCuboids(adjacentCuboid))
-			if(candidate != adjacentToCandidiate && candidate.isTouchingFace(adjacentToCandidiate) && !closedList.contains(adjacentToCandidiate))
+		const Cuboid adjacentCuboid = boundry.intersection(candidate.inflated({1}));
+		for(const Cuboid adjacentToCandidiate : getSupport(space, adjacentCuboid))
+			if(connects(candidate, adjacentToCandidiate) && !closedList.contains(adjacentToCandidiate))
 			{
+				if(m_anchored.query(adjacentToCandidiate))
+					return {};
 				closedList.maybeAdd(adjacentToCandidiate);
 				openList.maybeAdd(adjacentToCandidiate);
 			}
+		// Features which do not support fall with the group.
 		for(const auto& [featureCuboid, pointFeature] : space.pointFeature_getAllWithCuboids(adjacentCuboid))
-			if(candidate != featureCuboid && candidate.isTouchingFace(featureCuboid) && !closedList.contains(featureCuboid))
-			{
-				if(PointFeatureType::byId(pointFeature.pointFeatureType).isSupportAgainstCaveIn)
-					openList.maybeAdd(featureCuboid);
+			if(!PointFeatureType::byId(pointFeature.pointFeatureType).isSupportAgainstCaveIn && connects(candidate, featureCuboid) && !closedList.contains(featureCuboid))
 				closedList.maybeAdd(featureCuboid);
-			}
 	}
 	// Group is not supported
 	//TODO: check if nonsupporting featureCuboids are supported from elsewhere.
 	return closedList;
 }
-void Support::prepare() { m_support.prepare(); }
\ No newline at end of file
+void Support::prepare() { m_anchored.prepare(); }
+void Support::prepareIncremental() { m_anchored.prepareIncremental(); }
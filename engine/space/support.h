@@ -1,21 +1,42 @@
+/*
+	Tracks which static solid and features which support against cave ins are anchored: connected to the edge of the area through face adjacent support.
+	onAdd anchors any region which the added cuboid connects to an anchored region or to the edge, visiting only the newly anchored region.
+	onRemove searches outward from each region touching the removed cuboid, taking one step of each search in turn. A search ends when it reaches the edge, runs into a search which has, or runs out of region. If the removed cuboid was not touching the edge at least one of the regions must still be anchored, so when every other search has run out the last one is anchored without finishing it.
+	The work done is proportional to the size of the regions which fall rather then to the size of the connected mass, which may be an entire mountain.
+	Regions which are no longer anchored are added to maybeFall and fall in the next doStep.
+*/
 #pragma once
 #include "../dataStructures/rtreeBoolean.h"
 #include "../numericTypes/types.h"
 #include "../geometry/cuboidSet.h"
 
 class Area;
+class Space;
 
 class Support
 {
-	RTreeBoolean m_support;
+	RTreeBoolean m_anchored;
 	CuboidSet m_maybeFall;
+	// Adds openList and all unanchored support connected to it to m_anchored.
+	void anchor(const Space& space, CuboidSet openList);
+	// Static solid and supporting features intersecting cuboid.
+	[[nodiscard]] static CuboidSet getSupport(const Space& space, const Cuboid cuboid);
+	// Static solid and supporting features face adjacent to or intersecting cuboid.
+	[[nodiscard]] static CuboidSet getConnectedSupport(const Space& space, const Cuboid cuboid);
 public:
 	void doStep(Area& area);
-	void set(const auto& shape) { m_support.maybeInsert(shape); }
-	void unset(const auto& shape) { m_support.maybeRemove(shape); }
+	// Called after static solid or a supporting feature is added.
+	void onAdd(const Space& space, const Cuboid cuboid);
+	// Called after static solid or a supporting feature is removed.
+	void onRemove(const Space& space, const Cuboid cuboid);
+	// Anchored regions are not saved, they are found again after loading.
+	void rebuild(const Space& space);
 	void maybeFall(const Cuboid cuboid) { m_maybeFall.maybeAdd(cuboid); }
 	void prepare();
+	void prepareIncremental();
 	[[nodiscard]] CuboidSet getUnsupported(const Area& area, const Cuboid cuboid) const;
+	[[nodiscard]] bool isAnchored(const auto& shape) const { return m_anchored.query(shape); }
 	[[nodiscard]] int maybeFallVolume() const { return m_maybeFall.volume(); }
-	[[nodiscard]] bool canPrepare() const { return m_support.canPrepare(); }
-};
\ No newline at end of file
+	[[nodiscard]] bool canPrepare() const { return m_anchored.canPrepare(); }
+	[[nodiscard]] RTreeMetrics getMetrics() const { return m_anchored.getMetrics(); }
+};
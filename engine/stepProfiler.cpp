@@ -0,0 +1,213 @@
+#include "stepProfiler.h"
+#include "config/config.h"
+#include "util.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#ifdef PROFILE_ALLOCATIONS
+	#include <atomic>
+	#include <cstdlib>
+	#include <new>
+	static std::atomic<uint64_t> g_allocationCount = 0;
+	void* operator new(std::size_t size)
+	{
+		g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+		void* output = std::malloc(size == 0 ? 1 : size);
+		if(output == nullptr)
+			throw std::bad_alloc();
+		return output;
+	}
+	void* operator new[](std::size_t size) { return operator new(size); }
+	void operator delete(void* pointer) noexcept { std::free(pointer); }
+	void operator delete[](void* pointer) noexcept { std::free(pointer); }
+	void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+	void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+#endif
+StepProfiler::StepProfiler(std::vector<const SizeClassPool*> pools) : m_pools(std::move(pools)), m_capacity(Config::stepProfilerHistory) { }
+void StepProfiler::setEnabled(const bool enabled)
+{
+	m_enabled = enabled;
+	if(m_enabled && m_history.empty())
+		m_history.resize(m_capacity);
+}
+void StepProfiler::setCapacity(const int capacity)
+{
+	assert(capacity > 0);
+	m_capacity = capacity;
+	m_history.clear();
+	if(m_enabled)
+		m_history.resize(m_capacity);
+	m_current = 0;
+	m_size = 0;
+}
+void StepProfiler::clear()
+{
+	m_current = 0;
+	m_size = 0;
+}
+void StepProfiler::beginStep(const Step step)
+{
+	if(!m_enabled)
+		return;
+	StepProfile& profile = current();
+	profile = {};
+	profile.step = step;
+	profile.begin = util::getCurrentTimeInMicroSeconds();
+	// Totals are held untill endStep replaces them with the difference.
+	profile.pooledAllocationCount = getPooledAllocationCount();
+	profile.pooledHeapAllocationCount = getPooledHeapAllocationCount();
+}
+void StepProfiler::endStep()
+{
+	if(!m_enabled)
+		return;
+	StepProfile& profile = current();
+	profile.duration = util::getCurrentTimeInMicroSeconds() - profile.begin;
+	profile.pooledAllocationCount = getPooledAllocationCount() - profile.pooledAllocationCount;
+	profile.pooledHeapAllocationCount = getPooledHeapAllocationCount() - profile.pooledHeapAllocationCount;
+	m_current = (m_current + 1) % m_capacity;
+	m_size = std::min(m_size + 1, m_capacity);
+}
+void StepProfiler::beginPhase()
+{
+	if(!m_enabled)
+		return;
+	m_phaseBegin = util::getCurrentTimeInMicroSeconds();
+	m_allocationsAtPhaseBegin = getAllocationCount();
+}
+void StepProfiler::endPhase(const StepPhase phase, const int itemCount)
+{
+	if(!m_enabled)
+		return;
+	StepProfile& profile = current();
+	StepPhaseRecord& record = profile.phases[(int)phase];
+	record.begin = m_phaseBegin - profile.begin;
+	record.duration = util::getCurrentTimeInMicroSeconds() - m_phaseBegin;
+	record.itemCount = itemCount;
+	record.allocationCount = getAllocationCount() - m_allocationsAtPhaseBegin;
+	record.recorded = true;
+}
+const StepProfile& StepProfiler::get(const int stepsAgo) const
+{
+	assert(stepsAgo < m_size);
+	return m_history[(m_current - 1 - stepsAgo + m_capacity) % m_capacity];
+}
+std::chrono::microseconds StepProfiler::getMeanDuration(const StepPhase phase) const
+{
+	std::chrono::microseconds total = std::chrono::microseconds(0);
+	int count = 0;
+	for(int i = 0; i != m_size; ++i)
+	{
+		const StepPhaseRecord& record = get(i).get(phase);
+		if(record.recorded)
+		{
+			total += record.duration;
+			++count;
+		}
+	}
+	if(count == 0)
+		return total;
+	return total / count;
+}
+std::chrono::microseconds StepProfiler::getMaxDuration(const StepPhase phase) const
+{
+	std::chrono::microseconds output = std::chrono::microseconds(0);
+	for(int i = 0; i != m_size; ++i)
+		output = std::max(output, get(i).get(phase).duration);
+	return output;
+}
+void StepProfiler::writeCsv(std::ostream& stream) const
+{
+	stream << "step,phase,beginMicroseconds,durationMicroseconds,items,allocations\n";
+	for(int i = m_size - 1; i >= 0; --i)
+	{
+		const StepProfile& profile = get(i);
+		for(int phase = 0; phase != (int)StepPhase::Null; ++phase)
+		{
+			const StepPhaseRecord& record = profile.phases[phase];
+			if(!record.recorded)
+				continue;
+			stream << profile.step.get() << ',' << getPhaseName((StepPhase)phase) << ',' << record.begin.count() << ',' << record.duration.count() << ',' << record.itemCount << ',' << record.allocationCount << '\n';
+		}
+	}
+}
+Json StepProfiler::toChromeTrace(const int tid) const
+{
+	Json events = Json::array();
+	for(int i = m_size - 1; i >= 0; --i)
+	{
+		const StepProfile& profile = get(i);
+		events.push_back({
+			{"name", "step " + std::to_string(profile.step.get())},
+			{"ph", "X"},
+			{"ts", profile.begin.count()},
+			{"dur", profile.duration.count()},
+			{"pid", 0},
+			{"tid", tid},
+		});
+		for(int phase = 0; phase != (int)StepPhase::Null; ++phase)
+		{
+			const StepPhaseRecord& record = profile.phases[phase];
+			if(!record.recorded)
+				continue;
+			events.push_back({
+				{"name", std::string(getPhaseName((StepPhase)phase))},
+				{"ph", "X"},
+				{"ts", (profile.begin + record.begin).count()},
+				{"dur", record.duration.count()},
+				{"pid", 0},
+				{"tid", tid},
+				{"args", {{"items", record.itemCount}, {"allocations", record.allocationCount}}},
+			});
+		}
+	}
+	return {{"traceEvents", events}, {"displayTimeUnit", "ms"}};
+}
+std::string_view StepProfiler::getPhaseName(const StepPhase phase)
+{
+	switch(phase)
+	{
+		case StepPhase::FluidGroups: return "fluidGroups";
+		case StepPhase::PrepareRtrees: return "prepareRtrees";
+		case StepPhase::Support: return "support";
+		case StepPhase::Temperature: return "temperature";
+		case StepPhase::Rain: return "rain";
+		case StepPhase::FluidSources: return "fluidSources";
+		case StepPhase::Vision: return "vision";
+		case StepPhase::Paths: return "paths";
+		case StepPhase::AreaThreadedTasks: return "areaThreadedTasks";
+		case StepPhase::AreaEvents: return "areaEvents";
+		case StepPhase::Movement: return "movement";
+		case StepPhase::Plants: return "plants";
+		case StepPhase::Soldiers: return "soldiers";
+		case StepPhase::Fires: return "fires";
+		case StepPhase::Jobs: return "jobs";
+		case StepPhase::SimulationThreadedTasks: return "simulationThreadedTasks";
+		case StepPhase::Areas: return "areas";
+		case StepPhase::SimulationEvents: return "simulationEvents";
+		case StepPhase::Null: break;
+	}
+	std::unreachable();
+}
+uint64_t StepProfiler::getAllocationCount()
+{
+	#ifdef PROFILE_ALLOCATIONS
+		return g_allocationCount.load(std::memory_order_relaxed);
+	#else
+		return 0;
+	#endif
+}
+uint64_t StepProfiler::getPooledAllocationCount() const
+{
+	uint64_t output = 0;
+	for(const SizeClassPool* pool : m_pools)
+		output += pool->getAllocationCount();
+	return output;
+}
+uint64_t StepProfiler::getPooledHeapAllocationCount() const
+{
+	uint64_t output = 0;
+	for(const SizeClassPool* pool : m_pools)
+		output += pool->getHeapAllocationCount();
+	return output;
+}
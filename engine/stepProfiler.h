@@ -0,0 +1,98 @@
+/*
+	Records the wall time, item count and allocation count of each phase of Area::doStep and Simulation::doStep for the most recent steps.
+	Disabled by default, when disabled each begin / end is a single branch.
+	Allocations are only counted when the engine is built with PROFILE_ALLOCATIONS defined, which replaces the global operator new with a counting one. The count is shared by all threads, so when Areas are stepped concurrently phases also count allocations made by other Areas.
+	Allocations from the owner's SizeClassPools are counted per step regardless, comparing objects served with chunks taken from the heap shows how much work the pools save.
+*/
+#pragma once
+#include "numericTypes/types.h"
+#include "json.h"
+#include "allocators/sizeClassPool.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+enum class StepPhase
+{
+	FluidGroups,
+	PrepareRtrees,
+	Support,
+	Temperature,
+	Rain,
+	FluidSources,
+	Vision,
+	Paths,
+	AreaThreadedTasks,
+	AreaEvents,
+	Movement,
+	Plants,
+	Soldiers,
+	Fires,
+	Jobs,
+	SimulationThreadedTasks,
+	Areas,
+	SimulationEvents,
+	Null
+};
+struct StepPhaseRecord
+{
+	// Relative to the begining of the step.
+	std::chrono::microseconds begin = std::chrono::microseconds(0);
+	std::chrono::microseconds duration = std::chrono::microseconds(0);
+	int itemCount = 0;
+	uint64_t allocationCount = 0;
+	bool recorded = false;
+};
+struct StepProfile
+{
+	Step step;
+	// Since epoch, used to place steps on a shared timeline in chrome traces.
+	std::chrono::microseconds begin = std::chrono::microseconds(0);
+	std::chrono::microseconds duration = std::chrono::microseconds(0);
+	std::array<StepPhaseRecord, (int)StepPhase::Null> phases;
+	uint64_t pooledAllocationCount = 0;
+	uint64_t pooledHeapAllocationCount = 0;
+	[[nodiscard]] const StepPhaseRecord& get(const StepPhase phase) const { return phases[(int)phase]; }
+};
+class StepProfiler
+{
+	std::vector<StepProfile> m_history;
+	std::vector<const SizeClassPool*> m_pools;
+	std::chrono::microseconds m_phaseBegin = std::chrono::microseconds(0);
+	uint64_t m_allocationsAtPhaseBegin = 0;
+	int m_capacity;
+	// Index in m_history of the step being recorded.
+	int m_current = 0;
+	int m_size = 0;
+	bool m_enabled = false;
+	[[nodiscard]] StepProfile& current() { return m_history[m_current]; }
+public:
+	explicit StepProfiler(std::vector<const SizeClassPool*> pools = {});
+	void setEnabled(const bool enabled);
+	// Discards recorded history.
+	void setCapacity(const int capacity);
+	void clear();
+	void beginStep(const Step step);
+	void endStep();
+	void beginPhase();
+	void endPhase(const StepPhase phase, const int itemCount = 0);
+	[[nodiscard]] bool isEnabled() const { return m_enabled; }
+	// Number of completed steps held.
+	[[nodiscard]] int size() const { return m_size; }
+	// 0 is the most recently completed step.
+	[[nodiscard]] const StepProfile& get(const int stepsAgo) const;
+	[[nodiscard]] std::chrono::microseconds getMeanDuration(const StepPhase phase) const;
+	[[nodiscard]] std::chrono::microseconds getMaxDuration(const StepPhase phase) const;
+	// One row per recorded phase, oldest step first.
+	void writeCsv(std::ostream& stream) const;
+	// Complete events in the chrome://tracing / Perfetto format, one track per tid.
+	[[nodiscard]] Json toChromeTrace(const int tid = 0) const;
+	[[nodiscard]] static std::string_view getPhaseName(const StepPhase phase);
+	// Returns 0 unless built with PROFILE_ALLOCATIONS.
+	[[nodiscard]] static uint64_t getAllocationCount();
+	[[nodiscard]] uint64_t getPooledAllocationCount() const;
+	[[nodiscard]] uint64_t getPooledHeapAllocationCount() const;
+};
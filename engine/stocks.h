@@ -3,6 +3,7 @@
 #include "numericTypes/types.h"
 #include "numericTypes/index.h"
 #include "dataStructures/smallMap.h"
+#include "dataStructures/adaptiveSet.h"
 
 #include <cassert>
 
@@ -13,7 +14,8 @@ class Area;
 
 class AreaHasStocksForFaction final
 {
-	SmallMap<ItemTypeId, SmallMap<MaterialTypeId, SmallSet<ItemIndex>>> m_data;
+	// A stockpile of a common item can hold thousands of items of the same type and material.
+	SmallMap<ItemTypeId, SmallMap<MaterialTypeId, AdaptiveSet<ItemIndex, ItemIndex::Hash>>> m_data;
 public:
 	void record(Area& area, ItemIndex item);
 	void maybeRecord(Area& area, ItemIndex item);
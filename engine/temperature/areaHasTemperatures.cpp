@@ -7,6 +7,10 @@
 #include "../plants.h"
 #include "../fluid/fluidGroup.h"
 #include "../config/physics.h"
+#include "../threads.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 void AreaHasTemperature::markToUpdate(const CuboidSet& cuboids) { m_toUpdate.maybeAddAll(cuboids); }
 void AreaHasTemperature::markToUpdate(const Cuboid cuboid) { m_toUpdate.maybeAdd(cuboid); }
 void AreaHasTemperature::doStep(Area& area)
@@ -47,87 +51,197 @@ void AreaHasTemperature::doStep(Area& area)
 		const Point3D location = items.getLocation(item);
 		items.setTemperature(item, get(area, location), location);
 	}
+	// Split into tiles.
+	std::vector<TemperatureTile> tiles;
+	const int tileSize = Config::temperatureTileSize;
+	for(const Cuboid cuboid : m_toUpdate)
+	{
+		const Point3D high = cuboid.m_high;
+		const Point3D low = cuboid.m_low;
+		for(int z = low.z().get(); z <= high.z().get(); z += tileSize)
+			for(int y = low.y().get(); y <= high.y().get(); y += tileSize)
+				for(int x = low.x().get(); x <= high.x().get(); x += tileSize)
+				{
+					const Point3D tileHigh = Point3D::create(std::min(x + tileSize - 1, (int)high.x().get()), std::min(y + tileSize - 1, (int)high.y().get()), std::min(z + tileSize - 1, (int)high.z().get()));
+					tiles.emplace_back().cuboid = {tileHigh, Point3D::create(x, y, z)};
+				}
+	}
+	// Tiles are in m_toUpdate order, so each thread starts with a spatially local range. Tiles near sources and portals cost more so idle threads steal from busy ones.
+	threads::forEachWorkStealing(m_workStealingRanges, tiles.size(), [&](const int index)
+	{
+		threads::ReadPhaseGuard guard;
+		readTemperatures(area, tiles[index]);
+		readTile(area, tiles[index]);
+	});
+	// Merge tile results in tile order, which is independent of how tiles were distributed between threads.
+	SmallMap<FluidTypeId, CuboidSet> toFreeze;
+	SmallMap<MaterialTypeId, CuboidSet> toMeltFeatures;
+	SmallMap<MaterialTypeId, CuboidSet> toBurnFeatures;
+	SmallMap<MaterialTypeId, CuboidSet> toMeltSolid;
+	SmallMap<MaterialTypeId, CuboidSet> toBurnSolid;
+	for(const TemperatureTile& tile : tiles)
+	{
+		for(const auto& [fluidType, cuboids] : tile.toFreeze)
+			toFreeze.getOrCreate(fluidType).addAll(cuboids);
+		for(const auto& [materialType, cuboids] : tile.toMeltFeatures)
+			toMeltFeatures.getOrCreate(materialType).addAll(cuboids);
+		for(const auto& [materialType, cuboids] : tile.toBurnFeatures)
+			toBurnFeatures.getOrCreate(materialType).addAll(cuboids);
+		for(const auto& [materialType, cuboids] : tile.toMeltSolid)
+			toMeltSolid.getOrCreate(materialType).addAll(cuboids);
+		for(const auto& [materialType, cuboids] : tile.toBurnSolid)
+			toBurnSolid.getOrCreate(materialType).addAll(cuboids);
+	}
+	// Fluids may freeze.
+	for(const auto& [fluidType, cuboidSet] : toFreeze)
+		space.temperature_freeze(cuboidSet, fluidType);
+	// Melt or burn features.
+	for(const auto& [materialType, cuboids] : toMeltFeatures)
+		space.temperature_meltFeatures(cuboids, materialType);
+	for(const auto& [materialType, cuboids] : toBurnFeatures)
+		for(const Cuboid cuboid : cuboids)
+			for(const Point3D point : cuboid)
+				area.m_fires.ignite(area, point, materialType);
+	// Melt or burn solid.
+	for(const auto& [materialType, cuboids] : toMeltSolid)
+		space.temperature_meltSolid(cuboids, materialType);
+	for(const auto& [materialType, cuboids] : toBurnSolid)
+		for(const Cuboid cuboid : cuboids)
+			for(const Point3D point : cuboid)
+				area.m_fires.ignite(area, point, materialType);
+	m_toUpdate.clear();
+}
+int TemperatureTile::getIndex(const Point3D point) const
+{
+	assert(cuboid.contains(point));
+	const int x = point.x().get() - cuboid.m_low.x().get();
+	const int y = point.y().get() - cuboid.m_low.y().get();
+	const int z = point.z().get() - cuboid.m_low.z().get();
+	return x + (y + z * cuboid.sizeY().get()) * cuboid.sizeX().get();
+}
+void AreaHasTemperature::readTemperatures(Area& area, TemperatureTile& tile) const
+{
+	const Cuboid cuboid = tile.cuboid;
+	const int volume = cuboid.volume();
+	// Each source and portal is applied to whole rows of the tile at once, the inner loops are over contiguous x and do not branch on the source so they can be vectorized.
+	const auto forEachRow = [&](const Cuboid intersection, auto&& action){
+		const int lowX = intersection.m_low.x().get();
+		const int count = intersection.sizeX().get();
+		for(int z = intersection.m_low.z().get(); z <= intersection.m_high.z().get(); ++z)
+			for(int y = intersection.m_low.y().get(); y <= intersection.m_high.y().get(); ++y)
+				action(tile.getIndex(Point3D::create(lowX, y, z)), lowX, y, z, count);
+	};
+	tile.temperatures.assign(volume, Config::undergroundAmbiantTemperature.get());
+	int* temperatures = tile.temperatures.data();
+	const Space& space = area.getSpace();
+	const int ambiant = m_ambiant.get();
+	for(const Cuboid exposed : space.m_exposedToSky.get().queryGetIntersection(CuboidSet::create(cuboid)))
+		forEachRow(exposed, [&](const int index, const int, const int, const int, const int count){
+			std::fill(temperatures + index, temperatures + index + count, ambiant);
+		});
+	// Sources.
+	const float exponent = Config::Physics::radiantHeatDisipatesAtDistanceExponent;
+	m_sources.queryForEachWithCuboids(cuboid, [&](const Cuboid sourceCuboid, const TemperatureSource& source){
+		const float delta = source.m_delta.get();
+		const Point3D location = source.m_location;
+		const int sourceX = location.x().get();
+		forEachRow(sourceCuboid.intersection(cuboid), [&](const int index, const int lowX, const int y, const int z, const int count){
+			const int dy = y - location.y().get();
+			const int dz = z - location.z().get();
+			const int squaredYZ = dy * dy + dz * dz;
+			for(int i = 0; i < count; ++i)
+			{
+				const int dx = lowX + i - sourceX;
+				const float distance = std::sqrt((float)(dx * dx + squaredYZ));
+				// Truncated per source, as in TemperatureDelta::reduceForDistanceRadiant.
+				temperatures[index + i] += distance == 0 ? (int)delta : (TemperatureDeltaWidth)(delta / std::pow(distance, exponent));
+			}
+		});
+	});
+	// Portals, only the nearest applies to each point.
+	if(m_portals.m_data.empty())
+		return;
+	constexpr float none = std::numeric_limits<float>::max();
+	std::vector<float> nearest(volume, none);
+	m_portals.queryForEachWithCuboids(cuboid, [&](const Cuboid affectedCuboid, const Cuboid portal){
+		const int portalLowX = portal.m_low.x().get();
+		const int portalHighX = portal.m_high.x().get();
+		forEachRow(affectedCuboid.intersection(cuboid), [&](const int index, const int lowX, const int y, const int z, const int count){
+			const int dy = std::max(0, std::max((int)portal.m_low.y().get() - y, y - (int)portal.m_high.y().get()));
+			const int dz = std::max(0, std::max((int)portal.m_low.z().get() - z, z - (int)portal.m_high.z().get()));
+			const int squaredYZ = dy * dy + dz * dz;
+			for(int i = 0; i < count; ++i)
+			{
+				const int x = lowX + i;
+				const int dx = std::max(0, std::max(portalLowX - x, x - portalHighX));
+				nearest[index + i] = std::min(nearest[index + i], std::sqrt((float)(dx * dx + squaredYZ)));
+			}
+		});
+	});
+	const float portalDelta = TemperatureDeltaWidth(ambiant - Config::undergroundAmbiantTemperature.get());
+	const float decay = Config::Physics::ambiantTemperatureDeltaDecay;
+	for(int i = 0; i < volume; ++i)
+		if(nearest[i] != none)
+			temperatures[i] += nearest[i] == 0 ? (int)portalDelta : (TemperatureDeltaWidth)(portalDelta / (nearest[i] * decay));
+}
+void AreaHasTemperature::readTile(Area& area, TemperatureTile& tile) const
+{
+	const Space& space = area.getSpace();
+	const Cuboid tileCuboid = tile.cuboid;
 	// Fluids may freeze.
-	SmallMap<FluidTypeId, CuboidSet> m_toFreeze;
-	space.fluid_queryForEachWithCuboids(m_toUpdate, [&](const Cuboid cuboid, const FluidData fluidData){
+	space.fluid_queryForEachWithCuboids(tileCuboid, [&](const Cuboid cuboid, const FluidData fluidData){
 		const Temperature freezingPoint = FluidType::getFreezingPoint(fluidData.type);
 		if(freezingPoint.empty())
 			return;
-		const CuboidSet intersection = m_toUpdate.intersection(cuboid);
 		CuboidSet toFreezeInCuboid;
-		for(const Cuboid intersectionCuboid : intersection)
-			for(const Point3D point : intersectionCuboid)
-			{
-				const Temperature temperature = get(area, point);
-				if(temperature <= freezingPoint)
-					toFreezeInCuboid.add(point);
-			}
+		for(const Point3D point : cuboid.intersection(tileCuboid))
+			if(tile.get(point) <= freezingPoint)
+				toFreezeInCuboid.add(point);
 		if(toFreezeInCuboid.exists())
-			m_toFreeze.getOrCreate(fluidData.type).addAll(toFreezeInCuboid);
+			tile.toFreeze.getOrCreate(fluidData.type).addAll(toFreezeInCuboid);
 	});
-	for(const auto& [fluidType, cuboidSet] : m_toFreeze)
-		space.temperature_freeze(cuboidSet, fluidType);
 	// Melt or burn features.
-	SmallMap<MaterialTypeId, CuboidSet> toMeltFeatures;
-	SmallMap<MaterialTypeId, CuboidSet> toBurnFeatures;
-	space.pointFeature_queryForEachWithCuboids(m_toUpdate, [&](const Cuboid cuboid, const PointFeature pointFeature){
-		Temperature meltingPoint = MaterialType::getMeltingPoint(pointFeature.materialType);
-		Temperature ignitionPoint = MaterialType::getIgnitionTemperature(pointFeature.materialType);
+	space.pointFeature_queryForEachWithCuboids(tileCuboid, [&](const Cuboid cuboid, const PointFeature pointFeature){
+		const Temperature meltingPoint = MaterialType::getMeltingPoint(pointFeature.materialType);
+		const Temperature ignitionPoint = MaterialType::getIgnitionTemperature(pointFeature.materialType);
 		if(meltingPoint.empty() && ignitionPoint.empty())
 			return;
 		CuboidSet pointsOfCuboidToMelt;
 		CuboidSet pointsOfCuboidToBurn;
-		for(const Point3D point : cuboid)
+		for(const Point3D point : cuboid.intersection(tileCuboid))
 		{
-			Temperature temperature = get(area, point);
+			const Temperature temperature = tile.get(point);
 			if(meltingPoint.exists() && meltingPoint <= temperature)
 				pointsOfCuboidToMelt.add(point);
 			else if(ignitionPoint.exists() && ignitionPoint <= temperature)
 				pointsOfCuboidToBurn.add(point);
 		}
 		if(pointsOfCuboidToMelt.exists())
-			toMeltFeatures.getOrCreate(pointFeature.materialType).addAll(pointsOfCuboidToMelt);
+			tile.toMeltFeatures.getOrCreate(pointFeature.materialType).addAll(pointsOfCuboidToMelt);
 		if(pointsOfCuboidToBurn.exists())
-			toBurnFeatures.getOrCreate(pointFeature.materialType).addAll(pointsOfCuboidToBurn);
+			tile.toBurnFeatures.getOrCreate(pointFeature.materialType).addAll(pointsOfCuboidToBurn);
 	});
-	for(const auto& [materialType, cuboids] : toMeltFeatures)
-		space.temperature_meltFeatures(cuboids, materialType);
-	for(const auto& [materialType, cuboids] : toBurnFeatures)
-		for(const Cuboid cuboid : cuboids)
-			for(const Point3D point : cuboid)
-				area.m_fires.ignite(area, point, materialType);
 	// Melt or burn solid.
-	SmallMap<MaterialTypeId, CuboidSet> toMeltSolid;
-	SmallMap<MaterialTypeId, CuboidSet> toBurnSolid;
-	space.solid_queryForEachWithCuboids(m_toUpdate, [&](const Cuboid cuboid, const MaterialTypeId materialType){
+	space.solid_queryForEachWithCuboids(tileCuboid, [&](const Cuboid cuboid, const MaterialTypeId materialType){
 		const Temperature meltingPoint = MaterialType::getMeltingPoint(materialType);
 		const Temperature ignitionPoint = MaterialType::getIgnitionTemperature(materialType);
 		if(meltingPoint.empty() && ignitionPoint.empty())
 			return;
 		CuboidSet pointsOfCuboidToMelt;
 		CuboidSet pointsOfCuboidToBurn;
-		CuboidSet pointsOfCuboidToUpdate = m_toUpdate.intersection(cuboid);
-		for(const Cuboid cuboidToUpdate : pointsOfCuboidToUpdate)
-			for(const Point3D point : cuboidToUpdate)
-			{
-				Temperature temperature = get(area, point);
-				if(!meltingPoint.empty() && meltingPoint <= temperature)
-					pointsOfCuboidToMelt.add(point);
-				else if(!ignitionPoint.empty() && ignitionPoint <= temperature && !space.fire_exists(point))
-					pointsOfCuboidToBurn.add(point);
-			}
+		for(const Point3D point : cuboid.intersection(tileCuboid))
+		{
+			const Temperature temperature = tile.get(point);
+			if(!meltingPoint.empty() && meltingPoint <= temperature)
+				pointsOfCuboidToMelt.add(point);
+			else if(!ignitionPoint.empty() && ignitionPoint <= temperature && !space.fire_exists(point))
+				pointsOfCuboidToBurn.add(point);
+		}
 		if(pointsOfCuboidToMelt.exists())
-			toMeltSolid.getOrCreate(materialType).addAll(pointsOfCuboidToMelt);
+			tile.toMeltSolid.getOrCreate(materialType).addAll(pointsOfCuboidToMelt);
 		if(pointsOfCuboidToBurn.exists())
-			toBurnSolid.getOrCreate(materialType).addAll(pointsOfCuboidToBurn);
+			tile.toBurnSolid.getOrCreate(materialType).addAll(pointsOfCuboidToBurn);
 	});
-	for(const auto& [materialType, cuboids] : toMeltSolid)
-		space.temperature_meltSolid(cuboids, materialType);
-	for(const auto& [materialType, cuboids] : toBurnSolid)
-		for(const Cuboid cuboid : cuboids)
-			for(const Point3D point : cuboid)
-				area.m_fires.ignite(area, point, materialType);
-	m_toUpdate.clear();
 }
 void AreaHasTemperature::setAmbient(Area& area, const Temperature newAmbiant)
 {
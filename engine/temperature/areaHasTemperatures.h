@@ -1,6 +1,7 @@
 #pragma once
 #include "temperatureSource.h"
 #include "portals.h"
+#include "../threads.h"
 
 class FluidGroup;
 class PointFeature;
@@ -14,6 +15,21 @@ struct OnSurfaceData
 	bool empty() const { return solid.empty() && features.empty() && items.empty(); }
 	NLOHMANN_DEFINE_TYPE_INTRUSIVE(OnSurfaceData, solid, features, items);
 };
+// A part of AreaHasTemperature::m_toUpdate no larger then Config::temperatureTileSize on any side.
+// Tiles are read in parallel: the temperature of every point in the tile is computed in one pass over the sources and portals which reach it, then checked for freezing, melting and ignition. The results are applied in tile order once all are read.
+struct TemperatureTile
+{
+	Cuboid cuboid;
+	// Indexed by offset from cuboid.m_low, x varies fastest.
+	std::vector<int> temperatures;
+	SmallMap<FluidTypeId, CuboidSet> toFreeze;
+	SmallMap<MaterialTypeId, CuboidSet> toMeltFeatures;
+	SmallMap<MaterialTypeId, CuboidSet> toBurnFeatures;
+	SmallMap<MaterialTypeId, CuboidSet> toMeltSolid;
+	SmallMap<MaterialTypeId, CuboidSet> toBurnSolid;
+	[[nodiscard]] int getIndex(const Point3D point) const;
+	[[nodiscard]] Temperature get(const Point3D point) const { return Temperature::create((TemperatureWidth)temperatures[getIndex(point)]); }
+};
 struct AreaHasTemperature
 {
 	AreaHasPortalsBetweenOutSideAndInside m_portals;
@@ -22,9 +38,14 @@ struct AreaHasTemperature
 	SmallMap<FluidTypeId, SmallSet<FluidGroupId>> m_freezableFluidTypeOnSurface;
 	CuboidSet m_toUpdate;
 	Temperature m_ambiant;
+	threads::WorkStealingRanges m_workStealingRanges;
 	void markToUpdate(const CuboidSet& cuboids);
 	void markToUpdate(const Cuboid cuboid);
 	void doStep(Area& area);
+	// Fills tile.temperatures, equivalent to calling get for each point.
+	void readTemperatures(Area& area, TemperatureTile& tile) const;
+	// Records what freezes, melts or burns within tile.
+	void readTile(Area& area, TemperatureTile& tile) const;
 	void updateAmbientSurfaceTemperature(Area& area);
 	void setAmbient(Area& area, const Temperature newAmbiant);
 	void onTemperatureCanNoLongerTransmit(Area& area, const CuboidSet& cuboids);
@@ -8,6 +8,8 @@
  #include "../items/items.h"
  #include "../plants.h"
  #include "../pointFeature.h"
+ #include "../threads.h"
+ #include <algorithm>
  #include<cmath>
 std::string TemperatureSource::toS() const
 {
@@ -62,15 +64,37 @@ CuboidSet AreaHasTemperatureSources::onChangeAmbiantSurfaceTemperatureReturnInte
 }
 void AreaHasTemperatureSources::doStep(Area& area)
 {
+	if(m_sourcesToUpdate.empty())
+		return;
+	// A source may be recorded once for each change within it's range.
+	std::ranges::sort(m_sourcesToUpdate, std::less{}, [](const auto& pair){ return pair.second; });
+	const auto duplicates = std::ranges::unique(m_sourcesToUpdate, std::equal_to{}, [](const auto& pair){ return pair.second; });
+	m_sourcesToUpdate.erase(duplicates.begin(), duplicates.end());
+	const int size = m_sourcesToUpdate.size();
+	std::vector<TemperatureSource> sources;
+	sources.reserve(size);
 	for(const auto [point, temperatueSourceId] : m_sourcesToUpdate)
+		sources.push_back(m_data.queryGetOneWithCondition(point, [&](const TemperatureSource other) { return other.m_id == temperatueSourceId; }));
+	// Affected areas only read space, not m_data, so they are found in parallel.
+	std::vector<CuboidSet> affectedAreas(size);
+	#pragma omp parallel for schedule(dynamic)
+	for(int i = 0; i < size; ++i)
 	{
-		auto condition = [&](const TemperatureSource other) { return other.m_id == temperatueSourceId; };
-		TemperatureSource source = m_data.queryGetOneWithCondition(point, condition);
-		CuboidSet recordedArea = RTreeHelpers::getAdjacentWithConditionRecursive<TemperatureSource>(m_data, point, condition);
+		threads::ReadPhaseGuard guard;
+		// Sources removed since being recorded are skipped.
+		if(!sources[i].empty())
+			affectedAreas[i] = getAffectedArea(area, sources[i].m_location, sources[i].m_delta);
+	}
+	for(int i = 0; i < size; ++i)
+	{
+		const TemperatureSource& source = sources[i];
+		if(source.empty())
+			continue;
+		auto condition = [&](const TemperatureSource other) { return other.m_id == source.m_id; };
+		CuboidSet recordedArea = RTreeHelpers::getAdjacentWithConditionRecursive<TemperatureSource>(m_data, source.m_location, condition);
 		m_data.removeWithCondition(recordedArea, condition);
-		CuboidSet affectedArea = getAffectedArea(area, point, source.m_delta);
-		m_data.insert(affectedArea, source);
-		recordedArea.maybeAddAll(affectedArea);
+		m_data.insert(affectedAreas[i], source);
+		recordedArea.maybeAddAll(affectedAreas[i]);
 		area.m_hasTemperature.markToUpdate(recordedArea);
 	}
 	m_sourcesToUpdate.clear();
@@ -48,6 +48,7 @@ public:
 	void onTemperatureCanNoLongerTransmit(const CuboidSet& cuboids);
 	void onTemperatureCanNowTransmit(const CuboidSet& cuboids);
 	void queryForEach(const auto& shape, auto&& action) const { return m_data.queryForEach(shape, action); }
+	void queryForEachWithCuboids(const auto& shape, auto&& action) const { return m_data.queryForEachWithCuboids(shape, action); }
 	[[nodiscard]] TemperatureDelta getDelta(const Point3D point);
 	[[nodiscard]] TemperatureSourceId getNextId();
 	[[nodiscard]] CuboidSet getPointsIntersectingExposedToSky(Area& area) const;
@@ -17,21 +17,33 @@ void ThreadedTaskEngine::doStep(Simulation& simulation, Area* area)
 {
 	m_tasksForThisStep.swap(m_tasksForNextStep);
 	m_tasksForNextStep.clear();
-	//#pragma omp parallel for
-		for(const auto& task : m_tasksForThisStep)
-			task.get()->readStep(simulation, area);
+	m_parallelReadTasks.clear();
+	for(const auto& task : m_tasksForThisStep)
+	{
+		if(task->readStepIsThreadSafe())
+			m_parallelReadTasks.push_back(task.get());
+		else
+			task->readStep(simulation, area);
+	}
+	threads::forEachWorkStealing(m_workStealingRanges, m_parallelReadTasks.size(), [&](const int index)
+	{
+		threads::ReadPhaseGuard guard;
+		m_parallelReadTasks[index]->readStep(simulation, area);
+	});
 	for(auto& task : m_tasksForThisStep)
 	{
 		task->clearReferences(simulation, area);
 		task->writeStep(simulation, area);
 	}
 }
-void ThreadedTaskEngine::insert(std::unique_ptr<ThreadedTask>&& task)
+void ThreadedTaskEngine::insert(Pooled<ThreadedTask>&& task)
 {
+	threads::assertNotInReadPhase();
 	m_tasksForNextStep.push_back(std::move(task));
 }
 void ThreadedTaskEngine::remove(ThreadedTask& task)
 {
+	threads::assertNotInReadPhase();
 	assert(std::ranges::find_if(m_tasksForNextStep, [&](auto& t) { return t.get() == &task; }) != m_tasksForNextStep.end());
 	std::erase_if(m_tasksForNextStep, [&](auto& t) { return t.get() == &task; });
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "threads.h"
+#include "allocators/sizeClassPool.h"
 #include <vector>
 #include <memory>
 class ThreadedTask;
@@ -9,16 +11,26 @@ class Area;
 // Hold and runs threaded tasks.
 class ThreadedTaskEngine
 {
+	// Tasks from m_tasksForThisStep which may run their read step in parallel. Stored here rather then per step so the buffer is reused.
+	std::vector<ThreadedTask*> m_parallelReadTasks;
+	threads::WorkStealingRanges m_workStealingRanges;
+	// Declared before the task vectors so it outlives the tasks they hold.
+	SizeClassPool m_pool;
 public:
-	std::vector<std::unique_ptr<ThreadedTask>> m_tasksForThisStep;
-	std::vector<std::unique_ptr<ThreadedTask>> m_tasksForNextStep;
+	std::vector<Pooled<ThreadedTask>> m_tasksForThisStep;
+	std::vector<Pooled<ThreadedTask>> m_tasksForNextStep;
+	// Read steps run in parallel, costs vary widely so work is distributed with work stealing. Write steps run sequentially in insertion order.
 	void doStep(Simulation&, Area* area);
-	void insert(std::unique_ptr<ThreadedTask>&& task);
+	void insert(Pooled<ThreadedTask>&& task);
+	// Adopts a task which was not created by getPool.
+	void insert(std::unique_ptr<ThreadedTask>&& task) { insert(Pooled<ThreadedTask>(task.release())); }
 	void remove(ThreadedTask& task);
 	void clear(Simulation& simulation, Area* area);
 	// For testing.
 	[[maybe_unused, nodiscard]] inline int count() const { return m_tasksForNextStep.size(); }
 	[[nodiscard]] bool empty() const { return count() == 0; }
+	[[nodiscard]] SizeClassPool& getPool() { return m_pool; }
+	[[nodiscard]] const SizeClassPool& getPool() const { return m_pool; }
 };
 class ThreadedTask
 {
@@ -29,6 +41,8 @@ public:
 	virtual void writeStep(Simulation& simulation, Area* area) = 0;
 	// To be called before write step, must at minimum call clearPointer on HasThreadedTask, if one exists.
 	virtual void clearReferences(Simulation& simulation, Area* area) = 0;
+	// Override to return false for tasks which write to data outside of themselves during read step. These are run sequentially before the parallel read phase.
+	[[nodiscard]] virtual bool readStepIsThreadSafe() const { return true; }
 	// Calls clearReferences.
 	void cancel(Simulation& simulation, Area* area);
 	ThreadedTask() = default;
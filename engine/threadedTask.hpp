@@ -14,7 +14,7 @@ public:
 	void create(Args&& ...args)
 	{
 		assert(m_threadedTask == nullptr);
-		std::unique_ptr<ThreadedTask> task = std::make_unique<TaskType>(args...);
+		Pooled<ThreadedTask> task = m_engine.getPool().create<TaskType>(args...);
 		m_threadedTask = static_cast<TaskType*>(task.get());
 		m_engine.insert(std::move(task));
 	}
@@ -43,7 +43,7 @@ public:
 	void create(HasShapeIndex index, Args&& ...args)
 	{
 		assert(m_threadedTask == nullptr);
-		std::unique_ptr<ThreadedTask> task = std::make_unique<TaskType>(args...);
+		Pooled<ThreadedTask> task = m_engine.getPool().create<TaskType>(args...);
 		m_threadedTask[index] = static_cast<TaskType*>(task.get());
 		m_engine.insert(std::move(task));
 	}
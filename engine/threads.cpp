@@ -14,8 +14,78 @@ namespace threads
 				max = omp_get_max_threads();
 			}
 		}
+		// Only the outermost parallel region is active, except while Areas are stepped concurrently, when SimulationHasAreas::doStepConcurrently sizes the nested teams itself.
+		omp_set_max_active_levels(1);
 		// Reserve memory per thread (physical) for hot spots.
 		longRangePath::init();
 		ThreadStripedWatermarkingStack<RTreeNodeIndex>::init(max);
 	}
-}
\ No newline at end of file
+	void WorkStealingRanges::reset(const int count, const int threadCount)
+	{
+		assert(count >= 0);
+		if((int)m_ranges.size() < threadCount)
+			m_ranges = std::vector<Range>(threadCount);
+		const uint32_t perThread = count / threadCount;
+		const uint32_t remainder = count % threadCount;
+		uint32_t begin = 0;
+		for(int i = 0; i < (int)m_ranges.size(); ++i)
+		{
+			uint32_t end = begin;
+			if(i < threadCount)
+				end += perThread + ((uint32_t)i < remainder ? 1 : 0);
+			m_ranges[i].data.store(pack(begin, end), std::memory_order_relaxed);
+			begin = end;
+		}
+		assert(begin == (uint32_t)count);
+	}
+	int WorkStealingRanges::next(const int thread)
+	{
+		assert(thread < (int)m_ranges.size());
+		std::atomic<uint64_t>& own = m_ranges[thread].data;
+		while(true)
+		{
+			uint64_t data = own.load(std::memory_order_acquire);
+			while(front(data) < back(data))
+			{
+				if(own.compare_exchange_weak(data, pack(front(data) + 1, back(data)), std::memory_order_acq_rel))
+					return front(data);
+			}
+			if(!steal(thread))
+				return -1;
+		}
+	}
+	bool WorkStealingRanges::steal(const int thread)
+	{
+		while(true)
+		{
+			// Find the victim with the most remaining work.
+			int victim = -1;
+			uint32_t largest = 0;
+			for(int i = 0; i < (int)m_ranges.size(); ++i)
+			{
+				if(i == thread)
+					continue;
+				const uint64_t data = m_ranges[i].data.load(std::memory_order_relaxed);
+				if(front(data) < back(data) && back(data) - front(data) > largest)
+				{
+					largest = back(data) - front(data);
+					victim = i;
+				}
+			}
+			if(victim == -1)
+				return false;
+			uint64_t data = m_ranges[victim].data.load(std::memory_order_acquire);
+			if(front(data) >= back(data))
+				continue;
+			// Round up so a single remaining item can be stolen.
+			const uint32_t half = (back(data) - front(data) + 1) / 2;
+			const uint32_t newBack = back(data) - half;
+			if(m_ranges[victim].data.compare_exchange_strong(data, pack(front(data), newBack), std::memory_order_acq_rel))
+			{
+				// Our own range is empty so no other thread will modify it, each index is only ever in one range so ABA is not possible.
+				m_ranges[thread].data.store(pack(newBack, newBack + half), std::memory_order_release);
+				return true;
+			}
+		}
+	}
+}
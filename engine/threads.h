@@ -1,9 +1,98 @@
 #pragma once
 #include "allocators/watermarkingStack.h"
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include <omp.h>
 
 namespace threads
 {
 	inline int max;
 	// Run in main.
 	void init();
-}
\ No newline at end of file
+	#ifndef NDEBUG
+		// Set while a thread is running a parallel read phase.
+		// Methods which write to state shared by an Area assert that it is not set, so a read step which writes is caught in debug builds.
+		inline thread_local bool inReadPhase = false;
+	#endif
+	inline void assertNotInReadPhase()
+	{
+		#ifndef NDEBUG
+			assert(!inReadPhase);
+		#endif
+	}
+	#ifndef NDEBUG
+		// Set while a thread is stepping an Area concurrently with other Areas.
+		// Methods which write to state shared by Simulation assert that it is not set, such writes should go through Area::writeToSimulation instead.
+		inline thread_local bool inConcurrentAreaStep = false;
+	#endif
+	inline void assertNotInConcurrentAreaStep()
+	{
+		#ifndef NDEBUG
+			assert(!inConcurrentAreaStep);
+		#endif
+	}
+	// Index of the current thread, unique among threads running at the same time. Use this rather then omp_get_thread_num to index per thread buffers.
+	// Combines the thread number at each nesting level, so threads in the phase teams of Areas being stepped concurrently get distinct indices. Less then max as long as the product of the team sizes is, which SimulationHasAreas::doStepConcurrently ensures.
+	inline int getIndex()
+	{
+		int output = 0;
+		for(int level = 1; level <= omp_get_level(); ++level)
+			output = output * omp_get_team_size(level) + omp_get_ancestor_thread_num(level);
+		return output;
+	}
+	// Mark the current thread as reading for the duration of the scope.
+	struct ReadPhaseGuard
+	{
+		#ifndef NDEBUG
+			bool m_previous;
+			ReadPhaseGuard() : m_previous(inReadPhase) { inReadPhase = true; }
+			~ReadPhaseGuard() { inReadPhase = m_previous; }
+		#endif
+	};
+	// Mark the current thread as stepping an Area concurrently with other Areas for the duration of the scope.
+	struct ConcurrentAreaStepGuard
+	{
+		#ifndef NDEBUG
+			ConcurrentAreaStepGuard() { inConcurrentAreaStep = true; }
+			~ConcurrentAreaStepGuard() { inConcurrentAreaStep = false; }
+		#endif
+	};
+	// Divides a range of indices into one contiguous subrange per thread.
+	// A thread pops work from the front of it's own subrange, when that is empty it steals the back half of the largest remaining subrange.
+	// For parallel loops where the cost of each iteration varies by orders of magnitude.
+	class WorkStealingRanges
+	{
+		// Front in the high 32 bits, back in the low 32 bits, so both ends can be updated with a single compare exchange.
+		struct alignas(std::hardware_destructive_interference_size) Range
+		{
+			std::atomic<uint64_t> data;
+		};
+		std::vector<Range> m_ranges;
+		[[nodiscard]] static uint64_t pack(const uint32_t front, const uint32_t back) { return ((uint64_t)front << 32) | back; }
+		[[nodiscard]] static uint32_t front(const uint64_t data) { return data >> 32; }
+		[[nodiscard]] static uint32_t back(const uint64_t data) { return (uint32_t)data; }
+		[[nodiscard]] bool steal(const int thread);
+	public:
+		void reset(const int count, const int threadCount);
+		// Returns -1 when no work remains anywhere.
+		[[nodiscard]] int next(const int thread);
+	};
+	// Call action with each index in [0, count) from within an omp parallel region, balancing with WorkStealingRanges.
+	template<typename Action>
+	void forEachWorkStealing(WorkStealingRanges& ranges, const int count, Action&& action)
+	{
+		if(count == 0)
+			return;
+		// Sized by the maximum rather then by the number of threads in the team, subranges belonging to threads which are not in the team get stolen.
+		ranges.reset(count, omp_get_max_threads());
+		#pragma omp parallel
+		{
+			const int thread = omp_get_thread_num();
+			for(int index = ranges.next(thread); index != -1; index = ranges.next(thread))
+				action(index);
+		}
+	}
+}
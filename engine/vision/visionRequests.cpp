@@ -22,36 +22,50 @@ void VisionRequests::create(const ActorReference actor)
 	assert(actors.hasLocation(index));
 	assert(actors.vision_canSeeAnything(index));
 	const Point3D location = actors.getLocation(index);
-	m_data.emplace(location, actor, actors.vision_getRange(index), actors.getFacing(index), actors.getOccupied(index));
-	if(m_data.back().range > m_largestRange)
-		m_largestRange = m_data.back().range;
+	const VisionRequest& request = m_data.emplace(actor, location, actor, actors.vision_getRange(index), actors.getFacing(index), actors.getOccupied(index));
+	if(request.range > m_largestRange)
+		m_largestRange = request.range;
 }
 void VisionRequests::maybeCreate(const ActorReference actor)
 {
 	Actors& actors = m_area.getActors();
-	if(actors.vision_canSeeAnything(actor.getIndex(actors.m_referenceData)) && !m_data.containsAny([&](const auto& data){ return data.actor == actor; }))
+	if(actors.vision_canSeeAnything(actor.getIndex(actors.m_referenceData)) && !m_data.contains(actor))
 		create(actor);
 }
 void VisionRequests::cancelIfExists(const ActorReference actor)
 {
-	auto found = m_data.findIf([&](const VisionRequest& request) { return request.actor == actor; });
+	auto found = m_data.find(actor);
 	if(found == m_data.end())
 		return;
-	bool largestRange = found->range == m_largestRange;
+	bool largestRange = found->second.range == m_largestRange;
 	m_data.erase(found);
 	if(m_data.empty())
 		m_largestRange = Distance::create(0);
 	else if(largestRange)
-		m_largestRange = std::max_element(m_data.begin(), m_data.end(), [](const VisionRequest& a, const VisionRequest& b) { return a.actor < b.actor; })->range;
+		m_largestRange = std::ranges::max_element(m_data, {}, [](const auto& pair) { return pair.second.range; })->second.range;
 }
-void VisionRequests::readStepSegment(const int begin, const int end)
+void VisionRequestSegmentResults::resize(const int size)
 {
-	for(auto iter = m_data.begin() + begin; iter != m_data.begin() + end; ++iter)
+	// Clear rather then reassign to keep capacity of any set which was not moved out in the previous writeStep.
+	canSee.resize(size);
+	canBeSeenBy.resize(size);
+	for(int i = 0; i < size; ++i)
 	{
-		VisionRequest& request = *iter;
+		canSee[i].clear();
+		canBeSeenBy[i].clear();
+	}
+}
+void VisionRequests::readStepSegment(const int segment, const int begin, const int end)
+{
+	// Only this thread writes to results, VisionRequests and Area are read only during this phase.
+	VisionRequestSegmentResults& results = m_segmentResults[segment];
+	results.resize(end - begin);
+	for(int i = begin; i != end; ++i)
+	{
+		const VisionRequest& request = m_data.getValueAtIndex(i);
 		const DistanceSquared rangeSquared = request.range.squared();
-		SmallSet<ActorReference>& canSee = request.canSee;
-		SmallSet<ActorReference>& canBeSeenBy = request.canBeSeenBy;
+		SmallSet<ActorReference>& canSee = results.canSee[i - begin];
+		SmallSet<ActorReference>& canBeSeenBy = results.canBeSeenBy[i - begin];
 		// Collect results in a vector rather then a set to prevent cache thrashing.
 		const Sphere visionSphere{request.location, m_largestRange.toFloat()};
 		const Facing4 facing = request.facing;
@@ -59,56 +73,61 @@ void VisionRequests::readStepSegment(const int begin, const int end)
 		m_area.m_octTree.query(visionSphere, [&](const LocationBucket& bucket)
 		{
 			const auto& [actors, canSeeAndCanBeSeenBy] = bucket.visionRequestQuery(m_area, request.location, facing, rangeSquared, occupied, m_largestRange);
-			for(size_t i = 0; i < actors->size(); ++i)
+			for(size_t j = 0; j < actors->size(); ++j)
 			{
-				if(canSeeAndCanBeSeenBy.col(i)[0])
-					canSee.insertNonunique((*actors)[i]);
-				if(canSeeAndCanBeSeenBy.col(i)[1])
+				if(canSeeAndCanBeSeenBy.col(j)[0])
+					canSee.insertNonunique((*actors)[j]);
+				if(canSeeAndCanBeSeenBy.col(j)[1])
 					//TODO: change calls to insert rather then insertNonUnique by preventing duplicates.
-					canBeSeenBy.insertNonunique((*actors)[i]);
+					canBeSeenBy.insertNonunique((*actors)[j]);
 			}
 		});
 	}
 	// Finalize result by deduplicating.
 	// Do this in a seperate loop to avoid thrashing the CPU cache in the primary one.
-	for(auto iter = m_data.begin() + begin; iter != m_data.begin() + end; ++iter)
+	for(int i = begin; i != end; ++i)
 	{
-		VisionRequest& request = *iter;
-		request.canSee.removeDuplicatesAndValue(request.actor);
-		request.canBeSeenBy.makeUnique();
+		results.canSee[i - begin].removeDuplicatesAndValue(m_data.getValueAtIndex(i).actor);
+		results.canBeSeenBy[i - begin].makeUnique();
 		//TODO: maybe create canNoLongerSee / canNoLongerBeSeen here?
 	}
 }
 void VisionRequests::readStep()
 {
-	int index = 0;
-	int size = m_data.size();
-	std::vector<std::pair<int, int>> ranges;
-	while(index != size)
-	{
-		int end = std::min(size, index + Config::visionThreadingBatchSize);
-		ranges.emplace_back(index, end);
-		index = end;
-	}
 	// TODO: store hilbert number in request?
-	m_data.sort([&](const VisionRequest& a, const VisionRequest& b){ return a.location.hilbertNumber() < b.location.hilbertNumber(); });
+	m_data.sortByValue([&](const VisionRequest& a, const VisionRequest& b){ return a.location.hilbertNumber() < b.location.hilbertNumber(); });
 	m_area.m_octTree.maybeSort();
-	//#pragma omp parallel for
-	for(auto [start, end] : ranges)
-		readStepSegment(start, end);
+	const int size = m_data.size();
+	const int segmentCount = (size + Config::visionThreadingBatchSize - 1) / Config::visionThreadingBatchSize;
+	if(segmentCount > (int)m_segmentResults.size())
+		m_segmentResults.resize(segmentCount);
+	// Segments are indexed by position rather then by thread so writeStep can merge them in a fixed order regardless of scheduling.
+	#pragma omp parallel for schedule(dynamic)
+	for(int segment = 0; segment < segmentCount; ++segment)
+	{
+		const int begin = segment * Config::visionThreadingBatchSize;
+		const int end = std::min(size, begin + Config::visionThreadingBatchSize);
+		readStepSegment(segment, begin, end);
+	}
 }
 void VisionRequests::writeStep()
 {
 	Actors& actors = m_area.getActors();
-	for(VisionRequest& request : m_data)
+	// Merge segment results in request order, which is independent of how segments were distributed between threads.
+	for(int i = 0; i != m_data.size(); ++i)
 	{
+		VisionRequest& request = m_data.getValueAtIndex(i);
+		VisionRequestSegmentResults& results = m_segmentResults[i / Config::visionThreadingBatchSize];
+		const int offset = i % Config::visionThreadingBatchSize;
+		SmallSet<ActorReference>& canSee = results.canSee[offset];
+		SmallSet<ActorReference>& canBeSeenBy = results.canBeSeenBy[offset];
 		ActorIndex index = request.actor.getIndex(actors.m_referenceData);
-		const auto [noLongerCanSee, canNowSee] = actors.vision_getCanSee(index).getDeltaPair(request.canSee);
-		const auto [noLongerCanBeSeenBy, canNowBeSeenBy] = actors.vision_getCanBeSeenBy(index).getDeltaPair(request.canBeSeenBy);
+		const auto [noLongerCanSee, canNowSee] = actors.vision_getCanSee(index).getDeltaPair(canSee);
+		const auto [noLongerCanBeSeenBy, canNowBeSeenBy] = actors.vision_getCanBeSeenBy(index).getDeltaPair(canBeSeenBy);
 		// CanSee / CanBeSeenBy.
 		// Update for this actor.
-		actors.vision_setCanSee(index, std::move(request.canSee));
-		actors.vision_setCanBeSeenBy(index, std::move(request.canBeSeenBy));
+		actors.vision_setCanSee(index, std::move(canSee));
+		actors.vision_setCanBeSeenBy(index, std::move(canBeSeenBy));
 		// Update for other actors.
 		for(const ActorReference ref : noLongerCanSee)
 		{
@@ -167,7 +186,7 @@ void VisionRequests::doStep()
 void VisionRequests::clear()
 {
 	while(m_data.size())
-		cancelIfExists(m_data.back().actor);
+		cancelIfExists(m_data.back().first);
 }
 void VisionRequests::maybeGenerateRequestsForAllWithLineOfSightTo(const Cuboid cuboid)
 {
@@ -181,18 +200,18 @@ void VisionRequests::maybeGenerateRequestsForAllWithLineOfSightTo(const Cuboid c
 }
 bool VisionRequests::maybeUpdateRange(const ActorReference actor, const Distance range)
 {
-	auto iter = m_data.findIf([&](const VisionRequest& request) { return request.actor == actor; });
+	auto iter = m_data.find(actor);
 	if(iter == m_data.end())
 		return false;
-	iter->range = range;
+	iter->second.range = range;
 	return true;
 }
 bool VisionRequests::maybeUpdateLocation(const ActorReference actor, const Point3D location)
 {
-	auto iter = m_data.findIf([&](const VisionRequest& request) { return request.actor == actor; });
+	auto iter = m_data.find(actor);
 	if(iter == m_data.end())
 		return false;
-	iter->location = location;
+	iter->second.location = location;
 	return true;
 }
 size_t VisionRequests::size() const { return m_data.size(); }
\ No newline at end of file
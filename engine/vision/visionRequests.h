@@ -3,30 +3,40 @@
 #include "../numericTypes/types.h"
 #include "../numericTypes/index.h"
 #include "../dataStructures/smallSet.h"
+#include "../dataStructures/adaptiveMap.h"
 #include "../reference.h"
 #include "../geometry/point3D.h"
 #include <cassert>
 #include <cstdint>
+#include <new>
 #include <vector>
 class Area;
 struct VisionRequest
 {
 	CuboidSet occupied;
-	SmallSet<ActorReference> canSee = {};
-	SmallSet<ActorReference> canBeSeenBy = {};
 	Point3D location;
 	ActorReference actor;
 	Distance range;
 	Facing4 facing;
 	VisionRequest(const Point3D _location, const ActorReference _actor, const Distance _range, const Facing4& _facing, const CuboidSet& _occupied) :
 		occupied(_occupied), location(_location), actor(_actor), range(_range), facing(_facing) { }
-	struct hash { [[nodiscard]] static bool operator()(const VisionRequest& request) { return request.actor.getReferenceIndex().get(); }};
 	[[nodiscard]] bool operator==(const VisionRequest& visionRequest) const { return visionRequest.actor == actor; }
 	[[nodiscard]] bool operator!=(const VisionRequest& visionRequest) const { return visionRequest.actor != actor; }
 };
+// Results for one readStep segment, indexed by offset from the start of the segment.
+// Each segment is read by exactly one thread, alignment prevents false sharing between neighbouring segments.
+struct alignas(std::hardware_destructive_interference_size) VisionRequestSegmentResults
+{
+	std::vector<SmallSet<ActorReference>> canSee;
+	std::vector<SmallSet<ActorReference>> canBeSeenBy;
+	void resize(const int size);
+};
 class VisionRequests final
 {
-	SmallSet<VisionRequest> m_data;
+	// Indexed by actor so updates for moving actors do not search every request when a crowd gathers.
+	AdaptiveMap<ActorReference, VisionRequest, ActorReference::Hash> m_data;
+	// One entry per segment of Config::visionThreadingBatchSize requests. Stored here rather then per step so the buffers are reused.
+	std::vector<VisionRequestSegmentResults> m_segmentResults;
 	Area& m_area;
 	Distance m_largestRange = Distance::create(0);
 public:
@@ -34,7 +44,7 @@ public:
 	void create(const ActorReference actor);
 	void maybeCreate(const ActorReference actor);
 	void cancelIfExists(const ActorReference actor);
-	void readStepSegment(const int begin, const int end);
+	void readStepSegment(const int segment, const int begin, const int end);
 	void doStep();
 	void readStep();
 	void writeStep();
@@ -0,0 +1,104 @@
+#include "../../lib/doctest.h"
+#include "../../engine/dataStructures/adaptiveSet.h"
+#include "../../engine/dataStructures/adaptiveMap.h"
+#include "../../engine/config/config.h"
+TEST_CASE("adaptiveSet")
+{
+	using Set = AdaptiveSet<int, std::hash<int>>;
+	const int large = Config::adaptiveContainerIndexThreshold * 4;
+	SUBCASE("stays unindexed while small")
+	{
+		Set set;
+		for(int i = 0; i != Config::adaptiveContainerIndexThreshold - 1; ++i)
+			set.insert(i);
+		CHECK(!set.isIndexed());
+		CHECK(set.contains(3));
+		set.insert(Config::adaptiveContainerIndexThreshold - 1);
+		CHECK(set.isIndexed());
+	}
+	SUBCASE("indexed set matches vector contents through inserts and erases")
+	{
+		Set set;
+		for(int i = 0; i != large; ++i)
+			set.insert(i * 7);
+		CHECK(set.isIndexed());
+		CHECK(set.size() == large);
+		// Erase every third value, moving the back into each erased position.
+		for(int i = 0; i < large; i += 3)
+			set.erase(i * 7);
+		for(int i = 0; i != large; ++i)
+			CHECK(set.contains(i * 7) == (i % 3 != 0));
+		for(int i = 0; i != set.size(); ++i)
+			CHECK(*set.find(set[i]) == set[i]);
+		set.maybeInsert(0);
+		set.maybeInsert(7);
+		CHECK(set.contains(0));
+		CHECK(set.size() == large - (large + 2) / 3 + 1);
+	}
+	SUBCASE("index is dropped well below the threshold")
+	{
+		Set set;
+		for(int i = 0; i != large; ++i)
+			set.insert(i);
+		for(int i = 0; i != large - Config::adaptiveContainerIndexThreshold / 2; ++i)
+			set.erase(i);
+		CHECK(set.isIndexed());
+		const int back = set.back();
+		set.erase(back);
+		CHECK(!set.isIndexed());
+		CHECK(!set.contains(back));
+		CHECK(!set.contains(large - Config::adaptiveContainerIndexThreshold / 2 - 1));
+		for(const int value : set)
+			CHECK(set.contains(value));
+	}
+	SUBCASE("delta pair")
+	{
+		Set set;
+		for(int i = 0; i != large; ++i)
+			set.insert(i);
+		SmallSet<int> other;
+		for(int i = large / 2; i != large + 10; ++i)
+			other.insert(i);
+		const auto [toRemove, toInsert] = set.getDeltaPair(other);
+		CHECK(toRemove.size() == large / 2);
+		CHECK(toInsert.size() == 10);
+		CHECK(toInsert.contains(large));
+		set.assign(std::move(other));
+		CHECK(set.isIndexed());
+		CHECK(set.contains(large + 9));
+		CHECK(!set.contains(0));
+	}
+	SUBCASE("size histogram")
+	{
+		Set set;
+		for(int i = 0; i != 5; ++i)
+			set.insert(i);
+		const auto& histogram = set.getSizeHistogram().get();
+		CHECK(histogram[0] == 1);
+		CHECK(histogram[1] == 2);
+		CHECK(histogram[2] == 2);
+		CHECK(histogram[3] == 0);
+	}
+}
+TEST_CASE("adaptiveMap")
+{
+	using Map = AdaptiveMap<int, int, std::hash<int>>;
+	const int large = Config::adaptiveContainerIndexThreshold * 4;
+	Map map;
+	for(int i = 0; i != large; ++i)
+		map.emplace(i, i * 2);
+	CHECK(map.isIndexed());
+	for(int i = 0; i < large; i += 2)
+		map.erase(i);
+	for(int i = 0; i != large; ++i)
+	{
+		CHECK(map.contains(i) == (i % 2 == 1));
+		if(i % 2 == 1)
+			CHECK(map[i] == i * 2);
+	}
+	map.sortByValue([](const int a, const int b) { return a > b; });
+	CHECK(map.front().first == large - 1);
+	CHECK(map.find(1)->second == 2);
+	map.getOrCreate(0) = 5;
+	CHECK(map[0] == 5);
+}
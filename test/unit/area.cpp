@@ -11,6 +11,7 @@
 #include "../../engine/definitions/animalSpecies.h"
 #include "../../engine/config/config.h"
 #include "numericTypes/types.h"
+#include <sstream>
 
 TEST_CASE("Area")
 {
@@ -46,6 +47,7 @@ TEST_CASE("Area")
 		actors.move_setDestination(actor, destination);
 		area.doStep();
 		++simulation.m_step;
+		CHECK(area.m_hasPaths.getLastStepStats().pathCount == 1);
 		CHECK(actors.move_getPath(actor).size() == 7);
 		CHECK(simulation.m_threadedTaskEngine.m_tasksForNextStep.empty());
 		CHECK(actors.move_hasEvent(actor));
@@ -101,4 +103,147 @@ TEST_CASE("vision-threading")
 	simulation.doStep();
 	CHECK(actors.vision_canSeeActor(a1, a2));
 	CHECK(actors.vision_canSeeActor(a2, a1));
-}
\ No newline at end of file
+}
+class MessageFromAreaTestEvent final : public ScheduledEvent
+{
+public:
+	MessageFromAreaTestEvent(Simulation& simulation) : ScheduledEvent(simulation, Step::create(1)) { }
+	void execute(Simulation& simulation, Area* area)
+	{
+		CHECK(simulation.m_hasAreas->isSteppingConcurrently());
+		area->writeToSimulation([area, &simulation]{ simulation.m_hasDialogues.createMessageBox(area->m_name); });
+	}
+	void clearReferences(Simulation&, Area*) { }
+};
+class CreateActorInAreaTestEvent final : public ScheduledEvent
+{
+	ActorId& m_created;
+public:
+	CreateActorInAreaTestEvent(Simulation& simulation, ActorId& created) : ScheduledEvent(simulation, Step::create(1)), m_created(created) { }
+	void execute(Simulation&, Area* area)
+	{
+		Actors& actors = area->getActors();
+		const ActorIndex actor = actors.create(ActorParamaters{
+			.species=AnimalSpecies::byName("dwarf"),
+			.location=Point3D::create(2, 2, 1),
+		});
+		m_created = actors.getId(actor);
+	}
+	void clearReferences(Simulation&, Area*) { }
+};
+TEST_CASE("areas-stepped-concurrently")
+{
+	static MaterialTypeId marble = MaterialType::byName("marble");
+	static AnimalSpeciesId dwarf = AnimalSpecies::byName("dwarf");
+	Config::stepAreasConcurrently = true;
+	Simulation simulation;
+	std::vector<Area*> areas;
+	std::vector<ActorIndex> dwarves;
+	Point3D origin = Point3D::create(1, 1, 1);
+	Point3D destination = Point3D::create(8, 8, 1);
+	for(int i = 0; i < 4; ++i)
+	{
+		Area& area = simulation.m_hasAreas->createArea(10, 10, 10);
+		area.m_hasRain.disable();
+		areaBuilderUtil::setSolidLayer(area, 0, marble);
+		Actors& actors = area.getActors();
+		ActorIndex actor = actors.create(ActorParamaters{
+			.species=dwarf,
+			.location=origin,
+		});
+		actors.move_setDestination(actor, destination);
+		areas.push_back(&area);
+		dwarves.push_back(actor);
+	}
+	SUBCASE("all areas make progress")
+	{
+		simulation.fastForwardUntillActorIsAtDestination(*areas.back(), dwarves.back(), destination);
+		for(int i = 0; i < 4; ++i)
+			CHECK(areas[i]->getActors().getLocation(dwarves[i]) == destination);
+	}
+	SUBCASE("writes to simulation are deferred untill all areas have stepped")
+	{
+		for(Area* area : areas)
+			area->m_eventSchedule.schedule(std::make_unique<MessageFromAreaTestEvent>(simulation));
+		simulation.doStep();
+		CHECK(simulation.m_hasDialogues.empty());
+		simulation.doStep();
+		CHECK(!simulation.m_hasDialogues.empty());
+		// Applied in area order regardless of which finished stepping first.
+		for(Area* area : areas)
+		{
+			CHECK(simulation.m_hasDialogues.top().content == area->m_name);
+			simulation.m_hasDialogues.pop();
+		}
+		CHECK(simulation.m_hasDialogues.empty());
+	}
+	SUBCASE("each area allocates ids from it's own block and draws from it's own seed")
+	{
+		std::vector<ActorId> created(areas.size());
+		for(size_t i = 0; i != areas.size(); ++i)
+			areas[i]->m_eventSchedule.schedule(std::make_unique<CreateActorInAreaTestEvent>(simulation, created[i]));
+		simulation.doStep();
+		simulation.doStep();
+		for(size_t i = 0; i != areas.size(); ++i)
+		{
+			const ActorId first = areas[i]->getActors().getId(dwarves[i]);
+			// Blocks are handed out in area order and the second id follows the first.
+			CHECK(first.get() / Config::idsPerBlock == (int)i);
+			CHECK(created[i] == first + 1);
+			CHECK(simulation.m_actors.getAreaForId(created[i]).m_id == areas[i]->m_id);
+			if(i != 0)
+				CHECK(areas[i]->m_random.getSeed() != areas[i - 1]->m_random.getSeed());
+		}
+	}
+	Config::stepAreasConcurrently = false;
+}
+TEST_CASE("step-profiler")
+{
+	static MaterialTypeId marble = MaterialType::byName("marble");
+	static AnimalSpeciesId dwarf = AnimalSpecies::byName("dwarf");
+	Simulation simulation;
+	Area& area = simulation.m_hasAreas->createArea(10, 10, 10);
+	area.m_hasRain.disable();
+	areaBuilderUtil::setSolidLayer(area, 0, marble);
+	Actors& actors = area.getActors();
+	ActorIndex actor = actors.create(ActorParamaters{
+		.species=dwarf,
+		.location=Point3D::create(1, 1, 1),
+	});
+	SUBCASE("disabled records nothing")
+	{
+		simulation.doStep();
+		CHECK(area.m_stepProfiler.size() == 0);
+		CHECK(simulation.m_stepProfiler.size() == 0);
+	}
+	SUBCASE("records phases and item counts")
+	{
+		area.m_stepProfiler.setEnabled(true);
+		simulation.m_stepProfiler.setEnabled(true);
+		actors.move_setDestination(actor, Point3D::create(8, 8, 1));
+		simulation.doStep();
+		REQUIRE(area.m_stepProfiler.size() == 1);
+		const StepProfile& profile = area.m_stepProfiler.get(0);
+		CHECK(profile.get(StepPhase::Paths).recorded);
+		CHECK(profile.get(StepPhase::Paths).itemCount == 1);
+		CHECK(!profile.get(StepPhase::Rain).recorded);
+		CHECK(simulation.m_stepProfiler.get(0).get(StepPhase::Areas).itemCount == 1);
+		std::stringstream csv;
+		area.m_stepProfiler.writeCsv(csv);
+		CHECK(csv.str().find("paths") != std::string::npos);
+		Json trace = area.m_stepProfiler.toChromeTrace();
+		CHECK(trace["traceEvents"].size() > 1);
+	}
+	SUBCASE("history is a ring buffer")
+	{
+		area.m_stepProfiler.setCapacity(2);
+		area.m_stepProfiler.setEnabled(true);
+		Step first = simulation.m_step;
+		simulation.doStep();
+		simulation.doStep();
+		simulation.doStep();
+		CHECK(area.m_stepProfiler.size() == 2);
+		CHECK(area.m_stepProfiler.get(0).step == first + 2);
+		CHECK(area.m_stepProfiler.get(1).step == first + 1);
+	}
+}
@@ -124,4 +124,31 @@ TEST_CASE("caveIn")
 		CHECK(space.solid_isAny(block.below()));
 		CHECK(support.maybeFallVolume() == 0);
 	}
+	SUBCASE("Removing the only connection to an anchored region detaches the rest.")
+	{
+		areaBuilderUtil::setSolidLayer(area, Distance::create(0), marble);
+		Point3D pillar = Point3D::create(5, 5, 1);
+		Point3D block = Point3D::create(5, 5, 2);
+		Point3D block2 = Point3D::create(6, 5, 2);
+		space.solid_set(pillar, marble, false);
+		space.solid_set(block, marble, false);
+		space.solid_set(block2, marble, false);
+		CHECK(support.isAnchored(pillar));
+		CHECK(support.isAnchored(block2));
+		// Mining within the anchored layer does not detach anything.
+		space.solid_setNot(Point3D::create(2, 2, 0));
+		CHECK(support.maybeFallVolume() == 0);
+		space.solid_setNot(pillar);
+		CHECK(!support.isAnchored(block));
+		CHECK(!support.isAnchored(block2));
+		CHECK(support.isAnchored(Point3D::create(5, 5, 0)));
+		CHECK(support.maybeFallVolume() != 0);
+		support.doStep(area);
+		CHECK(!space.solid_isAny(block));
+		CHECK(!space.solid_isAny(block2));
+		CHECK(space.solid_get(pillar) == marble);
+		CHECK(space.solid_get(block2.below()) == marble);
+		CHECK(support.isAnchored(block2.below()));
+		CHECK(support.maybeFallVolume() == 0);
+	}
 }
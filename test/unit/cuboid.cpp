@@ -1,5 +1,9 @@
 #include "../../lib/doctest.h"
+#include "../../engine/config/config.h"
 #include "../../engine/geometry/cuboid.h"
+#include "../../engine/geometry/cuboidArray.h"
+#include "../../engine/geometry/sphere.h"
+#include "../../engine/dataStructures/rtreeBoolean.h"
 #include "../../engine/area/area.h"
 #include "../../engine/space/space.h"
 #include "../../engine/items/items.h"
@@ -7,6 +11,18 @@
 #include "../../engine/plants.h"
 #include "../../engine/simulation/simulation.h"
 #include "../../engine/simulation/hasAreas.h"
+namespace
+{
+	// Restores a Config value when the scope exits, so a failing REQUIRE does not leak the change into later tests.
+	template<typename T>
+	struct ScopedConfig
+	{
+		T& m_value;
+		T m_previous;
+		ScopedConfig(T& value, const T& override) : m_value(value), m_previous(value) { m_value = override; }
+		~ScopedConfig() { m_value = m_previous; }
+	};
+}
 TEST_CASE("cuboid")
 {
 	Simulation simulation;
@@ -46,4 +62,94 @@ TEST_CASE("cuboid")
 		CHECK(children.containsAny([](const Cuboid& cuboid) { return cuboid.volume() == 2; }));
 		CHECK(children.containsAny([](const Cuboid& cuboid) { return cuboid.volume() == 1; }));
 	}
+	SUBCASE("intersection bits match intersection mask")
+	{
+		CuboidArray<64> cuboids;
+		for(int i = 0; i < 60; ++i)
+		{
+			const Point3D low = Point3D::create(i % 7, (i * 3) % 11, (i * 5) % 13);
+			cuboids.insert(i, Cuboid(Point3D::create(low.x().get() + i % 3, low.y().get() + i % 4, low.z().get() + i % 2), low));
+		}
+		for(int x = 0; x < 12; ++x)
+			for(int y = 0; y < 14; ++y)
+			{
+				const Point3D point = Point3D::create(x, y, (x + y) % 15);
+				CHECK(cuboids.intersectionBits(point) == BitSet64::create(cuboids.indicesOfIntersectingCuboids(point)).data);
+				const Cuboid cuboid(Point3D::create(x + 1, y + 2, 14), point);
+				CHECK(cuboids.intersectionBits(cuboid) == BitSet64::create(cuboids.indicesOfIntersectingCuboids(cuboid)).data);
+			}
+	}
+	SUBCASE("rtree batch query matches single queries")
+	{
+		RTreeBoolean rtree;
+		// Enough leaves to require several levels of nodes.
+		for(int x = 0; x < 30; ++x)
+			for(int y = 0; y < 30; ++y)
+				if((x + y) % 3 != 0)
+					rtree.maybeInsert(Point3D::create(x * 2, y * 2, 0));
+		SmallSet<Point3D> points;
+		std::vector<Cuboid> cuboids;
+		std::vector<Sphere> spheres;
+		for(int x = 0; x < 60; ++x)
+			for(int y = 0; y < 60; y += 3)
+			{
+				const Point3D point = Point3D::create(x, y, 0);
+				points.insert(point);
+				cuboids.emplace_back(Point3D::create(x, y + 1, 1), point);
+				spheres.emplace_back(point, DistanceFractional::create(0.5f));
+			}
+		const std::vector<bool> pointResults = rtree.batchQuery(points);
+		const std::vector<bool> cuboidResults = rtree.batchQuery(cuboids);
+		const std::vector<bool> sphereResults = rtree.batchQuery(spheres);
+		for(int i = 0; i < (int)points.size(); ++i)
+		{
+			CHECK(pointResults[i] == rtree.query(points[i]));
+			CHECK(cuboidResults[i] == rtree.query(cuboids[i]));
+			CHECK(sphereResults[i] == !rtree.queryGetLeaves(spheres[i]).empty());
+		}
+		int intersections = 0;
+		rtree.batchQueryForEach(cuboids, [&](const Cuboid leaf, const int shapeIndex) { CHECK(leaf.intersects(cuboids[shapeIndex])); ++intersections; });
+		int expected = 0;
+		for(const Cuboid cuboid : cuboids)
+			expected += rtree.queryGetLeaves(cuboid).size();
+		CHECK(intersections == expected);
+	}
+	SUBCASE("incremental prepare")
+	{
+		RTreeBoolean rtree;
+		for(int x = 0; x < 40; ++x)
+			for(int y = 0; y < 40; ++y)
+				rtree.maybeInsert(Point3D::create(x * 2, y * 2, 0));
+		rtree.prepare();
+		const RTreeMetrics before = rtree.getMetrics();
+		CHECK(before.leafCount == 1600);
+		CHECK(before.depth > 1);
+		CHECK(before.emptySlots == 0);
+		CHECK(before.unsortedNodes == 0);
+		// Removing most leaves leaves many nodes to comb and slots to defragment.
+		rtree.maybeRemove(Cuboid(Point3D::create(79, 69, 0), Point3D::create(0, 0, 0)));
+		// Small budgets so the work is spread over several calls.
+		ScopedConfig combBudget(Config::rtreeCombBudget, 1);
+		ScopedConfig defragmentBudget(Config::rtreeDefragmentBudget, 1);
+		rtree.prepareIncremental();
+		int calls = 1;
+		// Not fully prepared after the first call.
+		CHECK(rtree.canPrepare());
+		while(rtree.canPrepare())
+		{
+			rtree.prepareIncremental();
+			++calls;
+			CHECK(calls < 1000);
+			if(calls == 1000)
+				break;
+		}
+		CHECK(calls > 1);
+		const RTreeMetrics after = rtree.getMetrics();
+		CHECK(after.leafCount == 200);
+		CHECK(after.emptySlots == 0);
+		CHECK(after.toComb == 0);
+		CHECK(after.fillFactor > 0.f);
+		CHECK(rtree.query(Point3D::create(0, 70, 0)));
+		CHECK(!rtree.query(Point3D::create(0, 68, 0)));
+	}
 }
\ No newline at end of file
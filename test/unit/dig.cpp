@@ -17,6 +17,7 @@
 #include "../../engine/plants.h"
 #include "../../engine/numericTypes/types.h"
 #include "../../engine/definitions/animalSpecies.h"
+#include <vector>
 TEST_CASE("dig")
 {
 	static MaterialTypeId dirt = MaterialType::byName("dirt");
@@ -76,6 +77,44 @@ TEST_CASE("dig")
 		CHECK(!actors.canPickUp_isCarryingItem(dwarf1, pick));
 		CHECK(!items.reservable_hasAnyReservations(pick));
 	}
+	SUBCASE("job board matches idle actors by distance up to each site's capacity")
+	{
+		const ObjectiveTypeId digId = digObjectiveType.getId();
+		Point3D holeLocation = Point3D::create(8, 4, 3);
+		area.m_hasDigDesignations.designate(faction, holeLocation, PointFeatureTypeId::Null);
+		std::vector<ActorIndex> nearDwarves;
+		for(int x = 5; x != 8; ++x)
+			nearDwarves.push_back(actors.create({
+				.species=dwarf,
+				.location=Point3D::create(x, 4, 4),
+				.faction=faction,
+			}));
+		REQUIRE(nearDwarves.size() == (size_t)digObjectiveType.getActorsPerJobSite());
+		// Actors becoming idle during a step wait for the end of the step.
+		area.m_hasJobs.beginStep();
+		// dwarf1 is the farthest but becomes idle first.
+		actors.objective_setPriority(dwarf1, digId, Priority::create(100));
+		for(const ActorIndex nearDwarf : nearDwarves)
+			actors.objective_setPriority(nearDwarf, digId, Priority::create(100));
+		CHECK(area.m_hasJobs.waitingCount() == 4);
+		CHECK(!actors.objective_exists(dwarf1));
+		area.m_hasJobs.doStep(area);
+		CHECK(area.m_hasJobs.waitingCount() == 0);
+		for(const ActorIndex nearDwarf : nearDwarves)
+			CHECK(actors.objective_getCurrentName(nearDwarf) == "dig");
+		CHECK(actors.objective_exists(dwarf1));
+		CHECK(actors.objective_getCurrentName(dwarf1) != "dig");
+	}
+	SUBCASE("job board skips objective types without job sites")
+	{
+		const ObjectiveTypeId digId = digObjectiveType.getId();
+		Point3D holeLocation = Point3D::create(8, 4, 3);
+		area.m_hasDigDesignations.designate(faction, holeLocation, PointFeatureTypeId::Null);
+		// As DigProject::onDelay does, the project remains but it has no job site.
+		area.m_spaceDesignations.getForFaction(faction).maybeUnset(holeLocation, SpaceDesignation::Dig);
+		actors.objective_setPriority(dwarf1, digId, Priority::create(100));
+		CHECK(actors.objective_getCurrentName(dwarf1) != "dig");
+	}
 	SUBCASE("dig stairs and tunnel")
 	{
 		Point3D aboveStairs = Point3D::create(8, 4, 4);
@@ -21,33 +21,34 @@ TEST_CASE("eventSchedule")
 	{
 		std::unique_ptr<ScheduledEvent> event = std::make_unique<TestEvent>(Step::create(10), fired, simulation);
 		simulation.m_eventSchedule.schedule(std::move(event));
-		CHECK(simulation.m_eventSchedule.m_data.contains(Step::create(11)));
-		CHECK(simulation.m_eventSchedule.m_data.at(Step::create(11)).size() == 1);
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(11)) != 0);
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(11)) == 1);
 		CHECK(!fired);
 		simulation.m_eventSchedule.doStep(Step::create(11));
 		CHECK(fired);
 		fired = false;
-		CHECK(simulation.m_eventSchedule.m_data.size() == 1);
+		CHECK(simulation.m_eventSchedule.count() == 1);
 		event = std::make_unique<TestEvent>(Step::create(10), fired, simulation);
 		auto eventPtr = event.get();
 		simulation.m_eventSchedule.schedule(std::move(event));
-		CHECK(simulation.m_eventSchedule.m_data.contains(Step::create(11)));
-		CHECK(simulation.m_eventSchedule.m_data.at(Step::create(11)).size() == 1);
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(11)) != 0);
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(11)) == 1);
 		simulation.doStep();
 		CHECK(eventPtr->percentComplete(simulation) == 10);
 		eventPtr->cancel(simulation, nullptr);
-		CHECK(eventPtr->m_cancel);
+		// Cancelled events are destroyed immediately.
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(11)) == 0);
 		CHECK(!fired);
 		simulation.m_eventSchedule.doStep(Step::create(11));
 		CHECK(!fired);
-		CHECK(simulation.m_eventSchedule.m_data.size() == 1);
+		CHECK(simulation.m_eventSchedule.count() == 1);
 	}
 	SUBCASE("raii fires")
 	{
 		HasScheduledEvent<TestEvent> holder(simulation.m_eventSchedule);
 		holder.schedule(Step::create(10), fired, simulation, &holder);
-		CHECK(simulation.m_eventSchedule.m_data.contains(Step::create(11)));
-		CHECK(simulation.m_eventSchedule.m_data.at(Step::create(11)).size() == 1);
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(11)) != 0);
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(11)) == 1);
 		CHECK(!fired);
 		simulation.m_eventSchedule.doStep(Step::create(11));
 		CHECK(fired);
@@ -57,8 +58,8 @@ TEST_CASE("eventSchedule")
 		{
 			HasScheduledEvent<TestEvent> holder(simulation.m_eventSchedule);
 			holder.schedule(Step::create(10), fired, simulation, &holder);
-			CHECK(simulation.m_eventSchedule.m_data.contains(Step::create(11)));
-			CHECK(simulation.m_eventSchedule.m_data.at(Step::create(11)).size() == 1);
+			CHECK(simulation.m_eventSchedule.countForStep(Step::create(11)) != 0);
+			CHECK(simulation.m_eventSchedule.countForStep(Step::create(11)) == 1);
 		}
 		CHECK(!fired);
 		simulation.m_eventSchedule.doStep(Step::create(11));
@@ -69,8 +70,8 @@ TEST_CASE("eventSchedule")
 		HasScheduledEventPausable<TestEvent> holder(simulation.m_eventSchedule);
 		holder.resume(Step::create(10), fired, simulation, &holder);
 		CHECK(holder.duration() == 10);
-		CHECK(simulation.m_eventSchedule.m_data.contains(Step::create(11)));
-		CHECK(simulation.m_eventSchedule.m_data.at(Step::create(11)).size() == 1);
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(11)) != 0);
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(11)) == 1);
 		CHECK(!fired);
 		CHECK(holder.elapsedSteps() == 0);
 		CHECK(!holder.isPaused());
@@ -80,15 +81,15 @@ TEST_CASE("eventSchedule")
 		CHECK(holder.percentComplete() == 10);
 		CHECK(holder.exists());
 		holder.pause();
-		CHECK(simulation.m_eventSchedule.m_data.at(Step::create(11)).front()->m_cancel == true);
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(11)) == 0);
 		CHECK(holder.getStoredElapsedSteps() == 1);
 		CHECK(holder.isPaused());
 		CHECK(!holder.exists());
 		simulation.doStep();
 		holder.resume(Step::create(10), fired, simulation, &holder);
 		CHECK(holder.duration() == 9);
-		CHECK(simulation.m_eventSchedule.m_data.contains(Step::create(12)));
-		CHECK(simulation.m_eventSchedule.m_data.at(Step::create(12)).size() == 1);
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(12)) != 0);
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(12)) == 1);
 		CHECK(!fired);
 		CHECK(holder.elapsedSteps() == 0);
 		CHECK(holder.getStoredElapsedSteps() == 1);
@@ -121,4 +122,56 @@ TEST_CASE("eventSchedule")
 		CHECK(fired);
 		CHECK(!holder.exists());
 	}
-}
+	SUBCASE("far future")
+	{
+		// Events may not be skipped over.
+		simulation.m_hourlyEvent.unschedule();
+		bool firedLater = false;
+		bool firedMuchLater = false;
+		const Step later = simulation.m_step + 5'000;
+		const Step muchLater = simulation.m_step + 5'000'000;
+		simulation.m_eventSchedule.schedule(std::make_unique<TestEvent>(Step::create(5'000), firedLater, simulation));
+		simulation.m_eventSchedule.schedule(std::make_unique<TestEvent>(Step::create(5'000'000), firedMuchLater, simulation));
+		CHECK(simulation.m_eventSchedule.countForStep(later) == 1);
+		CHECK(simulation.m_eventSchedule.countForStep(muchLater) == 1);
+		simulation.m_eventSchedule.doStep(later - 1);
+		CHECK(!firedLater);
+		CHECK(simulation.m_eventSchedule.getNextEventStep() == later);
+		simulation.m_eventSchedule.doStep(later);
+		CHECK(firedLater);
+		simulation.m_eventSchedule.doStep(muchLater - 1);
+		CHECK(!firedMuchLater);
+		CHECK(simulation.m_eventSchedule.getNextEventStep() == muchLater);
+		simulation.m_eventSchedule.doStep(muchLater);
+		CHECK(firedMuchLater);
+	}
+	SUBCASE("update step")
+	{
+		HasScheduledEvent<TestEvent> holder(simulation.m_eventSchedule);
+		holder.schedule(Step::create(5'000), fired, simulation, &holder);
+		holder.updateStep(Step::create(20));
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(5'001)) == 0);
+		CHECK(simulation.m_eventSchedule.countForStep(Step::create(20)) == 1);
+		simulation.m_eventSchedule.doStep(Step::create(20));
+		CHECK(fired);
+		CHECK(!holder.exists());
+	}
+	SUBCASE("pooled memory is reused")
+	{
+		const SizeClassPool& pool = simulation.m_eventSchedule.getPool();
+		const int liveCount = pool.getLiveCount();
+		HasScheduledEvent<TestEvent> holder(simulation.m_eventSchedule);
+		holder.schedule(Step::create(10), fired, simulation, &holder);
+		CHECK(pool.getLiveCount() == liveCount + 1);
+		const ScheduledEvent* first = holder.getEvent();
+		const uint64_t heapAllocationCount = pool.getHeapAllocationCount();
+		simulation.m_eventSchedule.doStep(Step::create(11));
+		CHECK(fired);
+		CHECK(pool.getLiveCount() == liveCount);
+		holder.schedule(Step::create(10), fired, simulation, &holder);
+		CHECK(holder.getEvent() == first);
+		CHECK(pool.getHeapAllocationCount() == heapAllocationCount);
+		holder.unschedule();
+		CHECK(pool.getLiveCount() == liveCount);
+	}
+}
\ No newline at end of file
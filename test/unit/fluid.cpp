@@ -117,6 +117,29 @@ TEST_CASE("fluidsSmaller")
 		CHECK(area.m_hasFluidGroups.m_groups.size() == 1);
 		CHECK(fluidGroup->m_stable);
 	}
+	SUBCASE("Separate groups flow independently")
+	{
+		areaBuilderUtil::setSolidLayers(area, 0, 2, marble);
+		Point3D destination1 = Point3D::create(2, 2, 1);
+		Point3D origin1 = Point3D::create(2, 2, 2);
+		Point3D destination2 = Point3D::create(7, 7, 1);
+		Point3D origin2 = Point3D::create(7, 7, 2);
+		for(Point3D point : {destination1, origin1, destination2, origin2})
+			space.solid_setNot(point);
+		space.fluid_add(origin1.toSet(), Config::maxPointVolume.get(), water);
+		space.fluid_add(origin2.toSet(), Config::maxPointVolume.get(), water);
+		CHECK(area.m_hasFluidGroups.m_groups.size() == 2);
+		area.m_hasFluidGroups.findIndependent();
+		CHECK(area.m_hasFluidGroups.m_independent.size() == 2);
+		simulation.doStep();
+		CHECK(area.m_hasFluidGroups.m_groups.size() == 2);
+		CHECK(space.fluid_volumeOfTypeContains(destination1, water) == Config::maxPointVolume);
+		CHECK(space.fluid_volumeOfTypeContains(destination2, water) == Config::maxPointVolume);
+		CHECK(!space.fluid_any(origin1));
+		CHECK(!space.fluid_any(origin2));
+		simulation.doStep();
+		CHECK(!area.m_hasFluidGroups.hasUnstable());
+	}
 	SUBCASE("Flow across area and then fill hole")
 	{
 		// Spread into square of volume 9 at first step. At second fill hole at point5.
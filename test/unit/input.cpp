@@ -0,0 +1,99 @@
+#include "../../lib/doctest.h"
+#include "../../engine/input.h"
+#include "../../engine/actors/actors.h"
+#include "../../engine/area/area.h"
+#include "../../engine/areaBuilderUtil.h"
+#include "../../engine/definitions/animalSpecies.h"
+#include "../../engine/simulation/simulation.h"
+#include "../../engine/simulation/hasActors.h"
+#include "../../engine/simulation/hasAreas.h"
+#include "../../engine/simulation/snapshot.h"
+#include "../../engine/space/space.h"
+#include <thread>
+#include <vector>
+TEST_CASE("input")
+{
+	static MaterialTypeId dirt = MaterialType::byName("dirt");
+	static AnimalSpeciesId dwarf = AnimalSpecies::byName("dwarf");
+	Simulation simulation;
+	Area& area = simulation.m_hasAreas->createArea(10,10,10);
+	area.m_hasRain.disable();
+	Space& space = area.getSpace();
+	Actors& actors = area.getActors();
+	areaBuilderUtil::setSolidLayers(area, 0, 3, dirt);
+	FactionId faction = simulation.createFaction("Tower of Power");
+	area.m_spaceDesignations.registerFaction(faction);
+	SUBCASE("actions inserted from several threads are applied after the step")
+	{
+		const size_t initialCount = actors.size();
+		std::vector<std::thread> threads;
+		for(int x = 1; x != 9; ++x)
+			threads.emplace_back([&, x]{
+				for(int y = 1; y != 9; ++y)
+					simulation.m_inputQueue.insert(std::make_unique<CreateActorInputAction>(area.m_id, ActorParamaters{
+						.species=dwarf,
+						.location=Point3D::create(x, y, 4),
+						.faction=faction,
+					}));
+			});
+		for(std::thread& thread : threads)
+			thread.join();
+		CHECK(actors.size() == initialCount);
+		const Step step = simulation.m_step;
+		simulation.doStep();
+		CHECK(actors.size() == initialCount + 64);
+		CHECK(simulation.m_publishedStep.load() == step);
+		CHECK(simulation.m_inputQueue.empty());
+	}
+	SUBCASE("published snapshots do not change after later steps")
+	{
+		CHECK(simulation.getSnapshot() == nullptr);
+		simulation.setSnapshotFrequency(Step::create(1));
+		const Step step = simulation.m_step;
+		simulation.doStep();
+		const std::shared_ptr<const SimulationSnapshot> snapshot = simulation.getSnapshot();
+		REQUIRE(snapshot != nullptr);
+		CHECK(snapshot->step == step);
+		const Point3D point = Point3D::create(5, 5, 3);
+		CHECK(snapshot->getArea(area.m_id).space.solid.queryGetOne(point) == dirt);
+		space.solid_setNot(point);
+		simulation.doStep();
+		CHECK(simulation.getSnapshot()->step == step + 1);
+		CHECK(simulation.getSnapshot()->getArea(area.m_id).space.solid.queryGetOne(point).empty());
+		// A reader still holding the earlier snapshot sees the world as it was.
+		CHECK(snapshot->getArea(area.m_id).space.solid.queryGetOne(point) == dirt);
+	}
+	SUBCASE("set priority and designate")
+	{
+		ActorIndex dwarf1 = actors.create({
+			.species=dwarf,
+			.location=Point3D::create(1, 1, 4),
+			.faction=faction,
+		});
+		const ObjectiveTypeId dig = ObjectiveType::getIdByName("dig");
+		const Point3D holeLocation = Point3D::create(8, 4, 3);
+		simulation.m_inputQueue.insert(std::make_unique<DigDesignateInputAction>(area.m_id, faction, Cuboid::create(holeLocation), PointFeatureTypeId::Null));
+		simulation.m_inputQueue.insert(std::make_unique<ObjectiveTypeSetPriorityInputAction>(actors.getId(dwarf1), dig, Priority::create(100)));
+		CHECK(!space.designation_has(holeLocation, faction, SpaceDesignation::Dig));
+		simulation.doStep();
+		CHECK(space.designation_has(holeLocation, faction, SpaceDesignation::Dig));
+		CHECK(area.m_hasDigDesignations.contains(faction, holeLocation));
+		CHECK(actors.objective_getPriorityFor(dwarf1, dig) == 100);
+		// Designating again is skipped rather than designating twice.
+		simulation.m_inputQueue.insert(std::make_unique<DigDesignateInputAction>(area.m_id, faction, Cuboid::create(holeLocation), PointFeatureTypeId::Null));
+		simulation.doStep();
+		CHECK(area.m_hasDigDesignations.contains(faction, holeLocation));
+	}
+	SUBCASE("actions for an actor which no longer exists do nothing")
+	{
+		ActorIndex dwarf1 = actors.create({
+			.species=dwarf,
+			.location=Point3D::create(1, 1, 4),
+			.faction=faction,
+		});
+		simulation.m_inputQueue.insert(std::make_unique<ObjectiveTypeSetPriorityInputAction>(actors.getId(dwarf1), ObjectiveType::getIdByName("dig"), Priority::create(100)));
+		actors.destroy(dwarf1);
+		simulation.doStep();
+		CHECK(simulation.m_inputQueue.empty());
+	}
+}
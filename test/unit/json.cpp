@@ -19,6 +19,11 @@
 #include "../../engine/objectives/construct.h"
 #include "../../engine/objectives/stockpile.h"
 #include "../../engine/numericTypes/types.h"
+#include "../../engine/binaryArchive.h"
+#include "../../engine/dataStructures/rtreeBoolean.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 TEST_CASE("json")
 {
 	Simulation simulation{"", DateTime(12, 50, 1000).toSteps()};
@@ -113,7 +118,7 @@ TEST_CASE("json")
 		CHECK(plants2.getStepAtWhichPlantWillDieFromLackOfFluid(sage2) != 0);
 		CHECK(plants2.getStepAtWhichPlantWillDieFromLackOfFluid(sage2).exists());
 		CHECK(plants2.fluidEventExists(sage2));
-		CHECK(!plants2.growthEventExists(sage2));
+		CHECK(!plants2.isGrowing(sage2));
 		// Fluid.
 		Point3D waterLocation = Point3D::create(3,8,1);
 		CHECK(space2.fluid_getTotalVolume(waterLocation) == 10);
@@ -182,6 +187,141 @@ TEST_CASE("json")
 		// OpacityFacade.
 		area2.m_opacityFacade.validate(area);
 	}
+	SUBCASE("binary")
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path()/"jsonTestArea.area";
+		Json simulationData;
+		{
+			space.plant_create(Point3D::create(8, 8, 1), sage, Percent::create(99));
+			space.pointFeature_construct(Point3D::create(1, 8, 1), PointFeatureTypeId::Stairs, wood);
+			items.create(ItemParamaters{.itemType = axe, .materialType = bronze, .location = Point3D::create(1, 2, 1), .quality = Quality::create(10), .percentWear = Percent::create(10)});
+			simulation.m_hasAreas->saveAreaBinary(area, path);
+			simulationData = simulation.toJson();
+		}
+		Simulation simulation2(simulationData);
+		Area& area2 = simulation2.m_hasAreas->loadAreaFromBinary(path, simulation2.getDeserializationMemo());
+		std::filesystem::remove(path);
+		Space& space2 = area2.getSpace();
+		CHECK(space2.m_sizeX == 10);
+		CHECK(space2.solid_get(Point3D::create(5,5,0)) == dirt);
+		CHECK(!space2.solid_isAny(Point3D::create(5,5,1)));
+		CHECK(space2.getSolid().nodeCount() == 1);
+		CHECK(space2.pointFeature_contains(Point3D::create(1,8,1), PointFeatureTypeId::Stairs));
+		CHECK(space2.plant_exists(Point3D::create(8,8,1)));
+		CHECK(area2.getPlants().getSpecies(space2.plant_get(Point3D::create(8,8,1))) == sage);
+		CHECK(!space2.item_empty(Point3D::create(1,2,1)));
+		area2.m_opacityFacade.validate(area);
+	}
+	SUBCASE("damaged binary")
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path()/"jsonTestDamagedArea.area";
+		simulation.m_hasAreas->saveAreaBinary(area, path);
+		CHECK_THROWS_AS(BinaryArchiveReader(path, binaryArchive::areaDeltaMagic), BinaryArchiveError);
+		// Truncated after the header and checkpoint, inside the json block.
+		std::filesystem::resize_file(path, sizeof(uint32_t) * 3 + sizeof(StepWidth));
+		Simulation simulation2(simulation.toJson());
+		CHECK_THROWS_AS(simulation2.m_hasAreas->loadAreaFromBinary(path, simulation2.getDeserializationMemo()), BinaryArchiveError);
+		std::filesystem::remove(path);
+		CHECK_THROWS_AS(BinaryArchiveReader(path, binaryArchive::areaMagic), BinaryArchiveError);
+	}
+	SUBCASE("damaged R-tree node count")
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path()/"jsonTestDamagedRTree.bin";
+		RTreeBoolean rtree;
+		rtree.maybeInsert(Point3D::create(1, 1, 1));
+		{
+			BinaryArchiveWriter writer(path, binaryArchive::areaMagic);
+			rtree.writeBinary(writer);
+			(void)writer.close();
+		}
+		// The node count directly follows the header.
+		const auto setNodeCount = [&](const uint64_t count)
+		{
+			std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+			file.seekp(sizeof(uint32_t) * 3);
+			file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+		};
+		// Far more nodes then the file holds, rejected before allocating.
+		setNodeCount(UINT64_MAX / 2);
+		{
+			BinaryArchiveReader reader(path, binaryArchive::areaMagic);
+			RTreeBoolean loaded;
+			CHECK_THROWS_AS(loaded.loadBinary(reader), BinaryArchiveError);
+		}
+		setNodeCount(0);
+		{
+			BinaryArchiveReader reader(path, binaryArchive::areaMagic);
+			RTreeBoolean loaded;
+			CHECK_THROWS_AS(loaded.loadBinary(reader), BinaryArchiveError);
+		}
+		std::filesystem::remove(path);
+	}
+	SUBCASE("autosave")
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path()/"jsonTestAutosave";
+		std::filesystem::remove_all(path);
+		simulation.m_path = path;
+		space.pointFeature_construct(Point3D::create(1, 8, 1), PointFeatureTypeId::Stairs, wood);
+		simulation.m_autosave.begin(simulation);
+		// Changes made while writing are not part of the autosave.
+		space.solid_set(Point3D::create(5, 5, 1), dirt, false);
+		simulation.m_autosave.wait();
+		CHECK(!simulation.m_autosave.isWriting());
+		CHECK(simulation.m_autosave.getLastBytesWritten() != 0);
+		CHECK(simulation.m_autosave.getLastStep() == simulation.m_step);
+		CHECK(!std::filesystem::exists(path/"simulation.json.tmp"));
+		CHECK(simulation.m_autosave.getLastError().empty());
+		const std::filesystem::path basePath = SimulationHasAreas::getAreaPath(path/"area", area.m_id, space.delta_getFileGeneration());
+		CHECK(std::filesystem::exists(basePath));
+		{
+			Simulation simulation2(path);
+			Area& area2 = simulation2.m_hasAreas->getById(area.m_id);
+			Space& space2 = area2.getSpace();
+			CHECK(space2.solid_get(Point3D::create(5,5,0)) == dirt);
+			CHECK(!space2.solid_isAny(Point3D::create(5,5,1)));
+			CHECK(space2.pointFeature_contains(Point3D::create(1,8,1), PointFeatureTypeId::Stairs));
+		}
+		// The first autosave was full, the second only writes changes made since.
+		CHECK(space.delta_isTracking());
+		space.pointFeature_remove(Point3D::create(1, 8, 1), PointFeatureTypeId::Stairs);
+		simulation.m_autosave.begin(simulation);
+		simulation.m_autosave.wait();
+		const std::filesystem::path deltaPath = SimulationHasAreas::getAreaDeltaPath(basePath, 1);
+		CHECK(std::filesystem::exists(deltaPath));
+		CHECK(space.delta_getCount() == 1);
+		{
+			Simulation simulation3(path);
+			Space& space3 = simulation3.m_hasAreas->getById(area.m_id).getSpace();
+			CHECK(space3.solid_get(Point3D::create(5,5,1)) == dirt);
+			CHECK(!space3.pointFeature_contains(Point3D::create(1,8,1), PointFeatureTypeId::Stairs));
+		}
+		// A failed autosave leaves the previous generation in place and is recorded rather then thrown. The area directory can't be created under a file.
+		space.pointFeature_construct(Point3D::create(1, 8, 1), PointFeatureTypeId::Stairs, wood);
+		simulation.m_path = path/"simulation.json";
+		simulation.m_autosave.begin(simulation);
+		simulation.m_autosave.wait();
+		CHECK(!simulation.m_autosave.getLastError().empty());
+		CHECK(simulation.m_autosave.getLastBytesWritten() == 0);
+		simulation.m_path = path;
+		{
+			Simulation simulation4(path);
+			CHECK(!simulation4.m_hasAreas->getById(area.m_id).getSpace().pointFeature_contains(Point3D::create(1,8,1), PointFeatureTypeId::Stairs));
+		}
+		// The changes taken for the failed delta are gone, so the next autosave is full.
+		simulation.m_autosave.begin(simulation);
+		CHECK(space.delta_getCount() == 0);
+		simulation.m_autosave.wait();
+		CHECK(simulation.m_autosave.getLastError().empty());
+		{
+			Simulation simulation5(path);
+			CHECK(simulation5.m_hasAreas->getById(area.m_id).getSpace().pointFeature_contains(Point3D::create(1,8,1), PointFeatureTypeId::Stairs));
+		}
+		// A full save removes the deltas.
+		simulation.save();
+		CHECK(!std::filesystem::exists(deltaPath));
+		CHECK(space.delta_getCount() == 0);
+		std::filesystem::remove_all(path);
+	}
 	SUBCASE("dig project")
 	{
 		Json areaData;
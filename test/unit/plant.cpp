@@ -26,8 +26,11 @@ TEST_CASE("plant")
 	space.plant_create(location, wheatGrass, Percent::create(50));
 	PlantIndex plant = space.plant_get(location);
 	CHECK(plants.isGrowing(plant));
-	CHECK(area.m_eventSchedule.m_data.contains(PlantSpecies::getStepsTillFullyGrown(wheatGrass) / 2));
-	CHECK(area.m_eventSchedule.m_data.contains(PlantSpecies::getStepsNeedsFluidFrequency(wheatGrass)));
+	// Growth and fluid checks are handled by the cohort pass rather then by events.
+	CHECK(plants.getStepOfNextFluidCheck(plant) == PlantSpecies::getStepsNeedsFluidFrequency(wheatGrass));
+	CHECK(plants.getCohortStep(plant) <= PlantSpecies::getStepsNeedsFluidFrequency(wheatGrass));
+	CHECK(plants.getCohortStep(plant).modulusIsZero(Config::plantCohortInterval));
+	CHECK(plants.getNextCohortStep() == plants.getCohortStep(plant));
 	CHECK(space.isExposedToSky(plants.getLocation(plant)));
 	CHECK(!plants.temperatureEventExists(plant));
 	CHECK(plants.isOnSurface(plant));
@@ -35,10 +38,14 @@ TEST_CASE("plant")
 	CHECK(plants.getVolumeFluidRequested(plant) != 0);
 	CHECK(!plants.isGrowing(plant));
 	CHECK(plants.getPercentGrown(plant) == 50 + ((float)simulation.m_step.get() / (float)PlantSpecies::getStepsTillFullyGrown(wheatGrass).get()) * 100);
-	CHECK(area.m_eventSchedule.m_data.contains(simulation.m_step + PlantSpecies::getStepsTillDieWithoutFluid(wheatGrass) - 1));
+	CHECK(area.m_eventSchedule.countForStep(simulation.m_step + PlantSpecies::getStepsTillDieWithoutFluid(wheatGrass) - 1) != 0);
+	CHECK(plants.fluidEventExists(plant));
+	CHECK(plants.getStepOfNextFluidCheck(plant).empty());
 	area.m_hasRain.start(water, Percent::create(1), Step::create(100));
 	CHECK(plants.getVolumeFluidRequested(plant) == 0);
 	CHECK(plants.isGrowing(plant));
+	CHECK(!plants.fluidEventExists(plant));
+	CHECK(plants.getStepOfNextFluidCheck(plant).exists());
 	area.m_hasTemperature.setAmbient(area, PlantSpecies::getMinimumGrowingTemperature(wheatGrass) - 1);
 	CHECK(!plants.isGrowing(plant));
 	CHECK(plants.temperatureEventExists(plant));
@@ -55,6 +62,33 @@ TEST_CASE("plant")
 	CHECK(plants.isGrowing(plant));
 	plants.die(plant);
 }
+TEST_CASE("plantCohortGrowth")
+{
+	static MaterialTypeId dirt = MaterialType::byName("dirt");
+	static PlantSpeciesId wheatGrass = PlantSpecies::byName("wheat grass");
+	Simulation simulation("test", DateTime::toSteps(12, 100, 1200));
+	Area& area = simulation.m_hasAreas->createArea(10,10,10);
+	area.m_hasRain.disable();
+	Space& space = area.getSpace();
+	Plants& plants = area.getPlants();
+	areaBuilderUtil::setSolidLayer(area, 1, dirt);
+	Point3D location = Point3D::create(5, 5, 2);
+	space.plant_create(location, wheatGrass, Percent::create(99));
+	PlantIndex plant = space.plant_get(location);
+	CHECK(plants.isGrowing(plant));
+	Step remaining = PlantSpecies::getStepsTillFullyGrown(wheatGrass) / 100;
+	CHECK(remaining < PlantSpecies::getStepsNeedsFluidFrequency(wheatGrass));
+	simulation.fastForward(remaining / 2);
+	CHECK(plants.getPercentGrown(plant) == 99);
+	CHECK(plants.isGrowing(plant));
+	// Completion is applied by the first cohort pass after growth finishes.
+	simulation.fastForward(remaining / 2 + Config::plantCohortInterval);
+	CHECK(!plants.isGrowing(plant));
+	CHECK(plants.getPercentGrown(plant) == 100);
+	CHECK(plants.getShape(plant) == PlantSpecies::getShapes(wheatGrass).back());
+	CHECK(plants.getStepOfNextFluidCheck(plant).exists());
+	CHECK(plants.getNextCohortStep() == plants.getCohortStep(plant));
+}
 TEST_CASE("plantFruits")
 {
 	static MaterialTypeId dirt = MaterialType::byName("dirt");
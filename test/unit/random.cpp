@@ -0,0 +1,59 @@
+#include "../../lib/doctest.h"
+#include "../../engine/random.h"
+TEST_CASE("randomStream")
+{
+	SUBCASE("philox known answers")
+	{
+		// From the Random123 philox4x32-10 known answer tests.
+		CHECK(RandomStream::philox({0, 0, 0, 0}, {0, 0}) == std::array<uint32_t, 4>{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+		CHECK(RandomStream::philox({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}) == std::array<uint32_t, 4>{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+		CHECK(RandomStream::philox({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}) == std::array<uint32_t, 4>{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1});
+	}
+	SUBCASE("streams are reproducible and independent")
+	{
+		const auto draw = [](const uint32_t seed, const Step step, const uint32_t entity)
+		{
+			RandomStream stream(seed, step, entity, RandomPurpose::CourageTest);
+			std::vector<uint32_t> output;
+			for(int i = 0; i != 10; ++i)
+				output.push_back(stream.next());
+			return output;
+		};
+		CHECK(draw(1, Step::create(5), 7) == draw(1, Step::create(5), 7));
+		CHECK(draw(1, Step::create(5), 7) != draw(1, Step::create(5), 8));
+		CHECK(draw(1, Step::create(5), 7) != draw(1, Step::create(6), 7));
+		CHECK(draw(1, Step::create(5), 7) != draw(2, Step::create(5), 7));
+		// Drawing other streams in between does not change a stream.
+		RandomStream first(1, Step::create(5), 7, RandomPurpose::CourageTest);
+		RandomStream second(1, Step::create(5), 8, RandomPurpose::CourageTest);
+		std::vector<uint32_t> interleaved;
+		for(int i = 0; i != 10; ++i)
+		{
+			interleaved.push_back(first.next());
+			(void)second.next();
+		}
+		CHECK(interleaved == draw(1, Step::create(5), 7));
+	}
+	SUBCASE("ranges")
+	{
+		RandomStream stream(0, Step::create(1), 0, RandomPurpose::CourageTest);
+		std::array<int, 7> counts{};
+		for(int i = 0; i != 7000; ++i)
+		{
+			const int value = stream.getInRange(-3, 3);
+			REQUIRE(value >= -3);
+			REQUIRE(value <= 3);
+			++counts[value + 3];
+		}
+		for(const int count : counts)
+			CHECK(count > 800);
+		for(int i = 0; i != 1000; ++i)
+		{
+			const float value = stream.getInRange(2.f, 4.f);
+			CHECK(value >= 2.f);
+			CHECK(value <= 4.f);
+		}
+		CHECK(stream.percentChance(Percent::create(100)));
+		CHECK(!stream.percentChance(Percent::create(0)));
+	}
+}
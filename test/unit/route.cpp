@@ -3,6 +3,7 @@
 #include "../../engine/areaBuilderUtil.h"
 #include "../../engine/actors/actors.h"
 #include "../../engine/plants.h"
+#include "../../engine/reservable.h"
 #include "../../engine/items/items.h"
 #include "../../engine/definitions/animalSpecies.h"
 #include "../../engine/definitions/materialType.h"
@@ -37,6 +38,76 @@ TEST_CASE("route_10_10_10")
 		simulation.doStep();
 		CHECK(actors.move_getPath(actor).size() == 4);
 	}
+	SUBCASE("Route cache")
+	{
+		areaBuilderUtil::setSolidLayer(area, 0, marble);
+		Point3D origin = Point3D::create(3, 3, 1);
+		Point3D destination = Point3D::create(7, 7, 1);
+		ActorIndex actor = actors.create({
+			.species=dwarf,
+			.location=origin,
+		});
+		const RouteCache& routeCache = area.m_hasPaths.get(area, actors.getMoveType(actor)).m_routeCache;
+		CHECK(routeCache.size() == 0);
+		actors.move_setDestination(actor, destination);
+		simulation.doStep();
+		CHECK(routeCache.size() == 1);
+		CHECK(routeCache.getHitCount() == 0);
+		CHECK(actors.move_getPath(actor).size() == 4);
+		// A second request from the same start cuboid to the same destination is served from the cache.
+		ActorIndex actor2 = actors.create({
+			.species=dwarf,
+			.location=Point3D::create(3, 4, 1),
+		});
+		actors.move_setDestination(actor2, destination);
+		simulation.doStep();
+		CHECK(routeCache.size() == 1);
+		CHECK(routeCache.getHitCount() == 1);
+		CHECK(!actors.move_getPath(actor2).empty());
+		// Changing space on the route invalidates it.
+		const Point3D block = Point3D::create(5, 5, 1);
+		space.solid_set(block, marble, false);
+		CHECK(routeCache.size() == 0);
+		// The next request searches again and routes around the change.
+		ActorIndex actor3 = actors.create({
+			.species=dwarf,
+			.location=Point3D::create(3, 5, 1),
+		});
+		actors.move_setDestination(actor3, destination);
+		simulation.doStep();
+		CHECK(routeCache.getHitCount() == 1);
+		CHECK(!actors.move_getPath(actor3).empty());
+		CHECK(!actors.move_getPath(actor3).contains(block));
+	}
+	SUBCASE("Route cache falls back to search when the destination is reserved")
+	{
+		areaBuilderUtil::setSolidLayer(area, 0, marble);
+		FactionId faction = simulation.createFaction("Tower of Power");
+		Point3D destination = Point3D::create(7, 7, 1);
+		ActorIndex actor = actors.create({
+			.species=dwarf,
+			.location=Point3D::create(3, 3, 1),
+			.faction=faction,
+		});
+		const RouteCache& routeCache = area.m_hasPaths.get(area, actors.getMoveType(actor)).m_routeCache;
+		// Unreserved so the request checks reservations for faction.
+		actors.move_setDestination(actor, destination, false, false, true);
+		simulation.doStep();
+		CHECK(routeCache.size() == 1);
+		CHECK(actors.move_getPath(actor).size() == 4);
+		ActorIndex actor2 = actors.create({
+			.species=dwarf,
+			.location=Point3D::create(3, 4, 1),
+			.faction=faction,
+		});
+		actors.move_setDestination(actor2, destination, false, false, true);
+		// Reserved after the request is made, the cached route ends on a reserved point so it is not used and the fresh search finds nothing.
+		CanReserve canReserve(faction);
+		space.reserve(destination, canReserve);
+		simulation.doStep();
+		CHECK(routeCache.getHitCount() == 0);
+		CHECK(actors.move_getPath(actor2).empty());
+	}
 	SUBCASE("Route around walls")
 	{
 		areaBuilderUtil::setSolidLayer(area, 0, marble);
@@ -87,6 +158,59 @@ TEST_CASE("route_10_10_10")
 		simulation.doStep();
 		CHECK(actors.move_getPath(actor).empty());
 	}
+	SUBCASE("Sealed off destination is ruled out by connectivity")
+	{
+		areaBuilderUtil::setSolidLayers(area, 0, 3, marble);
+		Point3D origin = Point3D::create(3, 3, 1);
+		Point3D middle = Point3D::create(4, 3, 1);
+		Point3D end = Point3D::create(5, 3, 1);
+		Point3D surface = Point3D::create(7, 7, 4);
+		space.solid_setNot(origin);
+		space.solid_setNot(middle);
+		space.solid_setNot(end);
+		ActorIndex actor = actors.create({
+			.species=dwarf,
+			.location=origin,
+		});
+		const Connectivity& connectivity = area.m_hasPaths.get(area, actors.getMoveType(actor)).m_connectivity;
+		CHECK(connectivity.getComponent(origin).exists());
+		CHECK(connectivity.getComponent(origin) == connectivity.getComponent(end));
+		CHECK(connectivity.getComponent(origin) != connectivity.getComponent(surface));
+		actors.move_setDestination(actor, surface);
+		simulation.doStep();
+		CHECK(actors.move_getPath(actor).empty());
+		// Removing space leaves the component over connected untill it is relabeled at the start of the next step.
+		space.solid_set(middle, marble, false);
+		CHECK(connectivity.needsPrepare());
+		CHECK(connectivity.getComponent(origin) == connectivity.getComponent(end));
+		simulation.doStep();
+		CHECK(!connectivity.needsPrepare());
+		CHECK(connectivity.getComponent(origin).exists());
+		CHECK(connectivity.getComponent(origin) != connectivity.getComponent(end));
+		// Reopening joins them again immediately.
+		space.solid_setNot(middle);
+		CHECK(connectivity.getComponent(origin) == connectivity.getComponent(end));
+	}
+	SUBCASE("Removing space which can be walked around keeps the component")
+	{
+		areaBuilderUtil::setSolidLayer(area, 0, marble);
+		Point3D origin = Point3D::create(1, 1, 1);
+		Point3D block = Point3D::create(4, 4, 1);
+		Point3D end = Point3D::create(8, 8, 1);
+		ActorIndex actor = actors.create({
+			.species=dwarf,
+			.location=origin,
+		});
+		const Connectivity& connectivity = area.m_hasPaths.get(area, actors.getMoveType(actor)).m_connectivity;
+		const ConnectivityComponentId component = connectivity.getComponent(origin);
+		space.solid_set(block, marble, false);
+		CHECK(connectivity.needsPrepare());
+		simulation.doStep();
+		CHECK(!connectivity.needsPrepare());
+		CHECK(connectivity.getComponent(block).empty());
+		CHECK(connectivity.getComponent(origin) == component);
+		CHECK(connectivity.getComponent(end) == component);
+	}
 	SUBCASE("Walk")
 	{
 		areaBuilderUtil::setSolidLayer(area, 0, marble);
@@ -123,6 +247,33 @@ TEST_CASE("route_10_10_10")
 		CHECK(actors.move_getPath(actor).empty());
 		CHECK(actors.move_getDestination(actor).empty());
 	}
+	SUBCASE("Walk in a crowd")
+	{
+		areaBuilderUtil::setSolidLayer(area, 0, marble);
+		std::vector<ActorIndex> crowd;
+		for(int y = 0; y != 10; ++y)
+			crowd.push_back(actors.create({
+				.species=dwarf,
+				.location=Point3D::create(1, y, 1),
+			}));
+		for(const ActorIndex actor : crowd)
+			actors.move_setDestination(actor, Point3D::create(8, actors.getLocation(actor).y().get(), 1));
+		simulation.doStep();
+		for(const ActorIndex actor : crowd)
+			CHECK(actors.move_hasEvent(actor));
+		CHECK(actors.move_getNextMoveStep().exists());
+		for(const ActorIndex actor : crowd)
+		{
+			const Point3D destination = actors.move_getDestination(actor);
+			if(destination.exists())
+				simulation.fastForwardUntillActorIsAtDestination(area, actor, destination);
+		}
+		for(int y = 0; y != 10; ++y)
+		{
+			CHECK(actors.getLocation(crowd[y]) == Point3D::create(8, y, 1));
+			CHECK(!actors.move_hasEvent(crowd[y]));
+		}
+	}
 	SUBCASE("Repath when route is blocked")
 	{
 		areaBuilderUtil::setSolidLayer(area, 0, marble);
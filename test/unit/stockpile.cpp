@@ -873,6 +873,80 @@ TEST_CASE("stockpile")
 		CHECK(area.m_hasStockPiles.getForFaction(faction).getStockPileFor(chunk1));
 		CHECK(area.m_hasStockPiles.getForFaction(faction).getItemsWithProjectsCount() == 0);
 	}
+	SUBCASE("item is given a new destination when it's stockpile becomes unavailable or is destroyed")
+	{
+		AreaHasStockPilesForFaction& hasStockPiles = area.m_hasStockPiles.getForFaction(faction);
+		auto& itemsByStockPile = hasStockPiles.getItemsWithDestinationsByStockPile();
+		std::vector<ItemQuery> queries;
+		queries.emplace_back(ItemQuery::create(chunk, wood));
+		StockPile& stockpile1 = hasStockPiles.addStockPile(queries);
+		stockpile1.addPoint(Point3D::create(5, 5, 1));
+		ItemIndex chunk1 = items.create({.itemType=chunk, .materialType=wood, .location=Point3D::create(1, 8, 1), .quantity=Quantity::create(1u)});
+		hasStockPiles.addItem(chunk1);
+		const ItemReference ref = items.getReference(chunk1);
+		CHECK(itemsByStockPile.at(&stockpile1).contains(ref));
+		StockPile& stockpile2 = hasStockPiles.addStockPile(queries);
+		stockpile2.addPoint(Point3D::create(7, 7, 1));
+		// A new stockpile does not take items which already have a destination.
+		CHECK(itemsByStockPile.at(&stockpile1).contains(ref));
+		CHECK(!itemsByStockPile.contains(&stockpile2));
+		// As if the last open point had been filled.
+		stockpile1.decrementOpenPoints();
+		CHECK(!itemsByStockPile.contains(&stockpile1));
+		CHECK(itemsByStockPile.at(&stockpile2).contains(ref));
+		CHECK(hasStockPiles.getItemsWithDestinations().contains(ref));
+		stockpile1.incrementOpenPoints();
+		CHECK(itemsByStockPile.at(&stockpile2).contains(ref));
+		stockpile2.destroy();
+		CHECK(itemsByStockPile.at(&stockpile1).contains(ref));
+		CHECK(itemsByStockPile.size() == 1);
+		CHECK(hasStockPiles.getItemsWithDestinations().contains(ref));
+	}
+	SUBCASE("remove item with a destination")
+	{
+		AreaHasStockPilesForFaction& hasStockPiles = area.m_hasStockPiles.getForFaction(faction);
+		auto& itemsByStockPile = hasStockPiles.getItemsWithDestinationsByStockPile();
+		std::vector<ItemQuery> queries;
+		queries.emplace_back(ItemQuery::create(chunk, wood));
+		StockPile& stockpile = hasStockPiles.addStockPile(queries);
+		stockpile.addPoint(Point3D::create(5, 5, 1));
+		Point3D chunkLocation = Point3D::create(1, 8, 1);
+		ItemIndex chunk1 = items.create({.itemType=chunk, .materialType=wood, .location=chunkLocation, .quantity=Quantity::create(1u)});
+		hasStockPiles.addItem(chunk1);
+		const ItemReference ref = items.getReference(chunk1);
+		CHECK(itemsByStockPile.at(&stockpile).contains(ref));
+		hasStockPiles.removeItem(chunk1);
+		CHECK(!itemsByStockPile.contains(&stockpile));
+		CHECK(!hasStockPiles.getItemsWithDestinations().contains(ref));
+		CHECK(!hasStockPiles.isAnyHaulingAvailable());
+		CHECK(!items.stockpile_canBeStockPiled(chunk1, faction));
+		CHECK(!area.m_spaceDesignations.getForFaction(faction).check(chunkLocation, SpaceDesignation::StockPileHaulFrom));
+		// Adding it again records the same destination.
+		hasStockPiles.addItem(chunk1);
+		CHECK(itemsByStockPile.at(&stockpile).contains(ref));
+		CHECK(hasStockPiles.getItemsWithDestinations().contains(ref));
+	}
+	SUBCASE("remove from items with destination by a stockpile which is not the item's destination")
+	{
+		AreaHasStockPilesForFaction& hasStockPiles = area.m_hasStockPiles.getForFaction(faction);
+		auto& itemsByStockPile = hasStockPiles.getItemsWithDestinationsByStockPile();
+		std::vector<ItemQuery> queries;
+		queries.emplace_back(ItemQuery::create(chunk, wood));
+		StockPile& stockpile1 = hasStockPiles.addStockPile(queries);
+		stockpile1.addPoint(Point3D::create(5, 5, 1));
+		ItemIndex chunk1 = items.create({.itemType=chunk, .materialType=wood, .location=Point3D::create(1, 8, 1), .quantity=Quantity::create(1u)});
+		hasStockPiles.addItem(chunk1);
+		StockPile& stockpile2 = hasStockPiles.addStockPile(queries);
+		stockpile2.addPoint(Point3D::create(7, 7, 1));
+		const ItemReference ref = items.getReference(chunk1);
+		// Does nothing, the item is recorded for stockpile1.
+		hasStockPiles.maybeRemoveFromItemsWithDestinationByStockPile(stockpile2, chunk1);
+		CHECK(itemsByStockPile.at(&stockpile1).contains(ref));
+		CHECK(!itemsByStockPile.contains(&stockpile2));
+		hasStockPiles.maybeRemoveFromItemsWithDestinationByStockPile(stockpile1, chunk1);
+		CHECK(!itemsByStockPile.contains(&stockpile1));
+		CHECK(!itemsByStockPile.contains(&stockpile2));
+	}
 	SUBCASE("some but not all reserved item from stack area destroyed")
 	{
 		//TODO
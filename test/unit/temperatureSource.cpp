@@ -42,7 +42,27 @@ TEST_CASE("temperature")
 		CHECK(space.temperature_get(b3) == temperatureBeforeHeatSource + 20);
 		CHECK(space.temperature_get(toBurn) > temperatureBeforeHeatSource + 1000);
 		CHECK(space.temperature_get(toNotBurn) == temperatureBeforeHeatSource + 1014);
-		CHECK(!simulation.m_eventSchedule.m_data.empty());
+		CHECK(!simulation.m_eventSchedule.empty());
+	}
+	SUBCASE("tile temperatures match point temperatures")
+	{
+		auto marble = MaterialType::byName("marble");
+		space.solid_set(Point3D::create(5, 6, 5), marble, false);
+		AreaHasTemperature& hasTemperature = area.m_hasTemperature;
+		hasTemperature.m_sources.addTemperatureSource(area, Point3D::create(5, 5, 5), TemperatureDelta::create(1000));
+		hasTemperature.m_sources.addTemperatureSource(area, Point3D::create(3, 7, 4), TemperatureDelta::create(-200));
+		hasTemperature.doStep(area);
+		for(const Cuboid cuboid : {space.boundry(), Cuboid{Point3D::create(7, 8, 9), Point3D::create(2, 3, 4)}})
+		{
+			TemperatureTile tile;
+			tile.cuboid = cuboid;
+			hasTemperature.readTemperatures(area, tile);
+			bool matches = true;
+			for(const Point3D point : cuboid)
+				if(tile.get(point) != hasTemperature.get(area, point))
+					matches = false;
+			CHECK(matches);
+		}
 	}
 	SUBCASE("burnt to ash")
 	{
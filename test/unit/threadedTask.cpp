@@ -6,6 +6,7 @@
 #include "../../engine/actors/actors.h"
 #include "../../engine/items/items.h"
 #include "../../engine/plants.h"
+#include <atomic>
 class TestThreadedTask final : public ThreadedTask
 {
 	bool& fired;
@@ -66,6 +67,28 @@ TEST_CASE("threadedTask")
 		CHECK(!fired);
 	}
 }
+class TestThreadedTaskCounter final : public ThreadedTask
+{
+	std::atomic<int>& reads;
+	int& writes;
+public:
+	TestThreadedTaskCounter(std::atomic<int>& r, int& w) : reads(r), writes(w) { }
+	void readStep(Simulation&, Area*) { ++reads; }
+	void writeStep(Simulation&, Area*) { ++writes; }
+	void clearReferences(Simulation&, Area*) { }
+};
+TEST_CASE("threadedTaskParallelRead")
+{
+	std::atomic<int> reads = 0;
+	int writes = 0;
+	Simulation simulation;
+	for(int i = 0; i < 1000; ++i)
+		simulation.m_threadedTaskEngine.insert(std::make_unique<TestThreadedTaskCounter>(reads, writes));
+	simulation.doStep();
+	CHECK(reads == 1000);
+	CHECK(writes == 1000);
+	CHECK(simulation.m_threadedTaskEngine.empty());
+}
 TEST_CASE("hasThreadedTask")
 {
 	bool fired = false;
@@ -8,6 +8,8 @@ void screens::load(Window& window)
 {
 	begin(window, "Load");
 	ImGui::PushFont(nullptr, displayData::menuFontSize);
+	if(!window.m_loadError.empty())
+		ImGui::TextWrapped("Load failed: %s", window.m_loadError.c_str());
 	for(const auto& [name, path] : window.m_simulationList)
 	{
 		if(imguiButtonCentered(name.c_str()))
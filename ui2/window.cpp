@@ -5,6 +5,7 @@
 #include "../engine/simulation/hasAreas.h"
 #include "../engine/area/area.h"
 #include "../engine/space/space.h"
+#include "../engine/binaryArchive.h"
 #include <stdint.h>
 #include <utility>
 #include <stdint.h>
@@ -342,6 +343,7 @@ void Window::showEditActor(const ActorReference actor)
 void Window::createSimulation(const std::string& name, const DateTime dateTime)
 {
 	m_simulation = std::make_unique<Simulation>(name, dateTime);
+	m_simulation->m_autosave.setFrequency(Config::stepsFrequencyToAutosave);
 	m_simulation->save();
 	updateSimulationList();
 }
@@ -360,9 +362,18 @@ void Window::updateSimulationList()
 void Window::load(const std::filesystem::path& path)
 {
 	m_gameOverlay.deselectAll();
+	m_loadError.clear();
 	auto result = std::make_shared<LoadResult>();
 	std::function<void()> task = [path, result] mutable {
-		result->simulation = std::make_unique<Simulation>(path);
+		try
+		{
+			result->simulation = std::make_unique<Simulation>(path);
+		}
+		catch(const BinaryArchiveError& error)
+		{
+			result->error = error.what();
+			return;
+		}
 		std::filesystem::path viewPath = result->simulation->getPath()/"view.json";
 		if(std::filesystem::exists(viewPath))
 		{
@@ -375,9 +386,16 @@ void Window::load(const std::filesystem::path& path)
 	};
 	std::function<void()> callback = [this, result] mutable
 	{
+		if(!result->error.empty())
+		{
+			m_loadError = result->error;
+			showLoad();
+			return;
+		}
 		m_paused = true;
 		m_speed = 1.0f;
 		m_simulation = std::move(result->simulation);
+		m_simulation->m_autosave.setFrequency(Config::stepsFrequencyToAutosave);
 		m_faction = result->faction;
 		if(result->area.exists())
 		{
@@ -75,6 +75,7 @@ struct POV final
 struct LoadResult final
 {
 	std::unique_ptr<Simulation> simulation;
+	std::string error;
 	FactionId faction;
 	AreaId area;
 };
@@ -102,6 +103,8 @@ public:
 	bool m_controllKey = false;
 	void updateSimulationList();
 	std::vector<std::pair<std::string, std::filesystem::path>> m_simulationList;
+	// Why the most recent load failed, shown by the load screen.
+	std::string m_loadError;
 	BackgroundTask m_backgroundTask;
 	ImGuiMouseCursor m_cursor = ImGuiMouseCursor_Arrow;
 	PanelId m_panel = PanelId::MainMenu;